@@ -13,6 +13,14 @@ list(APPEND OCS2_CXX_FLAGS
   "-DBOOST_ALL_DYN_LINK"
   )
 
+# Hierarchical solver tracing (see ocs2_core/misc/Tracing.h), disabled by default:
+#   catkin config --cmake-args -DOCS2_ENABLE_TRACING=ON
+if (OCS2_ENABLE_TRACING)
+  list(APPEND OCS2_CXX_FLAGS
+    "-DOCS2_ENABLE_TRACING"
+    )
+endif (OCS2_ENABLE_TRACING)
+
 # Add OpenMP flags
 if (NOT DEFINED OpenMP_CXX_FOUND)
   find_package(OpenMP REQUIRED)
@@ -38,7 +38,8 @@ namespace ocs2 {
  * Pre-Computation base class.
  *
  * This is an optional module for sharing computation between system dynamics, cost and constraint
- * terms. The virtual request callback are called before getting the value or approximation.
+ * terms. The request callbacks are called before getting the value or approximation. Derived classes implement the
+ * computation in the virtual requestImpl, requestPreJumpImpl, and requestFinalImpl.
  * The callbacks take a set of requested computation items, which must be computed and stored
  * in the PreComputation object. The same PreComputation is passed to the getter methods of
  * dynamics, cost and constraint terms, which can make use of the shared pre-computation.
@@ -56,18 +57,85 @@ class PreComputation {
   /** Clone */
   virtual PreComputation* clone() const { return new PreComputation(*this); }
 
-  /** Request callback */
-  virtual void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {}
-
-  /** Request callback at jump event time */
-  virtual void requestPreJump(RequestSet request, scalar_t t, const vector_t& x) {}
-
-  /** Request callback at final time */
-  virtual void requestFinal(RequestSet request, scalar_t t, const vector_t& x) {}
+  /** Request callback. Always computes the request and invalidates the cache of the cached requests. */
+  void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
+    invalidateCache();
+    requestImpl(request, t, x, u);
+  }
+
+  /** Request callback at jump event time, see request() */
+  void requestPreJump(RequestSet request, scalar_t t, const vector_t& x) {
+    invalidateCache();
+    requestPreJumpImpl(request, t, x);
+  }
+
+  /** Request callback at final time, see request() */
+  void requestFinal(RequestSet request, scalar_t t, const vector_t& x) {
+    invalidateCache();
+    requestFinalImpl(request, t, x);
+  }
+
+  /**
+   * Cached request callback. Computes the request unless it is already available at the same node (t, x, u), e.g. because
+   * the dynamics, cost and constraints of a node are evaluated one after the other. A computation is available if it was part
+   * of a cached request at exactly the same node since the last request() or invalidateCache(). A request without
+   * Request::Approximation is also served by an earlier request of the approximation at the same node.
+   *
+   * @note Changing any data the pre-computation depends on besides (t, x, u), e.g. the references, requires a call of
+   *       invalidateCache().
+   */
+  void cachedRequest(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u);
+
+  /** Cached request callback at jump event time, see cachedRequest() */
+  void cachedRequestPreJump(RequestSet request, scalar_t t, const vector_t& x);
+
+  /** Cached request callback at final time, see cachedRequest() */
+  void cachedRequestFinal(RequestSet request, scalar_t t, const vector_t& x);
+
+  /** Invalidates the node cache such that the next cached request is always computed */
+  void invalidateCache() { cache_.node = CachedNode::None; }
+
+  /** Number of cached requests and how many of them were served by the cache */
+  struct CacheStatistics {
+    size_t numRequests = 0;
+    size_t numReused = 0;
+  };
+
+  /** Gets the statistics of the cached requests */
+  const CacheStatistics& getCacheStatistics() const { return cacheStatistics_; }
+
+  /** Resets the statistics of the cached requests */
+  void resetCacheStatistics() { cacheStatistics_ = CacheStatistics(); }
 
  protected:
   /** Copy constructor */
   PreComputation(const PreComputation& other) = default;
+
+  /** Computes the requested items. Called by request() and cachedRequest(). */
+  virtual void requestImpl(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {}
+
+  /** Computes the requested items at jump event time. Called by requestPreJump() and cachedRequestPreJump(). */
+  virtual void requestPreJumpImpl(RequestSet request, scalar_t t, const vector_t& x) {}
+
+  /** Computes the requested items at final time. Called by requestFinal() and cachedRequestFinal(). */
+  virtual void requestFinalImpl(RequestSet request, scalar_t t, const vector_t& x) {}
+
+ private:
+  enum class CachedNode { None, Intermediate, PreJump, Final };
+
+  /** Returns true if the request is available at the given node, otherwise registers the request at that node. */
+  bool updateCache(CachedNode node, RequestSet request, scalar_t t, const vector_t& x, const vector_t* uPtr);
+
+  struct {
+    CachedNode node = CachedNode::None;
+    scalar_t time = 0.0;
+    vector_t state;
+    vector_t input;
+    int values = 0;          // bitmask of the Request items available as values
+    int approximations = 0;  // bitmask of the Request items available with their approximation
+  } cache_;
+
+  CacheStatistics cacheStatistics_;
 };
 
 /** Helper to cast to const reference of derived class. */
@@ -0,0 +1,113 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ocs2 {
+
+class CppAdInterface;
+
+/**
+ * Collects the compilation of CppAD models and compiles them in parallel.
+ *
+ * While a queue is alive, CppAdInterface::createModels (and loadModelsIfAvailable on a cache miss) called on the thread that created the
+ * queue only records the tape and generates the sources. The compilation is deferred to flush(), which compiles all queued libraries in
+ * parallel and afterwards loads them into every interface that is waiting for them, including copies made in the meantime. The pending
+ * interfaces must not be evaluated before flush() returns.
+ *
+ * Usage:
+ *   CppAdBuildQueue buildQueue;
+ *   ... construct all CppAd based components ...
+ *   buildQueue.flush();
+ */
+class CppAdBuildQueue {
+ public:
+  /**
+   * Constructor. Activates the queue on the calling thread.
+   * @param [in] numThreads: The number of threads (including the calling thread) that run the compilation jobs.
+   */
+  explicit CppAdBuildQueue(size_t numThreads = std::thread::hardware_concurrency());
+
+  /**
+   * Destructor. Flushes the queue if needed and restores the previously active queue on the calling thread. A compilation error
+   * during this flush is only reported, call flush() explicitly to handle it.
+   */
+  ~CppAdBuildQueue();
+
+  CppAdBuildQueue(const CppAdBuildQueue&) = delete;
+  CppAdBuildQueue& operator=(const CppAdBuildQueue&) = delete;
+
+  /**
+   * Compiles all queued libraries in parallel and loads them into the pending interfaces. The first compilation error is rethrown
+   * after all jobs have finished. In that case, none of the pending interfaces is loaded and their evaluation throws.
+   */
+  void flush();
+
+  /** Number of queued compilation jobs. */
+  size_t getNumJobs() const { return jobs_.size(); }
+
+  /** The queue that is active on the calling thread, nullptr if there is none. */
+  static CppAdBuildQueue* getActiveQueue();
+
+ private:
+  friend class CppAdInterface;
+
+  /**
+   * Queues the compilation of a library. A library that is already queued with the same key is only compiled once.
+   *
+   * @param [in] libraryName: The path of the library without extension.
+   * @param [in] modelKey: The cache key of the model.
+   * @param [in] job: The compilation job.
+   */
+  void push(const std::string& libraryName, const std::string& modelKey, std::function<void()> job);
+
+  /** Registers an interface that waits for its library to be compiled. */
+  void addPendingModel(CppAdInterface* interfacePtr);
+
+  /** Unregisters an interface, e.g., when it is destroyed before the queue is flushed. */
+  void removePendingModel(CppAdInterface* interfacePtr);
+
+  size_t numThreads_;
+  CppAdBuildQueue* previousActiveQueue_;
+
+  std::vector<std::function<void()>> jobs_;
+  std::map<std::string, std::string> queuedLibraries_;  // library name to model key
+
+  std::mutex pendingModelsMutex_;
+  std::vector<CppAdInterface*> pendingModels_;
+};
+
+}  // namespace ocs2
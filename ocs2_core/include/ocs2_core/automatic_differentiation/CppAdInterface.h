@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Eigen/Core>
 
 // STL
+#include <memory>
 #include <string>
 
 // CppAD
@@ -45,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+class CppAdBuildQueue;
+
 class CppAdInterface {
  public:
   enum class ApproximationOrder { Zero, First, Second };
@@ -82,10 +85,11 @@ class CppAdInterface {
   CppAdInterface(ad_function_t adFunction, size_t variableDim, std::string modelName, std::string folderName = "/tmp/ocs2",
                  std::vector<std::string> compileFlags = {"-O3", "-g", "-march=native", "-mtune=native", "-ffast-math"});
 
-  ~CppAdInterface() = default;
+  ~CppAdInterface();
 
   /**
-   * Copy constructor. Models are reloaded if available.
+   * Copy constructor. Models are reloaded if available. If the models of rhs are still queued in a CppAdBuildQueue, the copy
+   * is loaded when the queue is flushed.
    */
   CppAdInterface(const CppAdInterface& rhs);
 
@@ -100,7 +104,8 @@ class CppAdInterface {
   void loadModels(bool verbose = true);
 
   /**
-   * Creates models, compiles them, and saves them to disk
+   * Creates models, compiles them, and saves them to disk together with the model key (see loadModelsIfAvailable).
+   * If a CppAdBuildQueue is active on the calling thread, the compilation is deferred to the queue.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
@@ -108,7 +113,10 @@ class CppAdInterface {
   void createModels(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
   /**
-   * Load models if they are available on disk. Creates a new library otherwise.
+   * Load models if they are available on disk and up to date. Creates a new library otherwise.
+   * The library on disk is only reused if its model key matches the current model. The key is a hash of the size of the recorded
+   * tape, its function value at a fixed input, the dimensions, the approximation order, the compile flags, and the compiler version.
+   * Computing the key does not generate any sources, such that loading an up to date library only costs the taping.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
@@ -165,6 +173,54 @@ class CppAdInterface {
    */
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Sparsity pattern of the jacobian w.r.t. the variables x. Entry i holds the indices of the structurally non-zero columns of row i.
+   * Requires the models to be generated with ApproximationOrder::First or higher.
+   */
+  cppad_sparsity::SparsityPattern getJacobianSparsityPattern() const;
+
+  /**
+   * The following overloads write into caller-owned outputs. They do not allocate once the outputs have the right size, since
+   * the concatenated input and the sparse values are kept in a per-thread scratch memory.
+   */
+
+  /**
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] functionValue : y = f(x,p)
+   */
+  void getFunctionValue(const vector_t& x, const vector_t& p, vector_t& functionValue) const;
+
+  /**
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] jacobian : d/dx( f(x,p) )
+   */
+  void getJacobian(const vector_t& x, const vector_t& p, matrix_t& jacobian) const;
+
+  /**
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] gnApprox : Quadratic approximation with the values stored in f, dfdx, dfdxx.
+   */
+  void getGaussNewtonApproximation(const vector_t& x, const vector_t& p, ScalarFunctionQuadraticApproximation& gnApprox) const;
+
+  /**
+   * @param outputIndex : Output to get the hessian for.
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] hessian : dd/dxdx( f_i(x,p) )
+   */
+  void getHessian(size_t outputIndex, const vector_t& x, const vector_t& p, matrix_t& hessian) const;
+
+  /**
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] hessian : dd/dxdx(sum_i  w_i*f_i(x,p) )
+   */
+  void getHessian(const vector_t& w, const vector_t& x, const vector_t& p, matrix_t& hessian) const;
+
  private:
   /**
    * Defines library folder names
@@ -221,8 +277,51 @@ class CppAdInterface {
    */
   cppad_sparsity::SparsityPattern createHessianSparsity(ad_fun_t& fun) const;
 
+  /**
+   * Records the tape of the function and sets the range dimension.
+   * @return optimized taped ad function
+   */
+  std::unique_ptr<ad_fun_t> recordTape();
+
+  /**
+   * Computes the cache key of the model
+   * @param fun : taped ad function
+   * @param approximationOrder : Order of derivatives to generate
+   * @return hexadecimal hash
+   */
+  std::string getModelKey(ad_fun_t& fun, ApproximationOrder approximationOrder) const;
+
+  /**
+   * Reads the key of the library on disk.
+   * @return the key, or an empty string if the library has no key.
+   */
+  std::string readLibraryModelKey() const;
+
+  /**
+   * Generates the sources of the taped function and compiles them, or queues the compilation if a CppAdBuildQueue is active.
+   */
+  void buildModels(std::unique_ptr<ad_fun_t> funPtr, ApproximationOrder approximationOrder, const std::string& modelKey, bool verbose);
+
+  /**
+   * Writes the concatenation of x and p into the thread local scratch memory.
+   * @return view on the concatenated input
+   */
+  CppAD::cg::ArrayView<const scalar_t> getInputArrayView(const vector_t& x, const vector_t& p) const;
+
+  /**
+   * The loaded model.
+   * @throw std::runtime_error if no model is loaded, e.g., because it is still queued for compilation or its compilation failed.
+   */
+  CppAD::cg::GenericModel<scalar_t>& getModel() const;
+
+  friend class CppAdBuildQueue;
+
   std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib_;
   std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> model_;
+
+  // Set while the library is compiled by a build queue
+  CppAdBuildQueue* buildQueuePtr_ = nullptr;
+  cppad_sparsity::SparsityPattern pendingJacobianSparsity_;
   ad_parameterized_function_t adFunction_;
   std::vector<std::string> compileFlags_;
 
@@ -66,6 +66,18 @@ class StateConstraint {
     }
   }
 
+  /**
+   * Writes the constraint linear approximation into the rows starting at the given row of a preallocated approximation, e.g. of a
+   * constraint collection. The default implementation copies the result of getLinearApproximation().
+   */
+  virtual void writeLinearApproximation(scalar_t time, const vector_t& state, const PreComputation& preComp, size_t row,
+                                        VectorFunctionLinearApproximation& approximation) const {
+    const auto termApproximation = getLinearApproximation(time, state, preComp);
+    const size_t nc = termApproximation.f.rows();
+    approximation.f.segment(row, nc) = termApproximation.f;
+    approximation.dfdx.middleRows(row, nc) = termApproximation.dfdx;
+  }
+
   /** Get the constraint quadratic approximation */
   virtual VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                          const PreComputation& preComp) const {
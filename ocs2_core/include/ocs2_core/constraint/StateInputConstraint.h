@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/Types.h>
 #include <ocs2_core/constraint/ConstraintOrder.h>
+#include <ocs2_core/misc/BlockSparsity.h>
 
 namespace ocs2 {
 
@@ -66,6 +67,27 @@ class StateInputConstraint {
     }
   }
 
+  /**
+   * Writes the constraint linear approximation into the rows starting at the given row of a preallocated approximation, e.g. of a
+   * constraint collection. The default implementation copies the result of getLinearApproximation().
+   */
+  virtual void writeLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp,
+                                        size_t row, VectorFunctionLinearApproximation& approximation) const {
+    const auto termApproximation = getLinearApproximation(time, state, input, preComp);
+    const size_t nc = termApproximation.f.rows();
+    approximation.f.segment(row, nc) = termApproximation.f;
+    approximation.dfdx.middleRows(row, nc) = termApproximation.dfdx;
+    approximation.dfdu.middleRows(row, nc) = termApproximation.dfdu;
+  }
+
+  /**
+   * Get the structural sparsity of the constraint linear approximation. Columns outside of the returned blocks must be zero for every
+   * state and input. The default implementation returns a dense sparsity.
+   */
+  virtual LinearApproximationSparsity getLinearApproximationSparsity(scalar_t time, size_t stateDim, size_t inputDim) const {
+    return block_sparsity::dense(stateDim, inputDim);
+  }
+
   /** Get the constraint quadratic approximation */
   virtual VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                          const PreComputation& preComp) const {
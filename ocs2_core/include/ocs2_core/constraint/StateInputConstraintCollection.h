@@ -55,6 +55,9 @@ class StateInputConstraintCollection : public Collection<StateInputConstraint> {
   /** Returns the number of active constraints at a given time for each term. If a term is inactive, its size is zero. */
   size_array_t getTermsSize(scalar_t time) const;
 
+  /** In-place variant of getTermsSize, reusing the memory of termsSize. */
+  void getTermsSize(scalar_t time, size_array_t& termsSize) const;
+
   /** Get an array of all constraints. If a term is inactive, the corresponding element is a vector of size zero. */
   virtual vector_array_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) const;
 
@@ -62,6 +65,9 @@ class StateInputConstraintCollection : public Collection<StateInputConstraint> {
   virtual VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                    const PreComputation& preComp) const;
 
+  /** Get the structural sparsity of the constraint linear approximation, i.e., the union of the sparsity of all active terms. */
+  virtual LinearApproximationSparsity getLinearApproximationSparsity(scalar_t time, size_t stateDim, size_t inputDim) const;
+
   /** Get the constraint quadratic approximation */
   virtual VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                          const PreComputation& preComp) const;
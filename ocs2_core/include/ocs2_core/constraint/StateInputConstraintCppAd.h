@@ -66,6 +66,9 @@ class StateInputConstraintCppAd : public StateInputConstraint {
   VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                  const PreComputation& /* preComputation */) const override;
 
+  /** Sparsity of the generated jacobian. Columns that do not depend on the state or input for any parameter value are skipped. */
+  LinearApproximationSparsity getLinearApproximationSparsity(scalar_t time, size_t stateDim, size_t inputDim) const override;
+
  protected:
   StateInputConstraintCppAd(const StateInputConstraintCppAd& rhs);
 
@@ -75,6 +78,12 @@ class StateInputConstraintCppAd : public StateInputConstraint {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  LinearApproximationSparsity sparsity_;
+
+  // Evaluation buffers, the solvers evaluate a separate clone per thread.
+  mutable vector_t tapedTimeStateInput_;
+  mutable matrix_t jacobian_;
+  mutable matrix_t hessian_;
 };
 
 }  // namespace ocs2
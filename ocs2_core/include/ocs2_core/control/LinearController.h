@@ -105,6 +105,9 @@ class LinearController final : public ControllerBase {
  private:
   void flattenSingle(scalar_t time, std::vector<float>& flatArray) const;
 
+  // Lookup hint for the time stamps, queries are mostly monotone in time
+  LinearInterpolation::TimeSegmentCursor timeSegmentCursor_;
+
  public:
   scalar_array_t timeStamp_;
   vector_array_t biasArray_;
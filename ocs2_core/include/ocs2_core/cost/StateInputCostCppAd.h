@@ -78,6 +78,12 @@ class StateInputCostCppAd : public StateInputCost {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+
+  // Evaluation buffers, the solvers evaluate a separate clone per thread.
+  mutable vector_t tapedTimeStateInput_;
+  mutable vector_t functionValue_;
+  mutable matrix_t jacobian_;
+  mutable matrix_t hessian_;
 };
 
 }  // namespace ocs2
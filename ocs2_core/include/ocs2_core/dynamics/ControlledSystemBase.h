@@ -122,7 +122,21 @@ class ControlledSystemBase : public OdeBase {
   vector_t computeJumpMap(scalar_t time, const vector_t& state) override final;
 
   /** Get the pre-computation module */
-  const PreComputation& getPreComputation() const { return *preCompPtr_; }
+  const PreComputation& getPreComputation() const { return *activePreComputation(); }
+
+  /**
+   * Shares an external pre-computation module instead of the internal copy, e.g. the one of an OptimalControlProblem, such that
+   * the dynamics, cost and constraints at a node are computed in a single request. The dynamics then use the cached
+   * requests of the shared module. The module has to outlive this object. Pass nullptr to use the internal copy again.
+   *
+   * @note Copies of this object do not share the external module.
+   * @throw std::invalid_argument if the module is not of the same type as the one given at construction, unless that one is a
+   *        plain PreComputation, i.e. the dynamics do not use it.
+   */
+  void setSharedPreComputation(PreComputation* preCompPtr);
+
+  /** Whether the dynamics use an external pre-computation module */
+  bool hasSharedPreComputation() const { return sharedPreCompPtr_ != nullptr; }
 
  protected:
   /**
@@ -133,9 +147,18 @@ class ControlledSystemBase : public OdeBase {
    */
   ControlledSystemBase(const ControlledSystemBase& other);
 
+  /** Requests the computation of the dynamics at a node on the shared or the internal pre-computation module */
+  PreComputation& requestDynamics(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u);
+
+  /** Requests the computation of the jump map on the shared or the internal pre-computation module */
+  PreComputation& requestDynamicsPreJump(RequestSet request, scalar_t t, const vector_t& x);
+
   std::unique_ptr<PreComputation> preCompPtr_;  //! pointer to pre-computation module
 
  private:
+  PreComputation* activePreComputation() const { return sharedPreCompPtr_ != nullptr ? sharedPreCompPtr_ : preCompPtr_.get(); }
+
+  PreComputation* sharedPreCompPtr_ = nullptr;  //! pointer to the shared pre-computation module, not owned
   ControllerBase* controllerPtr_ = nullptr;  //! pointer to controller
 };
 
@@ -0,0 +1,102 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/integration/IntegratorBase.h>
+
+namespace ocs2 {
+
+/*
+ * Fixed step explicit Runge-Kutta integrator class (forward Euler or classic 4th order Runge-Kutta).
+ *
+ * The stepping follows the boost odeint integrate functions for simple steppers, i.e. the results match the EULER and RK4
+ * integrators up to round-off. Unlike those, the system is evaluated directly through OdeBase instead of a type-erased
+ * function, and the intermediate states are kept as members such that they are only allocated on the first integration.
+ * The only remaining allocation per stage is the vector returned by OdeBase::computeFlowMap.
+ */
+class FixedStepIntegrator : public IntegratorBase {
+ public:
+  enum class Scheme { Euler, RK4 };
+
+  /**
+   * Constructor
+   * @param [in] scheme: The Runge-Kutta scheme.
+   * @param [in] eventHandlerPtr: The integration event function.
+   */
+  explicit FixedStepIntegrator(Scheme scheme, std::shared_ptr<SystemEventHandler> eventHandlerPtr = nullptr)
+      : IntegratorBase(std::move(eventHandlerPtr)), scheme_(scheme) {}
+
+  ~FixedStepIntegrator() override = default;
+
+  void integrateConst(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime, scalar_t finalTime,
+                      scalar_t dt, int maxNumSteps = std::numeric_limits<int>::max()) override;
+
+  /** The tolerances are ignored, the integration takes steps of dtInitial with a shorter final step to end at finalTime. */
+  void integrateAdaptive(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime, scalar_t finalTime,
+                         scalar_t dtInitial = 0.01, scalar_t AbsTol = 1e-6, scalar_t RelTol = 1e-3,
+                         int maxNumSteps = std::numeric_limits<int>::max()) override;
+
+  /** The tolerances are ignored, the integration takes steps of at most dtInitial such that every time stamp is hit. */
+  void integrateTimes(OdeBase& system, Observer& observer, const vector_t& initialState,
+                      typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
+                      scalar_t dtInitial = 0.01, scalar_t AbsTol = 1e-6, scalar_t RelTol = 1e-3,
+                      int maxNumSteps = std::numeric_limits<int>::max()) override;
+
+ private:
+  void runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
+                         scalar_t finalTime, scalar_t dt) override;
+
+  void runIntegrateAdaptive(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
+                            scalar_t finalTime, scalar_t dtInitial, scalar_t absTol, scalar_t relTol) override;
+
+  void runIntegrateTimes(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                         typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
+                         scalar_t dtInitial, scalar_t absTol, scalar_t relTol) override;
+
+  /**
+   * Performs one step on x_.
+   * @param [in] flowMap: callable as flowMap(t, x, dxdt).
+   * @param [in] t: current time.
+   * @param [in] dt: step size.
+   */
+  template <typename FlowMap>
+  void doStep(FlowMap& flowMap, scalar_t t, scalar_t dt);
+
+  const Scheme scheme_;
+
+  vector_t x_;
+  vector_t xStage_;
+  vector_t k1_;
+  vector_t k2_;
+  vector_t k3_;
+  vector_t k4_;
+};
+
+}  // namespace ocs2
@@ -49,7 +49,9 @@ enum class IntegratorType {
   MODIFIED_MIDPOINT,
   RK4,
   RK5_VARIABLE,
-  ADAMS_BASHFORTH_MOULTON
+  ADAMS_BASHFORTH_MOULTON,
+  EULER_OCS2,
+  RK4_OCS2
 };
 
 namespace integrator_type {
@@ -71,6 +71,11 @@ DynamicsDiscretizer selectDynamicsDiscretization(SensitivityIntegratorType integ
 /**
  * A function handle to compute the linear approximation of the discretized system's flowmap.
  *
+ * @note The stages of the explicit schemes are evaluated at (t, x_{k}, u_{k}) and at predicted states inside the interval. Only the
+ * first stage coincides with a point evaluated elsewhere in a multiple-shooting transcription, i.e. the node itself. The stages of
+ * adjacent intervals do not coincide, since the next interval starts from its own shooting state x_{k+1} and input u_{k+1}. The
+ * evaluation of the first stage is shared with the costs and constraints of the node through the cached pre-computation request.
+ *
  * @param system : system to be discretized
  * @param t : starting time of the discretization interval
  * @param x : starting state x_{k}
@@ -46,10 +46,6 @@ class LoopshapingPreComputation final : public PreComputation {
   ~LoopshapingPreComputation() override = default;
   LoopshapingPreComputation* clone() const override;
 
-  void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
-  void requestPreJump(RequestSet request, scalar_t t, const vector_t& x) override;
-  void requestFinal(RequestSet request, scalar_t t, const vector_t& x) override;
-
   /** System state, computed for the last request. */
   const vector_t& getSystemState() const { return systemState_; }
 
@@ -68,6 +64,10 @@ class LoopshapingPreComputation final : public PreComputation {
  private:
   LoopshapingPreComputation(const LoopshapingPreComputation& rhs);
 
+  void requestImpl(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
+  void requestPreJumpImpl(RequestSet request, scalar_t t, const vector_t& x) override;
+  void requestFinalImpl(RequestSet request, scalar_t t, const vector_t& x) override;
+
   vector_t systemState_;
   vector_t systemInput_;
   vector_t filterState_;
@@ -43,6 +43,11 @@ class LoopshapingStateInputConstraint : public StateInputConstraintCollection {
 
   vector_array_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) const override;
 
+  /** The augmented approximation rearranges the columns of the system constraint, hence its sparsity is not propagated. */
+  LinearApproximationSparsity getLinearApproximationSparsity(scalar_t time, size_t stateDim, size_t inputDim) const override {
+    return block_sparsity::dense(stateDim, inputDim);
+  }
+
  protected:
   LoopshapingStateInputConstraint(const StateInputConstraintCollection& systemConstraint,
                                   std::shared_ptr<LoopshapingDefinition> loopshapingDefinition)
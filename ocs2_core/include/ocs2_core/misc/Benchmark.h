@@ -32,17 +32,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <chrono>
 
 #include "ocs2_core/Types.h"
+#include "ocs2_core/misc/Tracing.h"
 
 namespace ocs2 {
 namespace benchmark {
 
 /**
  * Timer class that can be repeatedly started and stopped. Statistics are collected for all measured intervals .
+ * If a trace name is given, each interval is also recorded as a tracing zone (see ocs2_core/misc/Tracing.h).
  */
 class RepeatedTimer {
  public:
-  RepeatedTimer()
-      : numTimedIntervals_(0),
+  /**
+   * Constructor
+   * @param [in] traceName: Name of the tracing zone, a string literal. Pass nullptr to not trace the intervals.
+   */
+  explicit RepeatedTimer(const char* traceName = nullptr)
+      : traceName_(traceName),
+        numTimedIntervals_(0),
         totalTime_(std::chrono::nanoseconds::zero()),
         maxIntervalTime_(std::chrono::nanoseconds::zero()),
         lastIntervalTime_(std::chrono::nanoseconds::zero()),
@@ -61,7 +68,15 @@ class RepeatedTimer {
   /**
    *  Start timing an interval
    */
-  void startTimer() { startTime_ = std::chrono::steady_clock::now(); }
+  void startTimer() {
+#ifdef OCS2_ENABLE_TRACING
+    if (traceName_ != nullptr && !traceZoneOpen_) {
+      tracing::beginZone(traceName_);
+      traceZoneOpen_ = true;
+    }
+#endif
+    startTime_ = std::chrono::steady_clock::now();
+  }
 
   /**
    * Stop timing of an interval
@@ -72,6 +87,12 @@ class RepeatedTimer {
     maxIntervalTime_ = std::max(maxIntervalTime_, lastIntervalTime_);
     totalTime_ += lastIntervalTime_;
     numTimedIntervals_++;
+#ifdef OCS2_ENABLE_TRACING
+    if (traceZoneOpen_) {
+      tracing::endZone();
+      traceZoneOpen_ = false;
+    }
+#endif
   };
 
   /**
@@ -100,6 +121,8 @@ class RepeatedTimer {
   scalar_t getAverageInMilliseconds() const { return getTotalInMilliseconds() / numTimedIntervals_; }
 
  private:
+  const char* traceName_;
+  bool traceZoneOpen_ = false;
   int numTimedIntervals_;
   std::chrono::nanoseconds totalTime_;
   std::chrono::nanoseconds maxIntervalTime_;
@@ -0,0 +1,87 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/** A block of consecutive matrix columns: [start, start + size). */
+struct ColumnBlock {
+  int start = 0;
+  int size = 0;
+};
+
+/** Sorted and disjoint column blocks which mark the structurally non-zero columns of a matrix. */
+using column_blocks_t = std::vector<ColumnBlock>;
+
+/**
+ * Structural sparsity of a linear approximation f(x,u) = dfdx * dx + dfdu * du + f. Columns of dfdx and dfdu that are not covered by
+ * the blocks are zero for every evaluation point, such that their products can be skipped.
+ */
+struct LinearApproximationSparsity {
+  /** Structurally non-zero columns of dfdx */
+  column_blocks_t stateColumns;
+  /** Structurally non-zero columns of dfdu */
+  column_blocks_t inputColumns;
+};
+
+namespace block_sparsity {
+
+/** Returns a single block that covers all columns. Returns no blocks if numColumns is zero. */
+column_blocks_t dense(int numColumns);
+
+/** Returns the sparsity of a dense linear approximation. */
+LinearApproximationSparsity dense(int stateDim, int inputDim);
+
+/**
+ * Extracts the column blocks of a window of a sparsity pattern.
+ *
+ * @param [in] columnIndices : Indices of the non-zero columns.
+ * @param [in] offset : First column of the window.
+ * @param [in] numColumns : Number of columns of the window.
+ * @return Column blocks relative to the offset.
+ */
+column_blocks_t fromColumnIndices(const std::set<size_t>& columnIndices, int offset, int numColumns);
+
+/** Returns the blocks that cover the columns of both lhs and rhs. */
+column_blocks_t getUnion(const column_blocks_t& lhs, const column_blocks_t& rhs);
+
+/** Returns the sparsity that covers the columns of both lhs and rhs. */
+LinearApproximationSparsity getUnion(const LinearApproximationSparsity& lhs, const LinearApproximationSparsity& rhs);
+
+/** Returns the number of columns that are covered by the blocks. */
+int getNumColumns(const column_blocks_t& blocks);
+
+}  // namespace block_sparsity
+}  // namespace ocs2
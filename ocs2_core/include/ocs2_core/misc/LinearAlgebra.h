@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/NumericTraits.h>
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/BlockSparsity.h>
 
 namespace ocs2 {
 namespace LinearAlgebra {
@@ -120,9 +121,38 @@ void computeConstraintProjection(const matrix_t& Dm, const matrix_t& RmInvUmUmT,
  * Implementation based on the QR decomposition
  *
  * @param [in] constraint : C = dfdx, D = dfdu, e = f;
+ * @param [in] stateColumnsPtr : Optional structurally non-zero columns of C. Px is only computed on these columns and zero elsewhere.
  * @return Projection terms Px = dfdx, Pu = dfdu, Pe = f (first) and left pseudo-inverse of D^T (second);
  */
-std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(const VectorFunctionLinearApproximation& constraint);
+std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(const VectorFunctionLinearApproximation& constraint,
+                                                                              const column_blocks_t* stateColumnsPtr = nullptr);
+
+/**
+ * Memory of the in-place constraint projections: the factorizations of the constraint and the intermediate results of their solves.
+ * Nothing is allocated by the projections when the problem dimensions do not change between calls.
+ */
+struct ConstraintProjectionWorkspace {
+  Eigen::HouseholderQR<matrix_t> qr;  // QR decomposition of D^T
+  matrix_t Q;                         // Q of the QR decomposition
+  Eigen::FullPivLU<matrix_t> lu;      // LU decomposition of D
+  matrix_t matrixSolution;            // Intermediate solution of the LU decomposition for C
+  vector_t vectorSolution;            // Intermediate solution of the LU decomposition for e, Householder workspace of the QR decomposition
+  matrix_t kernel;                    // Intermediate null space basis of U, from the LU decomposition
+};
+
+/**
+ * In-place variant of qrConstraintProjection. The factorization and the results are written into the given objects, such that their
+ * memory is reused when the problem dimensions do not change between calls.
+ *
+ * @param [in] constraint : C = dfdx, D = dfdu, e = f;
+ * @param [in, out] workspace : Memory of the factorization, workspace.qr holds the QR decomposition of D^T.
+ * @param [out] projection : Projection terms Px = dfdx, Pu = dfdu, Pe = f.
+ * @param [out] pseudoInverse : Left pseudo-inverse of D^T.
+ * @param [in] stateColumnsPtr : Optional structurally non-zero columns of C. Px is only computed on these columns and zero elsewhere.
+ */
+void qrConstraintProjection(const VectorFunctionLinearApproximation& constraint, ConstraintProjectionWorkspace& workspace,
+                            VectorFunctionLinearApproximation& projection, matrix_t& pseudoInverse,
+                            const column_blocks_t* stateColumnsPtr = nullptr);
 
 /**
  * Returns the linear projection
@@ -134,10 +164,26 @@ std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(co
  *
  * @param [in] constraint : C = dfdx, D = dfdu, e = f;
  * @param [in] extractPseudoInverse : If true, left pseudo-inverse of D^T is returned. If false, an empty matrix is returned;
+ * @param [in] stateColumnsPtr : Optional structurally non-zero columns of C. Px is only computed on these columns and zero elsewhere.
  * @return Projection terms Px = dfdx, Pu = dfdu, Pe = f (first) and left pseudo-inverse of D^T (second);
  */
 std::pair<VectorFunctionLinearApproximation, matrix_t> luConstraintProjection(const VectorFunctionLinearApproximation& constraint,
-                                                                              bool extractPseudoInverse = false);
+                                                                              bool extractPseudoInverse = false,
+                                                                              const column_blocks_t* stateColumnsPtr = nullptr);
+
+/**
+ * In-place variant of luConstraintProjection. The factorization and the results are written into the given objects, such that their
+ * memory is reused when the problem dimensions do not change between calls. Extracting the pseudo-inverse allocates a temporary.
+ *
+ * @param [in] constraint : C = dfdx, D = dfdu, e = f;
+ * @param [in, out] workspace : Memory of the factorization, workspace.lu holds the LU decomposition of D.
+ * @param [out] projection : Projection terms Px = dfdx, Pu = dfdu, Pe = f.
+ * @param [out] pseudoInversePtr : If not null, the left pseudo-inverse of D^T is written to it.
+ * @param [in] stateColumnsPtr : Optional structurally non-zero columns of C. Px is only computed on these columns and zero elsewhere.
+ */
+void luConstraintProjection(const VectorFunctionLinearApproximation& constraint, ConstraintProjectionWorkspace& workspace,
+                            VectorFunctionLinearApproximation& projection, matrix_t* pseudoInversePtr = nullptr,
+                            const column_blocks_t* stateColumnsPtr = nullptr);
 
 /** Computes the rank of a matrix */
 template <typename Derived>
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -53,6 +54,55 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Same as timeSegment(enquiryTime, timeArray), but the lookup starts at the given hint. For a sequence of monotone enquiries, passing
+ * the same hint to all of them finds each segment in O(1) amortized time. The result does not depend on the hint.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @param [in, out] hint: Index to start the lookup from, it is set to the index found for this enquiry.
+ * @return {index, alpha}
+ */
+index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& hint);
+
+/**
+ * Get the interval index and interpolation coefficient alpha for all enquiry times in a single pass over the time array.
+ * The enquiry times are expected to be sorted, unsorted enquiries give the correct result at the cost of a longer lookup.
+ *
+ * @param [in] enquiryTimes: The enquiry times for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @param [out] indexAlphas: {index, alpha} for each enquiry time.
+ */
+void timeSegments(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray, std::vector<index_alpha_t>& indexAlphas);
+
+/**
+ * Stateful lookup of the time segment for objects that are queried repeatedly at increasing times, e.g. a controller in a rollout or
+ * the target trajectories at the nodes of a horizon. The index of the last enquiry is kept as the hint for the next one.
+ *
+ * The hint is stored in a relaxed atomic, such that a cursor can be a mutable member of an object that is queried concurrently.
+ * Concurrent enquiries only degrade the hint, the results are always identical to timeSegment(enquiryTime, timeArray).
+ */
+class TimeSegmentCursor {
+ public:
+  TimeSegmentCursor() = default;
+  TimeSegmentCursor(const TimeSegmentCursor& other) : hint_(other.hint_.load(std::memory_order_relaxed)) {}
+  TimeSegmentCursor& operator=(const TimeSegmentCursor& other) {
+    hint_.store(other.hint_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+  }
+
+  /** Get the interval index and interpolation coefficient alpha, see timeSegment(enquiryTime, timeArray). */
+  index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) const {
+    int hint = hint_.load(std::memory_order_relaxed);
+    const auto indexAlpha = LinearInterpolation::timeSegment(enquiryTime, timeArray, hint);
+    hint_.store(hint, std::memory_order_relaxed);
+    return indexAlpha;
+  }
+
+ private:
+  mutable std::atomic<int> hint_{0};
+};
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -139,6 +189,49 @@ template <typename Data, class Alloc, class AccessFun>
 auto interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray,
                  AccessFun accessFun) -> remove_cvref_t<typename std::result_of<AccessFun(const std::vector<Data, Alloc>&, size_t)>::type>;
 
+/**
+ * In-place version of interpolate(indexAlpha, dataArray), which reuses the memory of the result.
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] dataArray: vector of data
+ * @param [out] result: The interpolation result
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc>
+void interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, Data& result);
+
+/**
+ * In-place version of interpolate(enquiryTime, timeArray, dataArray), which reuses the memory of the result.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: Times vector
+ * @param [in] dataArray: Data vector
+ * @param [out] result: The interpolation result
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc>
+void interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray, Data& result);
+
+/**
+ * Linearly interpolates at all enquiry times in a single pass over the time array, see timeSegments(). The memory of the results is
+ * reused.
+ *
+ * @param [in] enquiryTimes: The enquiry times for interpolation, expected to be sorted.
+ * @param [in] timeArray: Times vector
+ * @param [in] dataArray: Data vector
+ * @param [out] results: The interpolation result for each enquiry time.
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc>
+void interpolate(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray,
+                 std::vector<Data, Alloc>& results);
+
 }  // namespace LinearInterpolation
 }  // namespace ocs2
 
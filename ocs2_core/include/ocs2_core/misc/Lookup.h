@@ -91,6 +91,47 @@ int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time) {
   return static_cast<int>(firstLargerValueIterator - timeArray.begin());
 }
 
+/**
+ *  Same as findIndexInTimeArray, but the search starts at a hint index and expands exponentially from there.
+ *  For a hint close to the result, e.g. the result of the previous enquiry in a sequence of monotone enquiries, the cost is O(1).
+ *  The result does not depend on the hint, any hint outside [0, size(timeArray)] is clamped.
+ *
+ * @tparam SCALAR : numerical type of time
+ * @param timeArray : sorted time array to perform the lookup in
+ * @param time : enquiry time
+ * @param hint : index from which to start the search
+ * @return index between [0, size(timeArray)]
+ */
+template <typename SCALAR = double>
+int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time, int hint) {
+  const int size = static_cast<int>(timeArray.size());
+  hint = std::min(std::max(hint, 0), size);
+
+  int lower;  // first index that can be the result
+  int upper;  // last index that can be the result, timeArray[upper] >= time or upper = size
+  if (hint < size && timeArray[hint] < time) {
+    // Search forward
+    lower = hint + 1;
+    upper = lower;
+    for (int step = 1; upper < size && timeArray[upper] < time; step *= 2) {
+      lower = upper + 1;
+      upper = std::min(lower + step, size);
+    }
+  } else {
+    // Search backward
+    upper = hint;
+    lower = upper - 1;
+    for (int step = 1; lower >= 0 && !(timeArray[lower] < time); step *= 2) {
+      upper = lower;
+      lower = upper - step;
+    }
+    lower = std::max(lower + 1, 0);
+  }
+
+  auto firstLargerValueIterator = std::lower_bound(timeArray.begin() + lower, timeArray.begin() + upper, time);
+  return static_cast<int>(firstLargerValueIterator - timeArray.begin());
+}
+
 /**
  *  Find interval into a sorted time Array
  *
@@ -0,0 +1,148 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+
+/**
+ * Tracing of hierarchical timing zones. The instrumentation macros below compile to no-ops unless OCS2_ENABLE_TRACING is defined, which
+ * is set for all ocs2 packages by configuring with -DOCS2_ENABLE_TRACING=ON (see cmake/ocs2_cxx_flags.cmake).
+ *
+ * OCS2_TRACE_SCOPE("name")  : Traces the enclosing scope.
+ * OCS2_TRACE_BEGIN("name")  : Begins a zone, which has to be ended by OCS2_TRACE_END() on the same thread.
+ * OCS2_TRACE_END()          : Ends the innermost zone of the calling thread.
+ *
+ * The zone names must be string literals (or strings of static lifetime), since only their pointers are stored.
+ */
+#ifdef OCS2_ENABLE_TRACING
+#define OCS2_TRACE_CONCAT_IMPL(a, b) a##b
+#define OCS2_TRACE_CONCAT(a, b) OCS2_TRACE_CONCAT_IMPL(a, b)
+#define OCS2_TRACE_SCOPE(name) const ::ocs2::tracing::ScopedZone OCS2_TRACE_CONCAT(ocs2TraceZone, __LINE__)(name)
+#define OCS2_TRACE_BEGIN(name) ::ocs2::tracing::beginZone(name)
+#define OCS2_TRACE_END() ::ocs2::tracing::endZone()
+#else
+#define OCS2_TRACE_SCOPE(name) static_cast<void>(0)
+#define OCS2_TRACE_BEGIN(name) static_cast<void>(0)
+#define OCS2_TRACE_END() static_cast<void>(0)
+#endif
+
+namespace ocs2 {
+namespace tracing {
+
+/** A completed zone. */
+struct TraceEvent {
+  const char* name = nullptr;
+  const char* parent = nullptr;  // name of the enclosing zone, nullptr for top-level zones
+  int64_t startTimeInNanoseconds = 0;
+  int64_t durationInNanoseconds = 0;
+  uint32_t threadId = 0;  // sequential id of the recording thread, starting at 0
+  uint32_t depth = 0;     // nesting depth, 0 for top-level zones
+};
+
+/** Duration statistics of all events of a zone name within the same parent zone. */
+struct ZoneStatistics {
+  std::string name;
+  std::string parent;
+  size_t depth = 0;
+  size_t numCalls = 0;
+  scalar_t totalInMilliseconds = 0.0;
+  scalar_t averageInMilliseconds = 0.0;
+  scalar_t maxInMilliseconds = 0.0;
+  scalar_t p50InMilliseconds = 0.0;
+  scalar_t p90InMilliseconds = 0.0;
+  scalar_t p99InMilliseconds = 0.0;
+};
+
+/**
+ * Enables or disables the recording at runtime. Recording is enabled by default. Zones that are open while switching are not affected.
+ */
+void setEnabled(bool enabled);
+
+/** Returns true if recording is enabled at runtime. */
+bool isEnabled();
+
+/**
+ * Sets the number of events each thread can buffer between two calls to collectEvents(). Only affects threads which have not recorded
+ * any event yet. The capacity is rounded up to a power of two. Events are dropped if the buffer of a thread is full.
+ */
+void setThreadBufferCapacity(size_t capacity);
+
+/** Returns the number of events that were dropped because of full thread buffers. */
+size_t getNumDroppedEvents();
+
+/** Begins a zone on the calling thread. */
+void beginZone(const char* name);
+
+/** Ends the innermost zone of the calling thread and records it. Does nothing if no zone is open. */
+void endZone();
+
+/**
+ * Collects and removes all recorded events of all threads. The recording threads are never blocked: each thread writes to its own
+ * single-producer single-consumer ring buffer. The events of a thread are ordered by their end time.
+ */
+std::vector<TraceEvent> collectEvents();
+
+/**
+ * Computes the statistics of the given events, grouped by the zone name and the name of the parent zone. The statistics are sorted
+ * such that each zone is directly followed by its children.
+ */
+std::vector<ZoneStatistics> computeStatistics(const std::vector<TraceEvent>& events);
+
+/** Prints the statistics as an indented tree. */
+std::ostream& operator<<(std::ostream& stream, const std::vector<ZoneStatistics>& statistics);
+
+/** Writes the events in the Chrome trace event format (JSON object format), to be loaded in chrome://tracing or Perfetto. */
+void writeChromeTrace(std::ostream& stream, const std::vector<TraceEvent>& events);
+
+/** Writes the events in the Chrome trace event format to a file. */
+void writeChromeTrace(const std::string& fileName, const std::vector<TraceEvent>& events);
+
+/**
+ * Traces a zone from construction to destruction.
+ */
+class ScopedZone {
+ public:
+  explicit ScopedZone(const char* name) { beginZone(name); }
+  ~ScopedZone() { endZone(); }
+
+  ScopedZone(const ScopedZone&) = delete;
+  ScopedZone& operator=(const ScopedZone&) = delete;
+};
+
+}  // namespace tracing
+}  // namespace ocs2
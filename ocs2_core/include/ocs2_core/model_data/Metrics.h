@@ -185,6 +185,9 @@ size_array_t getSizes(const std::vector<LagrangianMetrics>& termsLagrangianMetri
  */
 vector_array_t toConstraintArray(const size_array_t& termsSize, const vector_t& vec);
 
+/** In-place variant of toConstraintArray, reusing the memory of the elements of constraintArray. */
+void toConstraintArray(const size_array_t& termsSize, const vector_t& vec, vector_array_t& constraintArray);
+
 /**
  * Deserializes the vector to an array of LagrangianMetrics structures based on size of constraint terms.
  *
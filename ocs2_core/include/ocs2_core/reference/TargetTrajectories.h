@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ostream>
 
 #include "ocs2_core/Types.h"
+#include "ocs2_core/misc/LinearInterpolation.h"
 
 namespace ocs2 {
 
@@ -55,6 +56,10 @@ struct TargetTrajectories {
   scalar_array_t timeTrajectory;
   vector_array_t stateTrajectory;
   vector_array_t inputTrajectory;
+
+ private:
+  // Lookup hint for the time trajectory, the cost and constraint terms query the nodes of the horizon in increasing time
+  LinearInterpolation::TimeSegmentCursor timeSegmentCursor_;
 };
 
 void swap(TargetTrajectories& lh, TargetTrajectories& rh);
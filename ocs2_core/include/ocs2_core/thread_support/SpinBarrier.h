@@ -0,0 +1,129 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+
+namespace ocs2 {
+
+/**
+ * A reusable, sense-reversing barrier for a fixed number of threads.
+ *
+ * Waiting threads poll a shared phase flag, which releases them within a few cycles once the last thread arrives. This is
+ * much cheaper than a mutex and condition variable when the work between two barriers is short. A thread which has polled
+ * for numSpins times parks on a condition variable instead (futex based on Linux), such that an oversubscribed machine
+ * does not burn the time slices of the thread it is waiting for.
+ *
+ * @note All numThreads threads must be running concurrently, otherwise the barrier never opens.
+ */
+class SpinBarrier {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] numThreads: Number of threads which synchronize on the barrier.
+   * @param [in] numSpins: Number of polls before a waiting thread parks. Pass std::numeric_limits<size_t>::max() to never park.
+   */
+  explicit SpinBarrier(size_t numThreads, size_t numSpins = std::numeric_limits<size_t>::max())
+      : numThreads_(numThreads), numSpins_(numSpins), numWaiting_(numThreads) {}
+
+  /** Blocks until all threads have arrived. */
+  void arriveAndWait() {
+    arriveAndWait([] {});
+  }
+
+  /**
+   * Blocks until all threads have arrived. The last arriving thread calls completion() before the others are released.
+   * Therefore, completion() runs exactly once per phase and its side effects are visible to all threads once they return.
+   *
+   * @param [in] completion: Callable with signature void().
+   */
+  template <typename Completion>
+  void arriveAndWait(Completion&& completion);
+
+ private:
+  /** Parks the calling thread until the phase flag differs from the given phase. */
+  void park(bool phase);
+
+  const size_t numThreads_;
+  const size_t numSpins_;
+
+  std::atomic<size_t> numWaiting_;
+  // Keep the flag which is polled by the waiting threads on a different cache line than the arrival counter.
+  char padding_[64];
+  std::atomic_bool phase_{false};
+
+  std::atomic<size_t> numParked_{0};
+  std::mutex parkLock_;
+  std::condition_variable parkCondition_;
+};
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Completion>
+void SpinBarrier::arriveAndWait(Completion&& completion) {
+  // The flag can not flip before this thread has arrived.
+  const bool phase = phase_.load(std::memory_order_relaxed);
+
+  if (numWaiting_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    completion();
+    numWaiting_.store(numThreads_, std::memory_order_relaxed);
+    phase_.store(!phase);  // sequentially consistent, pairs with the registration in park()
+    if (numParked_.load() > 0) {
+      std::lock_guard<std::mutex> lock(parkLock_);
+      parkCondition_.notify_all();
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < numSpins_; ++i) {
+    if (phase_.load(std::memory_order_acquire) != phase) {
+      return;
+    }
+  }
+  park(phase);
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+inline void SpinBarrier::park(bool phase) {
+  std::unique_lock<std::mutex> lock(parkLock_);
+  ++numParked_;
+  parkCondition_.wait(lock, [&] { return phase_.load() != phase; });
+  --numParked_;
+}
+
+}  // namespace ocs2
@@ -29,17 +29,30 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace ocs2 {
 
 /**
- * Thread pool class to execute tasks on multiple threads.
+ * Work-stealing thread pool class to execute tasks on multiple threads.
+ *
+ * Each worker owns a task deque. Tasks submitted from a worker go to its own deque, otherwise they are distributed
+ * round-robin. Idle workers steal from the other deques, spin for a short while and then park until new work arrives.
+ *
+ * Data-parallel loops should use parallelFor(), which claims chunks of the index range through a single atomic counter
+ * and does not allocate on the heap.
  */
 class ThreadPool {
  public:
@@ -74,12 +87,55 @@ class ThreadPool {
    *
    * @note This is a blocking operation, returns when all tasks are completed.
    * @warning Calling runParallel(task, nThreads) does not guarantee that each task will be executed with a different workerIndex.
+   * @warning The tasks are queued, they are not guaranteed to run at the same time. Use runConcurrently() if the tasks
+   * synchronize with each other, e.g. on a barrier.
    *
    * @param [in] taskFunction: task function to run in the pool.
    * @param [in] N: number of times to run taskFunction in parallel.
    */
   void runParallel(std::function<void(int)> taskFunction, int N);
 
+  /**
+   * Runs a task N times at the same time, such that the instances may block on each other (e.g. on a SpinBarrier).
+   * - 1 instance runs in the calling thread with ID = nThreads.
+   * - N-1 instances run on distinct pool workers with ID in [0, nThreads-1].
+   *
+   * None of the instances is started unless N-1 idle workers have been gathered within the timeout. This is never the case
+   * if N-1 exceeds the number of threads or if the calling thread is a worker of this pool.
+   *
+   * @note This is a blocking operation, returns when all instances are completed. The first exception thrown by
+   * taskFunction is rethrown in the calling thread.
+   *
+   * @param [in] taskFunction: task function to run concurrently.
+   * @param [in] N: number of concurrent instances.
+   * @param [in] timeout: Maximum time to wait for the pool workers.
+   * @return true if the task has been run N times, false if it has not been run at all.
+   */
+  bool tryRunConcurrently(std::function<void(int)> taskFunction, int N,
+                          std::chrono::microseconds timeout = std::chrono::milliseconds(100));
+
+  /**
+   * Same as tryRunConcurrently() but throws a std::runtime_error if the N instances can not run at the same time.
+   */
+  void runConcurrently(std::function<void(int)> taskFunction, int N, std::chrono::microseconds timeout = std::chrono::milliseconds(100));
+
+  /**
+   * Calls function(workerIndex, i) for every i in [begin, end). The range is split into chunks of "grain" indices which are
+   * claimed dynamically by the calling thread (ID = nThreads, or its own ID if it is a pool worker) and the pool workers
+   * (ID in [0, nThreads-1]).
+   *
+   * @note This is a blocking operation, returns when all indices are processed. The first exception thrown by function
+   * is rethrown in the calling thread. A nested call from within a parallelFor of the same pool, or a call while the pool
+   * is busy with another parallelFor, is processed by the calling thread only.
+   *
+   * @param [in] begin: First index.
+   * @param [in] end: One past the last index.
+   * @param [in] grain: Number of consecutive indices processed per claim.
+   * @param [in] function: Callable with signature void(int workerIndex, int i).
+   */
+  template <typename Functor>
+  void parallelFor(int begin, int end, int grain, Functor&& function);
+
   /** Get the number of threads. */
   size_t numThreads() const { return workerThreads_.size(); }
 
@@ -89,6 +145,12 @@ class ThreadPool {
   template <typename Functor>
   struct Task;
 
+  struct WorkerQueue;
+
+  struct ParallelForJob;
+
+  struct ConcurrentJob;
+
   /**
    * Thread worker loop
    *
@@ -103,11 +165,36 @@ class ThreadPool {
    */
   void runTask(std::unique_ptr<TaskBase> taskPtr);
 
-  bool stop_{false};  //!< flag telling all threads to stop, protected by taskQueueLock_
+  /** Executes a parallelFor job with the help of the workers. Rethrows the first exception of the job. */
+  void runJob(ParallelForJob& job);
+
+  /** Helps with the active parallelFor job. Returns true if any index has been processed. */
+  bool tryRunJob(int workerIndex);
+
+  /** Pops a task from the own deque or steals one from another worker. Returns true if a task has been executed. */
+  bool tryRunTask(int workerIndex);
+
+  /**
+   * Wakes up parked workers.
+   *
+   * @param [in] all: Whether to wake up all workers or only one of them.
+   */
+  void notifyWorkers(bool all);
+
+  std::atomic_bool stop_{false};  //!< flag telling all threads to stop
+
+  std::vector<std::unique_ptr<WorkerQueue>> workerQueues_;
+  std::atomic_int numPendingTasks_{0};
+  std::atomic<size_t> nextQueueIndex_{0};
+
+  std::atomic<ParallelForJob*> activeJob_{nullptr};
+  std::atomic_int numJobHelpers_{0};
 
-  std::queue<std::unique_ptr<TaskBase>> taskQueue_;  // protected by taskQueueLock_
-  std::condition_variable taskQueueCondition_;
-  std::mutex taskQueueLock_;
+  // Parking of idle workers
+  std::atomic<size_t> workEpoch_{0};
+  std::atomic_int numParkedWorkers_{0};
+  std::condition_variable parkCondition_;
+  std::mutex parkLock_;
 
   std::vector<std::thread> workerThreads_;
 };
@@ -136,6 +223,28 @@ struct ThreadPool::Task final : public ThreadPool::TaskBase {
   std::packaged_task<ReturnType(int)> packagedTask;
 };
 
+/**
+ * A chunked index range shared by all threads participating in a parallelFor. It lives on the stack of the calling thread.
+ */
+struct ThreadPool::ParallelForJob {
+  using Invoker = void (*)(void* function, int workerIndex, int i);
+
+  ParallelForJob(int beginArg, int endArg, int grainArg, void* functionArg, Invoker invokerArg)
+      : next(beginArg), end(endArg), grain(grainArg), function(functionArg), invoker(invokerArg) {}
+
+  /** Processes chunks until the range is exhausted. Returns true if any chunk has been claimed. */
+  bool execute(int workerIndex);
+
+  std::atomic_int next;
+  const int end;
+  const int grain;
+  void* const function;
+  const Invoker invoker;
+
+  std::atomic_bool failed{false};
+  std::exception_ptr exceptionPtr;  // written once by the thread that sets failed
+};
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
@@ -154,4 +263,21 @@ std::future<typename std::result_of<Functor(int)>::type> ThreadPool::run(Functor
   return future;
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Functor>
+void ThreadPool::parallelFor(int begin, int end, int grain, Functor&& function) {
+  if (begin >= end) {
+    return;
+  }
+
+  using FunctionType = typename std::remove_reference<Functor>::type;
+  auto invoker = [](void* functionPtr, int workerIndex, int i) { (*static_cast<FunctionType*>(functionPtr))(workerIndex, i); };
+  void* functionPtr = const_cast<void*>(static_cast<const void*>(std::addressof(function)));
+
+  ParallelForJob job(begin, end, std::max(grain, 1), functionPtr, invoker);
+  runJob(job);
+}
+
 }  // namespace ocs2
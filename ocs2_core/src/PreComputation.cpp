@@ -0,0 +1,113 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/PreComputation.h>
+
+namespace ocs2 {
+
+namespace {
+/** Bitmask of the computation items in the request set, i.e. without the Request::Approximation modifier */
+int getItems(RequestSet request) {
+  int items = 0;
+  for (const auto item : {Request::Dynamics, Request::Cost, Request::Constraint, Request::SoftConstraint}) {
+    if (request.contains(item)) {
+      items |= static_cast<int>(item);
+    }
+  }
+  return items;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PreComputation::cachedRequest(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
+  if (!updateCache(CachedNode::Intermediate, request, t, x, &u)) {
+    requestImpl(request, t, x, u);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PreComputation::cachedRequestPreJump(RequestSet request, scalar_t t, const vector_t& x) {
+  if (!updateCache(CachedNode::PreJump, request, t, x, nullptr)) {
+    requestPreJumpImpl(request, t, x);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PreComputation::cachedRequestFinal(RequestSet request, scalar_t t, const vector_t& x) {
+  if (!updateCache(CachedNode::Final, request, t, x, nullptr)) {
+    requestFinalImpl(request, t, x);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PreComputation::updateCache(CachedNode node, RequestSet request, scalar_t t, const vector_t& x, const vector_t* uPtr) {
+  cacheStatistics_.numRequests++;
+
+  const int items = getItems(request);
+  const bool approximation = request.contains(Request::Approximation);
+
+  const bool sameNode = cache_.node == node && cache_.time == t && cache_.state.size() == x.size() && cache_.state == x &&
+                        (uPtr == nullptr || (cache_.input.size() == uPtr->size() && cache_.input == *uPtr));
+
+  if (sameNode) {
+    const int available = approximation ? cache_.approximations : (cache_.values | cache_.approximations);
+    if ((items & available) == items) {
+      cacheStatistics_.numReused++;
+      return true;
+    }
+  } else {
+    // New node, nothing is available
+    cache_.node = node;
+    cache_.time = t;
+    cache_.state = x;
+    if (uPtr != nullptr) {
+      cache_.input = *uPtr;
+    }
+    cache_.values = 0;
+    cache_.approximations = 0;
+  }
+
+  // The computations of earlier requests at the same node stay valid, as they are functions of the node only
+  if (approximation) {
+    cache_.approximations |= items;
+  } else {
+    cache_.values |= items;
+  }
+  return false;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,148 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/automatic_differentiation/CppAdBuildQueue.h>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+namespace {
+
+CppAdBuildQueue*& activeQueue() {
+  thread_local CppAdBuildQueue* queuePtr = nullptr;
+  return queuePtr;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdBuildQueue::CppAdBuildQueue(size_t numThreads) : numThreads_(std::max<size_t>(numThreads, 1)), previousActiveQueue_(activeQueue()) {
+  activeQueue() = this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdBuildQueue::~CppAdBuildQueue() {
+  if (!jobs_.empty() || !pendingModels_.empty()) {
+    try {
+      flush();
+    } catch (const std::exception& e) {
+      // A destructor must not throw. The affected interfaces throw when they are evaluated.
+      std::cerr << "[CppAdBuildQueue] Failed to build the queued models: " << e.what() << std::endl;
+    }
+  }
+
+  activeQueue() = previousActiveQueue_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdBuildQueue* CppAdBuildQueue::getActiveQueue() {
+  return activeQueue();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdBuildQueue::flush() {
+  auto jobs = std::move(jobs_);
+  jobs_.clear();
+  queuedLibraries_.clear();
+
+  std::exception_ptr exceptionPtr;
+  if (!jobs.empty()) {
+    try {
+      // The calling thread participates in the compilation
+      ThreadPool threadPool(std::min(numThreads_, jobs.size()) - 1);
+      threadPool.parallelFor(0, jobs.size(), 1, [&](int, int i) { jobs[i](); });
+    } catch (...) {
+      exceptionPtr = std::current_exception();
+    }
+  }
+
+  std::vector<CppAdInterface*> pendingModels;
+  {
+    std::lock_guard<std::mutex> lock(pendingModelsMutex_);
+    pendingModels.swap(pendingModels_);
+  }
+  for (auto* interfacePtr : pendingModels) {
+    interfacePtr->buildQueuePtr_ = nullptr;
+  }
+
+  // If a library failed to build, the pending interfaces are left without a model and throw when they are evaluated
+  if (exceptionPtr) {
+    std::rethrow_exception(exceptionPtr);
+  }
+  for (auto* interfacePtr : pendingModels) {
+    interfacePtr->loadModels(false);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdBuildQueue::push(const std::string& libraryName, const std::string& modelKey, std::function<void()> job) {
+  const auto result = queuedLibraries_.emplace(libraryName, modelKey);
+  if (!result.second) {
+    if (result.first->second != modelKey) {
+      throw std::runtime_error("[CppAdBuildQueue] Two different models are queued for the same library: " + libraryName);
+    }
+    return;  // already queued
+  }
+  jobs_.push_back(std::move(job));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdBuildQueue::addPendingModel(CppAdInterface* interfacePtr) {
+  std::lock_guard<std::mutex> lock(pendingModelsMutex_);
+  pendingModels_.push_back(interfacePtr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdBuildQueue::removePendingModel(CppAdInterface* interfacePtr) {
+  std::lock_guard<std::mutex> lock(pendingModelsMutex_);
+  pendingModels_.erase(std::remove(pendingModels_.begin(), pendingModels_.end(), interfacePtr), pendingModels_.end());
+}
+
+}  // namespace ocs2
@@ -29,10 +29,110 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/automatic_differentiation/CppAdBuildQueue.h>
+#include <ocs2_core/misc/Tracing.h>
+
 namespace ocs2 {
 
+namespace {
+
+/**
+ * Evaluation memory of the generated models. It is shared by all CppAdInterface instances that are evaluated on the same thread and only
+ * grows, such that repeated evaluations do not allocate.
+ */
+struct CppAdScratchMemory {
+  std::vector<scalar_t> input;
+  std::vector<scalar_t> sparseValues;
+  std::vector<scalar_t> rangeValues;
+  vector_t weights;
+};
+
+CppAdScratchMemory& getThreadLocalScratch() {
+  thread_local CppAdScratchMemory scratch;
+  return scratch;
+}
+
+/** Exposes the source generation of a library processor, such that the sources can be generated before the compilation. */
+class CppAdLibraryProcessor : public CppAD::cg::DynamicModelLibraryProcessor<scalar_t> {
+ public:
+  using CppAD::cg::DynamicModelLibraryProcessor<scalar_t>::DynamicModelLibraryProcessor;
+
+  const std::map<std::string, std::string>& generateSources(CppAD::cg::ModelCSourceGen<scalar_t>& sourceGen) {
+    this->getLibrarySources();
+    return this->getSources(sourceGen);
+  }
+};
+
+/** The objects that generate and compile a model library. They are kept alive until a queued compilation has finished. */
+struct CppAdLibraryBuild {
+  CppAdLibraryBuild(std::unique_ptr<CppAdInterface::ad_fun_t> funPtrArg, const std::string& modelName, const std::string& libraryName)
+      : funPtr(std::move(funPtrArg)),
+        sourceGen(*funPtr, modelName),
+        libraryCSourceGen(sourceGen),
+        libraryProcessor(libraryCSourceGen, libraryName) {}
+
+  std::unique_ptr<CppAdInterface::ad_fun_t> funPtr;
+  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen;
+  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen;
+  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
+  CppAdLibraryProcessor libraryProcessor;
+};
+
+/** 64 bit FNV-1a hash */
+void hashCombine(uint64_t& hash, const std::string& data) {
+  for (const char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  // separator, such that the concatenation of fields is unambiguous
+  hash ^= 0xff;
+  hash *= 1099511628211ULL;
+}
+
+/** 64 bit FNV-1a hash of the bit pattern of a scalar */
+void hashCombine(uint64_t& hash, scalar_t data) {
+  char bytes[sizeof(scalar_t)];
+  std::memcpy(bytes, &data, sizeof(scalar_t));
+  hashCombine(hash, std::string(bytes, sizeof(scalar_t)));
+}
+
+/** The version of the compiler, queried once per compiler path. */
+std::string getCompilerVersion(const std::string& compilerPath) {
+  static std::mutex mutex;
+  static std::map<std::string, std::string> versions;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = versions.find(compilerPath);
+  if (it == versions.end()) {
+    std::string version;
+    try {
+      CppAD::cg::system::callExecutable(compilerPath, {"-dumpfullversion", "-dumpversion"}, &version);
+    } catch (...) {
+      version.clear();
+    }
+    it = versions.emplace(compilerPath, version).first;
+  }
+  return it->second;
+}
+
+std::string getModelKeyFileName(const std::string& libraryName) {
+  return libraryName + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION + ".key";
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -60,7 +160,12 @@ CppAdInterface::CppAdInterface(ad_function_t adFunction, size_t variableDim, std
 /******************************************************************************************************/
 CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
     : CppAdInterface(rhs.adFunction_, rhs.variableDim_, rhs.parameterDim_, rhs.modelName_, rhs.folderName_, rhs.compileFlags_) {
-  if (isLibraryAvailable()) {
+  if (rhs.buildQueuePtr_ != nullptr) {
+    rangeDim_ = rhs.rangeDim_;
+    pendingJacobianSparsity_ = rhs.pendingJacobianSparsity_;
+    buildQueuePtr_ = rhs.buildQueuePtr_;
+    buildQueuePtr_->addPendingModel(this);
+  } else if (isLibraryAvailable()) {
     loadModels(false);
   }
 }
@@ -68,55 +173,19 @@ CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
-  createFolderStructure();
-
-  // set and declare independent variables and start tape recording
-  ad_vector_t xp(variableDim_ + parameterDim_);
-  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
-  CppAD::Independent(xp);
-
-  // Split in variables and parameters
-  ad_vector_t x = xp.segment(0, variableDim_);
-  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
-  // dependent variable vector
-  ad_vector_t y;
-  // the model equation
-  adFunction_(x, p, y);
-  rangeDim_ = y.rows();
-  // create f: xp -> y and stop tape recording
-  ad_fun_t fun(xp, y);
-  // Optimize the operation sequence
-  fun.optimize();
-
-  // generates source code
-  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
-  setApproximationOrder(approximationOrder, sourceGen, fun);
-
-  // Compiler objects, compile to temporary shared library file to avoid interference between processes
-  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
-  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
-  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryName_ + tmpName_);
-  setCompilerOptions(gccCompiler);
-
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Compiling Shared Library: "
-              << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+CppAdInterface::~CppAdInterface() {
+  if (buildQueuePtr_ != nullptr) {
+    buildQueuePtr_->removePendingModel(this);
   }
+}
 
-  // Compile and store the library
-  dynamicLib_ = libraryProcessor.createDynamicLibrary(gccCompiler);
-  model_ = dynamicLib_->model(modelName_);
-
-  setSparsityNonzeros();
-
-  // Rename generated library after loading
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Renaming " << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << " to "
-              << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
-  }
-  boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
-                            libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
+  auto funPtr = recordTape();
+  const auto modelKey = getModelKey(*funPtr, approximationOrder);
+  buildModels(std::move(funPtr), approximationOrder, modelKey, verbose);
 }
 
 /******************************************************************************************************/
@@ -138,76 +207,129 @@ void CppAdInterface::loadModels(bool verbose) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
+  auto funPtr = recordTape();
+  const auto modelKey = getModelKey(*funPtr, approximationOrder);
+
   if (isLibraryAvailable()) {
-    loadModels(verbose);
-  } else {
-    createModels(approximationOrder, verbose);
+    if (readLibraryModelKey() == modelKey) {
+      loadModels(verbose);
+      return;
+    } else if (verbose) {
+      std::cerr << "[CppAdInterface] The library " << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
+                << " is outdated and will be recompiled." << std::endl;
+    }
   }
+
+  buildModels(std::move(funPtr), approximationOrder, modelKey, verbose);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p) const {
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
+  vector_t functionValue;
+  getFunctionValue(x, p, functionValue);
+  return functionValue;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const {
+  matrix_t jacobian;
+  getJacobian(x, p, jacobian);
+  return jacobian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
+  ScalarFunctionQuadraticApproximation gnApprox;
+  getGaussNewtonApproximation(x, p, gnApprox);
+  return gnApprox;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const vector_t& p) const {
+  matrix_t hessian;
+  getHessian(outputIndex, x, p, hessian);
+  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
+  matrix_t hessian;
+  getHessian(w, x, p, hessian);
+  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p, vector_t& functionValue) const {
+  OCS2_TRACE_SCOPE("CppAdInterface::getFunctionValue");
+  const auto xpArrayView = getInputArrayView(x, p);
 
-  vector_t functionValue(model_->Range());
+  functionValue.resize(rangeDim_);
+  CppAD::cg::ArrayView<scalar_t> functionValueArrayView(functionValue.data(), functionValue.size());
 
-  model_->ForwardZero(xp, functionValue);
+  getModel().ForwardZero(xpArrayView, functionValueArrayView);
   assert(functionValue.allFinite());
-  return functionValue;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
+void CppAdInterface::getJacobian(const vector_t& x, const vector_t& p, matrix_t& jacobian) const {
+  OCS2_TRACE_SCOPE("CppAdInterface::getJacobian");
+  const auto xpArrayView = getInputArrayView(x, p);
 
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
+  auto& sparseJacobian = getThreadLocalScratch().sparseValues;
+  sparseJacobian.resize(nnzJacobian_);
   CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
   size_t const* rows;
   size_t const* cols;
   // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+  getModel().SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
 
   // Write sparse elements into Eigen type. Only jacobian w.r.t. variables was requested, so cols should not contain elements corresponding
   // to parameters.
-  matrix_t jacobian = matrix_t::Zero(model_->Range(), variableDim_);
+  jacobian.setZero(rangeDim_, variableDim_);
   for (size_t i = 0; i < nnzJacobian_; i++) {
     jacobian(rows[i], cols[i]) = sparseJacobian[i];
   }
 
   assert(jacobian.allFinite());
-  return jacobian;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
-
-  ScalarFunctionQuadraticApproximation gnApprox;
+void CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p,
+                                                 ScalarFunctionQuadraticApproximation& gnApprox) const {
+  OCS2_TRACE_SCOPE("CppAdInterface::getGaussNewtonApproximation");
+  const auto xpArrayView = getInputArrayView(x, p);
+  auto& scratch = getThreadLocalScratch();
 
   // Zero order
-  vector_t valueVector(model_->Range());
-  model_->ForwardZero(xp, valueVector);
+  scratch.rangeValues.resize(rangeDim_);
+  Eigen::Map<vector_t> valueVector(scratch.rangeValues.data(), rangeDim_);
+  CppAD::cg::ArrayView<scalar_t> valueArrayView(scratch.rangeValues);
+  getModel().ForwardZero(xpArrayView, valueArrayView);
   gnApprox.f = 0.5 * valueVector.squaredNorm();
 
   // Jacobian
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
+  auto& sparseJacobian = scratch.sparseValues;
+  sparseJacobian.resize(nnzJacobian_);
   CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
   size_t const* rows;
   size_t const* cols;
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+  getModel().SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
 
   // Sparse evaluation of J' * f
   gnApprox.dfdx.setZero(variableDim_);
@@ -230,7 +352,7 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
     gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
     // Process off-diagonals
     size_t j = i + 1;
-    while (rows[j] == row_i) {
+    while (j < nnzJacobian_ && rows[j] == row_i) {
       const size_t col_j = cols[j];
       gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
       gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
@@ -240,29 +362,29 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
 
   assert(gnApprox.dfdx.allFinite());
   assert(gnApprox.dfdxx.allFinite());
-  return gnApprox;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const vector_t& p) const {
-  vector_t w = vector_t::Zero(rangeDim_);
+void CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const vector_t& p, matrix_t& hessian) const {
+  OCS2_TRACE_SCOPE("CppAdInterface::getHessian");
+  auto& w = getThreadLocalScratch().weights;
+  w.setZero(rangeDim_);
   w[outputIndex] = 1.0;
 
-  return getHessian(w, x, p);
+  getHessian(w, x, p, hessian);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
+void CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p, matrix_t& hessian) const {
+  OCS2_TRACE_SCOPE("CppAdInterface::getHessian");
+  const auto xpArrayView = getInputArrayView(x, p);
 
-  std::vector<scalar_t> sparseHessian(nnzHessian_);
+  auto& sparseHessian = getThreadLocalScratch().sparseValues;
+  sparseHessian.resize(nnzHessian_);
   CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseHessian);
   size_t const* rows;
   size_t const* cols;
@@ -270,10 +392,10 @@ matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const
   CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
 
   // Call this particular SparseHessian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+  getModel().SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
 
   // Fills upper triangular sparsity of hessian w.r.t variables.
-  matrix_t hessian = matrix_t::Zero(variableDim_, variableDim_);
+  hessian.setZero(variableDim_, variableDim_);
   for (size_t i = 0; i < nnzHessian_; i++) {
     hessian(rows[i], cols[i]) = sparseHessian[i];
   }
@@ -282,7 +404,171 @@ matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const
   hessian.template triangularView<Eigen::StrictlyLower>() = hessian.template triangularView<Eigen::StrictlyUpper>().transpose();
 
   assert(hessian.allFinite());
-  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+cppad_sparsity::SparsityPattern CppAdInterface::getJacobianSparsityPattern() const {
+  if (buildQueuePtr_ != nullptr && !pendingJacobianSparsity_.empty()) {
+    return pendingJacobianSparsity_;
+  } else if (buildQueuePtr_ != nullptr || !getModel().isJacobianSparsityAvailable()) {
+    throw std::runtime_error("[CppAdInterface] Jacobian sparsity is not available for model: " + modelName_);
+  }
+  return model_->JacobianSparsitySet();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAD::cg::GenericModel<scalar_t>& CppAdInterface::getModel() const {
+  if (model_ == nullptr) {
+    if (buildQueuePtr_ != nullptr) {
+      throw std::runtime_error("[CppAdInterface] The model " + modelName_ + " is queued for compilation. Flush the CppAdBuildQueue first.");
+    } else {
+      throw std::runtime_error("[CppAdInterface] No model is loaded for " + modelName_ + ". Create or load the models first.");
+    }
+  }
+  return *model_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAD::cg::ArrayView<const scalar_t> CppAdInterface::getInputArrayView(const vector_t& x, const vector_t& p) const {
+  assert(static_cast<size_t>(x.size()) == variableDim_);
+  assert(static_cast<size_t>(p.size()) == parameterDim_);
+  auto& xp = getThreadLocalScratch().input;
+  xp.resize(variableDim_ + parameterDim_);
+  std::copy(x.data(), x.data() + variableDim_, xp.begin());
+  std::copy(p.data(), p.data() + parameterDim_, xp.begin() + variableDim_);
+  return CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<CppAdInterface::ad_fun_t> CppAdInterface::recordTape() {
+  // set and declare independent variables and start tape recording
+  ad_vector_t xp(variableDim_ + parameterDim_);
+  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
+  CppAD::Independent(xp);
+
+  // Split in variables and parameters
+  ad_vector_t x = xp.segment(0, variableDim_);
+  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
+  // dependent variable vector
+  ad_vector_t y;
+  // the model equation
+  adFunction_(x, p, y);
+  rangeDim_ = y.rows();
+  // create f: xp -> y and stop tape recording
+  std::unique_ptr<ad_fun_t> funPtr(new ad_fun_t(xp, y));
+  // Optimize the operation sequence
+  funPtr->optimize();
+  return funPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::getModelKey(ad_fun_t& fun, ApproximationOrder approximationOrder) const {
+  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
+
+  uint64_t hash = 14695981039346656037ULL;
+  hashCombine(hash, modelName_);
+  hashCombine(hash, std::to_string(variableDim_) + " " + std::to_string(parameterDim_) + " " + std::to_string(rangeDim_));
+  hashCombine(hash, std::to_string(static_cast<int>(approximationOrder)));
+  for (const auto& flag : compileFlags_) {
+    hashCombine(hash, flag);
+  }
+  hashCombine(hash, gccCompiler.getCompilerPath());
+  hashCombine(hash, getCompilerVersion(gccCompiler.getCompilerPath()));
+
+  // The size of the optimized operation sequence and the function value at a fixed input identify the tape. Both are cheap to
+  // compute, such that a warm start does not generate the sources of the model.
+  hashCombine(hash, std::to_string(fun.size_op()) + " " + std::to_string(fun.size_op_arg()) + " " + std::to_string(fun.size_var()) + " " +
+                        std::to_string(fun.size_par()) + " " + std::to_string(fun.size_text()) + " " + std::to_string(fun.size_VecAD()));
+  std::vector<ad_base_t> probeInput(variableDim_ + parameterDim_);
+  for (size_t i = 0; i < probeInput.size(); i++) {
+    probeInput[i] = ad_base_t(0.5 + 0.1 * static_cast<scalar_t>(i % 13) - 0.01 * static_cast<scalar_t>(i % 7));
+  }
+  const auto probeOutput = fun.Forward(0, probeInput);
+  fun.capacity_order(0);
+  for (const auto& y : probeOutput) {
+    hashCombine(hash, y.isValueDefined() ? y.getValue() : std::numeric_limits<scalar_t>::quiet_NaN());
+  }
+
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::readLibraryModelKey() const {
+  std::ifstream keyFile(getModelKeyFileName(libraryName_));
+  std::string modelKey;
+  if (keyFile.is_open()) {
+    keyFile >> modelKey;
+  }
+  return modelKey;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::buildModels(std::unique_ptr<ad_fun_t> funPtr, ApproximationOrder approximationOrder, const std::string& modelKey,
+                                 bool verbose) {
+  createFolderStructure();
+
+  // generates source code, compile to temporary shared library file to avoid interference between processes
+  auto build = std::make_shared<CppAdLibraryBuild>(std::move(funPtr), modelName_, libraryName_ + tmpName_);
+  setApproximationOrder(approximationOrder, build->sourceGen, *build->funPtr);
+  setCompilerOptions(build->gccCompiler);
+  build->libraryProcessor.generateSources(build->sourceGen);
+
+  // Compiles the library and stores it together with its key. Only captures by value, such that the job can outlive this object.
+  const std::string libraryName = libraryName_;
+  const std::string tmpName = tmpName_;
+  auto compileLibrary = [build, libraryName, tmpName, modelKey, verbose]() {
+    const std::string extension = CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+    if (verbose) {
+      std::cerr << "[CppAdInterface] Compiling Shared Library: " << libraryName + tmpName + extension << std::endl;
+    }
+
+    auto dynamicLib = build->libraryProcessor.createDynamicLibrary(build->gccCompiler);
+
+    // Rename generated library after loading
+    if (verbose) {
+      std::cerr << "[CppAdInterface] Renaming " << libraryName + tmpName + extension << " to " << libraryName + extension << std::endl;
+    }
+    boost::filesystem::rename(libraryName + tmpName + extension, libraryName + extension);
+    {
+      std::ofstream keyFile(getModelKeyFileName(libraryName + tmpName));
+      keyFile << modelKey << std::endl;
+    }
+    boost::filesystem::rename(getModelKeyFileName(libraryName + tmpName), getModelKeyFileName(libraryName));
+
+    return dynamicLib;
+  };
+
+  auto* buildQueuePtr = CppAdBuildQueue::getActiveQueue();
+  if (buildQueuePtr != nullptr) {
+    if (approximationOrder != ApproximationOrder::Zero) {
+      pendingJacobianSparsity_ = createJacobianSparsity(*build->funPtr);
+    }
+    buildQueuePtr->push(libraryName_, modelKey, [compileLibrary]() { compileLibrary(); });
+    if (buildQueuePtr_ == nullptr) {
+      buildQueuePtr_ = buildQueuePtr;
+      buildQueuePtr_->addPendingModel(this);
+    }
+  } else {
+    dynamicLib_ = compileLibrary();
+    model_ = dynamicLib_->model(modelName_);
+    setSparsityNonzeros();
+  }
 }
 
 /******************************************************************************************************/
@@ -319,8 +605,10 @@ void CppAdInterface::createFolderStructure() const {
 /******************************************************************************************************/
 std::string CppAdInterface::getUniqueTemporaryName() const {
   // Random string should be unique for each process and time of calling.
+  // The counter makes the name unique within the process, since several models can be compiled concurrently by a build queue.
+  static std::atomic<size_t> instanceCounter{0};
   int randomFromClock = std::chrono::high_resolution_clock::now().time_since_epoch().count() % 1000;
-  return std::string("cppadcg_tmp") + std::to_string(randomFromClock) + std::to_string(getpid());
+  return std::string("cppadcg_tmp") + std::to_string(randomFromClock) + std::to_string(getpid()) + "_" + std::to_string(instanceCounter++);
 }
 
 /******************************************************************************************************/
@@ -72,4 +72,16 @@ VectorFunctionLinearApproximation LinearStateConstraint::getLinearApproximation(
   return g;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearStateConstraint::writeLinearApproximation(scalar_t t, const vector_t& x, const PreComputation&, size_t row,
+                                                     VectorFunctionLinearApproximation& approximation) const {
+  const size_t nc = h_.rows();
+  auto f = approximation.f.segment(row, nc);
+  f = h_;
+  f.noalias() += F_ * x;
+  approximation.dfdx.middleRows(row, nc) = F_;
+}
+
 }  // namespace ocs2
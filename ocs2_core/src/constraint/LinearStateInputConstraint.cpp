@@ -75,4 +75,18 @@ VectorFunctionLinearApproximation LinearStateInputConstraint::getLinearApproxima
   return g;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearStateInputConstraint::writeLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&,
+                                                          size_t row, VectorFunctionLinearApproximation& approximation) const {
+  const size_t nc = e_.rows();
+  auto f = approximation.f.segment(row, nc);
+  f = e_;
+  f.noalias() += C_ * x;
+  f.noalias() += D_ * u;
+  approximation.dfdx.middleRows(row, nc) = C_;
+  approximation.dfdu.middleRows(row, nc) = D_;
+}
+
 }  // namespace ocs2
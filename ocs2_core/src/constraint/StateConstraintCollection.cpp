@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/constraint/StateConstraintCollection.h>
 
+#include <numeric>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -60,13 +62,21 @@ size_t StateConstraintCollection::getNumConstraints(scalar_t time) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 size_array_t StateConstraintCollection::getTermsSize(scalar_t time) const {
-  size_array_t termsSize(this->terms_.size(), 0);
+  size_array_t termsSize;
+  getTermsSize(time, termsSize);
+  return termsSize;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateConstraintCollection::getTermsSize(scalar_t time, size_array_t& termsSize) const {
+  termsSize.assign(this->terms_.size(), 0);
   for (size_t i = 0; i < this->terms_.size(); ++i) {
     if (this->terms_[i]->isActive(time)) {
       termsSize[i] = this->terms_[i]->getNumConstraints(time);
     }
   }
-  return termsSize;
 }
 
 /******************************************************************************************************/
@@ -87,17 +97,18 @@ vector_array_t StateConstraintCollection::getValue(scalar_t time, const vector_t
 /******************************************************************************************************/
 VectorFunctionLinearApproximation StateConstraintCollection::getLinearApproximation(scalar_t time, const vector_t& state,
                                                                                     const PreComputation& preComp) const {
-  VectorFunctionLinearApproximation linearApproximation(getNumConstraints(time), state.rows());
+  // activity of each term is evaluated only once
+  const auto termsSize = getTermsSize(time);
+  const auto numConstraints = std::accumulate(termsSize.cbegin(), termsSize.cend(), size_t(0));
 
-  // append linearApproximation of each constraintTerm
-  size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      i += nc;
+  VectorFunctionLinearApproximation linearApproximation(numConstraints, state.rows());
+
+  // write linearApproximation of each constraintTerm in place
+  size_t row = 0;
+  for (size_t i = 0; i < this->terms_.size(); ++i) {
+    if (termsSize[i] > 0) {
+      this->terms_[i]->writeLinearApproximation(time, state, preComp, row, linearApproximation);
+      row += termsSize[i];
     }
   }
 
@@ -109,7 +120,9 @@ VectorFunctionLinearApproximation StateConstraintCollection::getLinearApproximat
 /******************************************************************************************************/
 VectorFunctionQuadraticApproximation StateConstraintCollection::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                           const PreComputation& preComp) const {
-  const auto numConstraints = getNumConstraints(time);
+  // activity of each term is evaluated only once
+  const auto termsSize = getTermsSize(time);
+  const auto numConstraints = std::accumulate(termsSize.cbegin(), termsSize.cend(), size_t(0));
 
   VectorFunctionQuadraticApproximation quadraticApproximation;
   quadraticApproximation.f.resize(numConstraints);
@@ -117,15 +130,15 @@ VectorFunctionQuadraticApproximation StateConstraintCollection::getQuadraticAppr
   quadraticApproximation.dfdxx.reserve(numConstraints);  // Use reserve instead of resize to avoid unnecessary allocations.
 
   // append quadraticApproximation of each constraintTerm
-  size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      quadraticApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+  size_t row = 0;
+  for (size_t i = 0; i < this->terms_.size(); ++i) {
+    if (termsSize[i] > 0) {
+      auto constraintTermApproximation = this->terms_[i]->getQuadraticApproximation(time, state, preComp);
+      const size_t nc = termsSize[i];
+      quadraticApproximation.f.segment(row, nc) = constraintTermApproximation.f;
+      quadraticApproximation.dfdx.middleRows(row, nc) = constraintTermApproximation.dfdx;
       appendVectorToVectorByMoving(quadraticApproximation.dfdxx, std::move(constraintTermApproximation.dfdxx));
-      i += nc;
+      row += nc;
     }
   }
 
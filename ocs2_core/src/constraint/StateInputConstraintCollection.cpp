@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/constraint/StateInputConstraintCollection.h>
 
+#include <numeric>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -61,13 +63,21 @@ size_t StateInputConstraintCollection::getNumConstraints(scalar_t time) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 size_array_t StateInputConstraintCollection::getTermsSize(scalar_t time) const {
-  size_array_t termsSize(this->terms_.size(), 0);
+  size_array_t termsSize;
+  getTermsSize(time, termsSize);
+  return termsSize;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCollection::getTermsSize(scalar_t time, size_array_t& termsSize) const {
+  termsSize.assign(this->terms_.size(), 0);
   for (size_t i = 0; i < this->terms_.size(); ++i) {
     if (this->terms_[i]->isActive(time)) {
       termsSize[i] = this->terms_[i]->getNumConstraints(time);
     }
   }
-  return termsSize;
 }
 
 /******************************************************************************************************/
@@ -90,31 +100,47 @@ vector_array_t StateInputConstraintCollection::getValue(scalar_t time, const vec
 VectorFunctionLinearApproximation StateInputConstraintCollection::getLinearApproximation(scalar_t time, const vector_t& state,
                                                                                          const vector_t& input,
                                                                                          const PreComputation& preComp) const {
-  VectorFunctionLinearApproximation linearApproximation(getNumConstraints(time), state.rows(), input.rows());
+  // activity of each term is evaluated only once
+  const auto termsSize = getTermsSize(time);
+  const auto numConstraints = std::accumulate(termsSize.cbegin(), termsSize.cend(), size_t(0));
 
-  // append linearApproximation of each constraintTerm
-  size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, input, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      linearApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
-      i += nc;
+  VectorFunctionLinearApproximation linearApproximation(numConstraints, state.rows(), input.rows());
+
+  // write linearApproximation of each constraintTerm in place
+  size_t row = 0;
+  for (size_t i = 0; i < this->terms_.size(); ++i) {
+    if (termsSize[i] > 0) {
+      this->terms_[i]->writeLinearApproximation(time, state, input, preComp, row, linearApproximation);
+      row += termsSize[i];
     }
   }
 
   return linearApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LinearApproximationSparsity StateInputConstraintCollection::getLinearApproximationSparsity(scalar_t time, size_t stateDim,
+                                                                                           size_t inputDim) const {
+  LinearApproximationSparsity sparsity;
+  for (const auto& constraintTerm : this->terms_) {
+    if (constraintTerm->isActive(time)) {
+      sparsity = block_sparsity::getUnion(sparsity, constraintTerm->getLinearApproximationSparsity(time, stateDim, inputDim));
+    }
+  }
+  return sparsity;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 VectorFunctionQuadraticApproximation StateInputConstraintCollection::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                                const vector_t& input,
                                                                                                const PreComputation& preComp) const {
-  const auto numConstraints = getNumConstraints(time);
+  // activity of each term is evaluated only once
+  const auto termsSize = getTermsSize(time);
+  const auto numConstraints = std::accumulate(termsSize.cbegin(), termsSize.cend(), size_t(0));
 
   VectorFunctionQuadraticApproximation quadraticApproximation;
   quadraticApproximation.f.resize(numConstraints);
@@ -125,18 +151,18 @@ VectorFunctionQuadraticApproximation StateInputConstraintCollection::getQuadrati
   quadraticApproximation.dfduu.reserve(numConstraints);
 
   // append quadraticApproximation of each constraintTerm
-  size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, input, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      quadraticApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      quadraticApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
+  size_t row = 0;
+  for (size_t i = 0; i < this->terms_.size(); ++i) {
+    if (termsSize[i] > 0) {
+      auto constraintTermApproximation = this->terms_[i]->getQuadraticApproximation(time, state, input, preComp);
+      const size_t nc = termsSize[i];
+      quadraticApproximation.f.segment(row, nc) = constraintTermApproximation.f;
+      quadraticApproximation.dfdx.middleRows(row, nc) = constraintTermApproximation.dfdx;
+      quadraticApproximation.dfdu.middleRows(row, nc) = constraintTermApproximation.dfdu;
       appendVectorToVectorByMoving(quadraticApproximation.dfdxx, std::move(constraintTermApproximation.dfdxx));
       appendVectorToVectorByMoving(quadraticApproximation.dfdux, std::move(constraintTermApproximation.dfdux));
       appendVectorToVectorByMoving(quadraticApproximation.dfduu, std::move(constraintTermApproximation.dfduu));
-      i += nc;
+      row += nc;
     }
   }
 
@@ -57,22 +57,30 @@ void StateInputConstraintCppAd::initialize(size_t stateDim, size_t inputDim, siz
   } else {
     adInterfacePtr_->loadModelsIfAvailable(orderCppAd, verbose);
   }
+
+  // Union of the non-zero columns over all rows. Column 0 of the taped function is the time.
+  std::set<size_t> nonZeroColumns;
+  for (const auto& rowSparsity : adInterfacePtr_->getJacobianSparsityPattern()) {
+    nonZeroColumns.insert(rowSparsity.begin(), rowSparsity.end());
+  }
+  sparsity_.stateColumns = block_sparsity::fromColumnIndices(nonZeroColumns, 1, stateDim);
+  sparsity_.inputColumns = block_sparsity::fromColumnIndices(nonZeroColumns, 1 + stateDim, inputDim);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputConstraintCppAd::StateInputConstraintCppAd(const StateInputConstraintCppAd& rhs)
-    : StateInputConstraint(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
+    : StateInputConstraint(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)), sparsity_(rhs.sparsity_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t StateInputConstraintCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
                                              const PreComputation& preComputation) const {
-  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
-  tapedTimeStateInput << time, state, input;
-  return adInterfacePtr_->getFunctionValue(tapedTimeStateInput, getParameters(time, preComputation));
+  tapedTimeStateInput_.resize(1 + state.rows() + input.rows());
+  tapedTimeStateInput_ << time, state, input;
+  return adInterfacePtr_->getFunctionValue(tapedTimeStateInput_, getParameters(time, preComputation));
 }
 
 /******************************************************************************************************/
@@ -86,13 +94,13 @@ VectorFunctionLinearApproximation StateInputConstraintCppAd::getLinearApproximat
   const size_t stateDim = state.rows();
   const size_t inputDim = input.rows();
   const vector_t params = getParameters(time, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
-  tapedTimeStateInput << time, state, input;
+  tapedTimeStateInput_.resize(1 + stateDim + inputDim);
+  tapedTimeStateInput_ << time, state, input;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  constraint.dfdx = J.middleCols(1, stateDim);
-  constraint.dfdu = J.rightCols(inputDim);
+  adInterfacePtr_->getFunctionValue(tapedTimeStateInput_, params, constraint.f);
+  adInterfacePtr_->getJacobian(tapedTimeStateInput_, params, jacobian_);
+  constraint.dfdx = jacobian_.middleCols(1, stateDim);
+  constraint.dfdu = jacobian_.rightCols(inputDim);
 
   return constraint;
 }
@@ -112,26 +120,36 @@ VectorFunctionQuadraticApproximation StateInputConstraintCppAd::getQuadraticAppr
   const size_t stateDim = state.rows();
   const size_t inputDim = input.rows();
   const vector_t params = getParameters(time, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
-  tapedTimeStateInput << time, state, input;
+  tapedTimeStateInput_.resize(1 + stateDim + inputDim);
+  tapedTimeStateInput_ << time, state, input;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  constraint.dfdx = J.middleCols(1, stateDim);
-  constraint.dfdu = J.rightCols(inputDim);
+  adInterfacePtr_->getFunctionValue(tapedTimeStateInput_, params, constraint.f);
+  adInterfacePtr_->getJacobian(tapedTimeStateInput_, params, jacobian_);
+  constraint.dfdx = jacobian_.middleCols(1, stateDim);
+  constraint.dfdu = jacobian_.rightCols(inputDim);
 
   const size_t numConstraints = constraint.f.rows();
   constraint.dfdxx.resize(numConstraints);
   constraint.dfdux.resize(numConstraints);
   constraint.dfduu.resize(numConstraints);
   for (int i = 0; i < numConstraints; i++) {
-    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeStateInput, params);
-    constraint.dfdxx[i] = H.block(1, 1, stateDim, stateDim);
-    constraint.dfdux[i] = H.block(1 + stateDim, 1, inputDim, stateDim);
-    constraint.dfduu[i] = H.bottomRightCorner(inputDim, inputDim);
+    adInterfacePtr_->getHessian(i, tapedTimeStateInput_, params, hessian_);
+    constraint.dfdxx[i] = hessian_.block(1, 1, stateDim, stateDim);
+    constraint.dfdux[i] = hessian_.block(1 + stateDim, 1, inputDim, stateDim);
+    constraint.dfduu[i] = hessian_.bottomRightCorner(inputDim, inputDim);
   }
 
   return constraint;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LinearApproximationSparsity StateInputConstraintCppAd::getLinearApproximationSparsity(scalar_t time, size_t stateDim,
+                                                                                      size_t inputDim) const {
+  assert(block_sparsity::getNumColumns(sparsity_.stateColumns) <= stateDim);
+  assert(block_sparsity::getNumColumns(sparsity_.inputColumns) <= inputDim);
+  return sparsity_;
+}
+
 }  // namespace ocs2
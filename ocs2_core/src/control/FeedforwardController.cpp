@@ -87,7 +87,7 @@ void FeedforwardController::setController(const scalar_array_t& controllerTime,
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t FeedforwardController::computeInput(scalar_t t, const vector_t& x) {
-  return LinearInterpolation::interpolate(t, timeStamp_, uffArray_);
+  return LinearInterpolation::interpolate(timeSegmentCursor_.timeSegment(t, timeStamp_), uffArray_);
 }
 
 /******************************************************************************************************/
@@ -119,7 +119,7 @@ void FeedforwardController::flattenSingle(scalar_t time, std::vector<float>& fla
    * ]
    */
 
-  const vector_t uff = LinearInterpolation::interpolate(time, timeStamp_, uffArray_);
+  const vector_t uff = LinearInterpolation::interpolate(timeSegmentCursor_.timeSegment(time, timeStamp_), uffArray_);
 
   flatArray = std::vector<float>(uff.data(), uff.data() + uff.rows());
 }
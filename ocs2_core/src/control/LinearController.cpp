@@ -77,7 +77,7 @@ void LinearController::setController(const scalar_array_t& controllerTime, const
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t LinearController::computeInput(scalar_t t, const vector_t& x) {
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, timeStamp_);
+  const auto indexAlpha = timeSegmentCursor_.timeSegment(t, timeStamp_);
 
   vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
   const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
@@ -128,7 +128,7 @@ void LinearController::flattenSingle(scalar_t time, std::vector<float>& flatArra
    * ]
    */
 
-  const auto indexAlpha = LinearInterpolation::timeSegment(time, timeStamp_);
+  const auto indexAlpha = timeSegmentCursor_.timeSegment(time, timeStamp_);
   const vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
   const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
 
@@ -241,14 +241,14 @@ void LinearController::display() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LinearController::getFeedbackGain(scalar_t time, matrix_t& gain) const {
-  gain = LinearInterpolation::interpolate(time, timeStamp_, gainArray_);
+  gain = LinearInterpolation::interpolate(timeSegmentCursor_.timeSegment(time, timeStamp_), gainArray_);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LinearController::getBias(scalar_t time, vector_t& bias) const {
-  bias = LinearInterpolation::interpolate(time, timeStamp_, biasArray_);
+  bias = LinearInterpolation::interpolate(timeSegmentCursor_.timeSegment(time, timeStamp_), biasArray_);
 }
 
 /******************************************************************************************************/
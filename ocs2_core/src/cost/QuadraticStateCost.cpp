@@ -67,6 +67,19 @@ ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximati
   return Phi;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateCost::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                          const PreComputation&, ScalarFunctionQuadraticApproximation& cost) const {
+  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+  const vector_t QDeviation = Q_ * xDeviation;
+
+  cost.f += 0.5 * xDeviation.dot(QDeviation);
+  cost.dfdx += QDeviation;
+  cost.dfdxx += Q_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
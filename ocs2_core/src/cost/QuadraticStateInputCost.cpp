@@ -96,6 +96,32 @@ ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApprox
   return L;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateInputCost::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                               const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                                               ScalarFunctionQuadraticApproximation& cost) const {
+  vector_t stateDeviation, inputDeviation;
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+
+  const vector_t QDeviation = Q_ * stateDeviation;
+  const vector_t RDeviation = R_ * inputDeviation;
+  cost.f += 0.5 * stateDeviation.dot(QDeviation) + 0.5 * inputDeviation.dot(RDeviation);
+  cost.dfdx += QDeviation;
+  cost.dfdu += RDeviation;
+  cost.dfdxx += Q_;
+  cost.dfduu += R_;
+
+  if (P_.size() > 0) {
+    const vector_t pDeviation = P_ * stateDeviation;
+    cost.f += inputDeviation.dot(pDeviation);
+    cost.dfdu += pDeviation;
+    cost.dfdx.noalias() += P_.transpose() * inputDeviation;
+    cost.dfdux += P_;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
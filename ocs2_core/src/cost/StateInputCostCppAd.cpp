@@ -64,9 +64,10 @@ StateInputCostCppAd::StateInputCostCppAd(const StateInputCostCppAd& rhs)
 /******************************************************************************************************/
 scalar_t StateInputCostCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
                                        const TargetTrajectories& targetTrajectories, const PreComputation& preComputation) const {
-  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
-  tapedTimeStateInput << time, state, input;
-  return adInterfacePtr_->getFunctionValue(tapedTimeStateInput, getParameters(time, targetTrajectories, preComputation))(0);
+  tapedTimeStateInput_.resize(1 + state.rows() + input.rows());
+  tapedTimeStateInput_ << time, state, input;
+  adInterfacePtr_->getFunctionValue(tapedTimeStateInput_, getParameters(time, targetTrajectories, preComputation), functionValue_);
+  return functionValue_(0);
 }
 
 /******************************************************************************************************/
@@ -81,19 +82,20 @@ ScalarFunctionQuadraticApproximation StateInputCostCppAd::getQuadraticApproximat
   const size_t stateDim = state.rows();
   const size_t inputDim = input.rows();
   const vector_t params = getParameters(time, targetTrajectories, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
-  tapedTimeStateInput << time, state, input;
+  tapedTimeStateInput_.resize(1 + stateDim + inputDim);
+  tapedTimeStateInput_ << time, state, input;
 
-  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params)(0);
+  adInterfacePtr_->getFunctionValue(tapedTimeStateInput_, params, functionValue_);
+  cost.f = functionValue_(0);
 
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  cost.dfdx = J.middleCols(1, stateDim).transpose();
-  cost.dfdu = J.rightCols(inputDim).transpose();
+  adInterfacePtr_->getJacobian(tapedTimeStateInput_, params, jacobian_);
+  cost.dfdx = jacobian_.middleCols(1, stateDim).transpose();
+  cost.dfdu = jacobian_.rightCols(inputDim).transpose();
 
-  const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeStateInput, params);
-  cost.dfdxx = H.block(1, 1, stateDim, stateDim);
-  cost.dfdux = H.block(1 + stateDim, 1, inputDim, stateDim);
-  cost.dfduu = H.bottomRightCorner(inputDim, inputDim);
+  adInterfacePtr_->getHessian(0, tapedTimeStateInput_, params, hessian_);
+  cost.dfdxx = hessian_.block(1, 1, stateDim, stateDim);
+  cost.dfdux = hessian_.block(1 + stateDim, 1, inputDim, stateDim);
+  cost.dfduu = hessian_.bottomRightCorner(inputDim, inputDim);
 
   return cost;
 }
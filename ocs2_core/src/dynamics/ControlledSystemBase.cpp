@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/dynamics/ControlledSystemBase.h>
 
+#include <stdexcept>
+#include <typeinfo>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -58,18 +61,16 @@ vector_t ControlledSystemBase::computeFlowMap(scalar_t t, const vector_t& x) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t ControlledSystemBase::computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u) {
-  assert(preCompPtr_ != nullptr);
-  preCompPtr_->request(Request::Dynamics, t, x, u);
-  return computeFlowMap(t, x, u, *preCompPtr_);
+  const auto& preComp = requestDynamics(Request::Dynamics, t, x, u);
+  return computeFlowMap(t, x, u, preComp);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t ControlledSystemBase::computeJumpMap(scalar_t t, const vector_t& x) {
-  assert(preCompPtr_ != nullptr);
-  preCompPtr_->requestPreJump(Request::Dynamics, t, x);
-  return computeJumpMap(t, x, *preCompPtr_);
+  const auto& preComp = requestDynamicsPreJump(Request::Dynamics, t, x);
+  return computeJumpMap(t, x, preComp);
 }
 
 /******************************************************************************************************/
@@ -80,4 +81,46 @@ vector_t ControlledSystemBase::computeJumpMap(scalar_t t, const vector_t& x, con
   return OdeBase::computeJumpMap(t, x);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ControlledSystemBase::setSharedPreComputation(PreComputation* preCompPtr) {
+  if (preCompPtr != nullptr) {
+    const auto& internalPreComp = *preCompPtr_;
+    if (typeid(internalPreComp) != typeid(PreComputation) && typeid(internalPreComp) != typeid(*preCompPtr)) {
+      throw std::invalid_argument(std::string("[ControlledSystemBase] The shared pre-computation of type ") + typeid(*preCompPtr).name() +
+                                  " is not compatible with the pre-computation of the dynamics of type " + typeid(internalPreComp).name());
+    }
+  }
+  sharedPreCompPtr_ = preCompPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PreComputation& ControlledSystemBase::requestDynamics(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
+  if (sharedPreCompPtr_ != nullptr) {
+    sharedPreCompPtr_->cachedRequest(request, t, x, u);
+    return *sharedPreCompPtr_;
+  } else {
+    assert(preCompPtr_ != nullptr);
+    preCompPtr_->request(request, t, x, u);
+    return *preCompPtr_;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PreComputation& ControlledSystemBase::requestDynamicsPreJump(RequestSet request, scalar_t t, const vector_t& x) {
+  if (sharedPreCompPtr_ != nullptr) {
+    sharedPreCompPtr_->cachedRequestPreJump(request, t, x);
+    return *sharedPreCompPtr_;
+  } else {
+    assert(preCompPtr_ != nullptr);
+    preCompPtr_->requestPreJump(request, t, x);
+    return *preCompPtr_;
+  }
+}
+
 }  // namespace ocs2
@@ -45,18 +45,16 @@ SystemDynamicsBase::SystemDynamicsBase(const SystemDynamicsBase& other) : Contro
 /******************************************************************************************************/
 /******************************************************************************************************/
 VectorFunctionLinearApproximation SystemDynamicsBase::linearApproximation(scalar_t t, const vector_t& x, const vector_t& u) {
-  assert(preCompPtr_ != nullptr);
-  preCompPtr_->request(Request::Dynamics + Request::Approximation, t, x, u);
-  return linearApproximation(t, x, u, *preCompPtr_);
+  const auto& preComp = requestDynamics(Request::Dynamics + Request::Approximation, t, x, u);
+  return linearApproximation(t, x, u, preComp);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 VectorFunctionLinearApproximation SystemDynamicsBase::jumpMapLinearApproximation(scalar_t t, const vector_t& x) {
-  assert(preCompPtr_ != nullptr);
-  preCompPtr_->requestPreJump(Request::Dynamics + Request::Approximation, t, x);
-  return jumpMapLinearApproximation(t, x, *preCompPtr_);
+  const auto& preComp = requestDynamicsPreJump(Request::Dynamics + Request::Approximation, t, x);
+  return jumpMapLinearApproximation(t, x, preComp);
 }
 
 /******************************************************************************************************/
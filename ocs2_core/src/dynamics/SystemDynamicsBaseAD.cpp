@@ -127,12 +127,12 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::linearApproximation(scal
                                                                             const PreComputation& preComputation) {
   tapedTimeStateInput_ << t, x, u;
   const vector_t parameters = getFlowMapParameters(t, preComputation);
-  flowJacobian_ = flowMapADInterfacePtr_->getJacobian(tapedTimeStateInput_, parameters);
+  flowMapADInterfacePtr_->getJacobian(tapedTimeStateInput_, parameters, flowJacobian_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = flowJacobian_.middleCols(1, x.rows());
   approximation.dfdu = flowJacobian_.rightCols(u.rows());
-  approximation.f = flowMapADInterfacePtr_->getFunctionValue(tapedTimeStateInput_, parameters);
+  flowMapADInterfacePtr_->getFunctionValue(tapedTimeStateInput_, parameters, approximation.f);
   return approximation;
 }
 
@@ -143,12 +143,12 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::jumpMapLinearApproximati
                                                                                    const PreComputation& preComputation) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getJumpMapParameters(t, preComputation);
-  jumpJacobian_ = jumpMapADInterfacePtr_->getJacobian(tapedTimeState_, parameters);
+  jumpMapADInterfacePtr_->getJacobian(tapedTimeState_, parameters, jumpJacobian_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = jumpJacobian_.rightCols(x.rows());
   approximation.dfdu.setZero(jumpJacobian_.rows(), 0);
-  approximation.f = jumpMapADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters);
+  jumpMapADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters, approximation.f);
   return approximation;
 }
 
@@ -158,12 +158,12 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::jumpMapLinearApproximati
 VectorFunctionLinearApproximation SystemDynamicsBaseAD::guardSurfacesLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getGuardSurfacesParameters(t);
-  guardJacobian_ = guardSurfacesADInterfacePtr_->getJacobian(tapedTimeState_, parameters);
+  guardSurfacesADInterfacePtr_->getJacobian(tapedTimeState_, parameters, guardJacobian_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = guardJacobian_.rightCols(x.rows());
   approximation.dfdu = matrix_t::Zero(guardJacobian_.rows(), u.rows());  // not provided
-  approximation.f = guardSurfacesADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters);
+  guardSurfacesADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters, approximation.f);
   return approximation;
 }
 
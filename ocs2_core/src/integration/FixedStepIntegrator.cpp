@@ -0,0 +1,221 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include <ocs2_core/integration/FixedStepIntegrator.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Helper less comparison for both positive and negative dt case. */
+bool lessWithSign(scalar_t t1, scalar_t t2, scalar_t dt) {
+  if (dt > 0) {
+    return t2 - t1 > std::numeric_limits<scalar_t>::epsilon();
+  } else {
+    return t1 - t2 > std::numeric_limits<scalar_t>::epsilon();
+  }
+}
+
+/** Helper less or equal comparison for both positive and negative dt case. */
+bool lessEqWithSign(scalar_t t1, scalar_t t2, scalar_t dt) {
+  if (dt > 0) {
+    return t1 - t2 <= std::numeric_limits<scalar_t>::epsilon();
+  } else {
+    return t2 - t1 <= std::numeric_limits<scalar_t>::epsilon();
+  }
+}
+
+/** Helper to get the min absolute value, t1 and t2 have same sign. */
+scalar_t minAbs(scalar_t t1, scalar_t t2) {
+  if (t1 > 0) {
+    return std::min(t1, t2);
+  } else {
+    return std::max(t1, t2);
+  }
+}
+
+/**
+ * Takes steps of dt as long as the next step ends before finalTime. The state is observed before every step and at the end.
+ * @return the number of steps taken.
+ */
+template <typename Step, typename Observe>
+size_t integrateConstSteps(Step& step, Observe& observe, const vector_t& x, scalar_t startTime, scalar_t finalTime, scalar_t dt) {
+  scalar_t time = startTime;
+  size_t numSteps = 0;
+  while (lessEqWithSign(time + dt, finalTime, dt)) {
+    observe(x, time);
+    step(time, dt);
+    ++numSteps;
+    // direct computation of the time avoids error propagation of time += dt
+    time = startTime + static_cast<scalar_t>(numSteps) * dt;
+  }
+  observe(x, time);
+  return numSteps;
+}
+
+/** Same as integrateConstSteps, but makes a final shorter step to end exactly at finalTime. */
+template <typename Step, typename Observe>
+void integrateAdaptiveSteps(Step& step, Observe& observe, const vector_t& x, scalar_t startTime, scalar_t finalTime, scalar_t dt) {
+  const size_t numSteps = integrateConstSteps(step, observe, x, startTime, finalTime, dt);
+  const scalar_t time = startTime + dt * numSteps;
+  if (lessWithSign(time, finalTime, dt)) {
+    step(time, finalTime - time);
+    observe(x, finalTime);
+  }
+}
+
+/** Takes steps of at most dt such that every time stamp is hit. The state is observed at every time stamp. */
+template <typename Step, typename Observe>
+void integrateTimesSteps(Step& step, Observe& observe, const vector_t& x, scalar_array_t::const_iterator beginTimeItr,
+                         scalar_array_t::const_iterator endTimeItr, scalar_t dt) {
+  scalar_t currentDt = dt;
+  while (true) {
+    scalar_t currentTime = *beginTimeItr++;
+    observe(x, currentTime);
+    if (beginTimeItr == endTimeItr) {
+      break;
+    }
+    while (lessWithSign(currentTime, *beginTimeItr, currentDt)) {
+      currentDt = minAbs(dt, *beginTimeItr - currentTime);
+      step(currentTime, currentDt);
+      currentTime += currentDt;
+    }
+  }
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename FlowMap>
+void FixedStepIntegrator::doStep(FlowMap& flowMap, scalar_t t, scalar_t dt) {
+  switch (scheme_) {
+    case Scheme::Euler: {
+      flowMap(t, x_, k1_);
+      x_ += dt * k1_;
+      break;
+    }
+    case Scheme::RK4: {
+      const scalar_t dtHalf = 0.5 * dt;
+      const scalar_t tHalf = t + dtHalf;
+      flowMap(t, x_, k1_);
+      xStage_ = x_ + dtHalf * k1_;
+      flowMap(tHalf, xStage_, k2_);
+      xStage_ = x_ + dtHalf * k2_;
+      flowMap(tHalf, xStage_, k3_);
+      xStage_ = x_ + dt * k3_;
+      flowMap(t + dt, xStage_, k4_);
+      x_ += (dt / 6.0) * (k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_);
+      break;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::integrateConst(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime,
+                                         scalar_t finalTime, scalar_t dt, int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
+  auto flowMap = [&](scalar_t t, const vector_t& x, vector_t& dxdt) { computeFlowMap(system, t, x, dxdt, maxNumSteps); };
+  auto step = [&](scalar_t t, scalar_t dt) { doStep(flowMap, t, dt); };
+  auto observe = [&](const vector_t& x, scalar_t t) { IntegratorBase::observe(system, observer, x, t); };
+  x_ = initialState;
+  // Ensure that finalTime is included by adding a fraction of dt such that: N * dt <= finalTime < (N + 1) * dt.
+  integrateConstSteps(step, observe, x_, startTime, finalTime + 0.1 * dt, dt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::integrateAdaptive(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime,
+                                            scalar_t finalTime, scalar_t dtInitial /*= 0.01*/, scalar_t AbsTol /*= 1e-6*/,
+                                            scalar_t RelTol /*= 1e-3*/, int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
+  auto flowMap = [&](scalar_t t, const vector_t& x, vector_t& dxdt) { computeFlowMap(system, t, x, dxdt, maxNumSteps); };
+  auto step = [&](scalar_t t, scalar_t dt) { doStep(flowMap, t, dt); };
+  auto observe = [&](const vector_t& x, scalar_t t) { IntegratorBase::observe(system, observer, x, t); };
+  x_ = initialState;
+  integrateAdaptiveSteps(step, observe, x_, startTime, finalTime, dtInitial);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::integrateTimes(OdeBase& system, Observer& observer, const vector_t& initialState,
+                                         typename scalar_array_t::const_iterator beginTimeItr,
+                                         typename scalar_array_t::const_iterator endTimeItr, scalar_t dtInitial /*= 0.01*/,
+                                         scalar_t AbsTol /*= 1e-6*/, scalar_t RelTol /*= 1e-3*/,
+                                         int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
+  auto flowMap = [&](scalar_t t, const vector_t& x, vector_t& dxdt) { computeFlowMap(system, t, x, dxdt, maxNumSteps); };
+  auto step = [&](scalar_t t, scalar_t dt) { doStep(flowMap, t, dt); };
+  auto observe = [&](const vector_t& x, scalar_t t) { IntegratorBase::observe(system, observer, x, t); };
+  x_ = initialState;
+  integrateTimesSteps(step, observe, x_, beginTimeItr, endTimeItr, dtInitial);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                            scalar_t startTime, scalar_t finalTime, scalar_t dt) {
+  auto flowMap = [&](scalar_t t, const vector_t& x, vector_t& dxdt) { system(x, dxdt, t); };
+  auto step = [&](scalar_t t, scalar_t dt) { doStep(flowMap, t, dt); };
+  x_ = initialState;
+  integrateConstSteps(step, observer, x_, startTime, finalTime + 0.1 * dt, dt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::runIntegrateAdaptive(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                               scalar_t startTime, scalar_t finalTime, scalar_t dtInitial, scalar_t absTol,
+                                               scalar_t relTol) {
+  auto flowMap = [&](scalar_t t, const vector_t& x, vector_t& dxdt) { system(x, dxdt, t); };
+  auto step = [&](scalar_t t, scalar_t dt) { doStep(flowMap, t, dt); };
+  x_ = initialState;
+  integrateAdaptiveSteps(step, observer, x_, startTime, finalTime, dtInitial);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::runIntegrateTimes(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                            typename scalar_array_t::const_iterator beginTimeItr,
+                                            typename scalar_array_t::const_iterator endTimeItr, scalar_t dtInitial, scalar_t absTol,
+                                            scalar_t relTol) {
+  auto flowMap = [&](scalar_t t, const vector_t& x, vector_t& dxdt) { system(x, dxdt, t); };
+  auto step = [&](scalar_t t, scalar_t dt) { doStep(flowMap, t, dt); };
+  x_ = initialState;
+  integrateTimesSteps(step, observer, x_, beginTimeItr, endTimeItr, dtInitial);
+}
+
+}  // namespace ocs2
@@ -45,16 +45,29 @@ IntegratorBase::IntegratorBase(std::shared_ptr<SystemEventHandler> eventHandlerP
 /******************************************************************************************************/
 /******************************************************************************************************/
 IntegratorBase::system_func_t IntegratorBase::systemFunction(OdeBase& system, int maxNumSteps) const {
-  return [&system, maxNumSteps](const vector_t& x, vector_t& dxdt, scalar_t t) {
-    dxdt = system.computeFlowMap(t, x);
-    // max number of function calls
-    if (system.incrementNumFunctionCalls() > maxNumSteps) {
-      std::stringstream msg;
-      msg << "Integration terminated since the maximum number of function calls is reached. State at termination time " << t << ":\n["
-          << x.transpose() << "]\n";
-      throw std::runtime_error(msg.str());
-    }
-  };
+  return [&system, maxNumSteps](const vector_t& x, vector_t& dxdt, scalar_t t) { computeFlowMap(system, t, x, dxdt, maxNumSteps); };
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IntegratorBase::computeFlowMap(OdeBase& system, scalar_t t, const vector_t& x, vector_t& dxdt, int maxNumSteps) {
+  dxdt = system.computeFlowMap(t, x);
+  // max number of function calls
+  if (system.incrementNumFunctionCalls() > maxNumSteps) {
+    std::stringstream msg;
+    msg << "Integration terminated since the maximum number of function calls is reached. State at termination time " << t << ":\n["
+        << x.transpose() << "]\n";
+    throw std::runtime_error(msg.str());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IntegratorBase::observe(OdeBase& system, Observer& observer, const vector_t& x, scalar_t t) const {
+  observer.observe(x, t);
+  eventHandlerPtr_->handleEvent(system, t, x);
 }
 
 /******************************************************************************************************/
@@ -62,10 +75,7 @@ IntegratorBase::system_func_t IntegratorBase::systemFunction(OdeBase& system, in
 /******************************************************************************************************/
 void IntegratorBase::integrateConst(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime,
                                     scalar_t finalTime, scalar_t dt, int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
-  observer_func_t callback = [&](const vector_t& x, scalar_t t) {
-    observer.observe(x, t);
-    eventHandlerPtr_->handleEvent(system, t, x);
-  };
+  observer_func_t callback = [&](const vector_t& x, scalar_t t) { observe(system, observer, x, t); };
   runIntegrateConst(systemFunction(system, maxNumSteps), callback, initialState, startTime, finalTime, dt);
 }
 
@@ -75,10 +85,7 @@ void IntegratorBase::integrateConst(OdeBase& system, Observer& observer, const v
 void IntegratorBase::integrateAdaptive(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime,
                                        scalar_t finalTime, scalar_t dtInitial /*= 0.01*/, scalar_t AbsTol /*= 1e-6*/,
                                        scalar_t RelTol /*= 1e-3*/, int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
-  observer_func_t callback = [&](const vector_t& x, scalar_t t) {
-    observer.observe(x, t);
-    eventHandlerPtr_->handleEvent(system, t, x);
-  };
+  observer_func_t callback = [&](const vector_t& x, scalar_t t) { observe(system, observer, x, t); };
   runIntegrateAdaptive(systemFunction(system, maxNumSteps), callback, initialState, startTime, finalTime, dtInitial, AbsTol, RelTol);
 }
 
@@ -90,10 +97,7 @@ void IntegratorBase::integrateTimes(OdeBase& system, Observer& observer, const v
                                     typename scalar_array_t::const_iterator endTimeItr, scalar_t dtInitial /*= 0.01*/,
                                     scalar_t AbsTol /*= 1e-6*/, scalar_t RelTol /*= 1e-3*/,
                                     int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
-  observer_func_t callback = [&](const vector_t& x, scalar_t t) {
-    observer.observe(x, t);
-    eventHandlerPtr_->handleEvent(system, t, x);
-  };
+  observer_func_t callback = [&](const vector_t& x, scalar_t t) { observe(system, observer, x, t); };
   runIntegrateTimes(systemFunction(system, maxNumSteps), callback, initialState, beginTimeItr, endTimeItr, dtInitial, AbsTol, RelTol);
 }
 
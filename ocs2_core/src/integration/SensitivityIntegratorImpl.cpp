@@ -31,6 +31,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+/**
+ * Memory of the intermediate stage states and of the products of the sensitivities. The discretizations are called concurrently by the
+ * workers of a solver, the memory is therefore kept per thread. It is sized by the first call, such that repeated discretizations of the
+ * same system only allocate in the system evaluations. The evaluated system must not discretize on the same thread.
+ */
+struct StageMemory {
+  vector_t state;
+  matrix_t product;
+};
+
+StageMemory& getThreadLocalStageMemory() {
+  thread_local StageMemory memory;
+  return memory;
+}
+
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -62,15 +81,17 @@ VectorFunctionLinearApproximation eulerSensitivityDiscretization(SystemDynamicsB
 /******************************************************************************************************/
 vector_t rk2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
   const scalar_t dt_halve = dt / 2.0;
+  auto& tmp = getThreadLocalStageMemory().state;
 
   // System evaluations
   const vector_t k1 = system.computeFlowMap(t, x, u);
 
-  vector_t tmp = x + dt * k1;
-  const vector_t k2 = system.computeFlowMap(t + dt, tmp, u);
+  tmp = x + dt * k1;
+  vector_t k2 = system.computeFlowMap(t + dt, tmp, u);
 
-  tmp = x + dt_halve * k1 + dt_halve * k2;
-  return tmp;
+  // Re-use k2 to collect the result
+  k2 = x + dt_halve * k1 + dt_halve * k2;
+  return k2;
 }
 
 /******************************************************************************************************/
@@ -79,10 +100,12 @@ vector_t rk2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt) {
   const scalar_t dt_halve = dt / 2.0;
+  auto& memory = getThreadLocalStageMemory();
 
   // System evaluations
   VectorFunctionLinearApproximation k1 = system.linearApproximation(t, x, u);
-  VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt, x + dt * k1.f, u);
+  memory.state = x + dt * k1.f;
+  VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt, memory.state, u);
 
   // Input sensitivity \dot{Su} = dfdx(t) Su + dfdu(t), with Su(0) = Zero()
   // Re-use memory from k.dfdu as dkduk
@@ -92,7 +115,8 @@ VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBas
   // State sensitivity \dot{Sx} = dfdx(t) Sx, with Sx(0) = Identity()
   // Re-use memory from k.dfdx as dkdxk
   // dk1dxk = k1.dfdx;
-  k2.dfdx += dt * k2.dfdx * k1.dfdx;  // need one temporary to avoid alias
+  memory.product.noalias() = dt * k2.dfdx * k1.dfdx;  // need one temporary to avoid alias
+  k2.dfdx += memory.product;
 
   // Assemble discrete approximation
   // Re-use k1 to collect the result
@@ -110,18 +134,20 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
   const scalar_t dt_halve = dt / 2.0;
   const scalar_t dt_sixth = dt / 6.0;
   const scalar_t dt_third = dt / 3.0;
+  auto& tmp = getThreadLocalStageMemory().state;
 
   // System evaluations
   const vector_t k1 = system.computeFlowMap(t, x, u);
-  vector_t tmp = x + dt_halve * k1;
+  tmp = x + dt_halve * k1;
   const vector_t k2 = system.computeFlowMap(t + dt_halve, tmp, u);
   tmp = x + dt_halve * k2;
   const vector_t k3 = system.computeFlowMap(t + dt_halve, tmp, u);
   tmp = x + dt * k3;
-  const vector_t k4 = system.computeFlowMap(t + dt, tmp, u);
+  vector_t k4 = system.computeFlowMap(t + dt, tmp, u);
 
-  tmp = x + dt_sixth * k1 + dt_third * k2 + dt_third * k3 + dt_sixth * k4;
-  return tmp;
+  // Re-use k4 to collect the result
+  k4 = x + dt_sixth * k1 + dt_third * k2 + dt_third * k3 + dt_sixth * k4;
+  return k4;
 }
 
 /******************************************************************************************************/
@@ -132,10 +158,12 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   const scalar_t dt_halve = dt / 2.0;
   const scalar_t dt_sixth = dt / 6.0;
   const scalar_t dt_third = dt / 3.0;
+  auto& memory = getThreadLocalStageMemory();
+  auto& tmpV = memory.state;
 
   // System evaluations
   VectorFunctionLinearApproximation k1 = system.linearApproximation(t, x, u);
-  vector_t tmpV = x + dt_halve * k1.f;
+  tmpV = x + dt_halve * k1.f;
   VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt_halve, tmpV, u);
   tmpV = x + dt_halve * k2.f;
   VectorFunctionLinearApproximation k3 = system.linearApproximation(t + dt_halve, tmpV, u);
@@ -152,7 +180,8 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   // State sensitivity \dot{Sx} = dfdx(t) Sx, with Sx(0) = Identity()
   // Re-use memory from k.dfdx as dkdxk
   // dk1dxk = k1.dfdx;
-  matrix_t tmp = dt_halve * k2.dfdx * k1.dfdx;  // need one temporary to avoid alias
+  auto& tmp = memory.product;  // need one temporary to avoid alias
+  tmp.noalias() = dt_halve * k2.dfdx * k1.dfdx;
   k2.dfdx += tmp;
   tmp.noalias() = dt_halve * k3.dfdx * k2.dfdx;
   k3.dfdx += tmp;
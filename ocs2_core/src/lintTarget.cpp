@@ -3,6 +3,7 @@
 #include <ocs2_core/Types.h>
 
 // Automatic Differentation
+#include <ocs2_core/automatic_differentiation/CppAdBuildQueue.h>
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 #include <ocs2_core/automatic_differentiation/CppAdSparsity.h>
 #include <ocs2_core/automatic_differentiation/FiniteDifferenceMethods.h>
@@ -69,6 +70,7 @@
 #include <ocs2_core/misc/LoadData.h>
 #include <ocs2_core/misc/Lookup.h>
 #include <ocs2_core/misc/randomMatrices.h>
+#include <ocs2_core/misc/Tracing.h>
 
 // thread_support
 #include <ocs2_core/thread_support/BufferedValue.h>
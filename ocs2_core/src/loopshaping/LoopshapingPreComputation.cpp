@@ -56,7 +56,7 @@ LoopshapingPreComputation* LoopshapingPreComputation::clone() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void LoopshapingPreComputation::request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
+void LoopshapingPreComputation::requestImpl(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
   loopshapingDefinition_->getSystemState(x, systemState_);
   loopshapingDefinition_->getSystemInput(x, u, systemInput_);
   loopshapingDefinition_->getFilterState(x, filterState_);
@@ -68,7 +68,7 @@ void LoopshapingPreComputation::request(RequestSet request, scalar_t t, const ve
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void LoopshapingPreComputation::requestPreJump(RequestSet request, scalar_t t, const vector_t& x) {
+void LoopshapingPreComputation::requestPreJumpImpl(RequestSet request, scalar_t t, const vector_t& x) {
   loopshapingDefinition_->getSystemState(x, systemState_);
   loopshapingDefinition_->getFilterState(x, filterState_);
 
@@ -78,7 +78,7 @@ void LoopshapingPreComputation::requestPreJump(RequestSet request, scalar_t t, c
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void LoopshapingPreComputation::requestFinal(RequestSet request, scalar_t t, const vector_t& x) {
+void LoopshapingPreComputation::requestFinalImpl(RequestSet request, scalar_t t, const vector_t& x) {
   loopshapingDefinition_->getSystemState(x, systemState_);
   loopshapingDefinition_->getFilterState(x, filterState_);
 
@@ -70,4 +70,22 @@ ScalarFunctionQuadraticApproximation LoopshapingStateCost::getQuadraticApproxima
   return Phi;
 }
 
+void LoopshapingStateCost::accumulateQuadraticApproximation(scalar_t t, const vector_t& x, const TargetTrajectories& targetTrajectories,
+                                                            const PreComputation& preComp, ScalarFunctionQuadraticApproximation& cost) const {
+  if (this->empty()) {
+    return;
+  }
+
+  const LoopshapingPreComputation& preCompLS = cast<LoopshapingPreComputation>(preComp);
+  const auto& x_system = preCompLS.getSystemState();
+  const auto sysStateDim = x_system.rows();
+
+  // The system cost only touches the system state block
+  const auto Phi_system =
+      StateCostCollection::getQuadraticApproximation(t, x_system, targetTrajectories, preCompLS.getSystemPreComputation());
+  cost.f += Phi_system.f;
+  cost.dfdx.head(sysStateDim) += Phi_system.dfdx;
+  cost.dfdxx.topLeftCorner(sysStateDim, sysStateDim) += Phi_system.dfdxx;
+}
+
 }  // namespace ocs2
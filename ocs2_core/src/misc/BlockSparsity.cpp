@@ -0,0 +1,122 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/misc/BlockSparsity.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace ocs2 {
+namespace block_sparsity {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+column_blocks_t dense(int numColumns) {
+  if (numColumns > 0) {
+    return {ColumnBlock{0, numColumns}};
+  } else {
+    return {};
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LinearApproximationSparsity dense(int stateDim, int inputDim) {
+  LinearApproximationSparsity sparsity;
+  sparsity.stateColumns = dense(stateDim);
+  sparsity.inputColumns = dense(inputDim);
+  return sparsity;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+column_blocks_t fromColumnIndices(const std::set<size_t>& columnIndices, int offset, int numColumns) {
+  column_blocks_t blocks;
+  // std::set is sorted, such that consecutive indices can be merged into one block
+  const auto firstIndex = static_cast<size_t>(offset);
+  const auto lastIndex = firstIndex + static_cast<size_t>(numColumns);
+  for (auto it = columnIndices.lower_bound(firstIndex); it != columnIndices.end() && *it < lastIndex; ++it) {
+    const int column = static_cast<int>(*it) - offset;
+    if (!blocks.empty() && blocks.back().start + blocks.back().size == column) {
+      ++blocks.back().size;
+    } else {
+      blocks.push_back({column, 1});
+    }
+  }
+  return blocks;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+column_blocks_t getUnion(const column_blocks_t& lhs, const column_blocks_t& rhs) {
+  column_blocks_t sortedBlocks;
+  sortedBlocks.reserve(lhs.size() + rhs.size());
+  std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(sortedBlocks),
+             [](const ColumnBlock& a, const ColumnBlock& b) { return a.start < b.start; });
+
+  // merge overlapping and adjacent blocks
+  column_blocks_t blocks;
+  for (const auto& block : sortedBlocks) {
+    if (!blocks.empty() && block.start <= blocks.back().start + blocks.back().size) {
+      const int end = std::max(blocks.back().start + blocks.back().size, block.start + block.size);
+      blocks.back().size = end - blocks.back().start;
+    } else {
+      blocks.push_back(block);
+    }
+  }
+  return blocks;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LinearApproximationSparsity getUnion(const LinearApproximationSparsity& lhs, const LinearApproximationSparsity& rhs) {
+  LinearApproximationSparsity sparsity;
+  sparsity.stateColumns = getUnion(lhs.stateColumns, rhs.stateColumns);
+  sparsity.inputColumns = getUnion(lhs.inputColumns, rhs.inputColumns);
+  return sparsity;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int getNumColumns(const column_blocks_t& blocks) {
+  int numColumns = 0;
+  for (const auto& block : blocks) {
+    numColumns += block.size;
+  }
+  return numColumns;
+}
+
+}  // namespace block_sparsity
+}  // namespace ocs2
@@ -157,45 +157,172 @@ void computeConstraintProjection(const matrix_t& Dm, const matrix_t& RmInvUmUmT,
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(const VectorFunctionLinearApproximation& constraint) {
+std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(const VectorFunctionLinearApproximation& constraint,
+                                                                              const column_blocks_t* stateColumnsPtr) {
+  ConstraintProjectionWorkspace workspace;
+  VectorFunctionLinearApproximation projectionTerms;
+  matrix_t pseudoInverse;
+  qrConstraintProjection(constraint, workspace, projectionTerms, pseudoInverse, stateColumnsPtr);
+  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void qrConstraintProjection(const VectorFunctionLinearApproximation& constraint, ConstraintProjectionWorkspace& workspace,
+                            VectorFunctionLinearApproximation& projection, matrix_t& pseudoInverse, const column_blocks_t* stateColumnsPtr) {
   // Constraint Projectors are based on the QR decomposition
   const auto numConstraints = constraint.dfdu.rows();
   const auto numInputs = constraint.dfdu.cols();
-  const Eigen::HouseholderQR<matrix_t> QRof_DT(constraint.dfdu.transpose());
+  auto& qr = workspace.qr;
+  qr.compute(constraint.dfdu.transpose());
 
-  const matrix_t Q = QRof_DT.householderQ();
-  const auto Q1 = Q.leftCols(numConstraints);
+  auto& Q = workspace.Q;
+  qr.householderQ().evalTo(Q, workspace.vectorSolution);
 
-  const auto R = QRof_DT.matrixQR().topRows(numConstraints).triangularView<Eigen::Upper>();
-  const matrix_t pseudoInverse = R.solve(Q1.transpose());  // left pseudo-inverse of D^T
+  const auto R = qr.matrixQR().topRows(numConstraints).triangularView<Eigen::Upper>();
+  pseudoInverse = Q.leftCols(numConstraints).transpose();
+  R.solveInPlace(pseudoInverse);  // left pseudo-inverse of D^T
 
-  VectorFunctionLinearApproximation projectionTerms;
-  projectionTerms.dfdu = Q.rightCols(numInputs - numConstraints);
-  projectionTerms.dfdx.noalias() = -pseudoInverse.transpose() * constraint.dfdx;
-  projectionTerms.f.noalias() = -pseudoInverse.transpose() * constraint.f;
+  if (stateColumnsPtr == nullptr) {
+    projection.dfdx.noalias() = -pseudoInverse.transpose() * constraint.dfdx;
+  } else {
+    projection.dfdx.setZero(numInputs, constraint.dfdx.cols());
+    for (const auto& block : *stateColumnsPtr) {
+      projection.dfdx.middleCols(block.start, block.size).noalias() =
+          -pseudoInverse.transpose() * constraint.dfdx.middleCols(block.start, block.size);
+    }
+  }
+  projection.f.noalias() = -pseudoInverse.transpose() * constraint.f;
 
-  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
+  // The last (numInputs - numConstraints) columns of Q span the null space of D
+  projection.dfdu = Q.rightCols(numInputs - numConstraints);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::pair<VectorFunctionLinearApproximation, matrix_t> luConstraintProjection(const VectorFunctionLinearApproximation& constraint,
-                                                                              bool extractPseudoInverse) {
-  // Constraint Projectors are based on the LU decomposition
-  const Eigen::FullPivLU<matrix_t> lu(constraint.dfdu);
-
+                                                                              bool extractPseudoInverse,
+                                                                              const column_blocks_t* stateColumnsPtr) {
+  ConstraintProjectionWorkspace workspace;
   VectorFunctionLinearApproximation projectionTerms;
-  projectionTerms.dfdu = lu.kernel();
-  projectionTerms.dfdx.noalias() = -lu.solve(constraint.dfdx);
-  projectionTerms.f.noalias() = -lu.solve(constraint.f);
-
   matrix_t pseudoInverse;
-  if (extractPseudoInverse) {
-    pseudoInverse = lu.solve(matrix_t::Identity(constraint.f.size(), constraint.f.size())).transpose();  // left pseudo-inverse of D^T
+  luConstraintProjection(constraint, workspace, projectionTerms, extractPseudoInverse ? &pseudoInverse : nullptr, stateColumnsPtr);
+  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
+}
+
+namespace {
+
+/**
+ * Computes the solution of D * x = b from the decomposition P * D * Q = L * U. This is a copy of FullPivLU::_solve_impl() of Eigen 3.4.0,
+ * except that the intermediate result c, of the size of b, is passed in. Eigen allocates it on every call and offers no way to provide
+ * the memory. Keep in sync with Eigen when upgrading.
+ */
+template <typename Rhs, typename Intermediate, typename Solution>
+void luSolve(const Eigen::FullPivLU<matrix_t>& lu, const Rhs& b, Intermediate&& c, Solution&& x) {
+  const auto& LU = lu.matrixLU();
+  const Eigen::Index rank = lu.rank();
+  const Eigen::Index smallDim = std::min(LU.rows(), LU.cols());
+  if (rank == 0) {
+    x.setZero();
+    return;
   }
 
-  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
+  c.noalias() = lu.permutationP() * b;
+  LU.topLeftCorner(smallDim, smallDim).triangularView<Eigen::UnitLower>().solveInPlace(c.topRows(smallDim));
+  if (LU.rows() > LU.cols()) {
+    c.bottomRows(LU.rows() - LU.cols()).noalias() -= LU.bottomRows(LU.rows() - LU.cols()) * c.topRows(LU.cols());
+  }
+  LU.topLeftCorner(rank, rank).triangularView<Eigen::Upper>().solveInPlace(c.topRows(rank));
+
+  const auto& q = lu.permutationQ().indices();
+  for (Eigen::Index i = 0; i < rank; ++i) {
+    x.row(q(i)) = c.row(i);
+  }
+  for (Eigen::Index i = rank; i < LU.cols(); ++i) {
+    x.row(q(i)).setZero();
+  }
+}
+
+/**
+ * Computes the null space basis of D from the decomposition P * D * Q = L * U. This follows internal::kernel_retval<FullPivLU>::evalTo()
+ * of Eigen 3.4.0 for the common case of leading non-zero pivots, but writes the intermediate result into the given memory instead of
+ * allocating it. Otherwise, U has to be permuted and it falls back to lu.kernel(). Keep in sync with Eigen when upgrading.
+ */
+void luKernel(const Eigen::FullPivLU<matrix_t>& lu, matrix_t& intermediate, matrix_t& kernel) {
+  const auto& LU = lu.matrixLU();
+  const Eigen::Index numCols = LU.cols();
+  const Eigen::Index rank = lu.rank();
+  if (rank == numCols) {
+    kernel.setZero(numCols, 1);  // the kernel is {0}, lu.kernel() returns a single zero column
+    return;
+  }
+
+  const scalar_t pivotThreshold = lu.maxPivot() * lu.threshold();
+  for (Eigen::Index i = 0; i < rank; ++i) {
+    if (std::abs(LU(i, i)) <= pivotThreshold) {
+      kernel = lu.kernel();
+      return;
+    }
+  }
+
+  // With U = [U1, U2] and the leading pivots in the upper triangular U1, the basis of Ker U is [-inv(U1) * U2; I]
+  const Eigen::Index dimKernel = numCols - rank;
+  intermediate = LU.topRightCorner(rank, dimKernel);
+  LU.topLeftCorner(rank, rank).triangularView<Eigen::Upper>().solveInPlace(intermediate);
+
+  // Ker D = Q * Ker U
+  const auto& q = lu.permutationQ().indices();
+  kernel.resize(numCols, dimKernel);
+  for (Eigen::Index i = 0; i < rank; ++i) {
+    kernel.row(q(i)) = -intermediate.row(i);
+  }
+  for (Eigen::Index i = rank; i < numCols; ++i) {
+    kernel.row(q(i)).setZero();
+  }
+  for (Eigen::Index k = 0; k < dimKernel; ++k) {
+    kernel(q(rank + k), k) = 1.0;
+  }
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void luConstraintProjection(const VectorFunctionLinearApproximation& constraint, ConstraintProjectionWorkspace& workspace,
+                            VectorFunctionLinearApproximation& projection, matrix_t* pseudoInversePtr, const column_blocks_t* stateColumnsPtr) {
+  // Constraint Projectors are based on the LU decomposition
+  const auto numInputs = constraint.dfdu.cols();
+  auto& lu = workspace.lu;
+  lu.compute(constraint.dfdu);
+
+  luKernel(lu, workspace.kernel, projection.dfdu);
+
+  // Px = -D^+ * C and Pe = -D^+ * e, solved into the projection and negated in place
+  auto& solution = workspace.matrixSolution;
+  solution.resize(constraint.dfdx.rows(), constraint.dfdx.cols());
+  projection.dfdx.resize(numInputs, constraint.dfdx.cols());
+  if (stateColumnsPtr == nullptr) {
+    luSolve(lu, constraint.dfdx, solution, projection.dfdx);
+    projection.dfdx = -projection.dfdx;
+  } else {
+    projection.dfdx.setZero();
+    for (const auto& block : *stateColumnsPtr) {
+      auto Px = projection.dfdx.middleCols(block.start, block.size);
+      luSolve(lu, constraint.dfdx.middleCols(block.start, block.size), solution.middleCols(block.start, block.size), Px);
+      Px = -Px;
+    }
+  }
+  workspace.vectorSolution.resize(constraint.f.size());
+  projection.f.resize(numInputs);
+  luSolve(lu, constraint.f, workspace.vectorSolution, projection.f);
+  projection.f = -projection.f;
+
+  if (pseudoInversePtr != nullptr) {
+    *pseudoInversePtr = lu.solve(matrix_t::Identity(constraint.f.size(), constraint.f.size())).transpose();  // left pseudo-inverse of D^T
+  }
 }
 
 // Explicit instantiations for dynamic sized matrices
@@ -0,0 +1,365 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/Tracing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+
+namespace ocs2 {
+namespace tracing {
+
+namespace {
+
+/** Single-producer single-consumer ring buffer of the events of one thread. */
+struct ThreadBuffer {
+  ThreadBuffer(size_t capacity, uint32_t id) : events(capacity), mask(capacity - 1), threadId(id) {}
+
+  std::vector<TraceEvent> events;
+  const uint64_t mask;
+  const uint32_t threadId;
+  std::atomic<uint64_t> head{0};  // written by the recording thread
+  std::atomic<uint64_t> tail{0};  // written by the collecting thread
+  std::atomic<size_t> numDropped{0};
+};
+
+struct Registry {
+  std::mutex mutex;  // guards buffers and serializes the collecting threads, never taken by the recording threads after registration
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  std::atomic<size_t> threadBufferCapacity{size_t(1) << 14};
+  std::atomic<bool> enabled{true};
+};
+
+Registry& getRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+struct OpenZone {
+  const char* name;  // nullptr if the zone is not recorded
+  int64_t startTime;
+  const char* childParent;  // parent of the zones opened within this zone
+  uint32_t childDepth;      // depth of the zones opened within this zone
+};
+
+struct ThreadState {
+  ThreadState() { zoneStack.reserve(64); }
+
+  std::shared_ptr<ThreadBuffer> buffer;
+  std::vector<OpenZone> zoneStack;
+};
+
+thread_local ThreadState threadState;
+
+int64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ThreadBuffer& getThreadBuffer() {
+  if (threadState.buffer == nullptr) {
+    auto& registry = getRegistry();
+    size_t capacity = 1;
+    while (capacity < registry.threadBufferCapacity.load(std::memory_order_relaxed)) {
+      capacity <<= 1;
+    }
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    threadState.buffer = std::make_shared<ThreadBuffer>(capacity, static_cast<uint32_t>(registry.buffers.size()));
+    registry.buffers.push_back(threadState.buffer);
+  }
+  return *threadState.buffer;
+}
+
+void push(ThreadBuffer& buffer, const TraceEvent& event) {
+  const auto head = buffer.head.load(std::memory_order_relaxed);
+  const auto tail = buffer.tail.load(std::memory_order_acquire);
+  if (head - tail > buffer.mask) {
+    buffer.numDropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.events[head & buffer.mask] = event;
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+/** Nearest-rank percentile of sorted durations */
+scalar_t getPercentileInMilliseconds(const std::vector<int64_t>& sortedDurations, scalar_t percentile) {
+  const auto n = sortedDurations.size();
+  const auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<scalar_t>(n)));
+  const auto index = std::min(std::max(rank, size_t(1)), n) - 1;
+  return static_cast<scalar_t>(sortedDurations[index]) * 1e-6;
+}
+
+void writeJsonString(std::ostream& stream, const char* str) {
+  stream << '"';
+  for (; str != nullptr && *str != '\0'; ++str) {
+    switch (*str) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      default:
+        stream << *str;
+    }
+  }
+  stream << '"';
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setEnabled(bool enabled) {
+  getRegistry().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isEnabled() {
+  return getRegistry().enabled.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setThreadBufferCapacity(size_t capacity) {
+  getRegistry().threadBufferCapacity.store(std::max(capacity, size_t(1)), std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getNumDroppedEvents() {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  size_t numDropped = 0;
+  for (const auto& buffer : registry.buffers) {
+    numDropped += buffer->numDropped.load(std::memory_order_relaxed);
+  }
+  return numDropped;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void beginZone(const char* name) {
+  auto& stack = threadState.zoneStack;
+  const char* parent = stack.empty() ? nullptr : stack.back().childParent;
+  const uint32_t depth = stack.empty() ? 0 : stack.back().childDepth;
+  if (isEnabled()) {
+    getThreadBuffer();  // allocate before taking the start time
+    stack.push_back({name, now(), name, depth + 1});
+  } else {
+    stack.push_back({nullptr, 0, parent, depth});
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void endZone() {
+  const auto endTime = now();
+  auto& stack = threadState.zoneStack;
+  if (stack.empty()) {
+    return;
+  }
+  const auto zone = stack.back();
+  stack.pop_back();
+  if (zone.name != nullptr) {
+    auto& buffer = getThreadBuffer();
+    TraceEvent event;
+    event.name = zone.name;
+    event.parent = stack.empty() ? nullptr : stack.back().childParent;
+    event.startTimeInNanoseconds = zone.startTime;
+    event.durationInNanoseconds = endTime - zone.startTime;
+    event.threadId = buffer.threadId;
+    event.depth = zone.childDepth - 1;
+    push(buffer, event);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<TraceEvent> collectEvents() {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::vector<TraceEvent> events;
+  for (auto& buffer : registry.buffers) {
+    const auto tail = buffer->tail.load(std::memory_order_relaxed);
+    const auto head = buffer->head.load(std::memory_order_acquire);
+    for (auto i = tail; i != head; ++i) {
+      events.push_back(buffer->events[i & buffer->mask]);
+    }
+    buffer->tail.store(head, std::memory_order_release);
+  }
+  return events;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<ZoneStatistics> computeStatistics(const std::vector<TraceEvent>& events) {
+  // group the durations by {parent, name}
+  using key_t = std::pair<std::string, std::string>;
+  std::map<key_t, std::vector<int64_t>> durations;
+  std::map<key_t, size_t> depths;
+  for (const auto& event : events) {
+    const key_t key{event.parent != nullptr ? event.parent : "", event.name};
+    durations[key].push_back(event.durationInNanoseconds);
+    auto depthIt = depths.emplace(key, event.depth).first;
+    depthIt->second = std::min<size_t>(depthIt->second, event.depth);
+  }
+
+  std::map<key_t, ZoneStatistics> statisticsMap;
+  for (auto& keyValue : durations) {
+    auto& sortedDurations = keyValue.second;
+    std::sort(sortedDurations.begin(), sortedDurations.end());
+    ZoneStatistics statistics;
+    statistics.parent = keyValue.first.first;
+    statistics.name = keyValue.first.second;
+    statistics.depth = depths[keyValue.first];
+    statistics.numCalls = sortedDurations.size();
+    for (const auto d : sortedDurations) {
+      statistics.totalInMilliseconds += static_cast<scalar_t>(d) * 1e-6;
+    }
+    statistics.averageInMilliseconds = statistics.totalInMilliseconds / static_cast<scalar_t>(statistics.numCalls);
+    statistics.maxInMilliseconds = static_cast<scalar_t>(sortedDurations.back()) * 1e-6;
+    statistics.p50InMilliseconds = getPercentileInMilliseconds(sortedDurations, 50.0);
+    statistics.p90InMilliseconds = getPercentileInMilliseconds(sortedDurations, 90.0);
+    statistics.p99InMilliseconds = getPercentileInMilliseconds(sortedDurations, 99.0);
+    statisticsMap.emplace(keyValue.first, std::move(statistics));
+  }
+
+  // depth-first ordering, children sorted by decreasing total time
+  auto getChildren = [&](const std::string& parent) {
+    std::vector<const ZoneStatistics*> children;
+    for (const auto& keyValue : statisticsMap) {
+      if (keyValue.first.first == parent) {
+        children.push_back(&keyValue.second);
+      }
+    }
+    std::sort(children.begin(), children.end(),
+              [](const ZoneStatistics* a, const ZoneStatistics* b) { return a->totalInMilliseconds > b->totalInMilliseconds; });
+    return children;
+  };
+
+  std::vector<ZoneStatistics> sortedStatistics;
+  sortedStatistics.reserve(statisticsMap.size());
+  std::set<const ZoneStatistics*> added;
+  std::set<std::string> expandedNames;
+  const auto roots = getChildren("");
+  std::vector<const ZoneStatistics*> stack(roots.rbegin(), roots.rend());
+  while (!stack.empty()) {
+    const auto* statistics = stack.back();
+    stack.pop_back();
+    sortedStatistics.push_back(*statistics);
+    added.insert(statistics);
+    // a name that appears under several parents (or recursively) is only expanded once
+    if (expandedNames.insert(statistics->name).second) {
+      const auto children = getChildren(statistics->name);
+      stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+  }
+
+  // zones whose enclosing zones have not been collected
+  for (const auto& keyValue : statisticsMap) {
+    if (added.count(&keyValue.second) == 0) {
+      sortedStatistics.push_back(keyValue.second);
+    }
+  }
+
+  return sortedStatistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::ostream& operator<<(std::ostream& stream, const std::vector<ZoneStatistics>& statistics) {
+  const auto flags = stream.flags();
+  stream << std::fixed << std::setprecision(3);
+  for (const auto& s : statistics) {
+    stream << std::string(2 * s.depth, ' ') << s.name << ": calls " << s.numCalls << ", total [ms] " << s.totalInMilliseconds
+           << ", avg [ms] " << s.averageInMilliseconds << ", p50 [ms] " << s.p50InMilliseconds << ", p90 [ms] " << s.p90InMilliseconds
+           << ", p99 [ms] " << s.p99InMilliseconds << ", max [ms] " << s.maxInMilliseconds << "\n";
+  }
+  stream.flags(flags);
+  return stream;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeChromeTrace(std::ostream& stream, const std::vector<TraceEvent>& events) {
+  int64_t startTime = 0;
+  if (!events.empty()) {
+    startTime = std::min_element(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+                  return a.startTimeInNanoseconds < b.startTimeInNanoseconds;
+                })->startTimeInNanoseconds;
+  }
+
+  const auto flags = stream.flags();
+  stream << std::fixed << std::setprecision(3);
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (size_t i = 0; i < events.size(); ++i) {
+    const auto& event = events[i];
+    stream << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+    writeJsonString(stream, event.name);
+    stream << ",\"cat\":\"ocs2\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.threadId
+           << ",\"ts\":" << static_cast<scalar_t>(event.startTimeInNanoseconds - startTime) * 1e-3
+           << ",\"dur\":" << static_cast<scalar_t>(event.durationInNanoseconds) * 1e-3 << "}";
+  }
+  stream << "\n]}\n";
+  stream.flags(flags);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeChromeTrace(const std::string& fileName, const std::vector<TraceEvent>& events) {
+  std::ofstream file(fileName);
+  if (!file.is_open()) {
+    throw std::runtime_error("[tracing::writeChromeTrace] Could not open " + fileName);
+  }
+  writeChromeTrace(file, events);
+}
+
+}  // namespace tracing
+}  // namespace ocs2
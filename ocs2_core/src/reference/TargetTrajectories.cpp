@@ -77,7 +77,7 @@ vector_t TargetTrajectories::getDesiredState(scalar_t time) const {
   if (this->empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
   } else {
-    return LinearInterpolation::interpolate(time, timeTrajectory, stateTrajectory);
+    return LinearInterpolation::interpolate(timeSegmentCursor_.timeSegment(time, timeTrajectory), stateTrajectory);
   }
 }
 
@@ -90,7 +90,7 @@ vector_t TargetTrajectories::getDesiredInput(scalar_t time) const {
   } else if (inputTrajectory.empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories does not have inputTrajectory!");
   } else {
-    return LinearInterpolation::interpolate(time, timeTrajectory, inputTrajectory);
+    return LinearInterpolation::interpolate(timeSegmentCursor_.timeSegment(time, timeTrajectory), inputTrajectory);
   }
 }
 
@@ -27,15 +27,144 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <stdexcept>
+#include <string>
+
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 namespace ocs2 {
 
+namespace {
+
+/** Number of idle rounds a worker spins (yielding) before it parks on the condition variable. */
+constexpr int numSpinRounds = 1024;
+
+/** The pool and worker index of the calling thread, used to push tasks into the worker's own deque. */
+struct CurrentWorker {
+  const ThreadPool* poolPtr = nullptr;
+  int index = -1;
+};
+thread_local CurrentWorker currentWorker;
+
+/** The pool whose parallelFor job the calling thread is currently processing, used to run nested calls serially. */
+thread_local const ThreadPool* currentJobPoolPtr = nullptr;
+
+/** Marks the calling thread as processing a job of the given pool for the lifetime of the object. */
+class JobScope {
+ public:
+  explicit JobScope(const ThreadPool* poolPtr) : previousPoolPtr_(currentJobPoolPtr) { currentJobPoolPtr = poolPtr; }
+  ~JobScope() { currentJobPoolPtr = previousPoolPtr_; }
+
+ private:
+  const ThreadPool* previousPoolPtr_;
+};
+
+/** Minimal test-and-set lock guarding a worker deque. Contention only happens while stealing. */
+class SpinLock {
+ public:
+  void lock() {
+    while (flag_.test_and_set(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+  }
+  void unlock() { flag_.clear(std::memory_order_release); }
+
+ private:
+  std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+};
+
+}  // unnamed namespace
+
+/**
+ * Per-worker task deque. The owner pushes and pops at the back, thieves steal from the front.
+ */
+struct ThreadPool::WorkerQueue {
+  SpinLock lock;
+  std::deque<std::unique_ptr<TaskBase>> tasks;  // protected by lock
+};
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::ParallelForJob::execute(int workerIndex) {
+  bool claimedChunk = false;
+  int chunkBegin;
+  while ((chunkBegin = next.fetch_add(grain)) < end) {
+    claimedChunk = true;
+    if (failed.load(std::memory_order_relaxed)) {
+      continue;  // drain the remaining chunks without running them
+    }
+    const int chunkEnd = std::min(chunkBegin, end - grain) + grain;
+    try {
+      for (int i = chunkBegin; i < chunkEnd; ++i) {
+        invoker(function, workerIndex, i);
+      }
+    } catch (...) {
+      if (!failed.exchange(true)) {
+        exceptionPtr = std::current_exception();
+      }
+    }
+  }
+  return claimedChunk;
+}
+
+/**
+ * Rendezvous of the helper tasks of tryRunConcurrently(). Each helper occupies a pool worker until the caller has decided
+ * whether all helpers have joined in time.
+ */
+struct ThreadPool::ConcurrentJob {
+  enum class Decision { Pending, Start, Abort };
+
+  //! Added to numJoined once the caller stops waiting for helpers.
+  static constexpr int withdrawn = 1 << 30;
+
+  /** Called by a helper task. Blocks until the caller decides and runs the task if all helpers have joined. */
+  void join(int workerIndex);
+
+  const std::function<void(int)>* taskPtr = nullptr;
+  std::atomic_int numJoined{0};
+  std::atomic<Decision> decision{Decision::Pending};
+  std::atomic_int numFinished{0};
+
+  std::atomic_bool failed{false};
+  std::exception_ptr exceptionPtr;  // written once by the thread that sets failed
+};
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::ConcurrentJob::join(int workerIndex) {
+  if (numJoined.fetch_add(1) >= withdrawn) {
+    return;
+  }
+
+  Decision d;
+  while ((d = decision.load()) == Decision::Pending) {
+    std::this_thread::yield();
+  }
+
+  if (d == Decision::Start) {
+    try {
+      (*taskPtr)(workerIndex);
+    } catch (...) {
+      if (!failed.exchange(true)) {
+        exceptionPtr = std::current_exception();
+      }
+    }
+    ++numFinished;
+  }
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 ThreadPool::ThreadPool(size_t nThreads, int priority) {
+  workerQueues_.reserve(nThreads);
+  for (size_t i = 0; i < nThreads; i++) {
+    workerQueues_.emplace_back(new WorkerQueue);
+  }
+
   workerThreads_.reserve(nThreads);
   for (size_t i = 0; i < nThreads; i++) {
     workerThreads_.emplace_back(&ThreadPool::worker, this, i);
@@ -47,11 +176,9 @@ ThreadPool::ThreadPool(size_t nThreads, int priority) {
 /**************************************************************************************************/
 /**************************************************************************************************/
 ThreadPool::~ThreadPool() {
-  {  // set exit flag, wake up threads and join
-    std::lock_guard<std::mutex> lock(taskQueueLock_);
-    stop_ = true;
-  }
-  taskQueueCondition_.notify_all();
+  // set exit flag, wake up threads and join
+  stop_ = true;
+  notifyWorkers(true);
   for (auto& thread : workerThreads_) {
     if (thread.joinable()) {
       thread.join();
@@ -63,27 +190,35 @@ ThreadPool::~ThreadPool() {
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::worker(int workerIndex) {
+  currentWorker.poolPtr = this;
+  currentWorker.index = workerIndex;
+
+  int idleRounds = 0;
   while (true) {
-    std::unique_ptr<ThreadPool::TaskBase> taskPtr;
-    {
-      std::unique_lock<std::mutex> lock(taskQueueLock_);
-      taskQueueCondition_.wait(lock, [this] { return !taskQueue_.empty() || stop_; });
+    // read the epoch before looking for work, such that work published afterwards prevents parking
+    const auto epoch = workEpoch_.load();
 
-      // exit condition
-      if (stop_) {
-        break;
-      }
+    if (tryRunJob(workerIndex) || tryRunTask(workerIndex)) {
+      idleRounds = 0;
+      continue;
+    }
 
-      // pop the first task
-      if (!taskQueue_.empty()) {
-        taskPtr = std::move(taskQueue_.front());
-        taskQueue_.pop();
-      }
+    // exit condition, all queued tasks have been executed
+    if (stop_) {
+      break;
     }
 
-    if (taskPtr) {
-      taskPtr->operator()(workerIndex);
+    if (++idleRounds < numSpinRounds) {
+      std::this_thread::yield();
+      continue;
     }
+
+    // park until new work is published
+    std::unique_lock<std::mutex> lock(parkLock_);
+    ++numParkedWorkers_;
+    parkCondition_.wait(lock, [&] { return workEpoch_.load() != epoch || stop_; });
+    --numParkedWorkers_;
+    idleRounds = 0;
   }
 }
 
@@ -91,11 +226,117 @@ void ThreadPool::worker(int workerIndex) {
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
+  const size_t queueIndex = (currentWorker.poolPtr == this) ? static_cast<size_t>(currentWorker.index)
+                                                            : nextQueueIndex_++ % workerQueues_.size();
+  auto& queue = *workerQueues_[queueIndex];
   {
-    std::lock_guard<std::mutex> lock(taskQueueLock_);
-    taskQueue_.push(std::move(taskPtr));
+    std::lock_guard<SpinLock> lock(queue.lock);
+    queue.tasks.push_back(std::move(taskPtr));
+  }
+  ++numPendingTasks_;
+  notifyWorkers(false);
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::tryRunTask(int workerIndex) {
+  if (numPendingTasks_.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+
+  const size_t numQueues = workerQueues_.size();
+  std::unique_ptr<TaskBase> taskPtr;
+  for (size_t k = 0; k < numQueues && !taskPtr; ++k) {
+    const bool isOwnQueue = (k == 0);
+    auto& queue = *workerQueues_[(workerIndex + k) % numQueues];
+    std::lock_guard<SpinLock> lock(queue.lock);
+    if (!queue.tasks.empty()) {
+      if (isOwnQueue) {
+        taskPtr = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        taskPtr = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+    }
+  }
+
+  if (taskPtr) {
+    --numPendingTasks_;
+    taskPtr->operator()(workerIndex);
+    return true;
+  } else {
+    return false;
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::tryRunJob(int workerIndex) {
+  if (activeJob_.load(std::memory_order_relaxed) == nullptr) {
+    return false;
+  }
+
+  // Register as helper before reading the job, such that the owner waits for us before the job leaves its scope.
+  ++numJobHelpers_;
+  ParallelForJob* jobPtr = activeJob_.load();
+  bool claimedChunk = false;
+  if (jobPtr != nullptr) {
+    JobScope jobScope(this);
+    claimedChunk = jobPtr->execute(workerIndex);
+  }
+  --numJobHelpers_;
+
+  return claimedChunk;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::runJob(ParallelForJob& job) {
+  // threadpool workers use ID 0 -> nThreads - 1, other threads use ID nThreads
+  const auto callerIndex = (currentWorker.poolPtr == this) ? currentWorker.index : static_cast<int>(numThreads());
+
+  // A nested call from within a job of this pool runs serially. Sharing the pool would make a helper wait for itself.
+  const bool isNested = (currentJobPoolPtr == this);
+  const bool hasMultipleChunks = job.end - job.next.load() > job.grain;
+  ParallelForJob* expected = nullptr;
+  if (!workerThreads_.empty() && !isNested && hasMultipleChunks && activeJob_.compare_exchange_strong(expected, &job)) {
+    notifyWorkers(true);
+    {
+      JobScope jobScope(this);
+      job.execute(callerIndex);
+    }
+
+    // Stop handing out the job and wait for the helpers that are still processing a chunk.
+    activeJob_ = nullptr;
+    while (numJobHelpers_.load() != 0) {
+      std::this_thread::yield();
+    }
+  } else {
+    job.execute(callerIndex);
+  }
+
+  if (job.exceptionPtr) {
+    std::rethrow_exception(job.exceptionPtr);
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::notifyWorkers(bool all) {
+  ++workEpoch_;
+  if (numParkedWorkers_.load() > 0) {
+    std::lock_guard<std::mutex> lock(parkLock_);
+    if (all) {
+      parkCondition_.notify_all();
+    } else {
+      parkCondition_.notify_one();
+    }
   }
-  taskQueueCondition_.notify_one();
 }
 
 /**************************************************************************************************/
@@ -122,4 +363,70 @@ void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::tryRunConcurrently(std::function<void(int)> taskFunction, int N, std::chrono::microseconds timeout) {
+  if (N <= 0) {
+    return true;
+  }
+
+  const int numHelpers = N - 1;
+  const auto callerIndex = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
+  if (numHelpers > callerIndex || currentWorker.poolPtr == this) {
+    return false;
+  } else if (numHelpers == 0) {
+    taskFunction(callerIndex);
+    return true;
+  }
+
+  // The state is shared with the queued helper tasks, which may only be dequeued after this call has given up on them.
+  auto jobPtr = std::make_shared<ConcurrentJob>();
+  jobPtr->taskPtr = &taskFunction;
+  for (int i = 0; i < numHelpers; ++i) {
+    run([jobPtr](int workerIndex) { jobPtr->join(workerIndex); });
+  }
+
+  // Wait for the helpers to join, then start them or withdraw the job. A helper joining after the withdrawal returns at once.
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (jobPtr->numJoined.load() < numHelpers && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  const int numJoined = jobPtr->numJoined.fetch_or(ConcurrentJob::withdrawn);
+  const bool start = (numJoined == numHelpers);
+  jobPtr->decision = start ? ConcurrentJob::Decision::Start : ConcurrentJob::Decision::Abort;
+  if (!start) {
+    return false;
+  }
+
+  std::exception_ptr callerExceptionPtr;
+  try {
+    taskFunction(callerIndex);
+  } catch (...) {
+    callerExceptionPtr = std::current_exception();
+  }
+
+  // The helpers reference taskFunction until they are finished.
+  while (jobPtr->numFinished.load() != numHelpers) {
+    std::this_thread::yield();
+  }
+
+  if (callerExceptionPtr) {
+    std::rethrow_exception(callerExceptionPtr);
+  } else if (jobPtr->exceptionPtr) {
+    std::rethrow_exception(jobPtr->exceptionPtr);
+  }
+  return true;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::runConcurrently(std::function<void(int)> taskFunction, int N, std::chrono::microseconds timeout) {
+  if (!tryRunConcurrently(std::move(taskFunction), N, timeout)) {
+    throw std::runtime_error("[ThreadPool::runConcurrently] Could not run " + std::to_string(N) + " tasks concurrently on a pool of " +
+                             std::to_string(numThreads()) + " threads.");
+  }
+}
+
 }  // namespace ocs2
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
 #include <ocs2_core/constraint/StateConstraintCollection.h>
 #include <ocs2_core/constraint/StateInputConstraintCollection.h>
 #include "testConstraints.h"
@@ -181,6 +182,39 @@ TEST(TestConstraintCollection, getLinearApproximation) {
   EXPECT_EQ(linearApproximation.dfdu.row(3).sum(), 2);
 }
 
+TEST(TestConstraintCollection, getLinearApproximationSkipsInactive) {
+  ocs2::StateInputConstraintCollection constraintCollection;
+
+  // evaluation point
+  double t = 0.0;
+  ocs2::vector_t x = ocs2::vector_t::Random(3);
+  ocs2::vector_t u = ocs2::vector_t::Random(2);
+
+  // Mix of linear terms with in-place writing and dummy terms with the default writing
+  const ocs2::vector_t e = ocs2::vector_t::Random(3);
+  const ocs2::matrix_t C = ocs2::matrix_t::Random(3, 3);
+  const ocs2::matrix_t D = ocs2::matrix_t::Random(3, 2);
+  constraintCollection.add("Constraint1", std::make_unique<TestDummyConstraint>());
+  constraintCollection.add("Constraint2", std::make_unique<ocs2::LinearStateInputConstraint>(e, C, D));
+  constraintCollection.add("Constraint3", std::make_unique<TestDummyConstraint>());
+  constraintCollection.get<TestDummyConstraint>("Constraint1").setActivity(false);
+
+  const auto linearApproximation = constraintCollection.getLinearApproximation(t, x, u, ocs2::PreComputation());
+  ASSERT_EQ(linearApproximation.f.size(), 5);
+  ASSERT_EQ(linearApproximation.dfdx.rows(), 5);
+  ASSERT_EQ(linearApproximation.dfdu.rows(), 5);
+
+  const auto linearTermApproximation = constraintCollection.get("Constraint2").getLinearApproximation(t, x, u, ocs2::PreComputation());
+  EXPECT_TRUE(linearApproximation.f.head(3).isApprox(linearTermApproximation.f));
+  EXPECT_TRUE(linearApproximation.dfdx.topRows(3).isApprox(C));
+  EXPECT_TRUE(linearApproximation.dfdu.topRows(3).isApprox(D));
+
+  const auto dummyTermApproximation = constraintCollection.get("Constraint3").getLinearApproximation(t, x, u, ocs2::PreComputation());
+  EXPECT_TRUE(linearApproximation.f.tail(2).isApprox(dummyTermApproximation.f));
+  EXPECT_TRUE(linearApproximation.dfdx.bottomRows(2).isApprox(dummyTermApproximation.dfdx));
+  EXPECT_TRUE(linearApproximation.dfdu.bottomRows(2).isApprox(dummyTermApproximation.dfdu));
+}
+
 TEST(TestConstraintCollection, getQuadraticApproximation) {
   using collection_t = ocs2::StateInputConstraintCollection;
   collection_t constraintCollection;
@@ -122,3 +122,58 @@ TEST(TestStateInputConstraintCppAd, getValue) {
   EXPECT_TRUE(quad.dfduu[0].isZero());
   EXPECT_TRUE(quad.dfduu[1].isApprox((ocs2::matrix_t(1, 1) << -2).finished()));
 }
+
+class TestSparseStateInputConstraint : public ocs2::StateInputConstraintCppAd {
+ public:
+  TestSparseStateInputConstraint() : ocs2::StateInputConstraintCppAd(ocs2::ConstraintOrder::Linear) {
+    initialize(5, 3, 1, "TestSparseStateInputConstraint", "/tmp/ocs2", true, false);
+  }
+  ~TestSparseStateInputConstraint() override = default;
+  TestSparseStateInputConstraint* clone() const override { return new TestSparseStateInputConstraint(*this); }
+
+  size_t getNumConstraints(ocs2::scalar_t time) const override { return 2; }
+
+  ocs2::vector_t getParameters(ocs2::scalar_t time, const ocs2::PreComputation& /* preComputation */) const override {
+    return ocs2::vector_t::Ones(1);
+  }
+
+  ocs2::ad_vector_t constraintFunction(ocs2::ad_scalar_t time, const ocs2::ad_vector_t& state, const ocs2::ad_vector_t& input,
+                                       const ocs2::ad_vector_t& parameters) const override {
+    ocs2::ad_vector_t constraint(2);
+    constraint(0) = parameters(0) * state(1) * state(2) + input(2);
+    constraint(1) = time * state(4) + input(2) * parameters(0);
+    return constraint;
+  }
+
+ private:
+  TestSparseStateInputConstraint(const TestSparseStateInputConstraint& other) = default;
+};
+
+TEST(TestStateInputConstraintCppAd, getLinearApproximationSparsity) {
+  TestSparseStateInputConstraint constraint;
+
+  const ocs2::scalar_t t = 0.5;
+  const auto sparsity = constraint.getLinearApproximationSparsity(t, 5, 3);
+  ASSERT_EQ(sparsity.stateColumns.size(), 2);
+  EXPECT_EQ(sparsity.stateColumns[0].start, 1);
+  EXPECT_EQ(sparsity.stateColumns[0].size, 2);
+  EXPECT_EQ(sparsity.stateColumns[1].start, 4);
+  EXPECT_EQ(sparsity.stateColumns[1].size, 1);
+  ASSERT_EQ(sparsity.inputColumns.size(), 1);
+  EXPECT_EQ(sparsity.inputColumns[0].start, 2);
+  EXPECT_EQ(sparsity.inputColumns[0].size, 1);
+
+  // Columns outside of the sparsity are zero
+  const ocs2::vector_t x = ocs2::vector_t::Random(5);
+  const ocs2::vector_t u = ocs2::vector_t::Random(3);
+  const auto lin = constraint.getLinearApproximation(t, x, u, ocs2::PreComputation());
+  EXPECT_TRUE(lin.dfdx.col(0).isZero());
+  EXPECT_TRUE(lin.dfdx.col(3).isZero());
+  EXPECT_TRUE(lin.dfdu.leftCols(2).isZero());
+
+  // Sparsity is kept by the copy
+  std::unique_ptr<TestSparseStateInputConstraint> constraintCopy(constraint.clone());
+  const auto sparsityCopy = constraintCopy->getLinearApproximationSparsity(t, 5, 3);
+  ASSERT_EQ(sparsityCopy.stateColumns.size(), sparsity.stateColumns.size());
+  ASSERT_EQ(sparsityCopy.inputColumns.size(), sparsity.inputColumns.size());
+}
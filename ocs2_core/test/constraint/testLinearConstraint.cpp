@@ -49,6 +49,12 @@ TEST(TestLinearConstraint, testLinearStateInputConstraint) {
   EXPECT_TRUE(approx.f.isApprox(value));
   EXPECT_TRUE(approx.dfdx.isApprox(C));
   EXPECT_TRUE(approx.dfdu.isApprox(D));
+
+  ocs2::VectorFunctionLinearApproximation stacked(5, 2, 1);
+  constraint.writeLinearApproximation(t, x, u, ocs2::PreComputation(), 2, stacked);
+  EXPECT_TRUE(stacked.f.tail(3).isApprox(approx.f));
+  EXPECT_TRUE(stacked.dfdx.bottomRows(3).isApprox(approx.dfdx));
+  EXPECT_TRUE(stacked.dfdu.bottomRows(3).isApprox(approx.dfdu));
 }
 
 TEST(TestLinearConstraint, testLinearStateConstraint) {
@@ -65,4 +71,9 @@ TEST(TestLinearConstraint, testLinearStateConstraint) {
   EXPECT_TRUE(value.isApprox(C * x + e));
   EXPECT_TRUE(approx.f.isApprox(value));
   EXPECT_TRUE(approx.dfdx.isApprox(C));
+
+  ocs2::VectorFunctionLinearApproximation stacked(5, 2);
+  constraint.writeLinearApproximation(t, x, ocs2::PreComputation(), 2, stacked);
+  EXPECT_TRUE(stacked.f.tail(3).isApprox(approx.f));
+  EXPECT_TRUE(stacked.dfdx.bottomRows(3).isApprox(approx.dfdx));
 }
@@ -117,6 +117,17 @@ TEST_F(StateInputCost_TestFixture, getStateInputCostApproximation) {
   EXPECT_TRUE((cost.dfdux.array() == 0.0).all());
 }
 
+TEST_F(StateInputCost_TestFixture, accumulateStateInputCostApproximation) {
+  auto cost = expectedCostApproximation;
+  costCollection.accumulateQuadraticApproximation(t, x, u, targetTrajectories, {}, cost);
+  EXPECT_NEAR(cost.f, 2.0 * expectedCost, 1e-6);
+  EXPECT_TRUE(cost.dfdx.isApprox(2.0 * expectedCostApproximation.dfdx));
+  EXPECT_TRUE(cost.dfdu.isApprox(2.0 * expectedCostApproximation.dfdu));
+  EXPECT_TRUE(cost.dfdxx.isApprox(2.0 * expectedCostApproximation.dfdxx));
+  EXPECT_TRUE(cost.dfduu.isApprox(2.0 * expectedCostApproximation.dfduu));
+  EXPECT_TRUE((cost.dfdux.array() == 0.0).all());
+}
+
 TEST_F(StateInputCost_TestFixture, canGetCostFunction) {
   const auto& costFunction = costCollection.get("Simple quadratic cost");
 }
@@ -220,3 +231,15 @@ TEST_F(StateCost_TestFixture, testStateCostApproximation) {
   EXPECT_TRUE(cost.dfdx.isApprox(expectedCostApproximation.dfdx));
   EXPECT_TRUE(cost.dfdxx.isApprox(expectedCostApproximation.dfdxx));
 }
+
+TEST_F(StateCost_TestFixture, accumulateStateCostApproximation) {
+  auto cost = ocs2::ScalarFunctionQuadraticApproximation::Zero(STATE_DIM, INPUT_DIM);
+  costCollection.accumulateQuadraticApproximation(t, x, targetTrajectories, {}, cost);
+  EXPECT_NEAR(cost.f, expectedCost, 1e-6);
+  EXPECT_TRUE(cost.dfdx.isApprox(expectedCostApproximation.dfdx));
+  EXPECT_TRUE(cost.dfdxx.isApprox(expectedCostApproximation.dfdxx));
+  // input derivatives are not touched
+  EXPECT_TRUE(cost.dfdu.isZero());
+  EXPECT_TRUE(cost.dfduu.isZero());
+  EXPECT_TRUE(cost.dfdux.isZero());
+}
@@ -0,0 +1,4 @@
+unsigned long cppad_cg_version() {
+   return 7u;
+}
+
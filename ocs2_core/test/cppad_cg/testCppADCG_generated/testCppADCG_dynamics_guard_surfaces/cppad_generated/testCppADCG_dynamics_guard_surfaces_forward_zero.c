@@ -0,0 +1,42 @@
+#include <math.h>
+#include <stdio.h>
+
+typedef struct Array {
+    void* data;
+    unsigned long size;
+    int sparse;
+    const unsigned long* idx;
+    unsigned long nnz;
+} Array;
+
+struct LangCAtomicFun {
+    void* libModel;
+    int (*forward)(void* libModel,
+                   int atomicIndex,
+                   int q,
+                   int p,
+                   const Array tx[],
+                   Array* ty);
+    int (*reverse)(void* libModel,
+                   int atomicIndex,
+                   int p,
+                   const Array tx[],
+                   Array* px,
+                   const Array py[]);
+};
+
+void testCppADCG_dynamics_guard_surfaces_forward_zero(double const *const * in,
+                                                      double*const * out,
+                                                      struct LangCAtomicFun atomicFun) {
+   //independent variables
+   const double* x = in[0];
+
+   //dependent variables
+   double* y = out[0];
+
+   // auxiliary variables
+
+   // dependent variables without operations
+   y[0] = -1;
+}
+
@@ -0,0 +1,9 @@
+void testCppADCG_dynamics_guard_surfaces_jacobian_sparsity(unsigned long const** row,
+                                                           unsigned long const** col,
+                                                           unsigned long* nnz) {
+   static unsigned long const rows[0] = {};
+   static unsigned long const cols[0] = {};
+   *row = rows;
+   *col = cols;
+   *nnz = 0;
+}
@@ -0,0 +1,8 @@
+void cppad_cg_models(char const *const** names,
+                     int* count) {
+   static const char* const models[] = {
+      "testCppADCG_dynamics_jump_map"};
+   *names = models;
+   *count = 1;
+}
+
@@ -0,0 +1,7 @@
+void testCppADCG_dynamics_jump_map_atomic_functions(const char*** names,
+                                                    unsigned long* n) {
+   static const char* atomic[0] = {};
+   *names = atomic;
+   *n = 0;
+}
+
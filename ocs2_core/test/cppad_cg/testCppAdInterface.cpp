@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/automatic_differentiation/CppAdBuildQueue.h>
+
 #include "commonFixture.h"
 
 using namespace ocs2;
@@ -60,3 +62,116 @@ TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
+
+TEST_F(CppAdInterfaceParameterizedFixture, preallocatedOutputs) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelPreallocatedOutputs");
+
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  vector_t value(rangeDim_);
+  matrix_t jacobian(rangeDim_, variableDim_);
+  matrix_t hessian(variableDim_, variableDim_);
+  ScalarFunctionQuadraticApproximation gnApproximation(variableDim_);
+  const auto* valueData = value.data();
+  const auto* jacobianData = jacobian.data();
+  const auto* hessianData = hessian.data();
+
+  for (int i = 0; i < 3; i++) {
+    const vector_t x = vector_t::Random(variableDim_);
+    const vector_t p = vector_t::Random(parameterDim_);
+
+    adInterface.getFunctionValue(x, p, value);
+    ASSERT_TRUE(value.isApprox(adInterface.getFunctionValue(x, p)));
+
+    adInterface.getJacobian(x, p, jacobian);
+    ASSERT_TRUE(jacobian.isApprox(adInterface.getJacobian(x, p)));
+
+    adInterface.getHessian(1, x, p, hessian);
+    ASSERT_TRUE(hessian.isApprox(adInterface.getHessian(1, x, p)));
+
+    adInterface.getGaussNewtonApproximation(x, p, gnApproximation);
+    ASSERT_DOUBLE_EQ(gnApproximation.f, 0.5 * testFun(x, p).squaredNorm());
+    ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
+    ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
+  }
+
+  // Outputs of the right size are written in place
+  ASSERT_EQ(value.data(), valueData);
+  ASSERT_EQ(jacobian.data(), jacobianData);
+  ASSERT_EQ(hessian.data(), hessianData);
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, outdatedLibraryIsRecompiled) {
+  const std::string modelName = "testModelOutdatedLibrary";
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, modelName);
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+
+  // Same name, different function: the library on disk must not be reused
+  auto scaledFunImpl = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    funImpl(x, p, y);
+    y *= ad_scalar_t(2.0);
+  };
+  ocs2::CppAdInterface scaledAdInterface(scaledFunImpl, variableDim_, parameterDim_, modelName);
+  scaledAdInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_TRUE(scaledAdInterface.getFunctionValue(x, p).isApprox(2.0 * testFun(x, p)));
+
+  // Same function again: the library on disk is up to date
+  ocs2::CppAdInterface reloadedAdInterface(scaledFunImpl, variableDim_, parameterDim_, modelName);
+  reloadedAdInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_TRUE(reloadedAdInterface.getFunctionValue(x, p).isApprox(2.0 * testFun(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, buildQueue) {
+  auto scaledFunImpl = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    funImpl(x, p, y);
+    y *= ad_scalar_t(2.0);
+  };
+
+  std::unique_ptr<ocs2::CppAdInterface> copiedAdInterfacePtr;
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelBuildQueue");
+  ocs2::CppAdInterface scaledAdInterface(scaledFunImpl, variableDim_, parameterDim_, "testModelBuildQueueScaled");
+  {
+    ocs2::CppAdBuildQueue buildQueue(2);
+    adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+    scaledAdInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+    ASSERT_EQ(buildQueue.getNumJobs(), 2);
+    ASSERT_FALSE(adInterface.getJacobianSparsityPattern().empty());
+
+    // Copies of pending models are loaded on flush
+    copiedAdInterfacePtr.reset(new ocs2::CppAdInterface(adInterface));
+    ocs2::CppAdInterface temporaryCopy(scaledAdInterface);
+
+    buildQueue.flush();
+    ASSERT_EQ(buildQueue.getNumJobs(), 0);
+  }
+
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(adInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+  ASSERT_TRUE(copiedAdInterfacePtr->getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(scaledAdInterface.getFunctionValue(x, p).isApprox(2.0 * testFun(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, throwsWithoutModel) {
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelThrowsWithoutModel");
+  ASSERT_THROW(adInterface.getFunctionValue(x, p), std::runtime_error);
+
+  // A failed compilation is rethrown by flush and leaves the interface without a model
+  ocs2::CppAdInterface invalidAdInterface(funImpl, variableDim_, parameterDim_, "testModelInvalidFlags", "/tmp/ocs2",
+                                          {"--invalid-compile-flag"});
+  {
+    ocs2::CppAdBuildQueue buildQueue(1);
+    invalidAdInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+    ASSERT_THROW(invalidAdInterface.getJacobian(x, p), std::runtime_error);
+    ASSERT_ANY_THROW(buildQueue.flush());
+  }
+  ASSERT_THROW(invalidAdInterface.getFunctionValue(x, p), std::runtime_error);
+}
@@ -13,13 +13,14 @@ class DummyPreComputation final : public PreComputation {
   DummyPreComputation() = default;
   PreComputation* clone() const override { return new DummyPreComputation(*this); }
 
-  void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override { lastRequest = request; }
-
-  void requestPreJump(RequestSet request, scalar_t t, const vector_t& x) override { lastRequest = request; }
-
   static void reset() { lastRequest = RequestSet(static_cast<Request>(0)); }
 
   static RequestSet lastRequest;
+
+ private:
+  void requestImpl(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override { lastRequest = request; }
+
+  void requestPreJumpImpl(RequestSet request, scalar_t t, const vector_t& x) override { lastRequest = request; }
 };
 
 RequestSet DummyPreComputation::lastRequest = RequestSet(static_cast<Request>(0));
@@ -98,6 +99,35 @@ TEST(testSystemDynamicsPreComputation, testPreJumpCallback) {
   EXPECT_TRUE(DummyPreComputation::lastRequest.contains(Request::Approximation));
 }
 
+TEST(testSystemDynamicsPreComputation, testSharedPreComputation) {
+  DummySystem system;
+  DummyPreComputation sharedPreComputation;
+  system.setSharedPreComputation(&sharedPreComputation);
+  ASSERT_TRUE(system.hasSharedPreComputation());
+  ASSERT_EQ(&system.getPreComputation(), &sharedPreComputation);
+
+  const scalar_t t = 0.0;
+  const vector_t x = vector_t::Zero(2);
+  const vector_t u = vector_t::Zero(1);
+
+  // The dynamics is served by an earlier request at the same node
+  sharedPreComputation.cachedRequest(Request::Cost + Request::Dynamics + Request::Approximation, t, x, u);
+  const auto flowMap = system.ControlledSystemBase::computeFlowMap(t, x, u);
+  const auto flowMapApproximation = system.SystemDynamicsBase::linearApproximation(t, x, u);
+  EXPECT_EQ(sharedPreComputation.getCacheStatistics().numRequests, 3);
+  EXPECT_EQ(sharedPreComputation.getCacheStatistics().numReused, 2);
+
+  // Copies do not share the pre-computation
+  std::unique_ptr<DummySystem> systemCopy(system.clone());
+  ASSERT_FALSE(systemCopy->hasSharedPreComputation());
+  ASSERT_NE(&systemCopy->getPreComputation(), &sharedPreComputation);
+
+  // A pre-computation of another type is rejected
+  PreComputation incompatiblePreComputation;
+  ASSERT_THROW(systemCopy->setSharedPreComputation(&incompatiblePreComputation), std::invalid_argument);
+  ASSERT_FALSE(systemCopy->hasSharedPreComputation());
+}
+
 TEST(testSystemDynamicsPreComputation, testPreComputationRequestLogic) {
   constexpr RequestSet a = Request::Cost + Request::Constraint;
 
@@ -105,6 +105,14 @@ TEST(IntegrationTest, SecondOrderSystem_ODE45_OCS2) {
   testSecondOrderSystem(IntegratorType::ODE45_OCS2);
 }
 
+TEST(IntegrationTest, SecondOrderSystem_EULER_OCS2) {
+  testSecondOrderSystem(IntegratorType::EULER_OCS2);
+}
+
+TEST(IntegrationTest, SecondOrderSystem_RK4_OCS2) {
+  testSecondOrderSystem(IntegratorType::RK4_OCS2);
+}
+
 TEST(IntegrationTest, SecondOrderSystem_AdamsBashfort) {
   testSecondOrderSystem(IntegratorType::ADAMS_BASHFORTH);
 }
@@ -0,0 +1,229 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+
+#include <ocs2_core/integration/Integrator.h>
+
+using namespace ocs2;
+
+namespace {
+
+class LinearSystem final : public OdeBase {
+ public:
+  ~LinearSystem() override = default;
+  vector_t computeFlowMap(scalar_t t, const vector_t& x) override {
+    const matrix_t A = (matrix_t(2, 2) << -2, -1,  // clang-format off
+                                           1,  0).finished();  // clang-format on
+    const vector_t B = (vector_t(2) << 1, 0).finished();
+    return A * x + B * std::sin(t);
+  }
+};
+
+struct Trajectory {
+  scalar_array_t timeTrajectory;
+  vector_array_t stateTrajectory;
+  size_t numFunctionCalls;
+};
+
+template <typename Integrate>
+Trajectory integrate(IntegratorType type, Integrate&& integrate) {
+  LinearSystem sys;
+  auto integrator = newIntegrator(type);
+  Trajectory trajectory;
+  Observer observer(&trajectory.stateTrajectory, &trajectory.timeTrajectory);
+  integrate(*integrator, sys, observer);
+  trajectory.numFunctionCalls = sys.getNumFunctionCalls();
+  return trajectory;
+}
+
+void expectEqual(const Trajectory& expected, const Trajectory& actual) {
+  ASSERT_EQ(expected.timeTrajectory.size(), actual.timeTrajectory.size());
+  ASSERT_EQ(expected.stateTrajectory.size(), actual.stateTrajectory.size());
+  EXPECT_EQ(expected.numFunctionCalls, actual.numFunctionCalls);
+  for (size_t i = 0; i < expected.timeTrajectory.size(); i++) {
+    EXPECT_DOUBLE_EQ(expected.timeTrajectory[i], actual.timeTrajectory[i]) << "i: " << i;
+    EXPECT_TRUE(expected.stateTrajectory[i].isApprox(actual.stateTrajectory[i], 1e-12)) << "i: " << i;
+  }
+}
+
+/** Compares the in-house integrator with the boost odeint integrator of the same scheme */
+void compareWithBoost(IntegratorType boostType, IntegratorType ocs2Type) {
+  const vector_t x0 = (vector_t(2) << 1.0, -1.0).finished();
+  const scalar_t t0 = 0.0;
+  const scalar_t t1 = 2.05;  // not a multiple of the step size
+  const scalar_t dt = 0.1;
+
+  auto integrateConst = [&](IntegratorBase& integrator, OdeBase& sys, Observer& observer) {
+    integrator.integrateConst(sys, observer, x0, t0, t1, dt);
+  };
+  expectEqual(integrate(boostType, integrateConst), integrate(ocs2Type, integrateConst));
+
+  auto integrateAdaptive = [&](IntegratorBase& integrator, OdeBase& sys, Observer& observer) {
+    integrator.integrateAdaptive(sys, observer, x0, t0, t1, dt);
+  };
+  expectEqual(integrate(boostType, integrateAdaptive), integrate(ocs2Type, integrateAdaptive));
+
+  const scalar_array_t timeStamps{0.0, 0.05, 0.3, 0.3, 0.75, 1.0, 2.05};
+  auto integrateTimes = [&](IntegratorBase& integrator, OdeBase& sys, Observer& observer) {
+    integrator.integrateTimes(sys, observer, x0, timeStamps.begin(), timeStamps.end(), dt);
+  };
+  expectEqual(integrate(boostType, integrateTimes), integrate(ocs2Type, integrateTimes));
+}
+
+}  // namespace
+
+TEST(FixedStepIntegratorTest, compareEulerWithBoost) {
+  compareWithBoost(IntegratorType::EULER, IntegratorType::EULER_OCS2);
+}
+
+TEST(FixedStepIntegratorTest, compareRK4WithBoost) {
+  compareWithBoost(IntegratorType::RK4, IntegratorType::RK4_OCS2);
+}
+
+TEST(FixedStepIntegratorTest, reuseIntegrator) {
+  LinearSystem sys;
+  auto integrator = newIntegrator(IntegratorType::RK4_OCS2);
+  const vector_t x0 = vector_t::Ones(2);
+
+  vector_array_t stateTrajectory1;
+  Observer observer1(&stateTrajectory1);
+  integrator->integrateAdaptive(sys, observer1, x0, 0.0, 1.0, 0.01);
+
+  // a second integration starts from its own initial state
+  vector_array_t stateTrajectory2;
+  Observer observer2(&stateTrajectory2);
+  integrator->integrateAdaptive(sys, observer2, vector_t::Zero(2), 0.0, 1.0, 0.01);
+  integrator->integrateAdaptive(sys, observer2, x0, 0.0, 1.0, 0.01);
+
+  ASSERT_EQ(2 * stateTrajectory1.size(), stateTrajectory2.size());
+  EXPECT_TRUE(stateTrajectory2.front().isZero());
+  EXPECT_TRUE(stateTrajectory1.back().isApprox(stateTrajectory2.back()));
+}
+
+TEST(FixedStepIntegratorTest, maxNumSteps) {
+  LinearSystem sys;
+  auto integrator = newIntegrator(IntegratorType::RK4_OCS2);
+  Observer observer;
+  // 10 steps of 4 function calls
+  EXPECT_NO_THROW(integrator->integrateConst(sys, observer, vector_t::Ones(2), 0.0, 1.0, 0.1, 40));
+  sys.resetNumFunctionCalls();
+  EXPECT_ANY_THROW(integrator->integrateConst(sys, observer, vector_t::Ones(2), 0.0, 1.0, 0.1, 39));
+}
+
+/*
+ * Counts the heap allocations by interposing malloc. Eigen and the default operator new both allocate through malloc.
+ * Only available with glibc, which exposes the underlying allocator.
+ */
+#ifdef __GLIBC__
+namespace {
+std::atomic<bool> countAllocations{false};
+std::atomic<size_t> numAllocations{0};
+}  // namespace
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size) {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_realloc(ptr, size);
+}
+}
+
+namespace {
+
+/** A system whose flow map allocates only its returned vector */
+class DecaySystem final : public OdeBase {
+ public:
+  ~DecaySystem() override = default;
+  vector_t computeFlowMap(scalar_t t, const vector_t& x) override { return -x; }
+};
+
+/** Returns the number of heap allocations of the given function call */
+template <typename Function>
+size_t countHeapAllocations(Function&& function) {
+  numAllocations = 0;
+  countAllocations = true;
+  function();
+  countAllocations = false;
+  return numAllocations;
+}
+
+}  // namespace
+
+TEST(FixedStepIntegratorTest, allocations) {
+  const vector_t x0 = vector_t::Ones(6);
+  const scalar_array_t timeStamps{0.0, 0.05, 0.3, 0.75, 1.0};
+
+  for (const auto type : {IntegratorType::EULER_OCS2, IntegratorType::RK4_OCS2}) {
+    DecaySystem sys;
+    auto integrator = newIntegrator(type);
+    Observer observer;  // does not store the trajectory
+
+    // the first integration sizes the stage buffers
+    integrator->integrateAdaptive(sys, observer, x0, 0.0, 1.0, 0.01);
+
+    // afterwards, every flow map evaluation allocates its returned vector and nothing else allocates
+    sys.resetNumFunctionCalls();
+    const size_t constAllocations = countHeapAllocations([&]() { integrator->integrateConst(sys, observer, x0, 0.0, 1.0, 0.01); });
+    EXPECT_EQ(constAllocations, sys.getNumFunctionCalls()) << integrator_type::toString(type);
+
+    sys.resetNumFunctionCalls();
+    const size_t adaptiveAllocations = countHeapAllocations([&]() { integrator->integrateAdaptive(sys, observer, x0, 0.0, 1.05, 0.01); });
+    EXPECT_EQ(adaptiveAllocations, sys.getNumFunctionCalls()) << integrator_type::toString(type);
+
+    sys.resetNumFunctionCalls();
+    const size_t timesAllocations = countHeapAllocations(
+        [&]() { integrator->integrateTimes(sys, observer, x0, timeStamps.begin(), timeStamps.end(), 0.01); });
+    EXPECT_EQ(timesAllocations, sys.getNumFunctionCalls()) << integrator_type::toString(type);
+  }
+}
+
+#endif
@@ -99,6 +99,14 @@ class TestFixtureLoopShapingCost : LoopshapingTestConfiguration {
 
     // Difference between new evaluation and approximation should be less than tol
     EXPECT_NEAR(L_disturbance, L_quad_approximation, tol);
+
+    // Accumulating into a zero approximation gives the same result
+    preComp_->requestFinal(Request::Cost + Request::Approximation, t, x_);
+    auto L_accumulated = ScalarFunctionQuadraticApproximation::Zero(x_.rows());
+    loopshapingStateCost->accumulateQuadraticApproximation(t, x_, targetTrajectories_, *preComp_, L_accumulated);
+    EXPECT_NEAR(L_accumulated.f, L.f, tol);
+    EXPECT_TRUE(L_accumulated.dfdx.isApprox(L.dfdx));
+    EXPECT_TRUE(L_accumulated.dfdxx.isApprox(L.dfdxx));
   }
 
  private:
@@ -0,0 +1,64 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <ocs2_core/misc/BlockSparsity.h>
+
+using namespace ocs2;
+
+namespace {
+bool isEqual(const column_blocks_t& lhs, const column_blocks_t& rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                    [](const ColumnBlock& a, const ColumnBlock& b) { return a.start == b.start && a.size == b.size; });
+}
+}  // namespace
+
+TEST(testBlockSparsity, dense) {
+  EXPECT_TRUE(isEqual(block_sparsity::dense(0), {}));
+  EXPECT_TRUE(isEqual(block_sparsity::dense(4), {{0, 4}}));
+}
+
+TEST(testBlockSparsity, fromColumnIndices) {
+  const std::set<size_t> columnIndices{0, 2, 3, 4, 7, 9, 10};
+  EXPECT_TRUE(isEqual(block_sparsity::fromColumnIndices(columnIndices, 0, 11), {{0, 1}, {2, 3}, {7, 1}, {9, 2}}));
+  EXPECT_TRUE(isEqual(block_sparsity::fromColumnIndices(columnIndices, 3, 5), {{0, 2}, {4, 1}}));
+  EXPECT_TRUE(isEqual(block_sparsity::fromColumnIndices(columnIndices, 5, 2), {}));
+}
+
+TEST(testBlockSparsity, getUnion) {
+  const column_blocks_t lhs{{0, 2}, {5, 2}, {12, 1}};
+  const column_blocks_t rhs{{1, 3}, {7, 2}, {10, 1}};
+  const auto blocks = block_sparsity::getUnion(lhs, rhs);
+  EXPECT_TRUE(isEqual(blocks, {{0, 4}, {5, 4}, {10, 1}, {12, 1}}));
+  EXPECT_EQ(block_sparsity::getNumColumns(blocks), 10);
+  EXPECT_TRUE(isEqual(block_sparsity::getUnion(lhs, {}), lhs));
+}
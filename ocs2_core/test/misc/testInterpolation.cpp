@@ -132,3 +132,62 @@ TEST(testLinearInterpolation, testDifferentEigenSizes) {
   result = ocs2::LinearInterpolation::interpolate(1.1, times, data);
   EXPECT_TRUE(result.isApprox(data[1]));
 }
+
+TEST(testLinearInterpolation, testInPlaceInterpolation) {
+  using Data_T = Eigen::VectorXd;
+  std::vector<double> times = {0.0, 1.0, 1.0, 2.0};
+  std::vector<Data_T, Eigen::aligned_allocator<Data_T>> data = {Data_T::Zero(2), Data_T::Ones(2), Data_T::Constant(3, 2.0),
+                                                                Data_T::Constant(3, 3.0)};
+
+  Data_T result;
+  for (const double time : {-0.1, 0.0, 0.3, 1.0, 1.5, 2.0, 2.1}) {
+    ocs2::LinearInterpolation::interpolate(time, times, data, result);
+    const Data_T expected = ocs2::LinearInterpolation::interpolate(time, times, data);
+    EXPECT_EQ(result.size(), expected.size());
+    EXPECT_TRUE(result.isApprox(expected));
+  }
+
+  // Single data point
+  ocs2::LinearInterpolation::interpolate(0.5, {0.0}, std::vector<Data_T, Eigen::aligned_allocator<Data_T>>{Data_T::Ones(2)}, result);
+  EXPECT_TRUE(result.isApprox(Data_T::Ones(2)));
+}
+
+TEST(testLinearInterpolation, testTimeSegmentCursor) {
+  using Data_T = Eigen::VectorXd;
+  std::vector<double> times = {0.0, 1.0, 1.0, 2.0, 3.0, 3.0, 4.0};
+  std::vector<Data_T, Eigen::aligned_allocator<Data_T>> data;
+  for (const double t : times) {
+    data.push_back(Data_T::Constant(2, t));
+  }
+
+  std::vector<double> enquiries;
+  for (int k = -2; k <= 18; k++) {
+    enquiries.push_back(0.25 * k);
+  }
+
+  // Increasing, decreasing and random enquiries give the same result as the stateless lookup
+  ocs2::LinearInterpolation::TimeSegmentCursor cursor;
+  auto checkEnquiries = [&](const std::vector<double>& enquiryTimes) {
+    for (const double time : enquiryTimes) {
+      const auto expected = ocs2::LinearInterpolation::timeSegment(time, times);
+      const auto indexAlpha = cursor.timeSegment(time, times);
+      EXPECT_EQ(indexAlpha.first, expected.first) << "time: " << time;
+      EXPECT_DOUBLE_EQ(indexAlpha.second, expected.second) << "time: " << time;
+    }
+  };
+  checkEnquiries(enquiries);
+  checkEnquiries({enquiries.rbegin(), enquiries.rend()});
+  checkEnquiries({3.5, -1.0, 1.0, 0.5, 5.0, 2.5, 3.0});
+
+  // Batch lookup and interpolation
+  std::vector<ocs2::LinearInterpolation::index_alpha_t> indexAlphas;
+  ocs2::LinearInterpolation::timeSegments(enquiries, times, indexAlphas);
+  std::vector<Data_T, Eigen::aligned_allocator<Data_T>> results;
+  ocs2::LinearInterpolation::interpolate(enquiries, times, data, results);
+  ASSERT_EQ(indexAlphas.size(), enquiries.size());
+  ASSERT_EQ(results.size(), enquiries.size());
+  for (size_t i = 0; i < enquiries.size(); i++) {
+    EXPECT_EQ(indexAlphas[i], ocs2::LinearInterpolation::timeSegment(enquiries[i], times));
+    EXPECT_TRUE(results[i].isApprox(ocs2::LinearInterpolation::interpolate(enquiries[i], times, data)));
+  }
+}
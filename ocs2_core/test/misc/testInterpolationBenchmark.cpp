@@ -0,0 +1,96 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+using namespace ocs2;
+
+/**
+ * Compares the stateless lookup, the cursor and the batch interpolation for monotone enquiries, as done by a controller in a rollout
+ * or by the cost terms at the nodes of a horizon.
+ */
+TEST(testInterpolationBenchmark, monotoneEnquiries) {
+  constexpr size_t numRepeats = 100;
+  constexpr int dataSize = 6;
+
+  for (int numTimes : {100, 1000, 10000}) {
+    scalar_array_t timeArray(numTimes);
+    vector_array_t dataArray(numTimes);
+    for (int k = 0; k < numTimes; k++) {
+      timeArray[k] = 0.01 * k;
+      dataArray[k] = vector_t::Random(dataSize);
+    }
+
+    // Four enquiries per interval
+    scalar_array_t enquiries;
+    for (int k = 0; k < 4 * numTimes; k++) {
+      enquiries.push_back(0.0025 * k);
+    }
+
+    benchmark::RepeatedTimer lookupTimer;
+    benchmark::RepeatedTimer cursorTimer;
+    benchmark::RepeatedTimer batchTimer;
+    vector_array_t lookupResults(enquiries.size());
+    vector_array_t cursorResults(enquiries.size());
+    vector_array_t batchResults;
+    for (size_t n = 0; n < numRepeats; n++) {
+      lookupTimer.startTimer();
+      for (size_t i = 0; i < enquiries.size(); i++) {
+        LinearInterpolation::interpolate(enquiries[i], timeArray, dataArray, lookupResults[i]);
+      }
+      lookupTimer.endTimer();
+
+      cursorTimer.startTimer();
+      LinearInterpolation::TimeSegmentCursor cursor;
+      for (size_t i = 0; i < enquiries.size(); i++) {
+        LinearInterpolation::interpolate(cursor.timeSegment(enquiries[i], timeArray), dataArray, cursorResults[i]);
+      }
+      cursorTimer.endTimer();
+
+      batchTimer.startTimer();
+      LinearInterpolation::interpolate(enquiries, timeArray, dataArray, batchResults);
+      batchTimer.endTimer();
+    }
+
+    for (size_t i = 0; i < enquiries.size(); i++) {
+      ASSERT_TRUE(cursorResults[i].isApprox(lookupResults[i])) << "i: " << i;
+      ASSERT_TRUE(batchResults[i].isApprox(lookupResults[i])) << "i: " << i;
+    }
+
+    std::cerr << "[InterpolationBenchmark] time array size = " << numTimes << ", enquiries = " << enquiries.size() << "\n"
+              << "\tbinary search    [ms]: " << lookupTimer.getAverageInMilliseconds() << "\n"
+              << "\tcursor           [ms]: " << cursorTimer.getAverageInMilliseconds() << "\n"
+              << "\tbatch            [ms]: " << batchTimer.getAverageInMilliseconds() << "\n";
+  }
+}
@@ -108,6 +108,74 @@ TEST(test_projection, testProjectionLU) {
   ASSERT_TRUE((pseudoInverse.transpose() * constraint.f).isApprox(-projection.f));
 }
 
+TEST(test_projection, testSparseProjection) {
+  constexpr int nx = 30;
+  constexpr int nu = 20;
+  constexpr int nc = 10;
+  const ocs2::column_blocks_t stateColumns{{2, 5}, {12, 1}, {20, 8}};
+  const auto constraint = [&]() {
+    ocs2::VectorFunctionLinearApproximation approx;
+    approx.dfdx = ocs2::matrix_t::Zero(nc, nx);
+    for (const auto& block : stateColumns) {
+      approx.dfdx.middleCols(block.start, block.size).setRandom();
+    }
+    approx.dfdu = ocs2::matrix_t::Random(nc, nu);
+    approx.f = ocs2::vector_t::Random(nc);
+    return approx;
+  }();
+
+  const auto qrProjection = ocs2::LinearAlgebra::qrConstraintProjection(constraint).first;
+  const auto qrSparseProjection = ocs2::LinearAlgebra::qrConstraintProjection(constraint, &stateColumns).first;
+  ASSERT_TRUE(qrSparseProjection.dfdx.isApprox(qrProjection.dfdx));
+  ASSERT_TRUE(qrSparseProjection.dfdu.isApprox(qrProjection.dfdu));
+  ASSERT_TRUE(qrSparseProjection.f.isApprox(qrProjection.f));
+
+  const auto luProjection = ocs2::LinearAlgebra::luConstraintProjection(constraint).first;
+  const auto luSparseProjection = ocs2::LinearAlgebra::luConstraintProjection(constraint, false, &stateColumns).first;
+  ASSERT_TRUE(luSparseProjection.dfdx.isApprox(luProjection.dfdx));
+  ASSERT_TRUE(luSparseProjection.dfdu.isApprox(luProjection.dfdu));
+  ASSERT_TRUE(luSparseProjection.f.isApprox(luProjection.f));
+}
+
+TEST(test_projection, testInPlaceProjection) {
+  constexpr int nx = 30;
+  constexpr int nu = 20;
+  auto getConstraint = [&](int nc) {
+    ocs2::VectorFunctionLinearApproximation approx;
+    approx.dfdx = ocs2::matrix_t::Random(nc, nx);
+    approx.dfdu = ocs2::matrix_t::Random(nc, nu);
+    approx.f = ocs2::vector_t::Random(nc);
+    return approx;
+  };
+
+  // The factorizations and the results are reused for constraints of different sizes.
+  ocs2::LinearAlgebra::ConstraintProjectionWorkspace workspace;
+  ocs2::VectorFunctionLinearApproximation qrProjection, luProjection;
+  ocs2::matrix_t qrPseudoInverse, luPseudoInverse;
+  for (const int nc : {10, 5, 10}) {
+    const auto constraint = getConstraint(nc);
+
+    ocs2::LinearAlgebra::qrConstraintProjection(constraint, workspace, qrProjection, qrPseudoInverse);
+    ASSERT_EQ(qrProjection.dfdu.cols(), nu - nc);
+    ASSERT_TRUE((constraint.dfdu * qrProjection.dfdu).isZero());
+    ASSERT_TRUE((constraint.dfdx + constraint.dfdu * qrProjection.dfdx).isZero());
+    ASSERT_TRUE((constraint.f + constraint.dfdu * qrProjection.f).isZero());
+    ASSERT_TRUE((qrPseudoInverse * constraint.dfdu.transpose()).isIdentity());
+
+    ocs2::LinearAlgebra::luConstraintProjection(constraint, workspace, luProjection, &luPseudoInverse);
+    ASSERT_EQ(luProjection.dfdu.cols(), nu - nc);
+    ASSERT_TRUE((constraint.dfdu * luProjection.dfdu).isZero());
+    ASSERT_TRUE((constraint.dfdx + constraint.dfdu * luProjection.dfdx).isZero());
+    ASSERT_TRUE((constraint.f + constraint.dfdu * luProjection.f).isZero());
+    ASSERT_TRUE((luPseudoInverse * constraint.dfdu.transpose()).isIdentity());
+
+    // The solves with the workspace memory match the ones of Eigen
+    ASSERT_TRUE(luProjection.dfdu.isApprox(workspace.lu.kernel()));
+    ASSERT_TRUE(luProjection.dfdx.isApprox(-workspace.lu.solve(constraint.dfdx)));
+    ASSERT_TRUE(luProjection.f.isApprox(-workspace.lu.solve(constraint.f)));
+  }
+}
+
 TEST(LLTofInverse, checkAgainstFullInverse) {
   constexpr size_t n = 10;        // matrix size
   constexpr ocs2::scalar_t tol = 1e-9;  // Coefficient-wise tolerance
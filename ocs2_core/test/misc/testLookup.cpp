@@ -74,6 +74,29 @@ TEST(testLookup, findIndexInTimeArray_precision_highNumbers) {
   ASSERT_EQ(findIndexInTimeArray(timeArray, tQueryPlus), 1);
 }
 
+TEST(testLookup, findIndexInTimeArray_hint) {
+  // Repeated times, and enquiries before, at and after every time
+  std::vector<double> timeArray{-1.0, 0.0, 1.0, 1.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 8.0, 9.0};
+  std::vector<double> enquiries{-2.0};
+  for (const auto t : timeArray) {
+    enquiries.push_back(t - 0.5);
+    enquiries.push_back(t);
+  }
+  enquiries.push_back(10.0);
+
+  const int size = static_cast<int>(timeArray.size());
+  for (const auto time : enquiries) {
+    for (int hint = -2; hint <= size + 2; hint++) {
+      ASSERT_EQ(findIndexInTimeArray(timeArray, time, hint), findIndexInTimeArray(timeArray, time)) << "time: " << time << " hint: " << hint;
+    }
+  }
+
+  // empty time
+  std::vector<double> timeArrayEmpty;
+  ASSERT_EQ(findIndexInTimeArray(timeArrayEmpty, 1.0, 0), 0);
+  ASSERT_EQ(findIndexInTimeArray(timeArrayEmpty, 1.0, 3), 0);
+}
+
 TEST(testLookup, findIntervalInTimeArray) {
   // Normal case
   std::vector<double> timeArray{-1.0, 2.0, 3.0};
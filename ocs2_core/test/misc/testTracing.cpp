@@ -0,0 +1,193 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include <ocs2_core/misc/Tracing.h>
+
+using namespace ocs2;
+
+namespace {
+const tracing::TraceEvent* findEvent(const std::vector<tracing::TraceEvent>& events, const std::string& name) {
+  for (const auto& event : events) {
+    if (name == event.name) {
+      return &event;
+    }
+  }
+  return nullptr;
+}
+}  // unnamed namespace
+
+TEST(testTracing, nestedZones) {
+  tracing::collectEvents();  // discard events of previous tests
+  {
+    tracing::ScopedZone outer("outer");
+    for (int i = 0; i < 2; i++) {
+      tracing::ScopedZone inner("inner");
+      tracing::beginZone("innermost");
+      tracing::endZone();
+    }
+  }
+  const auto events = tracing::collectEvents();
+  ASSERT_EQ(events.size(), 5);
+
+  // events are ordered by their end time
+  EXPECT_STREQ(events.front().name, "innermost");
+  EXPECT_STREQ(events.back().name, "outer");
+
+  const auto* outer = findEvent(events, "outer");
+  const auto* inner = findEvent(events, "inner");
+  const auto* innermost = findEvent(events, "innermost");
+  EXPECT_EQ(outer->parent, nullptr);
+  EXPECT_EQ(outer->depth, 0);
+  EXPECT_STREQ(inner->parent, "outer");
+  EXPECT_EQ(inner->depth, 1);
+  EXPECT_STREQ(innermost->parent, "inner");
+  EXPECT_EQ(innermost->depth, 2);
+  EXPECT_GE(inner->startTimeInNanoseconds, outer->startTimeInNanoseconds);
+  EXPECT_LE(inner->startTimeInNanoseconds + inner->durationInNanoseconds,
+            outer->startTimeInNanoseconds + outer->durationInNanoseconds);
+
+  const auto statistics = tracing::computeStatistics(events);
+  ASSERT_EQ(statistics.size(), 3);
+  EXPECT_EQ(statistics[0].name, "outer");
+  EXPECT_EQ(statistics[0].numCalls, 1);
+  EXPECT_EQ(statistics[1].name, "inner");
+  EXPECT_EQ(statistics[1].parent, "outer");
+  EXPECT_EQ(statistics[1].numCalls, 2);
+  EXPECT_EQ(statistics[2].name, "innermost");
+  EXPECT_EQ(statistics[2].depth, 2);
+
+  // a zone is never ended twice
+  tracing::endZone();
+  EXPECT_TRUE(tracing::collectEvents().empty());
+}
+
+TEST(testTracing, runtimeSwitch) {
+  tracing::collectEvents();
+  tracing::setEnabled(false);
+  {
+    tracing::ScopedZone disabled("disabled");
+    tracing::setEnabled(true);
+    tracing::ScopedZone enabled("enabled");
+  }
+  const auto events = tracing::collectEvents();
+  ASSERT_EQ(events.size(), 1);
+  EXPECT_STREQ(events.front().name, "enabled");
+  EXPECT_EQ(events.front().parent, nullptr);
+  EXPECT_EQ(events.front().depth, 0);
+}
+
+TEST(testTracing, multipleThreads) {
+  constexpr int numThreads = 4;
+  constexpr int numZones = 1000;
+  tracing::collectEvents();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; i++) {
+    threads.emplace_back([] {
+      for (int j = 0; j < numZones; j++) {
+        tracing::ScopedZone zone("threadZone");
+      }
+    });
+  }
+
+  // collect while the threads are recording
+  std::vector<tracing::TraceEvent> events;
+  while (events.size() < numThreads * numZones && tracing::getNumDroppedEvents() == 0) {
+    const auto newEvents = tracing::collectEvents();
+    events.insert(events.end(), newEvents.begin(), newEvents.end());
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(events.size(), numThreads * numZones);
+  std::set<uint32_t> threadIds;
+  for (const auto& event : events) {
+    EXPECT_STREQ(event.name, "threadZone");
+    threadIds.insert(event.threadId);
+  }
+  EXPECT_EQ(threadIds.size(), numThreads);
+}
+
+TEST(testTracing, fullBuffer) {
+  tracing::collectEvents();
+  const auto numDroppedBefore = tracing::getNumDroppedEvents();
+
+  // the capacity only applies to threads that have not recorded yet
+  tracing::setThreadBufferCapacity(3);
+  std::thread([] {
+    for (int i = 0; i < 10; i++) {
+      tracing::ScopedZone zone("bufferedZone");
+    }
+  }).join();
+  tracing::setThreadBufferCapacity(size_t(1) << 14);
+
+  EXPECT_EQ(tracing::collectEvents().size(), 4);  // rounded up to a power of two
+  EXPECT_EQ(tracing::getNumDroppedEvents() - numDroppedBefore, 6);
+}
+
+TEST(testTracing, statistics) {
+  std::vector<tracing::TraceEvent> events(100);
+  for (int i = 0; i < events.size(); i++) {
+    events[i].name = "zone";
+    events[i].durationInNanoseconds = (i + 1) * 1000000;
+  }
+  const auto statistics = tracing::computeStatistics(events);
+  ASSERT_EQ(statistics.size(), 1);
+  EXPECT_EQ(statistics[0].numCalls, 100);
+  EXPECT_DOUBLE_EQ(statistics[0].totalInMilliseconds, 5050.0);
+  EXPECT_DOUBLE_EQ(statistics[0].averageInMilliseconds, 50.5);
+  EXPECT_DOUBLE_EQ(statistics[0].maxInMilliseconds, 100.0);
+  EXPECT_DOUBLE_EQ(statistics[0].p50InMilliseconds, 50.0);
+  EXPECT_DOUBLE_EQ(statistics[0].p90InMilliseconds, 90.0);
+  EXPECT_DOUBLE_EQ(statistics[0].p99InMilliseconds, 99.0);
+}
+
+TEST(testTracing, chromeTrace) {
+  std::vector<tracing::TraceEvent> events(2);
+  events[0].name = "first \"zone\"";
+  events[0].startTimeInNanoseconds = 5000;
+  events[0].durationInNanoseconds = 2000;
+  events[1].name = "second";
+  events[1].startTimeInNanoseconds = 6000;
+  events[1].durationInNanoseconds = 500;
+  events[1].threadId = 1;
+
+  std::stringstream stream;
+  tracing::writeChromeTrace(stream, events);
+  const auto trace = stream.str();
+  EXPECT_NE(trace.find(R"({"name":"first \"zone\"","cat":"ocs2","ph":"X","pid":0,"tid":0,"ts":0.000,"dur":2.000})"), std::string::npos);
+  EXPECT_NE(trace.find(R"({"name":"second","cat":"ocs2","ph":"X","pid":0,"tid":1,"ts":1.000,"dur":0.500})"), std::string::npos);
+}
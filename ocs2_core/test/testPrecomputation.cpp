@@ -74,3 +74,90 @@ TEST(testPrecomputation, containtsAnyAll) {
   constexpr auto request3 = Request::Constraint + Request::Cost + Request::Approximation;
   ASSERT_TRUE(request3.containsAll(request2));
 }
+
+namespace {
+class CountingPreComputation final : public ocs2::PreComputation {
+ public:
+  CountingPreComputation() = default;
+  CountingPreComputation* clone() const override { return new CountingPreComputation(*this); }
+
+  size_t numRequests = 0;
+
+ private:
+  void requestImpl(ocs2::RequestSet request, ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u) override { numRequests++; }
+  void requestPreJumpImpl(ocs2::RequestSet request, ocs2::scalar_t t, const ocs2::vector_t& x) override { numRequests++; }
+  void requestFinalImpl(ocs2::RequestSet request, ocs2::scalar_t t, const ocs2::vector_t& x) override { numRequests++; }
+};
+}  // unnamed namespace
+
+TEST(testPrecomputation, cachedRequest) {
+  CountingPreComputation preComputation;
+  const ocs2::vector_t x = ocs2::vector_t::Ones(3);
+  const ocs2::vector_t u = ocs2::vector_t::Ones(2);
+
+  // Same node, same request
+  preComputation.cachedRequest(Request::Dynamics + Request::Cost, 0.0, x, u);
+  preComputation.cachedRequest(Request::Dynamics, 0.0, x, u);
+  preComputation.cachedRequest(Request::Cost, 0.0, x, u);
+  ASSERT_EQ(preComputation.numRequests, 1);
+
+  // Same node, new item
+  preComputation.cachedRequest(Request::Constraint, 0.0, x, u);
+  ASSERT_EQ(preComputation.numRequests, 2);
+  preComputation.cachedRequest(Request::Cost + Request::Constraint, 0.0, x, u);
+  ASSERT_EQ(preComputation.numRequests, 2);
+
+  // Approximation is not served by values, but values are served by the approximation
+  preComputation.cachedRequest(Request::Cost + Request::Approximation, 0.0, x, u);
+  ASSERT_EQ(preComputation.numRequests, 3);
+  preComputation.cachedRequest(Request::Cost, 0.0, x, u);
+  preComputation.cachedRequest(Request::Cost + Request::Approximation, 0.0, x, u);
+  ASSERT_EQ(preComputation.numRequests, 3);
+
+  // Different time, state or input
+  preComputation.cachedRequest(Request::Cost, 0.1, x, u);
+  ASSERT_EQ(preComputation.numRequests, 4);
+  preComputation.cachedRequest(Request::Cost, 0.1, 2.0 * x, u);
+  ASSERT_EQ(preComputation.numRequests, 5);
+  preComputation.cachedRequest(Request::Cost, 0.1, 2.0 * x, 2.0 * u);
+  ASSERT_EQ(preComputation.numRequests, 6);
+
+  // Invalidation
+  preComputation.invalidateCache();
+  preComputation.cachedRequest(Request::Cost, 0.1, 2.0 * x, 2.0 * u);
+  ASSERT_EQ(preComputation.numRequests, 7);
+
+  // A direct request may have overwritten the computation and invalidates the cache
+  preComputation.request(Request::Cost, 0.2, x, u);
+  ASSERT_EQ(preComputation.numRequests, 8);
+  preComputation.cachedRequest(Request::Cost, 0.1, 2.0 * x, 2.0 * u);
+  ASSERT_EQ(preComputation.numRequests, 9);
+  preComputation.requestFinal(Request::Cost, 0.2, x);
+  preComputation.cachedRequest(Request::Cost, 0.1, 2.0 * x, 2.0 * u);
+  ASSERT_EQ(preComputation.numRequests, 11);
+
+  const auto& statistics = preComputation.getCacheStatistics();
+  ASSERT_EQ(statistics.numRequests, 14);
+  ASSERT_EQ(statistics.numReused, 5);
+  preComputation.resetCacheStatistics();
+  ASSERT_EQ(preComputation.getCacheStatistics().numRequests, 0);
+  ASSERT_EQ(preComputation.getCacheStatistics().numReused, 0);
+}
+
+TEST(testPrecomputation, cachedRequestNodeKind) {
+  CountingPreComputation preComputation;
+  const ocs2::vector_t x = ocs2::vector_t::Ones(3);
+  const ocs2::vector_t u = ocs2::vector_t::Ones(2);
+
+  preComputation.cachedRequest(Request::Cost, 1.0, x, u);
+  preComputation.cachedRequestPreJump(Request::Cost, 1.0, x);
+  preComputation.cachedRequestFinal(Request::Cost, 1.0, x);
+  ASSERT_EQ(preComputation.numRequests, 3);
+
+  preComputation.cachedRequestFinal(Request::Cost, 1.0, x);
+  ASSERT_EQ(preComputation.numRequests, 3);
+  preComputation.cachedRequestPreJump(Request::Cost, 1.0, x);
+  ASSERT_EQ(preComputation.numRequests, 4);
+  preComputation.cachedRequestPreJump(Request::Cost, 1.0, x);
+  ASSERT_EQ(preComputation.numRequests, 4);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <ocs2_core/thread_support/SpinBarrier.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace ocs2;
+
+namespace {
+/** Lets numThreads threads pass the barrier numPhases times and checks that no thread runs ahead of the others. */
+void checkPhases(size_t numThreads, size_t numSpins, int numPhases) {
+  SpinBarrier barrier(numThreads, numSpins);
+
+  std::atomic_int numArrived{0};
+  int numCompletions = 0;
+  std::atomic_bool isSynchronized{true};
+
+  auto task = [&]() {
+    for (int phase = 0; phase < numPhases; ++phase) {
+      ++numArrived;
+      barrier.arriveAndWait([&]() {
+        // all threads have arrived and none of them has left yet
+        if (numArrived.load() != static_cast<int>(numThreads) * (phase + 1)) {
+          isSynchronized = false;
+        }
+        ++numCompletions;
+      });
+      // the completion of this phase is visible to every thread
+      if (numCompletions != phase + 1) {
+        isSynchronized = false;
+      }
+      barrier.arriveAndWait();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < numThreads; ++i) {
+    threads.emplace_back(task);
+  }
+  task();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_TRUE(isSynchronized);
+  EXPECT_EQ(numCompletions, numPhases);
+  EXPECT_EQ(numArrived.load(), static_cast<int>(numThreads) * numPhases);
+}
+}  // anonymous namespace
+
+TEST(testSpinBarrier, singleThread) {
+  checkPhases(1, 0, 1000);
+}
+
+TEST(testSpinBarrier, spinning) {
+  // few phases, pure spinning is slow on machines with less cores than threads
+  checkPhases(4, std::numeric_limits<size_t>::max(), 20);
+}
+
+TEST(testSpinBarrier, parking) {
+  checkPhases(4, 0, 1000);
+}
+
+TEST(testSpinBarrier, spinningThenParking) {
+  checkPhases(4, 100, 1000);
+}
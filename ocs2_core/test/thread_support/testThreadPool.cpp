@@ -1,5 +1,11 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_core/thread_support/SpinBarrier.h>
 
 using namespace ocs2;
 
@@ -121,3 +127,207 @@ TEST(testThreadPool, testMoveOnlyTask) {
 
   EXPECT_EQ(result.get(), 3.14);
 }
+
+TEST(testThreadPool, testParallelFor) {
+  ThreadPool pool(3);
+  constexpr int N = 1000;
+  std::vector<std::atomic_int> visits(N);
+  for (auto& v : visits) {
+    v = 0;
+  }
+  std::atomic_bool validWorkerIndex{true};
+
+  for (int grain : {1, 7, 2 * N}) {
+    pool.parallelFor(0, N, grain, [&](int workerIndex, int i) {
+      if (workerIndex < 0 || workerIndex > static_cast<int>(pool.numThreads())) {
+        validWorkerIndex = false;
+      }
+      visits[i]++;
+    });
+  }
+
+  EXPECT_TRUE(validWorkerIndex);
+  for (const auto& v : visits) {
+    EXPECT_EQ(v, 3);
+  }
+}
+
+TEST(testThreadPool, testParallelForNoThreads) {
+  ThreadPool pool(0);
+  int sum = 0;  // single threaded, no synchronization needed
+
+  pool.parallelFor(5, 15, 3, [&](int workerIndex, int i) {
+    EXPECT_EQ(workerIndex, 0);
+    sum += i;
+  });
+
+  EXPECT_EQ(sum, 95);
+}
+
+TEST(testThreadPool, testParallelForPropagateException) {
+  ThreadPool pool(2);
+  std::atomic_int counter{0};
+
+  auto task = [&](int, int i) {
+    counter++;
+    if (i == 10) {
+      throw std::runtime_error("exception");
+    }
+  };
+  EXPECT_THROW(pool.parallelFor(0, 100, 1, task), std::runtime_error);
+  EXPECT_LE(counter, 100);
+
+  // The pool is still usable afterwards
+  counter = 0;
+  pool.parallelFor(0, 100, 1, [&](int, int) { counter++; });
+  EXPECT_EQ(counter, 100);
+}
+
+TEST(testThreadPool, testNestedParallelFor) {
+  ThreadPool pool(2);
+  std::atomic_int counter{0};
+
+  pool.parallelFor(0, 10, 1, [&](int, int) { pool.parallelFor(0, 10, 1, [&](int, int) { counter++; }); });
+
+  EXPECT_EQ(counter, 100);
+}
+
+TEST(testThreadPool, testNestedParallelForOnCallingThread) {
+  ThreadPool pool(3);
+  std::atomic_int counter{0};
+  std::atomic_bool sameThread{true};
+
+  // The outer chunks outlast the work of the calling thread, such that the helpers run their nested calls after the outer job has
+  // been withdrawn from the pool.
+  for (int repetition = 0; repetition < 50; ++repetition) {
+    pool.parallelFor(0, 8, 1, [&](int outerWorkerIndex, int) {
+      const auto outerThreadId = std::this_thread::get_id();
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      pool.parallelFor(0, 10, 1, [&](int innerWorkerIndex, int) {
+        if (innerWorkerIndex != outerWorkerIndex || std::this_thread::get_id() != outerThreadId) {
+          sameThread = false;
+        }
+        counter++;
+      });
+    });
+  }
+
+  EXPECT_TRUE(sameThread);
+  EXPECT_EQ(counter, 50 * 8 * 10);
+}
+
+TEST(testThreadPool, testTasksFromWorkers) {
+  ThreadPool pool(2);
+  std::atomic_int counter{0};
+
+  // Tasks submitted from within a worker are pushed into its own deque and can be stolen by the other worker.
+  auto outer = pool.run([&](int) {
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 50; ++i) {
+      futures.push_back(pool.run([&](int) { counter++; }));
+    }
+    for (auto& f : futures) {
+      f.wait();
+    }
+  });
+  outer.get();
+
+  EXPECT_EQ(counter, 50);
+}
+
+TEST(testThreadPool, testRunParallelMoreTasksThanThreads) {
+  ThreadPool pool(2);
+  std::atomic_int counter{0};
+  std::atomic_bool validWorkerIndex{true};
+
+  pool.runParallel(
+      [&](int workerIndex) {
+        if (workerIndex < 0 || workerIndex > static_cast<int>(pool.numThreads())) {
+          validWorkerIndex = false;
+        }
+        counter++;
+      },
+      10);
+
+  EXPECT_TRUE(validWorkerIndex);
+  EXPECT_EQ(counter, 10);
+}
+
+TEST(testThreadPool, testRunConcurrently) {
+  constexpr int numThreads = 3;
+  ThreadPool pool(numThreads);
+
+  for (int repetition = 0; repetition < 20; ++repetition) {
+    // The instances only pass the barrier if all of them run at the same time.
+    SpinBarrier barrier(numThreads + 1);
+    std::vector<std::atomic_int> visits(numThreads + 1);
+    for (auto& v : visits) {
+      v = 0;
+    }
+
+    pool.runConcurrently(
+        [&](int workerIndex) {
+          visits[workerIndex]++;
+          barrier.arriveAndWait();
+          barrier.arriveAndWait();
+        },
+        numThreads + 1);
+
+    for (const auto& v : visits) {
+      EXPECT_EQ(v, 1);
+    }
+  }
+}
+
+TEST(testThreadPool, testRunConcurrentlyPropagateException) {
+  ThreadPool pool(2);
+
+  auto task = [](int workerIndex) {
+    if (workerIndex == 0) {
+      throw std::runtime_error("exception");
+    }
+  };
+  EXPECT_THROW(pool.runConcurrently(task, 3), std::runtime_error);
+
+  // The pool is still usable afterwards
+  std::atomic_int counter{0};
+  pool.runConcurrently([&](int) { counter++; }, 3);
+  EXPECT_EQ(counter, 3);
+}
+
+TEST(testThreadPool, testRunConcurrentlyFailsLoudly) {
+  ThreadPool pool(2);
+  std::atomic_int counter{0};
+  auto task = [&](int) { counter++; };
+
+  // More instances than threads
+  EXPECT_FALSE(pool.tryRunConcurrently(task, 4));
+  EXPECT_THROW(pool.runConcurrently(task, 4), std::runtime_error);
+
+  // Nested call from a pool worker
+  auto nested = pool.run([&](int) { return pool.tryRunConcurrently(task, 2); });
+  EXPECT_FALSE(nested.get());
+
+  // All workers are busy
+  std::atomic_int numBusy{0};
+  std::atomic_bool release{false};
+  auto busyTask = [&](int) {
+    numBusy++;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  };
+  auto busy = pool.run(busyTask);
+  auto busyOther = pool.run(busyTask);
+  while (numBusy != 2) {
+    std::this_thread::yield();
+  }
+  EXPECT_FALSE(pool.tryRunConcurrently(task, 3, std::chrono::milliseconds(10)));
+  release = true;
+  busy.get();
+  busyOther.get();
+
+  EXPECT_EQ(counter, 0);
+  EXPECT_TRUE(pool.tryRunConcurrently(task, 3));
+  EXPECT_EQ(counter, 3);
+}
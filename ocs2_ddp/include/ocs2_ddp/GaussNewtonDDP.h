@@ -394,12 +394,12 @@ class GaussNewtonDDP : public SolverBase {
   scalar_t avgTimeStepBP_ = 0.0;
 
   // benchmarking
-  benchmark::RepeatedTimer initializationTimer_;
-  benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
-  benchmark::RepeatedTimer backwardPassTimer_;
-  benchmark::RepeatedTimer computeControllerTimer_;
-  benchmark::RepeatedTimer searchStrategyTimer_;
-  benchmark::RepeatedTimer totalDualSolutionTimer_;
+  benchmark::RepeatedTimer initializationTimer_{"GaussNewtonDDP::initialization"};
+  benchmark::RepeatedTimer linearQuadraticApproximationTimer_{"GaussNewtonDDP::linearQuadraticApproximation"};
+  benchmark::RepeatedTimer backwardPassTimer_{"GaussNewtonDDP::backwardPass"};
+  benchmark::RepeatedTimer computeControllerTimer_{"GaussNewtonDDP::computeController"};
+  benchmark::RepeatedTimer searchStrategyTimer_{"GaussNewtonDDP::searchStrategy"};
+  benchmark::RepeatedTimer totalDualSolutionTimer_{"GaussNewtonDDP::totalDualSolution"};
 };
 
 }  // namespace ocs2
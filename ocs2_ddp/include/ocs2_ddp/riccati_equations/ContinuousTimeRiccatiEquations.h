@@ -38,6 +38,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/model_data/ModelData.h>
 
+#include "ocs2_ddp/riccati_equations/ContinuousTimeRiccatiKernel.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModification.h"
 
 namespace ocs2 {
@@ -111,8 +112,10 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
    * @param [in] reducedFormRiccati: The reduced form of the Riccati equation is yield by assuming that Hessein of
    * the Hamiltonian is positive definite. In this case, the computation of Riccati equation is more efficient.
    * @param [in] isRiskSensitive: Neither the risk sensitive variant is used or not.
+   * @param [in] useFixedSizeKernels: Use the fixed-size kernel registered for the dimensions of the data, if any, see
+   * registerContinuousTimeRiccatiKernel(). The risk sensitive variant always uses the dynamic-size implementation.
    */
-  explicit ContinuousTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive = false);
+  explicit ContinuousTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive = false, bool useFixedSizeKernels = true);
 
   /**
    * Default destructor.
@@ -226,9 +229,18 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
   void computeFlowMapILEG(std::pair<int, scalar_t> indexAlpha, const matrix_t& Sm, const vector_t& Sv, const scalar_t& s,
                           ContinuousTimeRiccatiData& creCache, matrix_t& dSm, vector_t& dSv, scalar_t& ds) const;
 
+  /**
+   * Gets the fixed-size kernel for the dimensions of the data at the interpolation interval.
+   *
+   * @param [in] indexAlpha: The index and interpolation coefficient (alpha) pair.
+   * @return The kernel or nullptr if the dynamic-size implementation should be used.
+   */
+  ContinuousTimeRiccatiKernel getFixedSizeKernel(std::pair<int, scalar_t> indexAlpha) const;
+
  private:
   bool reducedFormRiccati_;
   bool isRiskSensitive_;
+  bool useFixedSizeKernels_;
   scalar_t riskSensitiveCoeff_ = 0.0;
 
   // array pointers
@@ -237,6 +249,11 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
   const std::vector<ModelData>* modelDataEventTimesPtr_ = nullptr;
   const std::vector<riccati_modification::Data>* riccatiModificationPtr_ = nullptr;
   scalar_array_t eventTimes_;
+  // Lookup hint for the time stamps, the backward integration queries them in decreasing time
+  LinearInterpolation::TimeSegmentCursor timeSegmentCursor_;
+
+  // Registered kernels for the (projected) input dimensions of the data, as pairs of input dimension and kernel
+  std::vector<std::pair<int, ContinuousTimeRiccatiKernel>> fixedSizeKernels_;
 
   ContinuousTimeRiccatiData continuousTimeRiccatiData_;
 };
@@ -0,0 +1,100 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/ModelData.h>
+#include <ocs2_core/model_data/ModelDataLinearInterpolation.h>
+
+#include "ocs2_ddp/riccati_equations/RiccatiModification.h"
+#include "ocs2_ddp/riccati_equations/RiccatiModificationInterpolation.h"
+
+namespace ocs2 {
+
+/**
+ * A kernel of the continuous-time Riccati flow map for given state and (projected) input dimensions. It computes the time derivative of
+ * the flattened Riccati coefficients, see ContinuousTimeRiccatiEquations::convert2Vector(), from the interpolated model data.
+ *
+ * @param [in] indexAlpha: The index and interpolation coefficient (alpha) pair.
+ * @param [in] projectedModelData: The projected model data trajectory.
+ * @param [in] riccatiModification: The RiccatiModification trajectory.
+ * @param [in] reducedFormRiccati: Whether the reduced form of the Riccati equation is used.
+ * @param [in] allSs: A flattened vector constructed by concatenating Sm, Sv and s.
+ * @param [out] dallSs: The flattened time derivative of allSs.
+ */
+using ContinuousTimeRiccatiKernel = void (*)(std::pair<int, scalar_t> indexAlpha, const std::vector<ModelData>& projectedModelData,
+                                             const std::vector<riccati_modification::Data>& riccatiModification, bool reducedFormRiccati,
+                                             const vector_t& allSs, vector_t& dallSs);
+
+/**
+ * Riccati flow map kernel with compile-time fixed dimensions. All intermediate matrices are fixed-size Eigen types on the stack, such that
+ * the evaluation does not allocate and the products are unrolled and vectorized. The model data of the interpolation interval must have
+ * the given dimensions. The result is identical to ContinuousTimeRiccatiEquations::computeFlowMap() without risk sensitivity.
+ *
+ * @tparam STATE_DIM: Dimension of the state space.
+ * @tparam INPUT_DIM: Dimension of the projected input space.
+ */
+template <int STATE_DIM, int INPUT_DIM>
+void continuousTimeRiccatiFixedSizeKernel(std::pair<int, scalar_t> indexAlpha, const std::vector<ModelData>& projectedModelData,
+                                          const std::vector<riccati_modification::Data>& riccatiModification, bool reducedFormRiccati,
+                                          const vector_t& allSs, vector_t& dallSs);
+
+/**
+ * Registers a Riccati flow map kernel for the given state and (projected) input dimensions. A registered kernel is used by all
+ * ContinuousTimeRiccatiEquations whose data is set afterwards. An existing kernel for the same dimensions is replaced.
+ * Kernels for (10, 3), (12, 4) and (24, 24) are registered by default.
+ *
+ * @param [in] stateDim: Dimension of the state space.
+ * @param [in] inputDim: Dimension of the projected input space.
+ * @param [in] kernel: The Riccati flow map kernel.
+ */
+void registerContinuousTimeRiccatiKernel(int stateDim, int inputDim, ContinuousTimeRiccatiKernel kernel);
+
+/** Registers the fixed-size Riccati flow map kernel for STATE_DIM and INPUT_DIM, see continuousTimeRiccatiFixedSizeKernel() */
+template <int STATE_DIM, int INPUT_DIM>
+void registerContinuousTimeRiccatiKernel() {
+  registerContinuousTimeRiccatiKernel(STATE_DIM, INPUT_DIM, &continuousTimeRiccatiFixedSizeKernel<STATE_DIM, INPUT_DIM>);
+}
+
+/**
+ * Gets the Riccati flow map kernel registered for the given dimensions.
+ *
+ * @param [in] stateDim: Dimension of the state space.
+ * @param [in] inputDim: Dimension of the projected input space.
+ * @return The kernel or nullptr if no kernel is registered for these dimensions.
+ */
+ContinuousTimeRiccatiKernel getContinuousTimeRiccatiKernel(int stateDim, int inputDim);
+
+}  // namespace ocs2
+
+#include "implementation/ContinuousTimeRiccatiKernel.h"
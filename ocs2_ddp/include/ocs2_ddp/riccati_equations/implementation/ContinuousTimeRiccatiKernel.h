@@ -0,0 +1,142 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+namespace ocs2 {
+namespace riccati_kernel {
+
+/** Linear interpolation of a field of the data array into a fixed-size matrix, same as LinearInterpolation::interpolate() */
+template <typename Fixed, typename Data, typename AccessFun>
+void interpolate(std::pair<int, scalar_t> indexAlpha, const std::vector<Data>& dataArray, AccessFun accessFun, Fixed& result) {
+  if (dataArray.size() > 1) {
+    const scalar_t alpha = indexAlpha.second;
+    const Eigen::Map<const Fixed> lhs(accessFun(dataArray, indexAlpha.first).data());
+    const Eigen::Map<const Fixed> rhs(accessFun(dataArray, indexAlpha.first + 1).data());
+    result.noalias() = alpha * lhs + (scalar_t(1.0) - alpha) * rhs;
+  } else {
+    result = Eigen::Map<const Fixed>(accessFun(dataArray, 0).data());
+  }
+}
+
+}  // namespace riccati_kernel
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int STATE_DIM, int INPUT_DIM>
+void continuousTimeRiccatiFixedSizeKernel(std::pair<int, scalar_t> indexAlpha, const std::vector<ModelData>& projectedModelData,
+                                          const std::vector<riccati_modification::Data>& riccatiModification, bool reducedFormRiccati,
+                                          const vector_t& allSs, vector_t& dallSs) {
+  using state_vector_t = Eigen::Matrix<scalar_t, STATE_DIM, 1>;
+  using state_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, STATE_DIM>;
+  using input_vector_t = Eigen::Matrix<scalar_t, INPUT_DIM, 1>;
+  using input_matrix_t = Eigen::Matrix<scalar_t, INPUT_DIM, INPUT_DIM>;
+  using state_input_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, INPUT_DIM>;
+  using input_state_matrix_t = Eigen::Matrix<scalar_t, INPUT_DIM, STATE_DIM>;
+  using riccati_kernel::interpolate;
+
+  // Riccati coefficients, see ContinuousTimeRiccatiEquations::convert2Matrix()
+  state_matrix_t Sm;
+  int count = 0;
+  for (int col = 0; col < STATE_DIM; col++) {
+    Sm.col(col).head(col + 1) = Eigen::Map<const vector_t>(allSs.data() + count, col + 1);
+    count += col + 1;
+  }
+  Sm.template triangularView<Eigen::StrictlyLower>() = Sm.template triangularView<Eigen::StrictlyUpper>().transpose();
+  const Eigen::Map<const state_vector_t> Sv(allSs.data() + count);
+
+  // Interpolated model data
+  state_vector_t Hv;
+  state_matrix_t Am;
+  state_input_matrix_t Bm;
+  state_vector_t dSv;
+  state_matrix_t dSm;
+  input_vector_t Gv;
+  input_state_matrix_t Gm;
+  state_matrix_t deltaQm;
+  input_state_matrix_t Km;
+  input_vector_t Lv;
+  interpolate(indexAlpha, projectedModelData, model_data::dynamicsBias, Hv);
+  interpolate(indexAlpha, projectedModelData, model_data::dynamics_dfdx, Am);
+  interpolate(indexAlpha, projectedModelData, model_data::dynamics_dfdu, Bm);
+  scalar_t ds = LinearInterpolation::interpolate(indexAlpha, projectedModelData, model_data::cost_f);
+  interpolate(indexAlpha, projectedModelData, model_data::cost_dfdx, dSv);
+  interpolate(indexAlpha, projectedModelData, model_data::cost_dfdxx, dSm);
+  interpolate(indexAlpha, projectedModelData, model_data::cost_dfdu, Gv);
+  interpolate(indexAlpha, projectedModelData, model_data::cost_dfdux, Gm);
+  interpolate(indexAlpha, riccatiModification, riccati_modification::deltaQm, deltaQm);
+  interpolate(indexAlpha, riccatiModification, riccati_modification::deltaGm, Km);
+  interpolate(indexAlpha, riccatiModification, riccati_modification::deltaGv, Lv);
+
+  // Same operations as in ContinuousTimeRiccatiEquations::computeFlowMapSLQ()
+  Gm.noalias() += Bm.transpose() * Sm;
+  Gv.noalias() += Bm.transpose() * Sv;
+  Km = -(Gm + Km);
+  Lv = -(Gv + Lv);
+
+  state_matrix_t SmTrans_Am;
+  SmTrans_Am.noalias() = Sm.transpose() * Am;
+  state_matrix_t KmT_Gm;
+  KmT_Gm.noalias() = Km.transpose() * Gm;
+
+  dSm += deltaQm + SmTrans_Am + SmTrans_Am.transpose();
+  dSv.noalias() += Sm.transpose() * Hv;
+  dSv.noalias() += Am.transpose() * Sv;
+  dSv.noalias() += Gm.transpose() * Lv;
+  ds += Hv.dot(Sv);
+  if (reducedFormRiccati) {
+    dSm += KmT_Gm;
+    ds += 0.5 * Lv.dot(Gv);
+  } else {
+    input_matrix_t Rm;
+    interpolate(indexAlpha, projectedModelData, model_data::cost_dfduu, Rm);
+    input_state_matrix_t Rm_Km;
+    Rm_Km.noalias() = Rm * Km;
+    input_vector_t Rm_Lv;
+    Rm_Lv.noalias() = Rm * Lv;
+
+    dSm += KmT_Gm + KmT_Gm.transpose();
+    dSm.noalias() += Km.transpose() * Rm_Km;
+    dSv.noalias() += Km.transpose() * Gv;
+    dSv.noalias() += Rm_Km.transpose() * Lv;
+    ds += Lv.dot(Gv);
+    ds += 0.5 * Lv.dot(Rm_Lv);
+  }
+
+  // Flattened derivative, see ContinuousTimeRiccatiEquations::convert2Vector()
+  dallSs.resize(allSs.size());
+  count = 0;
+  for (int col = 0; col < STATE_DIM; col++) {
+    Eigen::Map<vector_t>(dallSs.data() + count, col + 1) = dSm.col(col).head(col + 1);
+    count += col + 1;
+  }
+  Eigen::Map<state_vector_t>(dallSs.data() + count) = dSv;
+  dallSs(count + STATE_DIM) = ds;
+}
+
+}  // namespace ocs2
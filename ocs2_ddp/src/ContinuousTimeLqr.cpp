@@ -50,7 +50,8 @@ solution solve(OptimalControlProblem& problem, scalar_t time, const vector_t& st
   const size_t stateDim = state.size();
 
   // --- Form the Linear quadratic approximation ---
-  // Obtain model data at the provided reference
+  // Obtain model data at the provided reference, the problem might have changed since an earlier call at the same point
+  problem.preComputationPtr->invalidateCache();
   const auto modelData = approximateIntermediateLQ(problem, time, state, input, MultiplierCollection());
 
   // checking the numerical properties
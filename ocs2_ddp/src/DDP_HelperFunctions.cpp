@@ -76,14 +76,14 @@ void computeRolloutMetrics(OptimalControlProblem& problem, const PrimalSolution&
   constexpr auto request = Request::Cost + Request::Constraint + Request::SoftConstraint;
   for (size_t k = 0; k < tTrajectory.size(); k++) {
     // intermediate time cost and constraints
-    problem.preComputationPtr->request(request, tTrajectory[k], xTrajectory[k], uTrajectory[k]);
+    problem.preComputationPtr->cachedRequest(request, tTrajectory[k], xTrajectory[k], uTrajectory[k]);
     problemMetrics.intermediates.push_back(
         computeIntermediateMetrics(problem, tTrajectory[k], xTrajectory[k], uTrajectory[k], dualSolution.intermediates[k]));
 
     // event time cost and constraints
     if (nextPostEventIndexItr != postEventIndices.end() && k + 1 == *nextPostEventIndexItr) {
       const auto m = dualSolution.preJumps[std::distance(postEventIndices.begin(), nextPostEventIndexItr)];
-      problem.preComputationPtr->requestPreJump(request, tTrajectory[k], xTrajectory[k]);
+      problem.preComputationPtr->cachedRequestPreJump(request, tTrajectory[k], xTrajectory[k]);
       problemMetrics.preJumps.push_back(computePreJumpMetrics(problem, tTrajectory[k], xTrajectory[k], m));
       nextPostEventIndexItr++;
     }
@@ -91,7 +91,7 @@ void computeRolloutMetrics(OptimalControlProblem& problem, const PrimalSolution&
 
   // final time cost and constraints
   if (!tTrajectory.empty()) {
-    problem.preComputationPtr->requestFinal(request, tTrajectory.back(), xTrajectory.back());
+    problem.preComputationPtr->cachedRequestFinal(request, tTrajectory.back(), xTrajectory.back());
     problemMetrics.final = computeFinalMetrics(problem, tTrajectory.back(), xTrajectory.back(), dualSolution.final);
   }
 }
@@ -989,6 +989,8 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   // set cost desired trajectories
   for (auto& ocp : optimalControlProblemStock_) {
     ocp.targetTrajectoriesPtr = &this->getReferenceManager().getTargetTrajectories();
+    // The references might have changed, which invalidates the pre-computation at any node
+    ocp.preComputationPtr->invalidateCache();
   }
 
   // initialize parameters
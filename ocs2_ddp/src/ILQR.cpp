@@ -47,8 +47,10 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
   sensitivityDiscretizer_ = [&]() {
     switch (settings().backwardPassIntegratorType_) {
       case IntegratorType::EULER:
+      case IntegratorType::EULER_OCS2:
         return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::EULER);
       case IntegratorType::RK4:
+      case IntegratorType::RK4_OCS2:
         return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
       case IntegratorType::ODE45:
         return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
@@ -27,6 +27,8 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  ******************************************************************************/
 
+#include <algorithm>
+
 #include <ocs2_core/misc/Lookup.h>
 #include <ocs2_core/model_data/ModelDataLinearInterpolation.h>
 
@@ -39,8 +41,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ContinuousTimeRiccatiEquations::ContinuousTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive)
-    : reducedFormRiccati_(reducedFormRiccati), isRiskSensitive_(isRiskSensitive) {}
+ContinuousTimeRiccatiEquations::ContinuousTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive, bool useFixedSizeKernels)
+    : reducedFormRiccati_(reducedFormRiccati), isRiskSensitive_(isRiskSensitive), useFixedSizeKernels_(useFixedSizeKernels) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -127,6 +129,18 @@ void ContinuousTimeRiccatiEquations::setData(const scalar_array_t* timeStampPtr,
   for (const auto& postEventIndex : *eventsPastTheEndIndecesPtr) {
     eventTimes_.push_back((*timeStampPtr)[postEventIndex - 1]);
   }
+
+  // look up the fixed-size kernels once for all input dimensions of the data, as the projected input dimension can change over time
+  fixedSizeKernels_.clear();
+  if (useFixedSizeKernels_ && !isRiskSensitive_) {
+    for (const auto& modelData : *projectedModelDataPtr) {
+      const int inputDim = modelData.dynamics.dfdu.cols();
+      const auto sameInputDim = [inputDim](const std::pair<int, ContinuousTimeRiccatiKernel>& kernel) { return kernel.first == inputDim; };
+      if (std::none_of(fixedSizeKernels_.cbegin(), fixedSizeKernels_.cend(), sameInputDim)) {
+        fixedSizeKernels_.emplace_back(inputDim, getContinuousTimeRiccatiKernel(modelData.dynamics.dfdx.rows(), inputDim));
+      }
+    }
+  }
 }
 
 /******************************************************************************************************/
@@ -152,7 +166,14 @@ vector_t ContinuousTimeRiccatiEquations::computeJumpMap(scalar_t z, const vector
 vector_t ContinuousTimeRiccatiEquations::computeFlowMap(scalar_t z, const vector_t& allSs) {
   // index
   const scalar_t t = -z;  // denormalized time
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, *timeStampPtr_);
+  const auto indexAlpha = timeSegmentCursor_.timeSegment(t, *timeStampPtr_);
+
+  const auto fixedSizeKernel = getFixedSizeKernel(indexAlpha);
+  if (fixedSizeKernel != nullptr) {
+    vector_t dallSs;
+    fixedSizeKernel(indexAlpha, *projectedModelDataPtr_, *riccatiModificationPtr_, reducedFormRiccati_, allSs, dallSs);
+    return dallSs;
+  }
 
   convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
   if (isRiskSensitive_) {
@@ -168,6 +189,34 @@ vector_t ContinuousTimeRiccatiEquations::computeFlowMap(scalar_t z, const vector
   return convert2Vector(continuousTimeRiccatiData_.dSm_, continuousTimeRiccatiData_.dSv_, continuousTimeRiccatiData_.ds_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ContinuousTimeRiccatiKernel ContinuousTimeRiccatiEquations::getFixedSizeKernel(std::pair<int, scalar_t> indexAlpha) const {
+  if (fixedSizeKernels_.empty()) {
+    return nullptr;
+  }
+
+  // The fixed-size kernel requires the same dimensions at both ends of the interpolation interval
+  const auto& modelData = *projectedModelDataPtr_;
+  const auto& riccatiModification = *riccatiModificationPtr_;
+  const size_t lhs = (modelData.size() > 1) ? indexAlpha.first : 0;
+  const size_t rhs = (modelData.size() > 1) ? indexAlpha.first + 1 : 0;
+  const auto stateDim = modelData[lhs].dynamics.dfdx.rows();
+  const auto inputDim = modelData[lhs].dynamics.dfdu.cols();
+  if (modelData[rhs].dynamics.dfdu.cols() != inputDim || modelData[rhs].dynamics.dfdx.rows() != stateDim ||
+      riccatiModification[lhs].deltaGm_.rows() != inputDim || riccatiModification[rhs].deltaGm_.rows() != inputDim) {
+    return nullptr;
+  }
+
+  for (const auto& kernel : fixedSizeKernels_) {
+    if (kernel.first == inputDim) {
+      return kernel.second;
+    }
+  }
+  return nullptr;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
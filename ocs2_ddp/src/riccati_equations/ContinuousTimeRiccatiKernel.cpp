@@ -0,0 +1,82 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "ocs2_ddp/riccati_equations/ContinuousTimeRiccatiKernel.h"
+
+#include <map>
+#include <mutex>
+
+namespace ocs2 {
+
+// Fixed-size kernels of the robotic examples: ballbot, quadrotor and unconstrained legged robot
+template void continuousTimeRiccatiFixedSizeKernel<10, 3>(std::pair<int, scalar_t>, const std::vector<ModelData>&,
+                                                          const std::vector<riccati_modification::Data>&, bool, const vector_t&, vector_t&);
+template void continuousTimeRiccatiFixedSizeKernel<12, 4>(std::pair<int, scalar_t>, const std::vector<ModelData>&,
+                                                          const std::vector<riccati_modification::Data>&, bool, const vector_t&, vector_t&);
+template void continuousTimeRiccatiFixedSizeKernel<24, 24>(std::pair<int, scalar_t>, const std::vector<ModelData>&,
+                                                           const std::vector<riccati_modification::Data>&, bool, const vector_t&, vector_t&);
+
+namespace {
+struct KernelRegistry {
+  KernelRegistry() {
+    kernels[{10, 3}] = &continuousTimeRiccatiFixedSizeKernel<10, 3>;
+    kernels[{12, 4}] = &continuousTimeRiccatiFixedSizeKernel<12, 4>;
+    kernels[{24, 24}] = &continuousTimeRiccatiFixedSizeKernel<24, 24>;
+  }
+
+  std::mutex mutex;
+  std::map<std::pair<int, int>, ContinuousTimeRiccatiKernel> kernels;
+};
+
+KernelRegistry& getKernelRegistry() {
+  static KernelRegistry registry;
+  return registry;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void registerContinuousTimeRiccatiKernel(int stateDim, int inputDim, ContinuousTimeRiccatiKernel kernel) {
+  auto& registry = getKernelRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.kernels[{stateDim, inputDim}] = kernel;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ContinuousTimeRiccatiKernel getContinuousTimeRiccatiKernel(int stateDim, int inputDim) {
+  auto& registry = getKernelRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const auto it = registry.kernels.find({stateDim, inputDim});
+  return (it != registry.kernels.end()) ? it->second : nullptr;
+}
+
+}  // namespace ocs2
@@ -27,10 +27,12 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <iostream>
 #include <memory>
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/randomMatrices.h>
 #include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
@@ -155,3 +157,90 @@ TEST(RiccatiTest, testFlattenAndUnflatten) {
   ASSERT_TRUE(Sv.isApprox(Sv_out));
   ASSERT_TRUE(Sm.isApprox(Sm_out));
 }
+
+template <int STATE_DIM, int INPUT_DIM>
+void compareFixedSizeKernel(bool reducedFormRiccati) {
+  using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
+
+  riccati_t riccatiEquationDynamicSize(reducedFormRiccati, false, false);
+  riccati_t riccatiEquationFixedSize(reducedFormRiccati, false, true);
+
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  ri.initialize(riccatiEquationDynamicSize);
+  ri.initialize(riccatiEquationFixedSize);
+
+  const ocs2::vector_t S = ocs2::vector_t::Random(ocs2::s_vector_dim(STATE_DIM));
+  for (const ocs2::scalar_t z : {-0.1, -0.6, -0.9}) {
+    const ocs2::vector_t dSdz_dynamicSize = riccatiEquationDynamicSize.computeFlowMap(z, S);
+    const ocs2::vector_t dSdz_fixedSize = riccatiEquationFixedSize.computeFlowMap(z, S);
+    ocs2::vector_t dSdz_kernel;
+    ocs2::continuousTimeRiccatiFixedSizeKernel<STATE_DIM, INPUT_DIM>({0, 1.0 + z}, ri.projectedModelDataTrajectory,
+                                                                      ri.riccatiModificationTrajectory, reducedFormRiccati, S, dSdz_kernel);
+
+    ASSERT_EQ(dSdz_fixedSize.size(), dSdz_dynamicSize.size());
+    EXPECT_LE((dSdz_fixedSize - dSdz_dynamicSize).array().abs().maxCoeff(), 1e-9) << "z: " << z;
+    EXPECT_LE((dSdz_kernel - dSdz_dynamicSize).array().abs().maxCoeff(), 1e-9) << "z: " << z;
+  }
+}
+
+TEST(RiccatiTest, fixedSizeKernels) {
+  ASSERT_NE(ocs2::getContinuousTimeRiccatiKernel(10, 3), nullptr);
+  ASSERT_NE(ocs2::getContinuousTimeRiccatiKernel(12, 4), nullptr);
+  ASSERT_NE(ocs2::getContinuousTimeRiccatiKernel(24, 24), nullptr);
+  ASSERT_EQ(ocs2::getContinuousTimeRiccatiKernel(48, 10), nullptr);
+
+  for (const bool reducedFormRiccati : {true, false}) {
+    compareFixedSizeKernel<10, 3>(reducedFormRiccati);
+    compareFixedSizeKernel<12, 4>(reducedFormRiccati);
+    compareFixedSizeKernel<24, 24>(reducedFormRiccati);
+  }
+}
+
+TEST(RiccatiTest, registerFixedSizeKernel) {
+  ASSERT_EQ(ocs2::getContinuousTimeRiccatiKernel(5, 2), nullptr);
+  ocs2::registerContinuousTimeRiccatiKernel<5, 2>();
+  ASSERT_NE(ocs2::getContinuousTimeRiccatiKernel(5, 2), nullptr);
+
+  compareFixedSizeKernel<5, 2>(true);
+  compareFixedSizeKernel<5, 2>(false);
+}
+
+template <int STATE_DIM, int INPUT_DIM>
+void benchmarkFixedSizeKernel(bool reducedFormRiccati) {
+  constexpr size_t numEvaluations = 10000;
+  using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
+
+  riccati_t riccatiEquationDynamicSize(reducedFormRiccati, false, false);
+  riccati_t riccatiEquationFixedSize(reducedFormRiccati, false, true);
+
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  ri.initialize(riccatiEquationDynamicSize);
+  ri.initialize(riccatiEquationFixedSize);
+
+  const ocs2::vector_t S = ocs2::vector_t::Random(ocs2::s_vector_dim(STATE_DIM));
+  ocs2::benchmark::RepeatedTimer dynamicSizeTimer;
+  ocs2::benchmark::RepeatedTimer fixedSizeTimer;
+  ocs2::scalar_t checksum = 0.0;  // prevents that the evaluations are optimized away
+  for (size_t i = 0; i < numEvaluations; i++) {
+    const ocs2::scalar_t z = -static_cast<ocs2::scalar_t>(i) / numEvaluations;
+    dynamicSizeTimer.startTimer();
+    checksum += riccatiEquationDynamicSize.computeFlowMap(z, S)(0);
+    dynamicSizeTimer.endTimer();
+    fixedSizeTimer.startTimer();
+    checksum -= riccatiEquationFixedSize.computeFlowMap(z, S)(0);
+    fixedSizeTimer.endTimer();
+  }
+
+  EXPECT_LE(std::abs(checksum), 1e-6);
+  std::cerr << "[RiccatiTest] nx = " << STATE_DIM << ", nu = " << INPUT_DIM << ", reducedFormRiccati = " << reducedFormRiccati << "\n"
+            << "\tdynamic size [us]: " << 1e3 * dynamicSizeTimer.getAverageInMilliseconds() << "\n"
+            << "\tfixed size   [us]: " << 1e3 * fixedSizeTimer.getAverageInMilliseconds() << "\n";
+}
+
+TEST(RiccatiTest, benchmarkFixedSizeKernels) {
+  for (const bool reducedFormRiccati : {true, false}) {
+    benchmarkFixedSizeKernel<10, 3>(reducedFormRiccati);
+    benchmarkFixedSizeKernel<12, 4>(reducedFormRiccati);
+    benchmarkFixedSizeKernel<24, 24>(reducedFormRiccati);
+  }
+}
@@ -136,10 +136,26 @@ class IpmSolver : public SolverBase {
                                             const vector_array_t& slackStateInputIneq, const vector_array_t& dualStateIneq,
                                             const vector_array_t& dualStateInputIneq, std::vector<Metrics>& metrics);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                      const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics);
+  /**
+   * A trial point of the linesearch {t, x(t) + a*dx(t), u(t) + a*du(t), slackStateIneq(t) + a*dslackStateIneq(t),
+   * slackStateInputIneq(t) + a*dslackStateInputIneq(t)} with a = stepSize, and its performance metrics
+   */
+  struct LinesearchCandidate {
+    scalar_t stepSize = 0.0;
+    vector_array_t x;
+    vector_array_t u;
+    vector_array_t slackStateIneq;
+    vector_array_t slackStateInputIneq;
+    std::vector<Metrics> metrics;
+    PerformanceIndex performance;
+  };
+
+  /**
+   * Computes only the performance metrics of the first numCandidates linesearch candidates. The nodes of all candidates are evaluated in
+   * a single parallel loop, such that the threads are split between candidates and nodes.
+   */
+  void computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, scalar_t barrierParam, size_t numCandidates,
+                          std::vector<LinesearchCandidate>& candidates);
 
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
@@ -216,6 +232,9 @@ class IpmSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
 
+  // Per-worker memory of the transcription, swapped with the LQ approximation of each node
+  std::vector<multiple_shooting::TranscriptionWorkspace> workerTranscription_;
+
   // Constraint terms size
   std::vector<multiple_shooting::ConstraintsSize> constraintsSize_;
 
@@ -230,11 +249,11 @@ class IpmSolver : public SolverBase {
 
   // Benchmarking
   size_t totalNumIterations_{0};
-  benchmark::RepeatedTimer initializationTimer_;
-  benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
-  benchmark::RepeatedTimer solveQpTimer_;
-  benchmark::RepeatedTimer linesearchTimer_;
-  benchmark::RepeatedTimer computeControllerTimer_;
+  benchmark::RepeatedTimer initializationTimer_{"IpmSolver::initialization"};
+  benchmark::RepeatedTimer linearQuadraticApproximationTimer_{"IpmSolver::linearQuadraticApproximation"};
+  benchmark::RepeatedTimer solveQpTimer_{"IpmSolver::solveQp"};
+  benchmark::RepeatedTimer linesearchTimer_{"IpmSolver::linesearch"};
+  benchmark::RepeatedTimer computeControllerTimer_{"IpmSolver::computeController"};
 };
 
 }  // namespace ocs2
@@ -39,7 +39,7 @@ std::pair<vector_t, vector_t> initializeIntermediateSlackVariable(OptimalControl
 
   if (!ocpDefinition.stateInequalityConstraintPtr->empty() || !ocpDefinition.inequalityConstraintPtr->empty()) {
     constexpr auto request = Request::Constraint;
-    ocpDefinition.preComputationPtr->request(request, time, state, input);
+    ocpDefinition.preComputationPtr->cachedRequest(request, time, state, input);
   }
 
   if (!ocpDefinition.stateInequalityConstraintPtr->empty()) {
@@ -64,7 +64,7 @@ vector_t initializeTerminalSlackVariable(OptimalControlProblem& ocpDefinition, s
   }
 
   constexpr auto request = Request::Constraint;
-  ocpDefinition.preComputationPtr->requestFinal(request, time, state);
+  ocpDefinition.preComputationPtr->cachedRequestFinal(request, time, state);
   const auto ineqConstraint = toVector(ocpDefinition.finalInequalityConstraintPtr->getValue(time, state, *ocpDefinition.preComputationPtr));
   return initializeSlackVariable(ineqConstraint, initialSlackLowerBound, initialSlackMarginRate);
 }
@@ -76,7 +76,7 @@ vector_t initializeEventSlackVariable(OptimalControlProblem& ocpDefinition, scal
   }
 
   constexpr auto request = Request::Constraint;
-  ocpDefinition.preComputationPtr->requestPreJump(request, time, state);
+  ocpDefinition.preComputationPtr->cachedRequestPreJump(request, time, state);
   const auto ineqConstraint =
       toVector(ocpDefinition.preJumpInequalityConstraintPtr->getValue(time, state, *ocpDefinition.preComputationPtr));
   return initializeSlackVariable(ineqConstraint, initialSlackLowerBound, initialSlackMarginRate);
@@ -78,6 +78,13 @@ IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optima
   for (int w = 0; w < settings_.nThreads; w++) {
     ocpDefinitions_.push_back(optimalControlProblem);
   }
+  // Optionally, the dynamics of each worker share its pre-computation, such that each node is requested once for all terms
+  if (settings_.shareDynamicsPreComputation) {
+    for (auto& ocpDefinition : ocpDefinitions_) {
+      ocpDefinition.dynamicsPtr->setSharedPreComputation(ocpDefinition.preComputationPtr.get());
+    }
+  }
+  workerTranscription_.resize(settings_.nThreads);
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
@@ -112,6 +119,9 @@ void IpmSolver::reset() {
   solveQpTimer_.reset();
   linesearchTimer_.reset();
   computeControllerTimer_.reset();
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    ocpDefinition.preComputationPtr->resetCacheStatistics();
+  }
 }
 
 std::string IpmSolver::getBenchmarkingInformation() const {
@@ -140,6 +150,13 @@ std::string IpmSolver::getBenchmarkingInformation() const {
                << linesearchTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tCompute Controller :\t" << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << computeControllerTotal / benchmarkTotal * inPercent << "%)\n";
+    size_t numRequests = 0;
+    size_t numReused = 0;
+    for (const auto& ocpDefinition : ocpDefinitions_) {
+      numRequests += ocpDefinition.preComputationPtr->getCacheStatistics().numRequests;
+      numReused += ocpDefinition.preComputationPtr->getCacheStatistics().numReused;
+    }
+    infoStream << "\tPre-computation    :\t" << numReused << " of " << numRequests << " requests reused\n";
   }
   return infoStream.str();
 }
@@ -215,6 +232,8 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   for (auto& ocpDefinition : ocpDefinitions_) {
     const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
     ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+    // The references might have changed, which invalidates the pre-computation at any node
+    ocpDefinition.preComputationPtr->invalidateCache();
   }
 
   // old and new mode schedules for the trajectory spreading
@@ -227,7 +246,12 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     std::ignore = trajectorySpread(oldModeSchedule, newModeSchedule, primalSolution_);
   }
   vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  if (settings_.extrapolateTail) {
+    multiple_shooting::shiftStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, discretizer_,
+                                                   *ocpDefinitions_.front().dynamicsPtr, x, u);
+  } else {
+    multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  }
 
   // Initialize the slack and dual variables of the interior point method
   if (!slackIneqTrajectory_.timeTrajectory.empty()) {
@@ -335,6 +359,8 @@ void IpmSolver::initializeCostateTrajectory(const std::vector<AnnotatedTime>& ti
     const auto time = getIntervalEnd(timeDiscretization[i]);
     if (time < interpolateTill) {  // interpolate previous solution
       costateTrajectory.push_back(LinearInterpolation::interpolate(time, primalSolution_.timeTrajectory_, costateTrajectory_));
+    } else if (settings_.extrapolateTail && !costateTrajectory_.empty() && costateTrajectory_.back().size() == stateTrajectory[i].size()) {
+      costateTrajectory.push_back(costateTrajectory_.back());  // Hold the last costate of the previous solution
     } else {  // Initialize with zero
       costateTrajectory.push_back(vector_t::Zero(stateTrajectory[i].size()));
     }
@@ -378,7 +404,8 @@ void IpmSolver::initializeProjectionMultiplierTrajectory(const std::vector<Annot
       // Intermediate node
       const scalar_t time = getIntervalStart(timeDiscretization[i]);
       const size_t numConstraints = ocpDefinition.equalityConstraintPtr->getNumConstraints(time);
-      if (time < interpolateTill) {  // interpolate previous solution
+      const bool extrapolate = settings_.extrapolateTail && primalSolution_.timeTrajectory_.size() >= 2;
+      if (time < interpolateTill || extrapolate) {  // interpolate previous solution, which holds its end in the tail
         projectionMultiplierTrajectory.push_back(interpolateProjectionMultiplierTrajectory(time));
       } else {  // Initialize with zero
         projectionMultiplierTrajectory.push_back(vector_t::Zero(numConstraints));
@@ -626,21 +653,23 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+    auto& workspace = workerTranscription_[workerId];
 
     int i = timeIndex++;
     while (i < N) {
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
+        auto& result = workspace.event;
+        multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1], result);
         metrics[i] = multiple_shooting::computeMetrics(result);
         performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[i]);
-        dynamics_[i] = std::move(result.dynamics);
+        std::swap(dynamics_[i], result.dynamics);
         stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+        std::swap(stateIneqConstraints_[i], result.ineqConstraints);
         stateInputIneqConstraints_[i].resize(0, x[i].size());
         constraintsProjection_[i].resize(0, x[i].size());
         projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
-        constraintsSize_[i] = std::move(result.constraintsSize);
+        std::swap(constraintsSize_[i], result.constraintsSize);
         if (settings_.computeLagrangeMultipliers) {
           lagrangian_[i] = multiple_shooting::evaluateLagrangianEventNode(lmd[i], lmd[i + 1], std::move(result.cost), dynamics_[i]);
         } else {
@@ -655,7 +684,8 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        auto& result = workspace.intermediate;
+        multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i], result);
         // Disable the state-only inequality constraints at the initial node
         if (i == 0) {
           result.stateIneqConstraints.setZero(0, x[i].size());
@@ -663,14 +693,14 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
         }
         metrics[i] = multiple_shooting::computeMetrics(result);
         performance[workerId] += ipm::computePerformanceIndex(result, dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
-        multiple_shooting::projectTranscription(result, settings_.computeLagrangeMultipliers);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
-        constraintsSize_[i] = std::move(result.constraintsSize);
+        multiple_shooting::projectTranscription(result, settings_.computeLagrangeMultipliers, workspace.projection);
+        std::swap(dynamics_[i], result.dynamics);
+        std::swap(stateInputEqConstraints_[i], result.stateInputEqConstraints);
+        std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+        std::swap(stateInputIneqConstraints_[i], result.stateInputIneqConstraints);
+        std::swap(constraintsProjection_[i], result.constraintsProjection);
+        std::swap(projectionMultiplierCoefficients_[i], result.projectionMultiplierCoefficients);
+        std::swap(constraintsSize_[i], result.constraintsSize);
         if (settings_.computeLagrangeMultipliers) {
           lagrangian_[i] = multiple_shooting::evaluateLagrangianIntermediateNode(lmd[i], lmd[i + 1], nu[i], std::move(result.cost),
                                                                                  dynamics_[i], stateInputEqConstraints_[i]);
@@ -693,12 +723,13 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
+      auto& result = workspace.terminal;
+      multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N], result);
       metrics[i] = multiple_shooting::computeMetrics(result);
       performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[N]);
       stateInputEqConstraints_[i].resize(0, x[i].size());
-      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-      constraintsSize_[i] = std::move(result.constraintsSize);
+      std::swap(stateIneqConstraints_[i], result.ineqConstraints);
+      std::swap(constraintsSize_[i], result.constraintsSize);
       if (settings_.computeLagrangeMultipliers) {
         lagrangian_[i] = multiple_shooting::evaluateLagrangianTerminalNode(lmd[i], std::move(result.cost));
       } else {
@@ -723,58 +754,76 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
   return totalPerformance;
 }
 
-PerformanceIndex IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                               const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
+void IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, scalar_t barrierParam,
+                                   size_t numCandidates, std::vector<LinesearchCandidate>& candidates) {
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
+  const int numNodes = N + 1;
+  const int numTasks = static_cast<int>(numCandidates) * numNodes;
+  for (size_t j = 0; j < numCandidates; ++j) {
+    candidates[j].metrics.resize(numNodes);
+  }
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
+  // Performance of candidate j accumulated by a worker is stored at [j * nThreads + workerId]
+  std::vector<PerformanceIndex> performance(numCandidates * settings_.nThreads, PerformanceIndex());
+  std::atomic_int taskIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    int k = taskIndex++;
+    while (k < numTasks) {
+      // Get candidate and node of the task
+      const int j = k / numNodes;
+      const int i = k % numNodes;
+      const auto& x = candidates[j].x;
+      const auto& u = candidates[j].u;
+      const auto& slackStateIneq = candidates[j].slackStateIneq;
+      const auto& slackStateInputIneq = candidates[j].slackStateInputIneq;
+      auto& metrics = candidates[j].metrics;
+      PerformanceIndex& workerPerformance = performance[j * settings_.nThreads + workerId];
+
+      if (i == N) {
+        // Terminal node
+        const scalar_t tN = getIntervalStart(time[N]);
+        metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
+        workerPerformance += ipm::toPerformanceIndex(metrics[N], barrierParam, slackStateIneq[N]);
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], barrierParam, slackStateIneq[i]);
+        workerPerformance += ipm::toPerformanceIndex(metrics[i], barrierParam, slackStateIneq[i]);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        const bool enableStateInequalityConstraints = (i > 0);
         metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
         // Disable the state-only inequality constraints at the initial node
         if (i == 0) {
           metrics[i].stateIneqConstraint.clear();
         }
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
+        workerPerformance += ipm::toPerformanceIndex(metrics[i], dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
       }
 
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += ipm::toPerformanceIndex(metrics[N], barrierParam, slackStateIneq[N]);
+      k = taskIndex++;
     }
   };
   runParallel(std::move(parallelTask));
 
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  for (size_t j = 0; j < numCandidates; ++j) {
+    auto& candidate = candidates[j];
+    const auto workerBegin = performance.begin() + j * settings_.nThreads;
+    const auto workerEnd = workerBegin + settings_.nThreads;
 
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
-  return totalPerformance;
+    // Account for initial state in performance
+    const vector_t initDynamicsViolation = initState - candidate.x.front();
+    candidate.metrics.front().dynamicsViolation += initDynamicsViolation;
+    workerBegin->dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+
+    // Sum performance of the threads
+    candidate.performance = std::accumulate(std::next(workerBegin), workerEnd, *workerBegin);
+    candidate.performance.merit =
+        candidate.performance.cost + candidate.performance.equalityLagrangian + candidate.performance.inequalityLagrangian;
+  }
 }
 
 ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
@@ -787,6 +836,9 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
    * Filter linesearch based on:
    * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
    * https://link.springer.com/article/10.1007/s10107-004-0559-y
+   *
+   * The step sizes of the backtracking sequence are evaluated concurrently in batches of settings_.linesearchCandidates, and the largest
+   * accepted step size of a batch is taken. This results in the same step as trying the step sizes one after the other.
    */
   if (settings_.printLinesearch) {
     std::cerr << std::setprecision(9) << std::fixed;
@@ -805,64 +857,76 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
   const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
   const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
 
+  const size_t maxNumCandidates = std::max(settings_.linesearchCandidates, size_t(1));
+  std::vector<LinesearchCandidate> candidates(maxNumCandidates);
+
   scalar_t alpha = subproblemSolution.maxPrimalStepSize;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  vector_array_t slackStateIneqNew(slackStateIneq.size());
-  vector_array_t slackStateInputIneqNew(slackStateInputIneq.size());
-  std::vector<Metrics> metricsNew(metrics.size());
+  bool tooSmallStep = false;
   do {
-    // Compute step
-    multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
-    multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
-    multiple_shooting::incrementTrajectory(slackStateIneq, deltaSlackStateIneq, alpha, slackStateIneqNew);
-    multiple_shooting::incrementTrajectory(slackStateInputIneq, deltaSlackStateInputIneq, alpha, slackStateInputIneqNew);
+    // Compute the steps of the next candidates of the backtracking sequence
+    size_t numCandidates = 0;
+    do {
+      auto& candidate = candidates[numCandidates++];
+      candidate.stepSize = alpha;
+      candidate.x.resize(x.size());
+      candidate.u.resize(u.size());
+      candidate.slackStateIneq.resize(slackStateIneq.size());
+      candidate.slackStateInputIneq.resize(slackStateInputIneq.size());
+      multiple_shooting::incrementTrajectory(u, du, alpha, candidate.u);
+      multiple_shooting::incrementTrajectory(x, dx, alpha, candidate.x);
+      multiple_shooting::incrementTrajectory(slackStateIneq, deltaSlackStateIneq, alpha, candidate.slackStateIneq);
+      multiple_shooting::incrementTrajectory(slackStateInputIneq, deltaSlackStateInputIneq, alpha, candidate.slackStateInputIneq);
+
+      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
+      alpha *= settings_.alpha_decay;
+      tooSmallStep = alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol;
+    } while (numCandidates < maxNumCandidates && !tooSmallStep && alpha >= settings_.alpha_min);
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew =
-        computePerformance(timeDiscretization, initState, xNew, uNew, barrierParam, slackStateIneqNew, slackStateInputIneqNew, metricsNew);
-
-    // Step acceptance and record step type
-    bool stepAccepted;
-    StepType stepType;
-    std::tie(stepAccepted, stepType) =
-        filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
-    }
+    computePerformance(timeDiscretization, initState, barrierParam, numCandidates, candidates);
+
+    for (size_t j = 0; j < numCandidates; ++j) {
+      auto& candidate = candidates[j];
+
+      // Step acceptance and record step type
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) =
+          filterLinesearch_.acceptStep(baseline, candidate.performance, candidate.stepSize * subproblemSolution.armijoDescentMetric);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << candidate.stepSize << ", Step Type: " << toString(stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << candidate.stepSize * deltaXnorm << "\t|du| = " << candidate.stepSize * deltaUnorm << "\n";
+        std::cerr << candidate.performance << "\n";
+      }
 
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      slackStateIneq = std::move(slackStateIneqNew);
-      slackStateInputIneq = std::move(slackStateInputIneqNew);
-      metrics = std::move(metricsNew);
-
-      // Prepare step info
-      ipm::StepInfo stepInfo;
-      stepInfo.primalStepSize = alpha;
-      stepInfo.stepType = stepType;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
-      return stepInfo;
-
-    } else {  // Try smaller step
-      alpha *= settings_.alpha_decay;
+      if (stepAccepted) {  // Return the largest accepted step
+        x = std::move(candidate.x);
+        u = std::move(candidate.u);
+        slackStateIneq = std::move(candidate.slackStateIneq);
+        slackStateInputIneq = std::move(candidate.slackStateInputIneq);
+        metrics = std::move(candidate.metrics);
+
+        // Prepare step info
+        ipm::StepInfo stepInfo;
+        stepInfo.primalStepSize = candidate.stepSize;
+        stepInfo.stepType = stepType;
+        stepInfo.dx_norm = candidate.stepSize * deltaXnorm;
+        stepInfo.du_norm = candidate.stepSize * deltaUnorm;
+        stepInfo.performanceAfterStep = candidate.performance;
+        stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(candidate.performance);
+        return stepInfo;
+      }
+    }
 
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
-        if (settings_.printLinesearch) {
-          std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
-                    << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
-        }
-        break;
+    // All candidates are rejected -> Try smaller steps
+    if (tooSmallStep) {
+      if (settings_.printLinesearch) {
+        std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
+                  << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
       }
+      break;
     }
   } while (alpha >= settings_.alpha_min);
 
@@ -124,7 +124,7 @@ class MPC_MRT_Interface final : public MRT_BASE {
   void copyToBuffer(const SystemObservation& mpcInitObservation);
 
   MPC_BASE& mpc_;
-  benchmark::RepeatedTimer mpcTimer_;
+  benchmark::RepeatedTimer mpcTimer_{"MPC_MRT_Interface::advanceMpc"};
 
   // MPC inputs
   SystemObservation currentObservation_;
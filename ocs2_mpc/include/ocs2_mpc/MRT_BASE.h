@@ -31,8 +31,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <Eigen/Dense>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 
@@ -47,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpc/CommandData.h"
 #include "ocs2_mpc/MrtObserver.h"
+#include "ocs2_mpc/PolicyAgeHistogram.h"
 #include "ocs2_mpc/SystemObservation.h"
 
 namespace ocs2 {
@@ -54,6 +58,11 @@ namespace ocs2 {
 /**
  * This class implements core MRT (Model Reference Tracking) functionality.
  * The responsibility of filling the buffer variables is left to the deriving classes.
+ *
+ * The policy is handed over from the MPC side (moveToBuffer) to the MRT side (updatePolicy) through a triple buffer: the MPC side
+ * fills its own slot and atomically exchanges it with the ready slot, while the MRT side atomically exchanges its active slot with
+ * the ready slot whenever it contains a new policy. Neither side ever blocks on the other and the MRT side always picks up the latest
+ * published policy.
  */
 class MRT_BASE {
  public:
@@ -63,6 +72,7 @@ class MRT_BASE {
 
   /**
    * Resets the class to its instantiated state.
+   * @note This method should be called from the MRT thread, i.e., the thread that calls updatePolicy().
    */
   void reset();
 
@@ -141,12 +151,24 @@ class MRT_BASE {
   /**
    * Checks the data buffer for an update of the MPC policy. If a new policy
    * is available on the buffer this method will load it to the in-use policy.
-   * This method also calls the modifyActiveSolution() method.
+   * This method also calls the modifyActiveSolution() method. This method is wait-free.
    *
    * @return True if the policy is updated.
    */
   bool updatePolicy();
 
+  /**
+   * Gets the histogram of the policy age, i.e., the time between publishing a policy in moveToBuffer() and using it in
+   * evaluatePolicy() or rolloutPolicy().
+   * @warning access to the returned reference is not threadsafe. It should be read from the MRT thread.
+   */
+  const PolicyAgeHistogram& getPolicyAgeHistogram() const { return policyAgeHistogram_; }
+
+  /**
+   * Clears the policy age histogram.
+   */
+  void resetPolicyAgeHistogram() { policyAgeHistogram_.reset(); }
+
   /**
    * @brief rolloutSet: Whether or not the internal rollout object has been set
    * @return True if a rollout object is available.
@@ -163,28 +185,41 @@ class MRT_BASE {
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
  private:
-  /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** A slot of the policy triple buffer. */
+  struct PolicyBuffer {
+    std::unique_ptr<CommandData> commandPtr;
+    std::unique_ptr<PrimalSolution> primalSolutionPtr;
+    std::unique_ptr<PerformanceIndex> performanceIndicesPtr;
+    std::chrono::steady_clock::time_point publishTime;
+  };
+
+  /** Calls modifyActiveSolution on all mrt observers. This function is called on the MRT thread. */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
-  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** Calls modifyBufferedSolution on all mrt observers. This function is called on the MPC thread before publishing the policy. */
   void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer);
 
+  /** Records the age of the active policy in the histogram. */
+  void recordPolicyAge();
+
+  const PolicyBuffer& activeBuffer() const { return policyBuffers_[activeIndex_]; }
+
   // flags on state of the class
   std::atomic_bool policyReceivedEver_;
-  bool newPolicyInBuffer_;  // whether a new policy is waiting to be swapped in
-
-  // variables related to the MPC output
-  std::unique_ptr<CommandData> activeCommandPtr_;
-  std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
-  std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
-  std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
-  std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
-
-  // thread safety
-  mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
-  const size_t mrtTrylockWarningThreshold_ = 5;
-  size_t mrtTrylockWarningCount_;
+
+  // triple buffer of the MPC output. The ready index is shared, the active index is owned by the MRT thread (updatePolicy), and
+  // the write index is owned by the MPC thread (moveToBuffer).
+  static constexpr uint8_t bufferIndexMask_ = 0x3;
+  static constexpr uint8_t newPolicyFlag_ = 0x4;  // whether the ready slot holds a policy that has not been swapped in yet
+  std::array<PolicyBuffer, 3> policyBuffers_;
+  std::atomic<uint8_t> readyState_;
+  uint8_t activeIndex_;
+  uint8_t writeIndex_;
+
+  // serializes moveToBuffer and reset. It is never taken by updatePolicy.
+  std::mutex writeMutex_;
+
+  PolicyAgeHistogram policyAgeHistogram_;
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
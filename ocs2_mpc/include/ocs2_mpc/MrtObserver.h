@@ -46,7 +46,8 @@ namespace ocs2 {
  * When a user requests an update, the in-use policy is swapped for the buffered policy.
  *      - At this point the "modifyActiveSolution" of this class is called.
  *
- * Both filling of the buffer and the update swapping are protected by the same mutex.
+ * The buffer is handed over without a lock. Therefore, modifyBufferedSolution (MPC thread) and modifyActiveSolution (MRT thread)
+ * can run concurrently, each on its own policy.
  */
 class MrtObserver {
  public:
@@ -65,8 +66,6 @@ class MrtObserver {
    *
    * This function is executed sequentially with updatePolicy and thus blocks the main thread. Computationally expensive modifications
    * should therefore rather be done in "modifyBufferedSolution".
-   *
-   * A call to this function is protected by the same mutex as modifyBufferedSolution.
    */
   virtual void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution) {}
 
@@ -75,8 +74,6 @@ class MrtObserver {
    * It allows the user to modify the buffered solution before it can be swapped during the updatePolicy call.
    *
    * When using a multi-threaded MRT, this function does not block the main thread.
-   *
-   * A call to this function is protected by the same mutex as modifyActiveSolution.
    */
   virtual void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) {}
 };
@@ -0,0 +1,97 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Histogram of the policy age, i.e., the time elapsed between the publication of a policy by the MPC side and its use on the MRT side.
+ * The bins have a fixed width and the last bin collects all samples beyond the histogram range. The class is not thread-safe and is
+ * meant to be owned by the MRT (control loop) thread.
+ */
+class PolicyAgeHistogram {
+ public:
+  /**
+   * Constructor
+   * @param [in] binWidthInMilliseconds: The width of each bin.
+   * @param [in] numBins: The number of bins. The last bin also collects the overflow.
+   */
+  explicit PolicyAgeHistogram(scalar_t binWidthInMilliseconds = 1.0, size_t numBins = 50);
+
+  /** Clears all samples. */
+  void reset();
+
+  /** Adds a sample to the histogram. */
+  void addSample(std::chrono::steady_clock::duration age);
+
+  /** Adds a sample to the histogram. */
+  void addSampleInMilliseconds(scalar_t ageInMilliseconds);
+
+  /** Number of collected samples. */
+  size_t getNumSamples() const { return numSamples_; }
+
+  /** The count of each bin. Bin i covers [i, i+1) * binWidth, the last bin is open to the right. */
+  const std::vector<size_t>& getBinCounts() const { return binCounts_; }
+
+  /** The bin width. */
+  scalar_t getBinWidthInMilliseconds() const { return binWidth_; }
+
+  /** The maximum recorded age. */
+  scalar_t getMaxInMilliseconds() const { return maxAge_; }
+
+  /** The average recorded age. */
+  scalar_t getAverageInMilliseconds() const { return (numSamples_ > 0) ? totalAge_ / static_cast<scalar_t>(numSamples_) : 0.0; }
+
+  /**
+   * An upper bound of the requested percentile, i.e. the upper edge of the bin that contains the percentile. For the overflow bin the
+   * maximum recorded age is returned.
+   *
+   * @param [in] percentile: A value in [0, 100].
+   */
+  scalar_t getPercentileInMilliseconds(scalar_t percentile) const;
+
+ private:
+  scalar_t binWidth_;
+  std::vector<size_t> binCounts_;
+  size_t numSamples_ = 0;
+  scalar_t totalAge_ = 0.0;
+  scalar_t maxAge_ = 0.0;
+};
+
+/** Prints the statistics and the non-empty bins of the histogram. */
+std::ostream& operator<<(std::ostream& stream, const PolicyAgeHistogram& histogram);
+
+}  // namespace ocs2
@@ -0,0 +1,121 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/PolicyAgeHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyAgeHistogram::PolicyAgeHistogram(scalar_t binWidthInMilliseconds, size_t numBins)
+    : binWidth_(binWidthInMilliseconds), binCounts_(numBins, 0) {
+  if (binWidth_ <= 0.0) {
+    throw std::runtime_error("[PolicyAgeHistogram] binWidthInMilliseconds should be positive!");
+  }
+  if (numBins == 0) {
+    throw std::runtime_error("[PolicyAgeHistogram] numBins should be positive!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyAgeHistogram::reset() {
+  std::fill(binCounts_.begin(), binCounts_.end(), 0);
+  numSamples_ = 0;
+  totalAge_ = 0.0;
+  maxAge_ = 0.0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyAgeHistogram::addSample(std::chrono::steady_clock::duration age) {
+  addSampleInMilliseconds(std::chrono::duration<scalar_t, std::milli>(age).count());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyAgeHistogram::addSampleInMilliseconds(scalar_t ageInMilliseconds) {
+  ageInMilliseconds = std::max(ageInMilliseconds, 0.0);
+  const auto bin = std::min(static_cast<size_t>(ageInMilliseconds / binWidth_), binCounts_.size() - 1);
+  ++binCounts_[bin];
+  ++numSamples_;
+  totalAge_ += ageInMilliseconds;
+  maxAge_ = std::max(maxAge_, ageInMilliseconds);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t PolicyAgeHistogram::getPercentileInMilliseconds(scalar_t percentile) const {
+  if (numSamples_ == 0) {
+    return 0.0;
+  }
+
+  const auto target = static_cast<size_t>(std::ceil(std::min(std::max(percentile, 0.0), 100.0) / 100.0 * numSamples_));
+  size_t cumulativeCount = 0;
+  for (size_t i = 0; i < binCounts_.size() - 1; ++i) {
+    cumulativeCount += binCounts_[i];
+    if (cumulativeCount >= std::max<size_t>(target, 1)) {
+      return std::min(static_cast<scalar_t>(i + 1) * binWidth_, maxAge_);
+    }
+  }
+  return maxAge_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::ostream& operator<<(std::ostream& stream, const PolicyAgeHistogram& histogram) {
+  const auto& binCounts = histogram.getBinCounts();
+  const auto binWidth = histogram.getBinWidthInMilliseconds();
+
+  stream << "Policy age [ms]: samples: " << histogram.getNumSamples() << ", average: " << histogram.getAverageInMilliseconds()
+         << ", p99: " << histogram.getPercentileInMilliseconds(99.0) << ", max: " << histogram.getMaxInMilliseconds() << "\n";
+  for (size_t i = 0; i < binCounts.size(); ++i) {
+    if (binCounts[i] == 0) {
+      continue;
+    }
+    if (i + 1 < binCounts.size()) {
+      stream << "  [" << i * binWidth << ", " << (i + 1) * binWidth << "): " << binCounts[i] << "\n";
+    } else {
+      stream << "  [" << i * binWidth << ", inf): " << binCounts[i] << "\n";
+    }
+  }
+  return stream;
+}
+
+}  // namespace ocs2
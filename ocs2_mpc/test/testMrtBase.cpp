@@ -0,0 +1,277 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+
+#include "ocs2_mpc/MRT_BASE.h"
+
+using namespace ocs2;
+
+namespace {
+
+/** MRT that publishes policies directly, the state and the input of the k-th policy are equal to k. */
+class TestMrt final : public MRT_BASE {
+ public:
+  void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override {}
+  void setCurrentObservation(const SystemObservation& observation) override {}
+
+  void publish(scalar_t k) {
+    auto primalSolutionPtr = std::make_unique<PrimalSolution>();
+    primalSolutionPtr->timeTrajectory_ = {0.0, 1.0};
+    primalSolutionPtr->stateTrajectory_ = {vector_t::Constant(1, k), vector_t::Constant(1, k)};
+    primalSolutionPtr->inputTrajectory_ = {vector_t::Constant(1, k), vector_t::Constant(1, k)};
+    primalSolutionPtr->controllerPtr_.reset(
+        new FeedforwardController(primalSolutionPtr->timeTrajectory_, primalSolutionPtr->inputTrajectory_));
+    moveToBuffer(std::make_unique<CommandData>(), std::move(primalSolutionPtr), std::make_unique<PerformanceIndex>());
+  }
+
+  /** Returns the state of the active policy. */
+  scalar_t evaluate() {
+    vector_t mpcState, mpcInput;
+    size_t mode;
+    evaluatePolicy(0.5, vector_t::Zero(1), mpcState, mpcInput, mode);
+    EXPECT_DOUBLE_EQ(mpcState(0), mpcInput(0));
+    return mpcState(0);
+  }
+};
+
+/** Adds an offset to the buffered policy and scales the active policy. */
+class TestObserver final : public MrtObserver {
+ public:
+  void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) override {
+    for (auto& x : primalSolutionBuffer.stateTrajectory_) {
+      x.array() += 1000.0;
+    }
+    numBufferedModifications++;
+  }
+
+  void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution) override {
+    for (auto& x : primalSolution.stateTrajectory_) {
+      x *= 2.0;
+    }
+    numActiveModifications++;
+  }
+
+  std::atomic_int numBufferedModifications{0};
+  int numActiveModifications = 0;
+};
+
+/** Blocks the publishing thread inside moveToBuffer until it is released. */
+class BlockingObserver final : public MrtObserver {
+ public:
+  void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    isBlocking_ = true;
+    condition_.notify_all();
+    condition_.wait(lock, [this] { return isReleased_; });
+  }
+
+  void waitUntilBlocking() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return isBlocking_; });
+  }
+
+  void release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    isReleased_ = true;
+    condition_.notify_all();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool isBlocking_ = false;
+  bool isReleased_ = false;
+};
+
+}  // namespace
+
+TEST(testMrtBase, noPolicy) {
+  TestMrt mrt;
+  EXPECT_FALSE(mrt.initialPolicyReceived());
+  EXPECT_FALSE(mrt.updatePolicy());
+  EXPECT_ANY_THROW(mrt.getPolicy());
+  EXPECT_ANY_THROW(mrt.evaluate());
+}
+
+TEST(testMrtBase, latestPolicy) {
+  TestMrt mrt;
+  mrt.publish(1.0);
+  mrt.publish(2.0);
+  mrt.publish(3.0);
+  EXPECT_TRUE(mrt.initialPolicyReceived());
+
+  // superseded policies are dropped
+  EXPECT_TRUE(mrt.updatePolicy());
+  EXPECT_DOUBLE_EQ(mrt.evaluate(), 3.0);
+  EXPECT_FALSE(mrt.updatePolicy());
+  EXPECT_DOUBLE_EQ(mrt.evaluate(), 3.0);
+
+  mrt.publish(4.0);
+  EXPECT_TRUE(mrt.updatePolicy());
+  EXPECT_DOUBLE_EQ(mrt.evaluate(), 4.0);
+}
+
+TEST(testMrtBase, reset) {
+  TestMrt mrt;
+  mrt.publish(1.0);
+  ASSERT_TRUE(mrt.updatePolicy());
+  mrt.publish(2.0);
+
+  mrt.reset();
+  EXPECT_FALSE(mrt.initialPolicyReceived());
+  EXPECT_FALSE(mrt.updatePolicy());
+  EXPECT_ANY_THROW(mrt.getPolicy());
+
+  mrt.publish(3.0);
+  EXPECT_TRUE(mrt.updatePolicy());
+  EXPECT_DOUBLE_EQ(mrt.evaluate(), 3.0);
+}
+
+TEST(testMrtBase, mrtObserver) {
+  TestMrt mrt;
+  auto observerPtr = std::make_shared<TestObserver>();
+  mrt.addMrtObserver(observerPtr);
+
+  mrt.publish(1.0);
+  mrt.publish(2.0);
+  EXPECT_EQ(observerPtr->numBufferedModifications, 2);
+  EXPECT_EQ(observerPtr->numActiveModifications, 0);
+
+  // the buffered modification is applied before the active one
+  ASSERT_TRUE(mrt.updatePolicy());
+  EXPECT_EQ(observerPtr->numActiveModifications, 1);
+  EXPECT_DOUBLE_EQ(mrt.getPolicy().stateTrajectory_.front()(0), 2.0 * (2.0 + 1000.0));
+}
+
+TEST(testMrtBase, updateWhilePublishing) {
+  TestMrt mrt;
+  auto observerPtr = std::make_shared<BlockingObserver>();
+
+  mrt.publish(1.0);
+  ASSERT_TRUE(mrt.updatePolicy());
+  mrt.addMrtObserver(observerPtr);
+
+  // the publisher is stuck inside moveToBuffer, the MRT side keeps running on the active policy
+  std::thread publisher([&] { mrt.publish(2.0); });
+  observerPtr->waitUntilBlocking();
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FALSE(mrt.updatePolicy());
+    EXPECT_DOUBLE_EQ(mrt.evaluate(), 1.0);
+  }
+
+  observerPtr->release();
+  publisher.join();
+  EXPECT_TRUE(mrt.updatePolicy());
+  EXPECT_DOUBLE_EQ(mrt.evaluate(), 2.0);
+}
+
+TEST(testMrtBase, concurrentPublishing) {
+  constexpr int numPolicies = 10000;
+  TestMrt mrt;
+  std::atomic_bool isPublishing{true};
+
+  std::thread publisher([&] {
+    for (int k = 1; k <= numPolicies; ++k) {
+      mrt.publish(k);
+    }
+    isPublishing = false;
+  });
+
+  // the consumer never sees an older policy than the one it already uses
+  scalar_t previousPolicy = 0.0;
+  bool isMonotonic = true;
+  while (isPublishing) {
+    if (mrt.updatePolicy()) {
+      const scalar_t policy = mrt.evaluate();
+      isMonotonic = isMonotonic && (policy > previousPolicy);
+      previousPolicy = policy;
+    }
+  }
+  publisher.join();
+
+  // the last published policy is picked up
+  mrt.updatePolicy();
+  EXPECT_TRUE(isMonotonic);
+  EXPECT_DOUBLE_EQ(mrt.evaluate(), numPolicies);
+  EXPECT_FALSE(mrt.updatePolicy());
+}
+
+TEST(testMrtBase, policyAgeHistogram) {
+  TestMrt mrt;
+  mrt.publish(1.0);
+  ASSERT_TRUE(mrt.updatePolicy());
+  mrt.resetPolicyAgeHistogram();
+
+  for (int i = 0; i < 5; ++i) {
+    mrt.evaluate();
+  }
+  EXPECT_EQ(mrt.getPolicyAgeHistogram().getNumSamples(), 5);
+  mrt.resetPolicyAgeHistogram();
+  EXPECT_EQ(mrt.getPolicyAgeHistogram().getNumSamples(), 0);
+}
+
+TEST(testPolicyAgeHistogram, bucketing) {
+  PolicyAgeHistogram histogram(1.0, 4);
+  for (const scalar_t age : {-1.0, 0.5, 1.0, 1.5, 1.7, 3.2, 100.0}) {
+    histogram.addSampleInMilliseconds(age);
+  }
+
+  // negative ages are clamped to zero, ages beyond the range go to the last bin
+  const std::vector<size_t> expectedCounts{2, 3, 0, 2};
+  EXPECT_EQ(histogram.getBinCounts(), expectedCounts);
+  EXPECT_EQ(histogram.getNumSamples(), 7);
+  EXPECT_DOUBLE_EQ(histogram.getMaxInMilliseconds(), 100.0);
+  EXPECT_DOUBLE_EQ(histogram.getAverageInMilliseconds(), (0.0 + 0.5 + 1.0 + 1.5 + 1.7 + 3.2 + 100.0) / 7.0);
+
+  // upper edges of the bins containing the percentiles, the maximum for the overflow bin
+  EXPECT_DOUBLE_EQ(histogram.getPercentileInMilliseconds(20.0), 1.0);
+  EXPECT_DOUBLE_EQ(histogram.getPercentileInMilliseconds(50.0), 2.0);
+  EXPECT_DOUBLE_EQ(histogram.getPercentileInMilliseconds(100.0), 100.0);
+
+  histogram.addSample(std::chrono::microseconds(2500));
+  EXPECT_EQ(histogram.getBinCounts()[2], 1);
+
+  histogram.reset();
+  EXPECT_EQ(histogram.getNumSamples(), 0);
+  EXPECT_EQ(histogram.getBinCounts(), std::vector<size_t>(4, 0));
+  EXPECT_DOUBLE_EQ(histogram.getPercentileInMilliseconds(50.0), 0.0);
+}
+
+TEST(testPolicyAgeHistogram, invalidArguments) {
+  EXPECT_ANY_THROW(PolicyAgeHistogram(0.0, 4));
+  EXPECT_ANY_THROW(PolicyAgeHistogram(1.0, 0));
+}
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/BlockSparsity.h>
 
 namespace ocs2 {
 
@@ -41,17 +42,44 @@ namespace ocs2 {
  * The altered model data will be of size stateDim=n, inputDim=p
  *
  * A Px / u0 of zeros can be efficiently applied by passing an empty matrix / vector (of size 0).
+ * If the structurally non-zero columns of Px are known, the products with the zero columns of Px are skipped.
  *
  * @param quadraticApproximation : Approximation to be adapted in-place
  * @param Pu : Matrix defining the range of \tilde{\delta u}
  * @param Px : Matrix defining the range of \delta x
  * @param u0 : Input offset
+ * @param PxColumnsPtr : Optional structurally non-zero columns of Px.
  */
 void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu,
-                            const matrix_t& Px = matrix_t(), const vector_t& u0 = vector_t());
+                            const matrix_t& Px = matrix_t(), const vector_t& u0 = vector_t(),
+                            const column_blocks_t* PxColumnsPtr = nullptr);
 
 /** Applies the change of input variables to a linear system */
 void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px = matrix_t(),
-                            const vector_t& u0 = vector_t());
+                            const vector_t& u0 = vector_t(), const column_blocks_t* PxColumnsPtr = nullptr);
+
+/** Memory of the temporaries of changeOfInputVariables for a quadratic approximation. */
+struct ChangeOfInputVariablesWorkspace {
+  matrix_t P_plus_R_Px;
+  vector_t r_plus_R_u0;
+  matrix_t R_Pu;
+};
+
+/**
+ * Variant of changeOfInputVariables that writes the altered quadratic approximation into result. The temporaries are kept in the
+ * workspace and the terms of the input dimension p are written into the memory of result, such that nothing is allocated when the
+ * dimensions do not change between calls. The terms of the state dimension are adapted in-place and swapped into result, which leaves
+ * quadraticApproximation in an unspecified state.
+ */
+void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, const column_blocks_t* PxColumnsPtr, ChangeOfInputVariablesWorkspace& workspace,
+                            ScalarFunctionQuadraticApproximation& result);
+
+/**
+ * Variant of changeOfInputVariables that writes the altered linear system into result, reusing its memory. The terms of the state
+ * dimension are adapted in-place and swapped into result, which leaves linearApproximation in an unspecified state.
+ */
+void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, const column_blocks_t* PxColumnsPtr, VectorFunctionLinearApproximation& result);
 
 }  // namespace ocs2
\ No newline at end of file
@@ -75,8 +75,30 @@ void incrementTrajectory(const std::vector<Type>& v, const std::vector<Type>& dv
 void remapProjectedInput(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, const vector_array_t& deltaXSol,
                          vector_array_t& deltaUSol);
 
+/**
+ * Re-map the projected input back to the original space. Unlike the in-place version, the projected input is kept, such that the memory
+ * of the given remapped input trajectory can be reused between calls.
+ *
+ * @param [in] constraintsProjection: The constraints projection.
+ * @param [in] deltaXSol: The state trajectory of the QP subproblem solution.
+ * @param [in] deltaUSolProjected: The projected input trajectory of the QP subproblem solution.
+ * @param [out] deltaUSol: The input trajectory in the original space.
+ */
+void remapProjectedInput(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, const vector_array_t& deltaXSol,
+                         const vector_array_t& deltaUSolProjected, vector_array_t& deltaUSol);
+
 void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, matrix_array_t& KMatrices);
 
+/**
+ * Re-map the projected feedback gains back to the original space, keeping the projected gains.
+ *
+ * @param [in] constraintsProjection: The constraints projection.
+ * @param [in] KMatricesProjected: The projected feedback gains.
+ * @param [out] KMatrices: The feedback gains in the original space.
+ */
+void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection,
+                        const matrix_array_t& KMatricesProjected, matrix_array_t& KMatrices);
+
 /**
  * Constructs a primal solution (with a feedforward controller) based the LQ subproblem solution.
  *
@@ -102,6 +124,33 @@ PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSche
 PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSchedule&& modeSchedule, vector_array_t&& x, vector_array_t&& u,
                                 matrix_array_t&& KMatrices);
 
+/**
+ * Writes a primal solution (with a feedforward controller) based the LQ subproblem solution into the given primal solution. The memory of
+ * its trajectories and controller is reused, which avoids heap allocations when the horizon does not change between calls.
+ *
+ * @param [in] time : The annotated time trajectory
+ * @param [in] modeSchedule: The mode schedule.
+ * @param [in] x: The state trajectory of the QP subproblem solution.
+ * @param [in] u: The input trajectory of the QP subproblem solution.
+ * @param [out] primalSolution: The primal solution.
+ */
+void toPrimalSolution(const std::vector<AnnotatedTime>& time, const ModeSchedule& modeSchedule, const vector_array_t& x,
+                      const vector_array_t& u, PrimalSolution& primalSolution);
+
+/**
+ * Writes a primal solution (with a linear controller) based the LQ subproblem solution into the given primal solution. The memory of
+ * its trajectories and controller is reused, which avoids heap allocations when the horizon does not change between calls.
+ *
+ * @param [in] time : The annotated time trajectory
+ * @param [in] modeSchedule: The mode schedule.
+ * @param [in] x: The state trajectory of the QP subproblem solution.
+ * @param [in] u: The input trajectory of the QP subproblem solution.
+ * @param [in] KMatrices: The LQR gain trajectory of the QP subproblem solution.
+ * @param [out] primalSolution: The primal solution.
+ */
+void toPrimalSolution(const std::vector<AnnotatedTime>& time, const ModeSchedule& modeSchedule, const vector_array_t& x,
+                      const vector_array_t& u, const matrix_array_t& KMatrices, PrimalSolution& primalSolution);
+
 /**
  * Constructs a ProblemMetrics from an array of metrics.
  *
@@ -111,5 +160,14 @@ PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSche
  */
 ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vector<Metrics>&& metrics);
 
+/**
+ * Writes the array of metrics into the given ProblemMetrics, reusing its memory.
+ *
+ * @param [in] time : The annotated time trajectory
+ * @param [in] metrics: The metrics array.
+ * @param [out] problemMetrics: The ProblemMetrics.
+ */
+void toProblemMetrics(const std::vector<AnnotatedTime>& time, const std::vector<Metrics>& metrics, ProblemMetrics& problemMetrics);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
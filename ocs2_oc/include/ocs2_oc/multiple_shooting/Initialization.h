@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 
 #include "ocs2_oc/oc_data/PrimalSolution.h"
@@ -74,7 +75,7 @@ inline std::pair<vector_t, vector_t> initializeIntermediateNode(const PrimalSolu
  * @param x : Pre-event state
  * @return x_next : Post-event state
  */
-inline vector_t initializeEventNode(scalar_t t, const vector_t& x) {
+inline const vector_t& initializeEventNode(scalar_t t, const vector_t& x) {
   // Assume identity map for now
   return x;
 }
@@ -94,5 +95,24 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
                                       const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
                                       vector_array_t& inputTrajectory);
 
+/**
+ * Horizon-shift warm start of the state-input trajectories for receding horizon control. Same as initializeStateInputTrajectories for the
+ * period that intersects with the previous solution. Instead of using the initializer, the tail after the previous solution is
+ * extrapolated by holding the last input of the previous solution and rolling out the discretized dynamics. The extrapolation stops at
+ * the first event in the tail, after which the initializer is used.
+ *
+ * @param [in] initState :  Initial state
+ * @param [in] timeDiscretization : The annotated time trajectory
+ * @param [in] primalSolution : previous solution
+ * @param [in] initializer : System initializer
+ * @param [in] discretizer : The dynamics discretization used for the rollout of the tail
+ * @param [in] systemDynamics : The system dynamics
+ * @param [out] stateTrajectory : The initialized state trajectory
+ * @param [out] inputTrajectory : The initialized input trajectory
+ */
+void shiftStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
+                                 const PrimalSolution& primalSolution, Initializer& initializer, const DynamicsDiscretizer& discretizer,
+                                 SystemDynamicsBase& systemDynamics, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
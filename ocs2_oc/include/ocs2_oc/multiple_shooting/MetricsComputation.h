@@ -46,6 +46,9 @@ namespace multiple_shooting {
  */
 Metrics computeMetrics(const Transcription& transcription);
 
+/** In-place variant of computeMetrics, reusing the memory of the given metrics. */
+void computeMetrics(const Transcription& transcription, Metrics& metrics);
+
 /**
  * Compute the Metrics for the event node.
  * @param transcription: multiple shooting transcription for event node.
@@ -53,6 +56,9 @@ Metrics computeMetrics(const Transcription& transcription);
  */
 Metrics computeMetrics(const EventTranscription& transcription);
 
+/** In-place variant of computeMetrics, reusing the memory of the given metrics. */
+void computeMetrics(const EventTranscription& transcription, Metrics& metrics);
+
 /**
  * Compute the Metrics for the terminal node.
  * @param transcription: multiple shooting transcription for terminal node.
@@ -60,6 +66,9 @@ Metrics computeMetrics(const EventTranscription& transcription);
  */
 Metrics computeMetrics(const TerminalTranscription& transcription);
 
+/** In-place variant of computeMetrics, reusing the memory of the given metrics. */
+void computeMetrics(const TerminalTranscription& transcription, Metrics& metrics);
+
 /**
  * Compute the Metrics for a single intermediate node.
  * @param optimalControlProblem : Definition of the optimal control problem
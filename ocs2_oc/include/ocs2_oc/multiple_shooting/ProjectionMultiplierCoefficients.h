@@ -54,6 +54,17 @@ struct ProjectionMultiplierCoefficients {
    */
   void compute(const ScalarFunctionQuadraticApproximation& cost, const VectorFunctionLinearApproximation& dynamics,
                const VectorFunctionLinearApproximation& constraintProjection, const matrix_t& pseudoInverse);
+
+  /** Memory of the temporaries of compute(). */
+  struct Workspace {
+    vector_t semiprojectedCost_dfdu;
+    matrix_t semiprojectedCost_dfdux;
+    matrix_t semiprojectedCost_dfduu;
+  };
+
+  /** Variant of compute that keeps the temporaries in the given workspace, such that nothing is allocated for fixed dimensions. */
+  void compute(const ScalarFunctionQuadraticApproximation& cost, const VectorFunctionLinearApproximation& dynamics,
+               const VectorFunctionLinearApproximation& constraintProjection, const matrix_t& pseudoInverse, Workspace& workspace);
 };
 
 }  // namespace multiple_shooting
@@ -31,7 +31,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/misc/BlockSparsity.h>
+#include <ocs2_core/misc/LinearAlgebra.h>
 
+#include "ocs2_oc/approximate_model/ChangeOfInputVariables.h"
 #include "ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h"
 #include "ocs2_oc/oc_problem/OptimalControlProblem.h"
 
@@ -57,6 +60,7 @@ struct Transcription {
   VectorFunctionLinearApproximation dynamics;
   VectorFunctionLinearApproximation stateEqConstraints;
   VectorFunctionLinearApproximation stateInputEqConstraints;
+  LinearApproximationSparsity stateInputEqConstraintsSparsity;
   VectorFunctionLinearApproximation stateIneqConstraints;
   VectorFunctionLinearApproximation stateInputIneqConstraints;
   VectorFunctionLinearApproximation constraintsProjection;
@@ -78,6 +82,33 @@ struct Transcription {
 Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
 
+/**
+ * In-place variant of setupIntermediateNode. The results are written into the given transcription, reusing the memory of its members.
+ * The constraint projection and the projection multiplier coefficients are not modified, they are set by projectTranscription.
+ *
+ * @param [in] optimalControlProblem : Definition of the optimal control problem
+ * @param [in] sensitivityDiscretizer : Integrator to use for creating the discrete dynamics.
+ * @param [in] t : Start of the discrete interval
+ * @param [in] dt : Duration of the interval
+ * @param [in] x : State at start of the interval
+ * @param [in] x_next : State at the end of the interval
+ * @param [in] u : Input, taken to be constant across the interval.
+ * @param [out] transcription : multiple shooting transcription for this node.
+ */
+void setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer, scalar_t t,
+                           scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u, Transcription& transcription);
+
+/**
+ * Memory of the constraint projection factorizations and of the temporaries of the projection. It is kept by the caller to be reused for
+ * all nodes that are projected by the same thread.
+ */
+struct ProjectionWorkspace {
+  LinearAlgebra::ConstraintProjectionWorkspace constraintProjection;
+  matrix_t pseudoInverse;
+  ProjectionMultiplierCoefficients::Workspace projectionMultiplierCoefficients;
+  ChangeOfInputVariablesWorkspace changeOfInputVariables;
+};
+
 /**
  * Apply the state-input equality constraint projection for a single intermediate node transcription.
  *
@@ -86,6 +117,33 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
  */
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier = false);
 
+/**
+ * Apply the state-input equality constraint projection for a single intermediate node transcription, using the given workspace for
+ * the factorization of the constraint. Without state-input equality constraints, the projection terms are cleared.
+ *
+ * @param [in, out] transcription : Transcription for a single intermediate node
+ * @param [in] extractProjectionMultiplier : Whether to extract the projection multiplier.
+ * @param [in, out] workspace : Memory of the factorization.
+ */
+void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier, ProjectionWorkspace& workspace);
+
+/**
+ * Variant of projectTranscription that writes the projected cost, dynamics, and state-input inequality constraints into the given terms
+ * instead of the transcription, e.g., into the per-node storage of a solver. The memory of the given terms is reused, and the
+ * corresponding terms of the transcription are left in an unspecified state. Without state-input equality constraints, the terms are
+ * swapped with the ones of the transcription.
+ *
+ * @param [in, out] transcription : Transcription for a single intermediate node
+ * @param [in] extractProjectionMultiplier : Whether to extract the projection multiplier.
+ * @param [in, out] workspace : Memory of the factorization.
+ * @param [out] projectedCost : The projected cost.
+ * @param [out] projectedDynamics : The projected dynamics.
+ * @param [out] projectedStateInputIneqConstraints : The projected state-input inequality constraints.
+ */
+void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier, ProjectionWorkspace& workspace,
+                          ScalarFunctionQuadraticApproximation& projectedCost, VectorFunctionLinearApproximation& projectedDynamics,
+                          VectorFunctionLinearApproximation& projectedStateInputIneqConstraints);
+
 /**
  * Results of the transcription at a terminal node
  */
@@ -106,6 +164,9 @@ struct TerminalTranscription {
  */
 TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x);
 
+/** In-place variant of setupTerminalNode, writing into the given transcription and reusing the memory of its members. */
+void setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, TerminalTranscription& transcription);
+
 /**
  * Results of the transcription at an event
  */
@@ -128,5 +189,20 @@ struct EventTranscription {
  */
 EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next);
 
+/** In-place variant of setupEventNode, writing into the given transcription and reusing the memory of its members. */
+void setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                    EventTranscription& transcription);
+
+/**
+ * Per-thread memory for the in-place transcription. A solver keeps one workspace per worker, transcribes a node into it, and swaps the
+ * results with its own per-node storage. The swapped out memory of the previous iteration is then reused for the next node.
+ */
+struct TranscriptionWorkspace {
+  Transcription intermediate;
+  EventTranscription event;
+  TerminalTranscription terminal;
+  ProjectionWorkspace projection;
+};
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -76,6 +76,19 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
                                                         const scalar_array_t& eventTimes,
                                                         scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
 
+/**
+ * In-place version of timeDiscretizationWithEvents(), which reuses the memory of the given time discretization.
+ *
+ * @param [in] initTime : start time.
+ * @param [in] finalTime : final time.
+ * @param [in] dt : desired discretization step.
+ * @param [in] eventTimes : Event times where a time discretization must be made.
+ * @param [in] dt_min : minimum discretization step.
+ * @param [out] timeDiscretization : vector of discrete time points
+ */
+void timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, const scalar_array_t& eventTimes, scalar_t dt_min,
+                                  std::vector<AnnotatedTime>& timeDiscretization);
+
 /**
  * Extracts the time trajectory from the annotated time trajectory.
  *
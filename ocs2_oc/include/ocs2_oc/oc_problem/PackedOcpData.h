@@ -0,0 +1,277 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_oc/oc_problem/OcpSize.h"
+
+namespace ocs2 {
+
+/**
+ * The LQ approximation of an optimal control problem, as used by the first order QP solvers, packed into one contiguous buffer.
+ *
+ * The buffer is stage-major: all data of stage k lies in one block, which starts at a cache line boundary. Within the block, the
+ * matrices and vectors of the stage are stored one after the other, each column-major and 16-byte aligned. Stage k holds
+ *
+ *   dynamics : C_k x_{k+1} = A_k x_k + B_k u_k + b_k, where C_k is the diagonal of the (scaled) identity part of the constraints.
+ *   cost     : 0.5 x_k' Q_k x_k + 0.5 u_k' R_k u_k + u_k' P_k x_k + q_k' x_k + r_k' u_k
+ *
+ * The final stage N only holds Q_N and q_N. The accessors return Eigen::Map views, indexed as the dynamics and cost arrays.
+ *
+ * @tparam Scalar : The scalar type of the stored data.
+ */
+template <typename Scalar>
+class PackedOcpData {
+ public:
+  using matrix_type = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+  using vector_type = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+  using matrix_map = Eigen::Map<matrix_type, Eigen::Aligned16>;
+  using vector_map = Eigen::Map<vector_type, Eigen::Aligned16>;
+  using const_matrix_map = Eigen::Map<const matrix_type, Eigen::Aligned16>;
+  using const_vector_map = Eigen::Map<const vector_type, Eigen::Aligned16>;
+
+  PackedOcpData() = default;
+
+  /** Constructor with the layout of the given problem size. */
+  explicit PackedOcpData(const OcpSize& ocpSize) { resize(ocpSize); }
+
+  /** The views point into the own buffer. Therefore, the buffer is not copied. */
+  PackedOcpData(const PackedOcpData&) = delete;
+  PackedOcpData& operator=(const PackedOcpData&) = delete;
+  PackedOcpData(PackedOcpData&&) noexcept = default;
+  PackedOcpData& operator=(PackedOcpData&&) noexcept = default;
+
+  /** Sets the layout for the given problem size. The buffer is only reallocated if it needs to grow. The data is not preserved. */
+  void resize(const OcpSize& ocpSize);
+
+  /** Number of stages N. */
+  int numStages() const { return static_cast<int>(layout_.size()) - 1; }
+
+  /** Sizes of the problem. */
+  const OcpSize& ocpSize() const { return ocpSize_; }
+
+  /**
+   * Copies the dynamics of stage k < N into the buffer and converts it to Scalar.
+   *
+   * @param [in] k : The stage index.
+   * @param [in] dynamics : The dynamics of stage k.
+   * @param [in] scalingVector : The diagonal C_k. Pass nullptr for the identity.
+   */
+  void setDynamics(int k, const VectorFunctionLinearApproximation& dynamics, const vector_t* scalingVector);
+
+  /** Copies the cost of stage k <= N into the buffer and converts it to Scalar. The cost value cost.f is not stored. */
+  void setCost(int k, const ScalarFunctionQuadraticApproximation& cost);
+
+  /** Copies stage k from other data with the same layout and converts it to Scalar. */
+  template <typename OtherScalar>
+  void setStage(int k, const PackedOcpData<OtherScalar>& other);
+
+  /** Copies the dynamics and the diagonal C_k of stage k < N out of the buffer. */
+  void getDynamics(int k, VectorFunctionLinearApproximation& dynamics, vector_t& scalingVector) const;
+
+  /** Copies the cost of stage k <= N out of the buffer. The cost value cost.f is not touched. */
+  void getCost(int k, ScalarFunctionQuadraticApproximation& cost) const;
+
+  /** Dynamics of stage k < N */
+  matrix_map A(int k) { return {data(layout_[k].A), layout_[k].nxNext, layout_[k].nx}; }
+  matrix_map B(int k) { return {data(layout_[k].B), layout_[k].nxNext, layout_[k].nu}; }
+  vector_map b(int k) { return {data(layout_[k].b), layout_[k].nxNext}; }
+  vector_map C(int k) { return {data(layout_[k].C), layout_[k].nxNext}; }
+  const_matrix_map A(int k) const { return {data(layout_[k].A), layout_[k].nxNext, layout_[k].nx}; }
+  const_matrix_map B(int k) const { return {data(layout_[k].B), layout_[k].nxNext, layout_[k].nu}; }
+  const_vector_map b(int k) const { return {data(layout_[k].b), layout_[k].nxNext}; }
+  const_vector_map C(int k) const { return {data(layout_[k].C), layout_[k].nxNext}; }
+
+  /** Cost of stage k <= N */
+  matrix_map Q(int k) { return {data(layout_[k].Q), layout_[k].nx, layout_[k].nx}; }
+  matrix_map R(int k) { return {data(layout_[k].R), layout_[k].nu, layout_[k].nu}; }
+  matrix_map P(int k) { return {data(layout_[k].P), layout_[k].nu, layout_[k].nx}; }
+  vector_map q(int k) { return {data(layout_[k].q), layout_[k].nx}; }
+  vector_map r(int k) { return {data(layout_[k].r), layout_[k].nu}; }
+  const_matrix_map Q(int k) const { return {data(layout_[k].Q), layout_[k].nx, layout_[k].nx}; }
+  const_matrix_map R(int k) const { return {data(layout_[k].R), layout_[k].nu, layout_[k].nu}; }
+  const_matrix_map P(int k) const { return {data(layout_[k].P), layout_[k].nu, layout_[k].nx}; }
+  const_vector_map q(int k) const { return {data(layout_[k].q), layout_[k].nx}; }
+  const_vector_map r(int k) const { return {data(layout_[k].r), layout_[k].nu}; }
+
+ private:
+  /** Sizes and offsets (in number of Scalars) of the data of one stage. */
+  struct StageLayout {
+    int nx = 0;
+    int nu = 0;
+    int nxNext = 0;
+    size_t A = 0, B = 0, b = 0, C = 0;
+    size_t Q = 0, R = 0, P = 0, q = 0, r = 0;
+  };
+
+  static constexpr size_t cacheLineSize = 64;
+  static constexpr size_t blockAlignment = 16;
+
+  Scalar* data(size_t offset) { return buffer_.data() + bufferOffset_ + offset; }
+  const Scalar* data(size_t offset) const { return buffer_.data() + bufferOffset_ + offset; }
+
+  OcpSize ocpSize_;
+  std::vector<StageLayout> layout_;
+  std::vector<Scalar> buffer_;
+  size_t bufferOffset_ = 0;  // The first Scalar at a cache line boundary
+};
+
+template <typename Scalar>
+constexpr size_t PackedOcpData<Scalar>::cacheLineSize;
+
+template <typename Scalar>
+constexpr size_t PackedOcpData<Scalar>::blockAlignment;
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Scalar>
+void PackedOcpData<Scalar>::resize(const OcpSize& ocpSize) {
+  const int N = ocpSize.numStages;
+  ocpSize_ = ocpSize;
+  layout_.resize(N + 1);
+
+  size_t offset = 0;
+  auto alignOffset = [&offset](size_t alignment) {
+    const size_t numScalars = alignment / sizeof(Scalar);
+    offset = (offset + numScalars - 1) / numScalars * numScalars;
+  };
+  auto allocate = [&](size_t numScalars) {
+    alignOffset(blockAlignment);
+    const size_t start = offset;
+    offset += numScalars;
+    return start;
+  };
+
+  for (int k = 0; k <= N; k++) {
+    auto& stage = layout_[k];
+    stage.nx = ocpSize.numStates[k];
+    stage.nu = (k < N) ? ocpSize.numInputs[k] : 0;
+    stage.nxNext = (k < N) ? ocpSize.numStates[k + 1] : 0;
+
+    alignOffset(cacheLineSize);
+    stage.A = allocate(stage.nxNext * stage.nx);
+    stage.B = allocate(stage.nxNext * stage.nu);
+    stage.b = allocate(stage.nxNext);
+    stage.C = allocate(stage.nxNext);
+    stage.Q = allocate(stage.nx * stage.nx);
+    stage.R = allocate(stage.nu * stage.nu);
+    stage.P = allocate(stage.nu * stage.nx);
+    stage.q = allocate(stage.nx);
+    stage.r = allocate(stage.nu);
+  }
+
+  // Spare Scalars to shift the start of the data to a cache line boundary
+  const size_t bufferSize = offset + cacheLineSize / sizeof(Scalar);
+  if (buffer_.size() < bufferSize) {
+    buffer_ = std::vector<Scalar>(bufferSize);
+  }
+  const auto address = reinterpret_cast<std::uintptr_t>(buffer_.data());
+  bufferOffset_ = ((cacheLineSize - address % cacheLineSize) % cacheLineSize) / sizeof(Scalar);
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Scalar>
+void PackedOcpData<Scalar>::setDynamics(int k, const VectorFunctionLinearApproximation& dynamics, const vector_t* scalingVector) {
+  A(k) = dynamics.dfdx.cast<Scalar>();
+  B(k) = dynamics.dfdu.cast<Scalar>();
+  b(k) = dynamics.f.cast<Scalar>();
+  if (scalingVector != nullptr) {
+    C(k) = scalingVector->cast<Scalar>();
+  } else {
+    C(k).setOnes();
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Scalar>
+void PackedOcpData<Scalar>::setCost(int k, const ScalarFunctionQuadraticApproximation& cost) {
+  Q(k) = cost.dfdxx.cast<Scalar>();
+  q(k) = cost.dfdx.cast<Scalar>();
+  if (k < numStages()) {
+    R(k) = cost.dfduu.cast<Scalar>();
+    P(k) = cost.dfdux.cast<Scalar>();
+    r(k) = cost.dfdu.cast<Scalar>();
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Scalar>
+template <typename OtherScalar>
+void PackedOcpData<Scalar>::setStage(int k, const PackedOcpData<OtherScalar>& other) {
+  if (k < numStages()) {
+    A(k) = other.A(k).template cast<Scalar>();
+    B(k) = other.B(k).template cast<Scalar>();
+    b(k) = other.b(k).template cast<Scalar>();
+    C(k) = other.C(k).template cast<Scalar>();
+    R(k) = other.R(k).template cast<Scalar>();
+    P(k) = other.P(k).template cast<Scalar>();
+    r(k) = other.r(k).template cast<Scalar>();
+  }
+  Q(k) = other.Q(k).template cast<Scalar>();
+  q(k) = other.q(k).template cast<Scalar>();
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Scalar>
+void PackedOcpData<Scalar>::getDynamics(int k, VectorFunctionLinearApproximation& dynamics, vector_t& scalingVector) const {
+  dynamics.dfdx = A(k).template cast<scalar_t>();
+  dynamics.dfdu = B(k).template cast<scalar_t>();
+  dynamics.f = b(k).template cast<scalar_t>();
+  scalingVector = C(k).template cast<scalar_t>();
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Scalar>
+void PackedOcpData<Scalar>::getCost(int k, ScalarFunctionQuadraticApproximation& cost) const {
+  cost.dfdxx = Q(k).template cast<scalar_t>();
+  cost.dfdx = q(k).template cast<scalar_t>();
+  if (k < numStages()) {
+    cost.dfduu = R(k).template cast<scalar_t>();
+    cost.dfdux = P(k).template cast<scalar_t>();
+    cost.dfdu = r(k).template cast<scalar_t>();
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,178 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/**
+ * Solves the unconstrained linear-quadratic optimal control problem
+ *
+ * min_{x, u} sum_{k=0}^{N-1} [ 0.5 x_k' Q_k x_k + x_k' P_k' u_k + 0.5 u_k' R_k u_k + q_k' x_k + r_k' u_k ] + 0.5 x_N' Q_N x_N + q_N' x_N
+ * s.t.       x_{k+1} = A_k x_k + B_k u_k + b_k,  x_0 given,
+ *
+ * with a Riccati recursion that is parallelized over the horizon. The horizon is split into partitions. Each partition first condenses
+ * its stages into a single conditional value function V(x_start, x_end), represented in the dual form of
+ * "S. Särkkä and Á. F. García-Fernández, Temporal Parallelization of Dynamic Programming and Linear Quadratic Control, 2023".
+ * The condensed partitions are combined sequentially from the end of the horizon, which yields the cost-to-go at every partition
+ * boundary. Finally, each partition runs the standard Riccati recursion from its boundary. The forward pass is a sequential rollout of
+ * the resulting affine policy, since it is cheap compared to the backward pass.
+ *
+ * The cost matrices are expected as in ScalarFunctionQuadraticApproximation: dfdxx = Q, dfdux = P, dfduu = R, dfdx = q, dfdu = r.
+ * The dynamics are expected as in VectorFunctionLinearApproximation: dfdx = A, dfdu = B, f = b. R_k + B_k' S_{k+1} B_k has to be
+ * positive definite. With a single partition, the solver reduces to the sequential Riccati recursion.
+ */
+class PartitionedRiccatiSolver {
+ public:
+  /**
+   * Constructor
+   * @param [in] numPartitions : The number of horizon partitions. Typically the number of threads of the pool passed to solve().
+   */
+  explicit PartitionedRiccatiSolver(size_t numPartitions = 1);
+
+  /** Sets the number of horizon partitions. */
+  void setNumPartitions(size_t numPartitions) { numPartitions_ = std::max<size_t>(numPartitions, 1); }
+
+  /** Returns the number of horizon partitions. */
+  size_t getNumPartitions() const { return numPartitions_; }
+
+  /**
+   * Solves the linear-quadratic problem.
+   *
+   * @param [in] threadPool : The thread pool that processes the partitions.
+   * @param [in] x0 : The initial state.
+   * @param [in] dynamics : Linear dynamics for k = 0, ..., N-1.
+   * @param [in] cost : Quadratic cost for k = 0, ..., N. Only the state terms are used at k = N.
+   * @param [out] xTrajectory : The optimal state trajectory of length N + 1.
+   * @param [out] uTrajectory : The optimal input trajectory of length N.
+   */
+  void solve(ThreadPool& threadPool, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& xTrajectory, vector_array_t& uTrajectory);
+
+  /**
+   * Returns the N feedback matrices of the optimal policy u = K x + k of the previously solved problem.
+   */
+  const matrix_array_t& getRiccatiFeedback() const { return feedback_; }
+
+  /**
+   * Returns the N feedforward vectors of the optimal policy u = K x + k of the previously solved problem.
+   */
+  const vector_array_t& getRiccatiFeedforward() const { return feedforward_; }
+
+  /**
+   * Returns the N + 1 cost-to-go's of the previously solved problem: V_k(x) = 0.5 * x' * dfdxx * x + x' * dfdx.
+   * The constant f is set to zero.
+   */
+  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo() const;
+
+  /** Writes the cost-to-go's of getRiccatiCostToGo() into the given array, reusing its memory. */
+  void getRiccatiCostToGo(std::vector<ScalarFunctionQuadraticApproximation>& costToGo) const;
+
+ private:
+  /**
+   * Conditional value function V(x, y) = 0.5 x' J x - eta' x + max_lambda { lambda' (y - A x - b) - 0.5 lambda' C lambda }, i.e.
+   * the optimal cost from state x to state y.
+   */
+  struct ConditionalValueFunction {
+    matrix_t A;
+    vector_t b;
+    matrix_t C;
+    vector_t eta;
+    matrix_t J;
+  };
+
+  /**
+   * Temporaries of a single partition. They are kept between calls, such that solving problems of unchanged dimensions does not
+   * allocate memory.
+   */
+  struct Workspace {
+    // Stage condensation
+    matrix_t RinvP;
+    matrix_t RinvBt;
+    vector_t Rinvr;
+    // Combination of conditional value functions
+    matrix_t IplusCJ;
+    matrix_t T;
+    matrix_t luSolution;
+    matrix_t product;
+    vector_t vector;
+    vector_t luVectorSolution;
+    // Riccati recursion
+    matrix_t SA;
+    matrix_t SB;
+    matrix_t G;
+    matrix_t H;
+    vector_t Sbs;
+    vector_t g;
+    // Factorizations
+    Eigen::LLT<matrix_t> llt;
+    Eigen::PartialPivLU<matrix_t> lu;
+  };
+
+  /** Condenses the stage k < N into a conditional value function. */
+  static void getStageElement(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                              ConditionalValueFunction& element, Workspace& workspace);
+
+  /** Combines V_i(x, y) of the earlier stages with V_j(y, z) of the later stages into V_ij(x, z) = min_y V_i(x, y) + V_j(y, z). */
+  static void combine(const ConditionalValueFunction& first, const ConditionalValueFunction& second, ConditionalValueFunction& result,
+                      Workspace& workspace);
+
+  /**
+   * Combines V_i(x, y) with a cost-to-go V(y) = 0.5 y' S y + s' y into the cost-to-go min_y V_i(x, y) + V(y).
+   * The outputs must not alias the inputs.
+   */
+  static void combineWithCostToGo(const ConditionalValueFunction& first, const matrix_t& S, const vector_t& s, matrix_t& SOut,
+                                  vector_t& sOut, Workspace& workspace);
+
+  /** Runs the Riccati recursion for the stages [begin, end), given the cost-to-go at stage end. */
+  void riccatiRecursion(int begin, int end, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                        const std::vector<ScalarFunctionQuadraticApproximation>& cost, Workspace& workspace);
+
+  size_t numPartitions_;
+
+  // Partition data
+  std::vector<int> partitionStart_;
+  std::vector<ConditionalValueFunction> partitionElements_;
+  std::vector<ConditionalValueFunction> elementWorkspace_;
+  std::vector<Workspace> workspace_;
+
+  // Riccati data
+  matrix_array_t S_;
+  vector_array_t s_;
+  matrix_array_t feedback_;
+  vector_array_t feedforward_;
+};
+
+}  // namespace ocs2
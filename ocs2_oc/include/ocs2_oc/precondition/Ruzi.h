@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include "ocs2_oc/oc_problem/OcpSize.h"
+#include "ocs2_oc/oc_problem/PackedOcpData.h"
 
 namespace ocs2 {
 namespace precondition {
@@ -94,6 +95,41 @@ void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const
                               std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
                               vector_array_t& scalingVectors, scalar_t& cOut);
 
+/**
+ * Same as the above, but operates on the packed stage-major layout. The scaling vectors are stored in place of the identity
+ * blocks of the dynamics, i.e., PackedOcpData::C(k), which are reset to ones before scaling.
+ *
+ * @param [in] threadPool : The external thread pool.
+ * @param [in] x0 : The initial state.
+ * @param [in] iteration : Number of iterations.
+ * @param [in, out] ocpData : The packed dynamics and cost data of all time points.
+ * @param [out] DOut : The matrix D decomposed for each time step.
+ * @param [out] EOut : The matrix E decomposed for each time step.
+ * @param [out] cOut : Scaling factor c.
+ */
+void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const int iteration, PackedOcpData<scalar_t>& ocpData,
+                              vector_array_t& DOut, vector_array_t& EOut, scalar_t& cOut);
+
+/**
+ * Incremental variant of the above, which starts from a given scaling, e.g., the one of the previous problem. The given scaling is
+ * applied to the data at once, and the Ruiz passes continue from there until the infinity norms of all nonzero rows and columns of
+ * the KKT matrix deviate from one by at most the tolerance, or maxIteration passes are done. The scaling factors of the passes
+ * are accumulated into the given ones. If the given scaling does not fit the problem size, it starts from the identity.
+ *
+ * @param [in] threadPool : The external thread pool.
+ * @param [in] x0 : The initial state.
+ * @param [in] maxIteration : Maximum number of passes.
+ * @param [in] tolerance : The tolerance on the deviation of the row and column infinity norms from one.
+ * @param [in, out] ocpData : The packed dynamics and cost data of all time points.
+ * @param [in, out] DInOut : The matrix D decomposed for each time step.
+ * @param [in, out] EInOut : The matrix E decomposed for each time step.
+ * @param [in, out] cInOut : Scaling factor c.
+ * @return The number of passes done.
+ */
+size_t ocpDataIncrementallyInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const size_t maxIteration,
+                                             const scalar_t tolerance, PackedOcpData<scalar_t>& ocpData, vector_array_t& DInOut,
+                                             vector_array_t& EInOut, scalar_t& cInOut);
+
 /**
  * Calculates the pre-conditioning factors D, E, and c, and scale the input dynamics, and cost data in place in place.
  *
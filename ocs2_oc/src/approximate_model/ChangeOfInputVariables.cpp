@@ -32,7 +32,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 
 void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
-                            const vector_t& u0) {
+                            const vector_t& u0, const column_blocks_t* PxColumnsPtr) {
+  ChangeOfInputVariablesWorkspace workspace;
+  ScalarFunctionQuadraticApproximation result;
+  changeOfInputVariables(quadraticApproximation, Pu, Px, u0, PxColumnsPtr, workspace, result);
+  quadraticApproximation = std::move(result);
+}
+
+void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, const column_blocks_t* PxColumnsPtr, ChangeOfInputVariablesWorkspace& workspace,
+                            ScalarFunctionQuadraticApproximation& result) {
   /*
    * 3 temporaries are needed in any branch because Pu is non-zero and:
    *  - new P contains a product Pu'*P
@@ -45,23 +54,43 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
    */
   const bool hasPx(Px.size() > 0);
   const bool hasu0(u0.size() > 0);
+  // Calls f(start, size) for each block of non-zero columns of Px.
+  const auto forEachPxBlock = [&](const auto& f) {
+    if (PxColumnsPtr == nullptr) {
+      f(0, Px.cols());
+    } else {
+      for (const auto& block : *PxColumnsPtr) {
+        f(block.start, block.size);
+      }
+    }
+  };
 
   // Shared term number 1
-  matrix_t P_plus_R_Px = quadraticApproximation.dfdux;
+  auto& P_plus_R_Px = workspace.P_plus_R_Px;
+  P_plus_R_Px = quadraticApproximation.dfdux;
   if (hasPx) {
-    P_plus_R_Px.noalias() += quadraticApproximation.dfduu * Px;
+    forEachPxBlock([&](int start, int size) {
+      P_plus_R_Px.middleCols(start, size).noalias() += quadraticApproximation.dfduu * Px.middleCols(start, size);
+    });
   }  // else added term is zero
 
   // Shared term number 2
-  vector_t r_plus_R_u0 = quadraticApproximation.dfdu;
+  auto& r_plus_R_u0 = workspace.r_plus_R_u0;
+  r_plus_R_u0 = quadraticApproximation.dfdu;
   if (hasu0) {
     r_plus_R_u0.noalias() += quadraticApproximation.dfduu * u0;
   }  // else added term is zero
 
   // Q = Q + P'*Px + Px'*P + Px'*R*Px = Q + P'*Px + Px'*(P + R*Px)
+  // Only the columns of P'*Px and the rows of Px'*(P + R*Px) that belong to the non-zero columns of Px are updated.
   if (hasPx) {
-    quadraticApproximation.dfdxx.noalias() += quadraticApproximation.dfdux.transpose() * Px;  // Before adapting dfdux!
-    quadraticApproximation.dfdxx.noalias() += Px.transpose() * P_plus_R_Px;
+    forEachPxBlock([&](int start, int size) {
+      quadraticApproximation.dfdxx.middleCols(start, size).noalias() +=
+          quadraticApproximation.dfdux.transpose() * Px.middleCols(start, size);  // Before adapting dfdux!
+    });
+    forEachPxBlock([&](int start, int size) {
+      quadraticApproximation.dfdxx.middleRows(start, size).noalias() += Px.middleCols(start, size).transpose() * P_plus_R_Px;
+    });
   }  // else Q remains unaltered
 
   // q = q + P' * u0 + Px' (R*u0 + r)
@@ -69,7 +98,9 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
     quadraticApproximation.dfdx.noalias() += quadraticApproximation.dfdux.transpose() * u0;  // Before adapting dfdux!
   }
   if (hasPx) {
-    quadraticApproximation.dfdx.noalias() += Px.transpose() * r_plus_R_u0;
+    forEachPxBlock([&](int start, int size) {
+      quadraticApproximation.dfdx.segment(start, size).noalias() += Px.middleCols(start, size).transpose() * r_plus_R_u0;
+    });
   }
 
   // c = c + r'*u0 + 1/2*u0'*R*u0 = 1/2*u0'((R*u0 + r) + r)
@@ -78,24 +109,44 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
   }
 
   // P = Pu'*P + Pu'*R*Px = Pu'*(P + R*Px)
-  quadraticApproximation.dfdux.noalias() = Pu.transpose() * P_plus_R_Px;
+  result.dfdux.noalias() = Pu.transpose() * P_plus_R_Px;
 
   // R = Pu' * R * Pu
-  matrix_t R_Pu = quadraticApproximation.dfduu * Pu;  // make the required temporary explicit, to save it in the second multiplication
-  quadraticApproximation.dfduu.noalias() = Pu.transpose() * R_Pu;
+  auto& R_Pu = workspace.R_Pu;  // make the required temporary explicit, to save it in the second multiplication
+  R_Pu.noalias() = quadraticApproximation.dfduu * Pu;
+  result.dfduu.noalias() = Pu.transpose() * R_Pu;
 
   // r = Pu' * (R*u0 + r)
-  quadraticApproximation.dfdu.noalias() = Pu.transpose() * r_plus_R_u0;
+  result.dfdu.noalias() = Pu.transpose() * r_plus_R_u0;
+
+  // Q, q, and c were adapted in-place
+  result.dfdxx.swap(quadraticApproximation.dfdxx);
+  result.dfdx.swap(quadraticApproximation.dfdx);
+  result.f = quadraticApproximation.f;
 }
 
 void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px,
-                            const vector_t& u0) {
+                            const vector_t& u0, const column_blocks_t* PxColumnsPtr) {
+  VectorFunctionLinearApproximation result;
+  changeOfInputVariables(linearApproximation, Pu, Px, u0, PxColumnsPtr, result);
+  linearApproximation = std::move(result);
+}
+
+void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, const column_blocks_t* PxColumnsPtr, VectorFunctionLinearApproximation& result) {
   const bool hasPx(Px.size() > 0);
   const bool hasu0(u0.size() > 0);
 
   // A = A + B*Px
   if (hasPx) {
-    linearApproximation.dfdx.noalias() += linearApproximation.dfdu * Px;  // Before adapting dfdu!
+    if (PxColumnsPtr == nullptr) {
+      linearApproximation.dfdx.noalias() += linearApproximation.dfdu * Px;  // Before adapting dfdu!
+    } else {
+      for (const auto& block : *PxColumnsPtr) {
+        linearApproximation.dfdx.middleCols(block.start, block.size).noalias() +=
+            linearApproximation.dfdu * Px.middleCols(block.start, block.size);  // Before adapting dfdu!
+      }
+    }
   }
 
   // b = b + B*u0
@@ -104,7 +155,11 @@ void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximati
   }
 
   // B = B*Pu
-  linearApproximation.dfdu = linearApproximation.dfdu * Pu;  // temporary matrix unavoidable
+  result.dfdu.noalias() = linearApproximation.dfdu * Pu;
+
+  // A and b were adapted in-place
+  result.dfdx.swap(linearApproximation.dfdx);
+  result.f.swap(linearApproximation.f);
 }
 
 }  // namespace ocs2
@@ -55,6 +55,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 
 // oc_solver
+#include <ocs2_oc/oc_solver/PartitionedRiccatiSolver.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 
 // precondition
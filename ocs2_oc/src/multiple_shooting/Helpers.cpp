@@ -29,12 +29,45 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/multiple_shooting/Helpers.h"
 
+#include <algorithm>
+
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 
 namespace ocs2 {
 namespace multiple_shooting {
 
+namespace {
+/** Writes the time, state and input trajectories of the primal solution, reusing the memory of its trajectories. */
+void setNominalTrajectories(const std::vector<AnnotatedTime>& time, const ModeSchedule& modeSchedule, const vector_array_t& x,
+                            const vector_array_t& u, PrimalSolution& primalSolution) {
+  primalSolution.timeTrajectory_.resize(time.size());
+  primalSolution.postEventIndices_.clear();
+  for (int i = 0; i < time.size(); ++i) {
+    primalSolution.timeTrajectory_[i] = time[i].time;
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      primalSolution.postEventIndices_.push_back(i + 1);
+    }
+  }
+
+  primalSolution.stateTrajectory_ = x;
+
+  // Correct for missing inputs at PreEvents and repeat the last input to make equal length vectors
+  auto& inputTrajectory = primalSolution.inputTrajectory_;
+  inputTrajectory.resize(u.size() + 1);
+  for (int i = 0; i < u.size(); ++i) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent && i > 0) {
+      inputTrajectory[i] = inputTrajectory[i - 1];
+    } else {
+      inputTrajectory[i] = u[i];
+    }
+  }
+  inputTrajectory.back() = inputTrajectory[u.size() - 1];
+
+  primalSolution.modeSchedule_ = modeSchedule;
+}
+}  // anonymous namespace
+
 void remapProjectedInput(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, const vector_array_t& deltaXSol,
                          vector_array_t& deltaUSol) {
   vector_t tmp;  // 1 temporary for re-use.
@@ -47,6 +80,20 @@ void remapProjectedInput(const std::vector<VectorFunctionLinearApproximation>& c
   }
 }
 
+void remapProjectedInput(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, const vector_array_t& deltaXSol,
+                         const vector_array_t& deltaUSolProjected, vector_array_t& deltaUSol) {
+  deltaUSol.resize(deltaUSolProjected.size());
+  for (int i = 0; i < deltaUSol.size(); ++i) {
+    if (constraintsProjection[i].f.size() > 0) {
+      deltaUSol[i] = constraintsProjection[i].f;
+      deltaUSol[i].noalias() += constraintsProjection[i].dfdu * deltaUSolProjected[i];
+      deltaUSol[i].noalias() += constraintsProjection[i].dfdx * deltaXSol[i];
+    } else {
+      deltaUSol[i] = deltaUSolProjected[i];
+    }
+  }
+}
+
 void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, matrix_array_t& KMatrices) {
   matrix_t tmp;  // 1 temporary for re-use.
   for (int i = 0; i < KMatrices.size(); ++i) {
@@ -57,6 +104,19 @@ void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& co
   }
 }
 
+void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection,
+                        const matrix_array_t& KMatricesProjected, matrix_array_t& KMatrices) {
+  KMatrices.resize(KMatricesProjected.size());
+  for (int i = 0; i < KMatrices.size(); ++i) {
+    if (constraintsProjection[i].f.size() > 0) {
+      KMatrices[i] = constraintsProjection[i].dfdx;
+      KMatrices[i].noalias() += constraintsProjection[i].dfdu * KMatricesProjected[i];
+    } else {
+      KMatrices[i] = KMatricesProjected[i];
+    }
+  }
+}
+
 PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSchedule&& modeSchedule, vector_array_t&& x,
                                 vector_array_t&& u) {
   // Correct for missing inputs at PreEvents and the terminal time
@@ -119,6 +179,55 @@ PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSche
   return primalSolution;
 }
 
+void toPrimalSolution(const std::vector<AnnotatedTime>& time, const ModeSchedule& modeSchedule, const vector_array_t& x,
+                      const vector_array_t& u, PrimalSolution& primalSolution) {
+  setNominalTrajectories(time, modeSchedule, x, u, primalSolution);
+
+  // Reuse the controller if it has the right type
+  auto* controllerPtr = dynamic_cast<FeedforwardController*>(primalSolution.controllerPtr_.get());
+  if (controllerPtr == nullptr) {
+    controllerPtr = new FeedforwardController();
+    primalSolution.controllerPtr_.reset(controllerPtr);
+  }
+  controllerPtr->setController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_);
+}
+
+void toPrimalSolution(const std::vector<AnnotatedTime>& time, const ModeSchedule& modeSchedule, const vector_array_t& x,
+                      const vector_array_t& u, const matrix_array_t& KMatrices, PrimalSolution& primalSolution) {
+  setNominalTrajectories(time, modeSchedule, x, u, primalSolution);
+
+  // Reuse the controller if it has the right type
+  auto* controllerPtr = dynamic_cast<LinearController*>(primalSolution.controllerPtr_.get());
+  if (controllerPtr == nullptr) {
+    controllerPtr = new LinearController();
+    primalSolution.controllerPtr_.reset(controllerPtr);
+  }
+  controllerPtr->timeStamp_ = primalSolution.timeTrajectory_;
+  controllerPtr->deltaBiasArray_.clear();
+
+  // Compute feedback directly in the controller, see doc/LQR_full.pdf for detailed derivation for feedback terms
+  auto& uff = controllerPtr->biasArray_;
+  auto& gains = controllerPtr->gainArray_;
+  uff.resize(KMatrices.size() + 1);
+  gains.resize(KMatrices.size() + 1);
+  for (int i = 0; i < KMatrices.size(); ++i) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent && i > 0) {
+      uff[i] = uff[i - 1];
+      gains[i] = gains[i - 1];
+    } else {
+      // Linear controller has convention u = uff + K * x;
+      // We computed u = u'(t) + K (x - x'(t));
+      // >> uff = u'(t) - K x'(t)
+      gains[i] = KMatrices[i];
+      uff[i] = u[i];
+      uff[i].noalias() -= KMatrices[i] * x[i];
+    }
+  }
+  // Copy last one to get correct length
+  uff.back() = uff[KMatrices.size() - 1];
+  gains.back() = gains[KMatrices.size() - 1];
+}
+
 ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vector<Metrics>&& metrics) {
   assert(time.size() > 1);
   assert(metrics.size() == time.size());
@@ -143,5 +252,30 @@ ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vec
   return problemMetrics;
 }
 
+void toProblemMetrics(const std::vector<AnnotatedTime>& time, const std::vector<Metrics>& metrics, ProblemMetrics& problemMetrics) {
+  assert(time.size() > 1);
+  assert(metrics.size() == time.size());
+
+  // Problem horizon
+  const int N = static_cast<int>(time.size()) - 1;
+
+  // resize
+  const auto numPreJumps = std::count_if(time.begin(), std::prev(time.end()),
+                                         [](const AnnotatedTime& t) { return t.event == AnnotatedTime::Event::PreEvent; });
+  problemMetrics.preJumps.resize(numPreJumps);
+  problemMetrics.intermediates.resize(N - numPreJumps);
+  problemMetrics.final = metrics.back();
+
+  auto preJumpIt = problemMetrics.preJumps.begin();
+  auto intermediateIt = problemMetrics.intermediates.begin();
+  for (int i = 0; i < N; ++i) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      *(preJumpIt++) = metrics[i];
+    } else {
+      *(intermediateIt++) = metrics[i];
+    }
+  }
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -32,14 +32,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
-void initializeStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
-                                      const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
-                                      vector_array_t& inputTrajectory) {
+namespace {
+/**
+ * Initializes the state-input trajectories from the previous solution in the interval it covers. The tail is extrapolated by holding
+ * the last input of the previous solution if a discretizer is given, and by the initializer otherwise or after an event in the tail.
+ */
+void initializeTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
+                            const PrimalSolution& primalSolution, Initializer& initializer, const DynamicsDiscretizer* discretizerPtr,
+                            SystemDynamicsBase* systemDynamicsPtr, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
   const int N = static_cast<int>(timeDiscretization.size()) - 1;  // // size of the input trajectory
-  stateTrajectory.clear();
-  stateTrajectory.reserve(N + 1);
-  inputTrajectory.clear();
-  inputTrajectory.reserve(N);
+  // Resize instead of clearing, such that the memory of the elements is reused for an unchanged horizon.
+  stateTrajectory.resize(N + 1);
+  inputTrajectory.resize(N);
 
   // Determine till when to use the previous solution
   scalar_t interpolateStateTill = timeDiscretization.front().time;
@@ -49,34 +53,67 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
     interpolateInputTill = primalSolution.timeTrajectory_[primalSolution.timeTrajectory_.size() - 2];
   }
 
+  // The tail is extrapolated with the last input of the previous solution until the first event in the tail
+  bool extrapolateTail = discretizerPtr != nullptr && primalSolution.timeTrajectory_.size() >= 2 &&
+                         primalSolution.inputTrajectory_.size() == primalSolution.timeTrajectory_.size() &&
+                         primalSolution.inputTrajectory_.back().size() > 0;
+  bool inTail = false;
+
+  // The nodes are visited in increasing time, the lookup of each node starts from the previous one.
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  int inputHint = 0;
+  int stateHint = 0;
+
   // Initial state
   const scalar_t initTime = getIntervalStart(timeDiscretization[0]);
   if (initTime < interpolateStateTill) {
-    stateTrajectory.push_back(LinearInterpolation::interpolate(initTime, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_));
+    const auto indexAlpha = LinearInterpolation::timeSegment(initTime, timeTrajectory, stateHint);
+    LinearInterpolation::interpolate(indexAlpha, primalSolution.stateTrajectory_, stateTrajectory[0]);
   } else {
-    stateTrajectory.push_back(initState);
+    stateTrajectory[0] = initState;
   }
 
   for (int i = 0; i < N; i++) {
     if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
       // Event Node
-      inputTrajectory.push_back(vector_t());  // no input at event node
-      stateTrajectory.push_back(initializeEventNode(timeDiscretization[i].time, stateTrajectory.back()));
+      inputTrajectory[i].resize(0);  // no input at event node
+      stateTrajectory[i + 1] = initializeEventNode(timeDiscretization[i].time, stateTrajectory[i]);
+      extrapolateTail = extrapolateTail && !inTail;
     } else {
       // Intermediate node
       const scalar_t time = getIntervalStart(timeDiscretization[i]);
       const scalar_t nextTime = getIntervalEnd(timeDiscretization[i + 1]);
-      vector_t input, nextState;
-      if (time > interpolateInputTill || nextTime > interpolateStateTill) {  // Using initializer
-        std::tie(input, nextState) = initializeIntermediateNode(initializer, time, nextTime, stateTrajectory.back());
+      if (time > interpolateInputTill || nextTime > interpolateStateTill) {
+        inTail = true;
+        if (extrapolateTail) {  // Holding the last input
+          inputTrajectory[i] = primalSolution.inputTrajectory_.back();
+          stateTrajectory[i + 1] = (*discretizerPtr)(*systemDynamicsPtr, time, stateTrajectory[i], inputTrajectory[i], nextTime - time);
+        } else {  // Using initializer
+          initializer.compute(time, stateTrajectory[i], nextTime, inputTrajectory[i], stateTrajectory[i + 1]);
+        }
       } else {  // interpolate previous solution
-        std::tie(input, nextState) = initializeIntermediateNode(primalSolution, time, nextTime);
+        const auto inputIndexAlpha = LinearInterpolation::timeSegment(time, timeTrajectory, inputHint);
+        LinearInterpolation::interpolate(inputIndexAlpha, primalSolution.inputTrajectory_, inputTrajectory[i]);
+        const auto stateIndexAlpha = LinearInterpolation::timeSegment(nextTime, timeTrajectory, stateHint);
+        LinearInterpolation::interpolate(stateIndexAlpha, primalSolution.stateTrajectory_, stateTrajectory[i + 1]);
       }
-      inputTrajectory.push_back(std::move(input));
-      stateTrajectory.push_back(std::move(nextState));
     }
   }
 }
+}  // unnamed namespace
+
+void initializeStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
+                                      const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
+                                      vector_array_t& inputTrajectory) {
+  initializeTrajectories(initState, timeDiscretization, primalSolution, initializer, nullptr, nullptr, stateTrajectory, inputTrajectory);
+}
+
+void shiftStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
+                                 const PrimalSolution& primalSolution, Initializer& initializer, const DynamicsDiscretizer& discretizer,
+                                 SystemDynamicsBase& systemDynamics, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+  initializeTrajectories(initState, timeDiscretization, primalSolution, initializer, &discretizer, &systemDynamics, stateTrajectory,
+                         inputTrajectory);
+}
 
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -34,10 +34,26 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
-Metrics computeMetrics(const Transcription& transcription) {
-  const auto& constraintsSize = transcription.constraintsSize;
+namespace {
+
+/** The Lagrangians are not part of the transcription. Clearing keeps the memory of the arrays. */
+void clearLagrangians(Metrics& metrics) {
+  metrics.stateEqLagrangian.clear();
+  metrics.stateIneqLagrangian.clear();
+  metrics.stateInputEqLagrangian.clear();
+  metrics.stateInputIneqLagrangian.clear();
+}
+
+}  // anonymous namespace
 
+Metrics computeMetrics(const Transcription& transcription) {
   Metrics metrics;
+  computeMetrics(transcription, metrics);
+  return metrics;
+}
+
+void computeMetrics(const Transcription& transcription, Metrics& metrics) {
+  const auto& constraintsSize = transcription.constraintsSize;
 
   // Cost
   metrics.cost = transcription.cost.f;
@@ -46,20 +62,24 @@ Metrics computeMetrics(const Transcription& transcription) {
   metrics.dynamicsViolation = transcription.dynamics.f;
 
   // Equality constraints
-  metrics.stateEqConstraint = toConstraintArray(constraintsSize.stateEq, transcription.stateEqConstraints.f);
-  metrics.stateInputEqConstraint = toConstraintArray(constraintsSize.stateInputEq, transcription.stateInputEqConstraints.f);
+  toConstraintArray(constraintsSize.stateEq, transcription.stateEqConstraints.f, metrics.stateEqConstraint);
+  toConstraintArray(constraintsSize.stateInputEq, transcription.stateInputEqConstraints.f, metrics.stateInputEqConstraint);
 
   // Inequality constraints.
-  metrics.stateIneqConstraint = toConstraintArray(constraintsSize.stateIneq, transcription.stateIneqConstraints.f);
-  metrics.stateInputIneqConstraint = toConstraintArray(constraintsSize.stateInputIneq, transcription.stateInputIneqConstraints.f);
+  toConstraintArray(constraintsSize.stateIneq, transcription.stateIneqConstraints.f, metrics.stateIneqConstraint);
+  toConstraintArray(constraintsSize.stateInputIneq, transcription.stateInputIneqConstraints.f, metrics.stateInputIneqConstraint);
 
-  return metrics;
+  clearLagrangians(metrics);
 }
 
 Metrics computeMetrics(const EventTranscription& transcription) {
-  const auto& constraintsSize = transcription.constraintsSize;
-
   Metrics metrics;
+  computeMetrics(transcription, metrics);
+  return metrics;
+}
+
+void computeMetrics(const EventTranscription& transcription, Metrics& metrics) {
+  const auto& constraintsSize = transcription.constraintsSize;
 
   // Cost
   metrics.cost = transcription.cost.f;
@@ -68,52 +88,67 @@ Metrics computeMetrics(const EventTranscription& transcription) {
   metrics.dynamicsViolation = transcription.dynamics.f;
 
   // Equality constraints
-  metrics.stateEqConstraint = toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f);
+  toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f, metrics.stateEqConstraint);
+  metrics.stateInputEqConstraint.clear();
 
   // Inequality constraints.
-  metrics.stateIneqConstraint = toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f);
+  toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f, metrics.stateIneqConstraint);
+  metrics.stateInputIneqConstraint.clear();
 
-  return metrics;
+  clearLagrangians(metrics);
 }
 
 Metrics computeMetrics(const TerminalTranscription& transcription) {
-  const auto& constraintsSize = transcription.constraintsSize;
-
   Metrics metrics;
+  computeMetrics(transcription, metrics);
+  return metrics;
+}
+
+void computeMetrics(const TerminalTranscription& transcription, Metrics& metrics) {
+  const auto& constraintsSize = transcription.constraintsSize;
 
   // Cost
   metrics.cost = transcription.cost.f;
 
+  // Dynamics
+  metrics.dynamicsViolation.resize(0);
+
   // Equality constraints
-  metrics.stateEqConstraint = toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f);
+  toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f, metrics.stateEqConstraint);
+  metrics.stateInputEqConstraint.clear();
 
   // Inequality constraints.
-  metrics.stateIneqConstraint = toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f);
+  toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f, metrics.stateIneqConstraint);
+  metrics.stateInputIneqConstraint.clear();
 
-  return metrics;
+  clearLagrangians(metrics);
 }
 
 Metrics computeIntermediateMetrics(OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer, scalar_t t, scalar_t dt,
                                    const vector_t& x, const vector_t& x_next, const vector_t& u) {
-  // Dynamics
-  auto dynamicsViolation = discretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
-  dynamicsViolation -= x_next;
-
-  // Precomputation
+  // Precomputation, includes the dynamics at the node if they share the pre-computation module
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
-  optimalControlProblem.preComputationPtr->request(request, t, x, u);
-
-  // Compute metrics
-  auto metrics = computeIntermediateMetrics(optimalControlProblem, t, x, u, std::move(dynamicsViolation));
+  if (optimalControlProblem.dynamicsPtr->hasSharedPreComputation()) {
+    optimalControlProblem.preComputationPtr->cachedRequest(request + Request::Dynamics, t, x, u);
+  } else {
+    optimalControlProblem.preComputationPtr->cachedRequest(request, t, x, u);
+  }
+
+  // Compute metrics, the dynamics violation is set below
+  auto metrics = computeIntermediateMetrics(optimalControlProblem, t, x, u, vector_t());
   metrics.cost *= dt;  // consider dt
 
+  // Dynamics, last because the discretization can request the pre-computation at other points than the node
+  metrics.dynamicsViolation = discretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
+  metrics.dynamicsViolation -= x_next;
+
   return metrics;
 }
 
 Metrics computeTerminalMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
   // Precomputation
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
-  optimalControlProblem.preComputationPtr->requestFinal(request, t, x);
+  optimalControlProblem.preComputationPtr->cachedRequestFinal(request, t, x);
 
   return computeFinalMetrics(optimalControlProblem, t, x);
 }
@@ -121,7 +156,7 @@ Metrics computeTerminalMetrics(OptimalControlProblem& optimalControlProblem, sca
 Metrics computeEventMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next) {
   // Precomputation
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Dynamics;
-  optimalControlProblem.preComputationPtr->requestPreJump(request, t, x);
+  optimalControlProblem.preComputationPtr->cachedRequestPreJump(request, t, x);
 
   // Dynamics
   auto dynamicsViolation = optimalControlProblem.dynamicsPtr->computeJumpMap(t, x);
@@ -36,13 +36,24 @@ void ProjectionMultiplierCoefficients::compute(const ScalarFunctionQuadraticAppr
                                                const VectorFunctionLinearApproximation& dynamics,
                                                const VectorFunctionLinearApproximation& constraintProjection,
                                                const matrix_t& pseudoInverse) {
-  vector_t semiprojectedCost_dfdu = cost.dfdu;
+  Workspace workspace;
+  compute(cost, dynamics, constraintProjection, pseudoInverse, workspace);
+}
+
+void ProjectionMultiplierCoefficients::compute(const ScalarFunctionQuadraticApproximation& cost,
+                                               const VectorFunctionLinearApproximation& dynamics,
+                                               const VectorFunctionLinearApproximation& constraintProjection, const matrix_t& pseudoInverse,
+                                               Workspace& workspace) {
+  auto& semiprojectedCost_dfdu = workspace.semiprojectedCost_dfdu;
+  semiprojectedCost_dfdu = cost.dfdu;
   semiprojectedCost_dfdu.noalias() += cost.dfduu * constraintProjection.f;
 
-  matrix_t semiprojectedCost_dfdux = cost.dfdux;
+  auto& semiprojectedCost_dfdux = workspace.semiprojectedCost_dfdux;
+  semiprojectedCost_dfdux = cost.dfdux;
   semiprojectedCost_dfdux.noalias() += cost.dfduu * constraintProjection.dfdx;
 
-  const matrix_t semiprojectedCost_dfduu = cost.dfduu * constraintProjection.dfdu;
+  auto& semiprojectedCost_dfduu = workspace.semiprojectedCost_dfduu;
+  semiprojectedCost_dfduu.noalias() = cost.dfduu * constraintProjection.dfdu;
 
   this->dfdx.noalias() = -pseudoInverse * semiprojectedCost_dfdux;
   this->dfdu.noalias() = -pseudoInverse * semiprojectedCost_dfduu;
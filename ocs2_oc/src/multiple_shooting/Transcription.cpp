@@ -37,26 +37,43 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
+namespace {
+
+/** Clears an approximation of a constraint that is not present, such that it is equivalent to a default constructed one. */
+void clearApproximation(VectorFunctionLinearApproximation& approximation) {
+  approximation.f.resize(0);
+  approximation.dfdx.resize(0, 0);
+  approximation.dfdu.resize(0, 0);
+}
+
+}  // anonymous namespace
+
 Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
-  // Results and short-hand notation
   Transcription transcription;
+  setupIntermediateNode(optimalControlProblem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+  return transcription;
+}
+
+void setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer, scalar_t t,
+                           scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u, Transcription& transcription) {
+  // Results and short-hand notation
   auto& cost = transcription.cost;
   auto& dynamics = transcription.dynamics;
   auto& constraintsSize = transcription.constraintsSize;
   auto& stateEqConstraints = transcription.stateEqConstraints;
   auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
+  auto& stateInputEqConstraintsSparsity = transcription.stateInputEqConstraintsSparsity;
   auto& stateIneqConstraints = transcription.stateIneqConstraints;
   auto& stateInputIneqConstraints = transcription.stateInputIneqConstraints;
 
-  // Dynamics
-  // Discretization returns x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
-  dynamics = sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
-  dynamics.f -= x_next;  // make it dx_{k+1} = ...
-
-  // Precomputation for other terms
+  // Precomputation, includes the dynamics at the node if they share the pre-computation module
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
-  optimalControlProblem.preComputationPtr->request(request, t, x, u);
+  if (optimalControlProblem.dynamicsPtr->hasSharedPreComputation()) {
+    optimalControlProblem.preComputationPtr->cachedRequest(request + Request::Dynamics, t, x, u);
+  } else {
+    optimalControlProblem.preComputationPtr->cachedRequest(request, t, x, u);
+  }
 
   // Costs: Approximate the integral with forward euler
   cost = approximateCost(optimalControlProblem, t, x, u);
@@ -64,39 +81,78 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
 
   // State equality constraints
   if (!optimalControlProblem.stateEqualityConstraintPtr->empty()) {
-    constraintsSize.stateEq = optimalControlProblem.stateEqualityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.stateEqualityConstraintPtr->getTermsSize(t, constraintsSize.stateEq);
     stateEqConstraints =
         optimalControlProblem.stateEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateEq.clear();
+    clearApproximation(stateEqConstraints);
   }
 
   // State-input equality constraints
   if (!optimalControlProblem.equalityConstraintPtr->empty()) {
-    constraintsSize.stateInputEq = optimalControlProblem.equalityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.equalityConstraintPtr->getTermsSize(t, constraintsSize.stateInputEq);
     stateInputEqConstraints =
         optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+    stateInputEqConstraintsSparsity = optimalControlProblem.equalityConstraintPtr->getLinearApproximationSparsity(t, x.size(), u.size());
+  } else {
+    constraintsSize.stateInputEq.clear();
+    clearApproximation(stateInputEqConstraints);
+    stateInputEqConstraintsSparsity.stateColumns.clear();
+    stateInputEqConstraintsSparsity.inputColumns.clear();
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.stateInequalityConstraintPtr->empty()) {
-    constraintsSize.stateIneq = optimalControlProblem.stateInequalityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.stateInequalityConstraintPtr->getTermsSize(t, constraintsSize.stateIneq);
     stateIneqConstraints =
         optimalControlProblem.stateInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateIneq.clear();
+    clearApproximation(stateIneqConstraints);
   }
 
   // State-input inequality constraints.
   if (!optimalControlProblem.inequalityConstraintPtr->empty()) {
-    constraintsSize.stateInputIneq = optimalControlProblem.inequalityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.inequalityConstraintPtr->getTermsSize(t, constraintsSize.stateInputIneq);
     stateInputIneqConstraints =
         optimalControlProblem.inequalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateInputIneq.clear();
+    clearApproximation(stateInputIneqConstraints);
   }
 
-  return transcription;
+  // Dynamics, last because the discretization can request the pre-computation at other points than the node
+  // Discretization returns x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+  dynamics = sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
+  dynamics.f -= x_next;  // make it dx_{k+1} = ...
 }
 
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier) {
+  ProjectionWorkspace workspace;
+  projectTranscription(transcription, extractProjectionMultiplier, workspace);
+}
+
+void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier, ProjectionWorkspace& workspace) {
+  ScalarFunctionQuadraticApproximation projectedCost;
+  VectorFunctionLinearApproximation projectedDynamics;
+  VectorFunctionLinearApproximation projectedStateInputIneqConstraints;
+  projectTranscription(transcription, extractProjectionMultiplier, workspace, projectedCost, projectedDynamics,
+                       projectedStateInputIneqConstraints);
+  transcription.cost = std::move(projectedCost);
+  transcription.dynamics = std::move(projectedDynamics);
+  transcription.stateInputIneqConstraints = std::move(projectedStateInputIneqConstraints);
+}
+
+void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier, ProjectionWorkspace& workspace,
+                          ScalarFunctionQuadraticApproximation& projectedCost, VectorFunctionLinearApproximation& projectedDynamics,
+                          VectorFunctionLinearApproximation& projectedStateInputIneqConstraints) {
   auto& cost = transcription.cost;
   auto& dynamics = transcription.dynamics;
   auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
+  // A full row rank D always has non-zero input columns. Empty input columns therefore mark a sparsity that was not provided.
+  const auto& sparsity = transcription.stateInputEqConstraintsSparsity;
+  const column_blocks_t* stateColumnsPtr = sparsity.inputColumns.empty() ? nullptr : &sparsity.stateColumns;
   auto& stateInputIneqConstraints = transcription.stateInputIneqConstraints;
   auto& projection = transcription.constraintsProjection;
   auto& projectionMultiplierCoefficients = transcription.projectionMultiplierCoefficients;
@@ -104,66 +160,92 @@ void projectTranscription(Transcription& transcription, bool extractProjectionMu
   if (stateInputEqConstraints.f.size() > 0) {
     // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
     if (extractProjectionMultiplier) {
-      matrix_t constraintPseudoInverse;
-      std::tie(projection, constraintPseudoInverse) = LinearAlgebra::qrConstraintProjection(stateInputEqConstraints);
-      projectionMultiplierCoefficients.compute(cost, dynamics, projection, constraintPseudoInverse);
+      LinearAlgebra::qrConstraintProjection(stateInputEqConstraints, workspace.constraintProjection, projection, workspace.pseudoInverse,
+                                            stateColumnsPtr);
+      projectionMultiplierCoefficients.compute(cost, dynamics, projection, workspace.pseudoInverse,
+                                               workspace.projectionMultiplierCoefficients);
     } else {
-      projection = LinearAlgebra::luConstraintProjection(stateInputEqConstraints).first;
+      LinearAlgebra::luConstraintProjection(stateInputEqConstraints, workspace.constraintProjection, projection, nullptr, stateColumnsPtr);
       projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
     }
-    stateInputEqConstraints = VectorFunctionLinearApproximation();
+    clearApproximation(stateInputEqConstraints);
 
-    // Adapt dynamics, cost, and state-input inequality constraints
-    changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
-    changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f);
+    // Adapt dynamics, cost, and state-input inequality constraints. Px has the column sparsity of the constraint state jacobian.
+    changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f, stateColumnsPtr, projectedDynamics);
+    changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f, stateColumnsPtr, workspace.changeOfInputVariables,
+                           projectedCost);
     if (stateInputIneqConstraints.f.size() > 0) {
-      changeOfInputVariables(stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f);
+      changeOfInputVariables(stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f, stateColumnsPtr,
+                             projectedStateInputIneqConstraints);
+    } else {
+      std::swap(projectedStateInputIneqConstraints, stateInputIneqConstraints);
     }
+  } else {
+    clearApproximation(projection);
+    projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
+    std::swap(projectedCost, cost);
+    std::swap(projectedDynamics, dynamics);
+    std::swap(projectedStateInputIneqConstraints, stateInputIneqConstraints);
   }
 }
 
 TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
-  // Results and short-hand notation
   TerminalTranscription transcription;
+  setupTerminalNode(optimalControlProblem, t, x, transcription);
+  return transcription;
+}
+
+void setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, TerminalTranscription& transcription) {
+  // Results and short-hand notation
   auto& cost = transcription.cost;
   auto& constraintsSize = transcription.constraintsSize;
   auto& eqConstraints = transcription.eqConstraints;
   auto& ineqConstraints = transcription.ineqConstraints;
 
-  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Approximation;
-  optimalControlProblem.preComputationPtr->requestFinal(request, t, x);
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
+  optimalControlProblem.preComputationPtr->cachedRequestFinal(request, t, x);
 
   // Costs
   cost = approximateFinalCost(optimalControlProblem, t, x);
 
   // State equality constraints.
   if (!optimalControlProblem.finalEqualityConstraintPtr->empty()) {
-    constraintsSize.stateEq = optimalControlProblem.finalEqualityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.finalEqualityConstraintPtr->getTermsSize(t, constraintsSize.stateEq);
     eqConstraints =
         optimalControlProblem.finalEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateEq.clear();
+    clearApproximation(eqConstraints);
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.finalInequalityConstraintPtr->empty()) {
-    constraintsSize.stateIneq = optimalControlProblem.finalInequalityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.finalInequalityConstraintPtr->getTermsSize(t, constraintsSize.stateIneq);
     ineqConstraints =
         optimalControlProblem.finalInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateIneq.clear();
+    clearApproximation(ineqConstraints);
   }
+}
 
+EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next) {
+  EventTranscription transcription;
+  setupEventNode(optimalControlProblem, t, x, x_next, transcription);
   return transcription;
 }
 
-EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next) {
+void setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                    EventTranscription& transcription) {
   // Results and short-hand notation
-  EventTranscription transcription;
   auto& cost = transcription.cost;
   auto& dynamics = transcription.dynamics;
   auto& constraintsSize = transcription.constraintsSize;
   auto& eqConstraints = transcription.eqConstraints;
   auto& ineqConstraints = transcription.ineqConstraints;
 
-  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Dynamics + Request::Approximation;
-  optimalControlProblem.preComputationPtr->requestPreJump(request, t, x);
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Dynamics + Request::Approximation;
+  optimalControlProblem.preComputationPtr->cachedRequestPreJump(request, t, x);
 
   // Dynamics
   // jump map returns // x_{k+1} = A_{k} * dx_{k} + b_{k}
@@ -176,19 +258,23 @@ EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem,
 
   // State equality constraints.
   if (!optimalControlProblem.preJumpEqualityConstraintPtr->empty()) {
-    constraintsSize.stateEq = optimalControlProblem.preJumpEqualityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.preJumpEqualityConstraintPtr->getTermsSize(t, constraintsSize.stateEq);
     eqConstraints =
         optimalControlProblem.preJumpEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateEq.clear();
+    clearApproximation(eqConstraints);
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.preJumpInequalityConstraintPtr->empty()) {
-    constraintsSize.stateIneq = optimalControlProblem.preJumpInequalityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.preJumpInequalityConstraintPtr->getTermsSize(t, constraintsSize.stateIneq);
     ineqConstraints =
         optimalControlProblem.preJumpInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateIneq.clear();
+    clearApproximation(ineqConstraints);
   }
-
-  return transcription;
 }
 
 }  // namespace multiple_shooting
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/oc_data/TimeDiscretization.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/Lookup.h>
 
 namespace ocs2 {
@@ -59,9 +61,16 @@ scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& en
 
 std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
                                                         const scalar_array_t& eventTimes, scalar_t dt_min) {
+  std::vector<AnnotatedTime> timeDiscretization;
+  timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes, dt_min, timeDiscretization);
+  return timeDiscretization;
+}
+
+void timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, const scalar_array_t& eventTimes, scalar_t dt_min,
+                                  std::vector<AnnotatedTime>& timeDiscretization) {
   assert(dt > 0);
   assert(finalTime > initTime);
-  std::vector<AnnotatedTime> timeDiscretization;
+  timeDiscretization.clear();
 
   // Initialize
   timeDiscretization.emplace_back(initTime, AnnotatedTime::Event::None);
@@ -98,19 +107,20 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
     timeDiscretization.front().event = AnnotatedTime::Event::PostEvent;
   }
 
-  // Duplicate all preEvents to postEvents
-  std::vector<AnnotatedTime> timeDiscretizationWithDoubleEvents;
-  timeDiscretizationWithDoubleEvents.reserve(2 * timeDiscretization.size());  // upper bound on size
-
-  for (const auto& t : timeDiscretization) {
-    timeDiscretizationWithDoubleEvents.push_back(t);
-    if (t.event == AnnotatedTime::Event::PreEvent) {
-      timeDiscretizationWithDoubleEvents.push_back(t);
-      timeDiscretizationWithDoubleEvents.back().event = AnnotatedTime::Event::PostEvent;
+  // Duplicate all preEvents to postEvents, in place from the back
+  const auto numPreEvents = std::count_if(timeDiscretization.begin(), timeDiscretization.end(),
+                                          [](const AnnotatedTime& t) { return t.event == AnnotatedTime::Event::PreEvent; });
+  auto src = static_cast<int>(timeDiscretization.size()) - 1;
+  auto dst = src + static_cast<int>(numPreEvents);
+  timeDiscretization.resize(dst + 1, timeDiscretization.back());
+  for (; src >= 0 && dst > src; --src) {
+    timeDiscretization[dst] = timeDiscretization[src];
+    if (timeDiscretization[src].event == AnnotatedTime::Event::PreEvent) {
+      timeDiscretization[dst].event = AnnotatedTime::Event::PostEvent;
+      timeDiscretization[--dst] = timeDiscretization[src];
     }
+    --dst;
   }
-
-  return timeDiscretizationWithDoubleEvents;
 }
 
 scalar_array_t toTime(const std::vector<AnnotatedTime>& annotatedTime) {
@@ -47,9 +47,24 @@ bool operator==(const OcpSize& lhs, const OcpSize& rhs) noexcept {
 OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                 const std::vector<VectorFunctionLinearApproximation>* constraints) {
+  OcpSize problemSize;
+  extractSizesFromProblem(dynamics, cost, constraints, problemSize);
+  return problemSize;
+}
+
+void extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                             const std::vector<VectorFunctionLinearApproximation>* constraints, OcpSize& problemSize) {
   const int numStages = dynamics.size();
 
-  OcpSize problemSize(dynamics.size());
+  problemSize.numStages = numStages;
+  for (auto* sizes : {&problemSize.numInputs, &problemSize.numStates}) {
+    sizes->resize(numStages + 1);
+  }
+  for (auto* sizes : {&problemSize.numInputBoxConstraints, &problemSize.numStateBoxConstraints, &problemSize.numIneqConstraints,
+                      &problemSize.numInputBoxSlack, &problemSize.numStateBoxSlack, &problemSize.numIneqSlack}) {
+    sizes->assign(numStages + 1, 0);
+  }
 
   // State inputs
   for (int k = 0; k < numStages; k++) {
@@ -65,8 +80,6 @@ OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximat
       problemSize.numIneqConstraints[k] = (*constraints)[k].f.size();
     }
   }
-
-  return problemSize;
 }
 
-}  // namespace ocs2
\ No newline at end of file
+}  // namespace ocs2
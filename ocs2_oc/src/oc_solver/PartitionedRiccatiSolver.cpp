@@ -0,0 +1,326 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/oc_solver/PartitionedRiccatiSolver.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace ocs2 {
+
+namespace {
+/** Replaces the square matrix by its symmetric part 0.5 * (M + M'), without a temporary. */
+void symmetrize(matrix_t& M) {
+  for (Eigen::Index j = 0; j < M.cols(); ++j) {
+    for (Eigen::Index i = 0; i < j; ++i) {
+      M(i, j) = M(j, i) = 0.5 * (M(i, j) + M(j, i));
+    }
+  }
+}
+}  // anonymous namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PartitionedRiccatiSolver::PartitionedRiccatiSolver(size_t numPartitions) : numPartitions_(std::max<size_t>(numPartitions, 1)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PartitionedRiccatiSolver::solve(ThreadPool& threadPool, const vector_t& x0,
+                                     const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                     const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& xTrajectory,
+                                     vector_array_t& uTrajectory) {
+  const int N = static_cast<int>(dynamics.size());
+  if (cost.size() != dynamics.size() + 1) {
+    throw std::runtime_error("[PartitionedRiccatiSolver::solve] Expected " + std::to_string(N + 1) + " cost terms, but got " +
+                             std::to_string(cost.size()) + ".");
+  }
+
+  // Split the horizon into partitions. Condensing a stage is about two to three times as expensive as a Riccati step, therefore the last
+  // partition, which only runs the Riccati recursion, gets twice the number of stages of the others.
+  const int numPartitions = std::max(std::min(static_cast<int>(numPartitions_), N - 1), 1);
+  partitionStart_.resize(numPartitions + 1);
+  for (int c = 0; c < numPartitions; ++c) {
+    partitionStart_[c] = c * N / (numPartitions + 1);
+  }
+  partitionStart_[numPartitions] = N;
+  partitionElements_.resize(numPartitions);
+  elementWorkspace_.resize(2 * numPartitions);
+  workspace_.resize(numPartitions);
+
+  S_.resize(N + 1);
+  s_.resize(N + 1);
+  feedback_.resize(N);
+  feedforward_.resize(N);
+  S_[N] = cost[N].dfdxx;
+  s_[N] = cost[N].dfdx;
+
+  // Condense all partitions but the last one, while the last partition runs the Riccati recursion from the terminal cost
+  const int lastPartition = numPartitions - 1;
+  threadPool.parallelFor(0, numPartitions, 1, [&](int, int c) {
+    const int begin = partitionStart_[c];
+    const int end = partitionStart_[c + 1];
+    if (c == lastPartition) {
+      riccatiRecursion(begin, end, dynamics, cost, workspace_[c]);
+      return;
+    }
+    auto& aggregate = partitionElements_[c];
+    auto& stageElement = elementWorkspace_[2 * c];
+    auto& result = elementWorkspace_[2 * c + 1];
+    getStageElement(dynamics[end - 1], cost[end - 1], aggregate, workspace_[c]);
+    for (int k = end - 2; k >= begin; --k) {
+      getStageElement(dynamics[k], cost[k], stageElement, workspace_[c]);
+      combine(stageElement, aggregate, result, workspace_[c]);
+      std::swap(aggregate, result);
+    }
+  });
+
+  // Propagate the cost-to-go over the partition boundaries
+  for (int c = lastPartition - 1; c >= 0; --c) {
+    const int begin = partitionStart_[c];
+    const int end = partitionStart_[c + 1];
+    combineWithCostToGo(partitionElements_[c], S_[end], s_[end], S_[begin], s_[begin], workspace_[c]);
+  }
+
+  // Riccati recursion within the remaining partitions
+  if (lastPartition > 0) {
+    threadPool.parallelFor(0, lastPartition, 1, [&](int, int c) {
+      riccatiRecursion(partitionStart_[c], partitionStart_[c + 1], dynamics, cost, workspace_[c]);
+    });
+  }
+
+  // Forward rollout
+  xTrajectory.resize(N + 1);
+  uTrajectory.resize(N);
+  xTrajectory[0] = x0;
+  for (int k = 0; k < N; ++k) {
+    uTrajectory[k] = feedforward_[k];
+    uTrajectory[k].noalias() += feedback_[k] * xTrajectory[k];
+    xTrajectory[k + 1] = dynamics[k].f;
+    xTrajectory[k + 1].noalias() += dynamics[k].dfdx * xTrajectory[k];
+    xTrajectory[k + 1].noalias() += dynamics[k].dfdu * uTrajectory[k];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<ScalarFunctionQuadraticApproximation> PartitionedRiccatiSolver::getRiccatiCostToGo() const {
+  std::vector<ScalarFunctionQuadraticApproximation> costToGo;
+  getRiccatiCostToGo(costToGo);
+  return costToGo;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PartitionedRiccatiSolver::getRiccatiCostToGo(std::vector<ScalarFunctionQuadraticApproximation>& costToGo) const {
+  costToGo.resize(S_.size());
+  for (size_t k = 0; k < S_.size(); ++k) {
+    costToGo[k].f = 0.0;
+    costToGo[k].dfdxx = S_[k];
+    costToGo[k].dfdx = s_[k];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PartitionedRiccatiSolver::getStageElement(const VectorFunctionLinearApproximation& dynamics,
+                                               const ScalarFunctionQuadraticApproximation& cost, ConditionalValueFunction& element,
+                                               Workspace& workspace) {
+  // Stages without inputs, e.g. event nodes
+  if (dynamics.dfdu.cols() == 0) {
+    element.A = dynamics.dfdx;
+    element.b = dynamics.f;
+    element.C.setZero(dynamics.f.size(), dynamics.f.size());
+    element.eta = -cost.dfdx;
+    element.J = cost.dfdxx;
+    return;
+  }
+
+  auto& RChol = workspace.llt;
+  RChol.compute(cost.dfduu);
+  if (RChol.info() != Eigen::Success) {
+    throw std::runtime_error("[PartitionedRiccatiSolver::getStageElement] The input cost Hessian is not positive definite.");
+  }
+  auto& RinvP = workspace.RinvP;
+  auto& RinvBt = workspace.RinvBt;
+  auto& Rinvr = workspace.Rinvr;
+  RinvP = RChol.solve(cost.dfdux);
+  RinvBt = RChol.solve(dynamics.dfdu.transpose());
+  Rinvr = RChol.solve(cost.dfdu);
+
+  // Eliminate the input: u = R^{-1} (B' lambda - P x - r)
+  element.A = dynamics.dfdx;
+  element.A.noalias() -= dynamics.dfdu * RinvP;
+  element.b = dynamics.f;
+  element.b.noalias() -= dynamics.dfdu * Rinvr;
+  element.C.noalias() = dynamics.dfdu * RinvBt;
+  element.eta = -cost.dfdx;
+  element.eta.noalias() += cost.dfdux.transpose() * Rinvr;
+  element.J = cost.dfdxx;
+  element.J.noalias() -= cost.dfdux.transpose() * RinvP;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PartitionedRiccatiSolver::combine(const ConditionalValueFunction& first, const ConditionalValueFunction& second,
+                                       ConditionalValueFunction& result, Workspace& workspace) {
+  // (I + C_i J_j)^{-1} and T = (I + C_i J_j)^{-1} A_i
+  auto& IplusCJ = workspace.IplusCJ;
+  IplusCJ.noalias() = first.C * second.J;
+  IplusCJ.diagonal().array() += 1.0;
+  auto& lu = workspace.lu;
+  lu.compute(IplusCJ);
+  auto& T = workspace.T;
+  T = lu.solve(first.A);
+
+  auto& tmp = workspace.vector;
+  auto& luTmp = workspace.luVectorSolution;
+  tmp = first.b;
+  tmp.noalias() += first.C * second.eta;
+  luTmp = lu.solve(tmp);
+  result.b = second.b;
+  result.b.noalias() += second.A * luTmp;
+
+  auto& luC = workspace.luSolution;
+  auto& luCAt = workspace.product;
+  luC = lu.solve(first.C);
+  luCAt.noalias() = luC * second.A.transpose();
+  result.C = second.C;
+  result.C.noalias() += second.A * luCAt;
+  symmetrize(result.C);
+
+  tmp = second.eta;
+  tmp.noalias() -= second.J * first.b;
+  result.eta = first.eta;
+  result.eta.noalias() += T.transpose() * tmp;
+
+  auto& JA = workspace.product;
+  JA.noalias() = second.J * first.A;
+  result.J = first.J;
+  result.J.noalias() += T.transpose() * JA;
+  symmetrize(result.J);
+
+  result.A.noalias() = second.A * T;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PartitionedRiccatiSolver::combineWithCostToGo(const ConditionalValueFunction& first, const matrix_t& S, const vector_t& s,
+                                                   matrix_t& SOut, vector_t& sOut, Workspace& workspace) {
+  // Combination with an element of A = 0, b = 0, C = 0, J = S, eta = -s
+  auto& IplusCS = workspace.IplusCJ;
+  IplusCS.noalias() = first.C * S;
+  IplusCS.diagonal().array() += 1.0;
+  auto& lu = workspace.lu;
+  lu.compute(IplusCS);
+  auto& T = workspace.T;
+  T = lu.solve(first.A);
+
+  auto& tmp = workspace.vector;
+  tmp = s;
+  tmp.noalias() += S * first.b;
+  sOut = -first.eta;
+  sOut.noalias() += T.transpose() * tmp;
+
+  auto& SA = workspace.product;
+  SA.noalias() = S * first.A;
+  SOut = first.J;
+  SOut.noalias() += T.transpose() * SA;
+  symmetrize(SOut);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PartitionedRiccatiSolver::riccatiRecursion(int begin, int end, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                                const std::vector<ScalarFunctionQuadraticApproximation>& cost, Workspace& workspace) {
+  auto& SA = workspace.SA;
+  auto& SB = workspace.SB;
+  auto& G = workspace.G;
+  auto& H = workspace.H;
+  auto& Sbs = workspace.Sbs;
+  auto& g = workspace.g;
+  auto& HChol = workspace.llt;
+  for (int k = end - 1; k >= begin; --k) {
+    const auto& A = dynamics[k].dfdx;
+    const auto& B = dynamics[k].dfdu;
+    const auto& S = S_[k + 1];
+
+    // Sbs = S * b + s
+    Sbs = s_[k + 1];
+    Sbs.noalias() += S * dynamics[k].f;
+    SA.noalias() = S * A;
+
+    // Stages without inputs, e.g. event nodes
+    if (B.cols() == 0) {
+      feedback_[k].resize(0, A.cols());
+      feedforward_[k].resize(0);
+      S_[k] = cost[k].dfdxx;
+      S_[k].noalias() += A.transpose() * SA;
+      symmetrize(S_[k]);
+      s_[k] = cost[k].dfdx;
+      s_[k].noalias() += A.transpose() * Sbs;
+      continue;
+    }
+
+    SB.noalias() = S * B;
+    H = cost[k].dfduu;
+    H.noalias() += B.transpose() * SB;
+    G = cost[k].dfdux;
+    G.noalias() += B.transpose() * SA;
+    g = cost[k].dfdu;
+    g.noalias() += B.transpose() * Sbs;
+
+    HChol.compute(H);
+    if (HChol.info() != Eigen::Success) {
+      throw std::runtime_error("[PartitionedRiccatiSolver::riccatiRecursion] The input Hessian at stage " + std::to_string(k) +
+                               " is not positive definite.");
+    }
+    feedback_[k] = HChol.solve(G);
+    feedback_[k] = -feedback_[k];
+    feedforward_[k] = HChol.solve(g);
+    feedforward_[k] = -feedforward_[k];
+
+    S_[k] = cost[k].dfdxx;
+    S_[k].noalias() += A.transpose() * SA;
+    S_[k].noalias() += feedback_[k].transpose() * G;
+    symmetrize(S_[k]);
+    s_[k] = cost[k].dfdx;
+    s_[k].noalias() += A.transpose() * Sbs;
+    s_[k].noalias() += G.transpose() * feedforward_[k];
+  }
+}
+
+}  // namespace ocs2
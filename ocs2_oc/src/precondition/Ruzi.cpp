@@ -29,9 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/precondition/Ruzi.h"
 
-#include <atomic>
+#include <algorithm>
 #include <functional>
 #include <numeric>
+#include <tuple>
 
 namespace ocs2 {
 namespace precondition {
@@ -39,56 +40,59 @@ namespace precondition {
 // Internal helper functions
 namespace {
 
+// The infinity norms below minInfNorm belong to zero rows or columns, which are not scaled.
+constexpr scalar_t minInfNorm = 1e-4;
+constexpr scalar_t maxInfNorm = 1e+4;
+
 scalar_t limitScaling(const scalar_t& v) {
-  if (v < 1e-4) {
+  if (v < minInfNorm) {
     return 1.0;
-  } else if (v > 1e+4) {
-    return 1e+4;
+  } else if (v > maxInfNorm) {
+    return maxInfNorm;
   } else {
     return v;
   }
 }
 
 template <typename T>
-vector_t matrixInfNormRows(const Eigen::MatrixBase<T>& mat) {
-  if (mat.rows() == 0 || mat.cols() == 0) {
-    return vector_t(0);
-  } else {
-    return mat.rowwise().template lpNorm<Eigen::Infinity>();
+void maxInfNormRowsInPlace(const Eigen::MatrixBase<T>& mat, vector_t& infNorm) {
+  if (mat.rows() != 0 && mat.cols() != 0) {
+    infNorm = infNorm.cwiseMax(mat.rowwise().template lpNorm<Eigen::Infinity>());
   }
 }
 
-template <typename T, typename... Rest>
-vector_t matrixInfNormRows(const Eigen::MatrixBase<T>& mat, const Eigen::MatrixBase<Rest>&... rest) {
-  vector_t temp = matrixInfNormRows(rest...);
-  if (mat.rows() == 0 || mat.cols() == 0) {
-    return temp;
-  } else if (temp.rows() != 0) {
-    return mat.rowwise().template lpNorm<Eigen::Infinity>().cwiseMax(temp);
-  } else {
-    return mat.rowwise().template lpNorm<Eigen::Infinity>();
+template <typename T>
+void maxInfNormColsInPlace(const Eigen::MatrixBase<T>& mat, vector_t& infNorm) {
+  if (mat.rows() != 0 && mat.cols() != 0) {
+    infNorm = infNorm.cwiseMax(mat.colwise().template lpNorm<Eigen::Infinity>().transpose());
   }
 }
 
-template <typename T>
-vector_t matrixInfNormCols(const Eigen::MatrixBase<T>& mat) {
-  if (mat.rows() == 0 || mat.cols() == 0) {
-    return vector_t(0);
-  } else {
-    return mat.colwise().template lpNorm<Eigen::Infinity>().transpose();
-  }
+/** Computes the row-wise infinity norm of the horizontally stacked matrices into infNorm without temporaries. */
+template <typename... T>
+void matrixInfNormRows(vector_t& infNorm, Eigen::Index rows, const Eigen::MatrixBase<T>&... mats) {
+  infNorm.setZero(rows);
+  const int expand[] = {0, (maxInfNormRowsInPlace(mats, infNorm), 0)...};
+  (void)expand;
 }
 
-template <typename T, typename... Rest>
-vector_t matrixInfNormCols(const Eigen::MatrixBase<T>& mat, const Eigen::MatrixBase<Rest>&... rest) {
-  vector_t temp = matrixInfNormCols(rest...);
-  if (mat.rows() == 0 || mat.cols() == 0) {
-    return temp;
-  } else if (temp.rows() != 0) {
-    return mat.colwise().template lpNorm<Eigen::Infinity>().transpose().cwiseMax(temp);
-  } else {
-    return mat.colwise().template lpNorm<Eigen::Infinity>().transpose();
+/** Computes the column-wise infinity norm of the vertically stacked matrices into infNorm without temporaries. */
+template <typename... T>
+void matrixInfNormCols(vector_t& infNorm, Eigen::Index cols, const Eigen::MatrixBase<T>&... mats) {
+  infNorm.setZero(cols);
+  const int expand[] = {0, (maxInfNormColsInPlace(mats, infNorm), 0)...};
+  (void)expand;
+}
+
+/** The largest deviation of the infinity norms from one, ignoring the zero rows or columns. */
+scalar_t infNormDeviation(const vector_t& infNorm) {
+  scalar_t deviation = 0.0;
+  for (int i = 0; i < infNorm.size(); i++) {
+    if (infNorm(i) >= minInfNorm) {
+      deviation = std::max(deviation, std::abs(1.0 - infNorm(i)));
+    }
   }
+  return deviation;
 }
 
 template <typename T>
@@ -101,74 +105,87 @@ void scaleMatrixInPlace(const vector_t* rowScale, const vector_t* colScale, Eige
   }
 }
 
-void invSqrtInfNormInParallel(ThreadPool& threadPool, const std::vector<VectorFunctionLinearApproximation>& dynamics,
-                              const std::vector<ScalarFunctionQuadraticApproximation>& cost, const vector_array_t& scalingVectors,
-                              vector_array_t& D, vector_array_t& E) {
-  // Helper function
-  auto invSqrt = [](const vector_t& v) -> vector_t { return v.unaryExpr(std::ref(limitScaling)).array().sqrt().inverse(); };
-
-  // resize
-  const int N = static_cast<int>(cost.size()) - 1;
+/**
+ * Computes the scaling factors D and E of one Ruiz pass, i.e., the inverse square root of the infinity norms of the columns and rows
+ * of the KKT matrix, in place. Returns the largest deviation of these norms from one.
+ */
+scalar_t invSqrtInfNormInParallel(ThreadPool& threadPool, const PackedOcpData<scalar_t>& ocpData, vector_array_t& D, vector_array_t& E) {
+  const auto& ocpSize = ocpData.ocpSize();
+  const int N = ocpData.numStages();
   E.resize(N);
   D.resize(2 * N);
 
-  D[0] = invSqrt(matrixInfNormCols(cost[0].dfduu, dynamics[0].dfdu));
-  E[0] = invSqrt(matrixInfNormRows(dynamics[0].dfdu, scalingVectors[0]));
+  scalar_array_t deviationArray(threadPool.numThreads() + 1U, 0.0);
+  auto invSqrtInPlace = [&](int workerId, vector_t& infNorm) {
+    deviationArray[workerId] = std::max(deviationArray[workerId], infNormDeviation(infNorm));
+    infNorm = infNorm.unaryExpr(std::ref(limitScaling)).array().sqrt().inverse().matrix();
+  };
 
-  std::atomic_int timeStamp{1};
-  auto task = [&](int workerId) {
-    int k;
-    while ((k = timeStamp++) < N) {
-      D[2 * k - 1] = invSqrt(matrixInfNormCols(cost[k].dfdxx, cost[k].dfdux, scalingVectors[k - 1].transpose().eval(), dynamics[k].dfdx));
-      D[2 * k] = invSqrt(matrixInfNormCols(cost[k].dfdux.transpose().eval(), cost[k].dfduu, dynamics[k].dfdu));
-      E[k] = invSqrt(matrixInfNormRows(dynamics[k].dfdx, dynamics[k].dfdu, scalingVectors[k]));
+  threadPool.parallelFor(0, N + 1, 1, [&](int workerId, int k) {
+    if (k == 0) {
+      matrixInfNormCols(D[0], ocpSize.numInputs[0], ocpData.R(0), ocpData.B(0));
+      matrixInfNormRows(E[0], ocpSize.numStates[1], ocpData.B(0), ocpData.C(0));
+      invSqrtInPlace(workerId, D[0]);
+      invSqrtInPlace(workerId, E[0]);
+    } else if (k < N) {
+      matrixInfNormCols(D[2 * k - 1], ocpSize.numStates[k], ocpData.Q(k), ocpData.P(k), ocpData.C(k - 1).transpose(), ocpData.A(k));
+      matrixInfNormCols(D[2 * k], ocpSize.numInputs[k], ocpData.P(k).transpose(), ocpData.R(k), ocpData.B(k));
+      matrixInfNormRows(E[k], ocpSize.numStates[k + 1], ocpData.A(k), ocpData.B(k), ocpData.C(k));
+      invSqrtInPlace(workerId, D[2 * k - 1]);
+      invSqrtInPlace(workerId, D[2 * k]);
+      invSqrtInPlace(workerId, E[k]);
+    } else {
+      matrixInfNormCols(D[2 * N - 1], ocpSize.numStates[N], ocpData.Q(N), ocpData.C(N - 1).transpose());
+      invSqrtInPlace(workerId, D[2 * N - 1]);
     }
-  };
-  threadPool.runParallel(std::move(task), threadPool.numThreads() + 1U);
+  });
 
-  D[2 * N - 1] = invSqrt(matrixInfNormCols(cost[N].dfdxx, scalingVectors[N - 1].transpose().eval()));
+  return *std::max_element(deviationArray.cbegin(), deviationArray.cend());
 }
 
 void scaleDataOneStepInPlaceInParallel(ThreadPool& threadPool, const vector_array_t& D, const vector_array_t& E,
-                                       std::vector<VectorFunctionLinearApproximation>& dynamics,
-                                       std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<vector_t>& scalingVectors) {
+                                       PackedOcpData<scalar_t>& ocpData) {
   // cost at 0
-  scaleMatrixInPlace(&(D[0]), nullptr, cost.front().dfdu);
-  scaleMatrixInPlace(&(D[0]), &(D[0]), cost.front().dfduu);
-  scaleMatrixInPlace(&(D[0]), nullptr, cost.front().dfdux);
+  auto r0 = ocpData.r(0);
+  auto R0 = ocpData.R(0);
+  auto P0 = ocpData.P(0);
+  scaleMatrixInPlace(&(D[0]), nullptr, r0);
+  scaleMatrixInPlace(&(D[0]), &(D[0]), R0);
+  scaleMatrixInPlace(&(D[0]), nullptr, P0);
   // constraints at 0
-  scaleMatrixInPlace(&(E[0]), nullptr, dynamics[0].f);
-  scaleMatrixInPlace(&(E[0]), nullptr, dynamics[0].dfdx);
-  scalingVectors[0].array() *= E[0].array() * D[1].array();
-  if (dynamics[0].dfdu.size() > 0) {
-    scaleMatrixInPlace(&(E[0]), &(D[0]), dynamics[0].dfdu);
-  }
-
-  std::atomic_int timeStamp1{1}, timeStamp2{1};
-  auto scaleCostConstraints = [&](int workerId) {
-    int k;
-    const int N = static_cast<int>(cost.size()) - 1;
+  auto b0 = ocpData.b(0);
+  auto A0 = ocpData.A(0);
+  auto B0 = ocpData.B(0);
+  scaleMatrixInPlace(&(E[0]), nullptr, b0);
+  scaleMatrixInPlace(&(E[0]), nullptr, A0);
+  ocpData.C(0).array() *= E[0].array() * D[1].array();
+  scaleMatrixInPlace(&(E[0]), &(D[0]), B0);
+
+  const int N = ocpData.numStages();
+  threadPool.parallelFor(1, N + 1, 1, [&](int, int k) {
     // cost
-    while ((k = timeStamp1++) <= N) {
-      scaleMatrixInPlace(&(D[2 * k - 1]), nullptr, cost[k].dfdx);
-      scaleMatrixInPlace(&(D[2 * k - 1]), &(D[2 * k - 1]), cost[k].dfdxx);
-      if (cost[k].dfdu.size() > 0) {
-        scaleMatrixInPlace(&(D[2 * k]), nullptr, cost[k].dfdu);
-        scaleMatrixInPlace(&(D[2 * k]), &(D[2 * k]), cost[k].dfduu);
-        scaleMatrixInPlace(&(D[2 * k]), &(D[2 * k - 1]), cost[k].dfdux);
-      }
+    auto q = ocpData.q(k);
+    auto Q = ocpData.Q(k);
+    scaleMatrixInPlace(&(D[2 * k - 1]), nullptr, q);
+    scaleMatrixInPlace(&(D[2 * k - 1]), &(D[2 * k - 1]), Q);
+    if (k < N) {
+      auto r = ocpData.r(k);
+      auto R = ocpData.R(k);
+      auto P = ocpData.P(k);
+      scaleMatrixInPlace(&(D[2 * k]), nullptr, r);
+      scaleMatrixInPlace(&(D[2 * k]), &(D[2 * k]), R);
+      scaleMatrixInPlace(&(D[2 * k]), &(D[2 * k - 1]), P);
+
+      // constraints
+      auto b = ocpData.b(k);
+      auto A = ocpData.A(k);
+      auto B = ocpData.B(k);
+      scaleMatrixInPlace(&(E[k]), nullptr, b);
+      scaleMatrixInPlace(&(E[k]), &(D[2 * k - 1]), A);
+      ocpData.C(k).array() *= E[k].array() * D[2 * k + 1].array();
+      scaleMatrixInPlace(&(E[k]), &(D[2 * k]), B);
     }
-    // constraints
-    while ((k = timeStamp2++) < N) {
-      scaleMatrixInPlace(&(E[k]), nullptr, dynamics[k].f);
-      scaleMatrixInPlace(&(E[k]), &(D[2 * k - 1]), dynamics[k].dfdx);
-      scalingVectors[k].array() *= E[k].array() * D[2 * k + 1].array();
-      if (dynamics[k].dfdu.size() > 0) {
-        scaleMatrixInPlace(&(E[k]), &(D[2 * k]), dynamics[k].dfdu);
-      }
-    }
-  };
-  threadPool.runParallel(std::move(scaleCostConstraints), threadPool.numThreads() + 1U);
+  });
 }
 
 vector_t matrixInfNormRows(const Eigen::SparseMatrix<scalar_t>& mat) {
@@ -205,6 +222,122 @@ void scaleMatrixInPlace(const vector_t& rowScale, const vector_t& colScale, Eige
   }
 }
 
+/** Scales all cost terms by gamma. */
+void scaleCostInPlaceInParallel(ThreadPool& threadPool, scalar_t gamma, PackedOcpData<scalar_t>& ocpData) {
+  threadPool.parallelFor(0, ocpData.numStages() + 1, 1, [&](int, int k) {
+    ocpData.Q(k) *= gamma;
+    ocpData.R(k) *= gamma;
+    ocpData.P(k) *= gamma;
+    ocpData.q(k) *= gamma;
+    ocpData.r(k) *= gamma;
+  });
+}
+
+/** Sets the initial scaling to identity. */
+void setScalingToIdentity(const OcpSize& ocpSize, vector_array_t& DOut, vector_array_t& EOut, scalar_t& cOut) {
+  const int N = ocpSize.numStages;
+  cOut = 1.0;
+  DOut.resize(2 * N);
+  EOut.resize(N);
+  for (int i = 0; i < N; i++) {
+    DOut[2 * i].setOnes(ocpSize.numInputs[i]);
+    DOut[2 * i + 1].setOnes(ocpSize.numStates[i + 1]);
+    EOut[i].setOnes(ocpSize.numStates[i + 1]);
+  }
+}
+
+/** Checks whether the given scaling fits the problem size. */
+bool isScalingConsistent(const OcpSize& ocpSize, const vector_array_t& D, const vector_array_t& E, scalar_t c) {
+  const int N = ocpSize.numStages;
+  if (D.size() != 2 * N || E.size() != N || !(c > 0.0)) {
+    return false;
+  }
+  for (int i = 0; i < N; i++) {
+    if (D[2 * i].size() != ocpSize.numInputs[i] || D[2 * i + 1].size() != ocpSize.numStates[i + 1] ||
+        E[i].size() != ocpSize.numStates[i + 1]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** The workspace of the Ruiz passes. */
+struct RuizWorkspace {
+  RuizWorkspace(const OcpSize& ocpSize, size_t numWorkers)
+      : numDecisionVariables(std::accumulate(ocpSize.numInputs.begin(), ocpSize.numInputs.end(), 0) +
+                             std::accumulate(std::next(ocpSize.numStates.begin()), ocpSize.numStates.end(), 0)),
+        infNormOfhArray(numWorkers),
+        sumOfInfNormOfHArray(numWorkers),
+        infNormArray(numWorkers) {}
+
+  int numDecisionVariables;
+  vector_array_t D, E;  // The scaling factors of one pass
+  scalar_array_t infNormOfhArray;
+  scalar_array_t sumOfInfNormOfHArray;
+  vector_array_t infNormArray;
+};
+
+/**
+ * Scales the data with the factors D and E of the workspace, and scales the cost to equilibrate it against the constraints. The
+ * applied factors are accumulated into DOut, EOut, and cOut.
+ */
+void scaleOnePassInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, RuizWorkspace& workspace, PackedOcpData<scalar_t>& ocpData,
+                                   vector_array_t& DOut, vector_array_t& EOut, scalar_t& cOut) {
+  const auto& ocpSize = ocpData.ocpSize();
+  const int N = ocpData.numStages();
+  const auto& D = workspace.D;
+  const auto& E = workspace.E;
+  scaleDataOneStepInPlaceInParallel(threadPool, D, E, ocpData);
+
+  auto& infNormOfhArray = workspace.infNormOfhArray;
+  auto& sumOfInfNormOfHArray = workspace.sumOfInfNormOfHArray;
+  std::fill(infNormOfhArray.begin(), infNormOfhArray.end(), 0.0);
+  std::fill(sumOfInfNormOfHArray.begin(), sumOfInfNormOfHArray.end(), 0.0);
+  threadPool.parallelFor(0, N + 1, 1, [&](int workerId, int k) {
+    auto& infNorm = workspace.infNormArray[workerId];
+    scalar_t infNormOfh;
+    scalar_t sumOfInfNormOfH;
+    if (k == 0) {
+      infNormOfh = (ocpData.r(0) + ocpData.P(0) * x0).lpNorm<Eigen::Infinity>();
+      matrixInfNormCols(infNorm, ocpSize.numInputs[0], ocpData.R(0));
+      sumOfInfNormOfH = infNorm.sum();
+    } else {
+      infNormOfh = std::max(ocpData.q(k).lpNorm<Eigen::Infinity>(), ocpData.r(k).lpNorm<Eigen::Infinity>());
+      matrixInfNormCols(infNorm, ocpSize.numStates[k], ocpData.Q(k), ocpData.P(k));
+      sumOfInfNormOfH = infNorm.sum();
+      if (k < N) {
+        matrixInfNormCols(infNorm, ocpSize.numInputs[k], ocpData.P(k).transpose(), ocpData.R(k));
+        sumOfInfNormOfH += infNorm.sum();
+      }
+    }
+    infNormOfhArray[workerId] = std::max(infNormOfhArray[workerId], infNormOfh);
+    sumOfInfNormOfHArray[workerId] += sumOfInfNormOfH;
+  });
+
+  const auto infNormOfh = *std::max_element(infNormOfhArray.cbegin(), infNormOfhArray.cend());
+  const auto sumOfInfNormOfH = std::accumulate(sumOfInfNormOfHArray.cbegin(), sumOfInfNormOfHArray.cend(), 0.0);
+  const auto averageOfInfNormOfH = sumOfInfNormOfH / static_cast<scalar_t>(workspace.numDecisionVariables);
+  const auto gamma = 1.0 / limitScaling(std::max(averageOfInfNormOfH, infNormOfh));
+
+  // compute EOut, DOut, and scale cost
+  threadPool.parallelFor(0, N + 1, 1, [&](int, int k) {
+    if (k < N) {
+      EOut[k].array() *= E[k].array();
+      DOut[2 * k].array() *= D[2 * k].array();
+      DOut[2 * k + 1].array() *= D[2 * k + 1].array();
+    }
+    // cost
+    ocpData.Q(k) *= gamma;
+    ocpData.R(k) *= gamma;
+    ocpData.P(k) *= gamma;
+    ocpData.q(k) *= gamma;
+    ocpData.r(k) *= gamma;
+  });
+
+  // compute cOut
+  cOut *= gamma;
+}
+
 }  // anonymous namespace
 
 void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const OcpSize& ocpSize, const int iteration,
@@ -216,90 +349,78 @@ void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const
     throw std::runtime_error("[precondition::ocpDataInPlaceInParallel] The number of stages cannot be less than 1.");
   }
 
-  // Init output
-  cOut = 1.0;
-  DOut.resize(2 * N);
-  EOut.resize(N);
+  PackedOcpData<scalar_t> ocpData(ocpSize);
+  threadPool.parallelFor(0, N + 1, 1, [&](int, int k) {
+    if (k < N) {
+      ocpData.setDynamics(k, dynamics[k], nullptr);
+    }
+    ocpData.setCost(k, cost[k]);
+  });
+
+  ocpDataInPlaceInParallel(threadPool, x0, iteration, ocpData, DOut, EOut, cOut);
+
   scalingVectors.resize(N);
-  for (int i = 0; i < N; i++) {
-    DOut[2 * i].setOnes(ocpSize.numInputs[i]);
-    DOut[2 * i + 1].setOnes(ocpSize.numStates[i + 1]);
-    EOut[i].setOnes(ocpSize.numStates[i + 1]);
-    scalingVectors[i].setOnes(ocpSize.numStates[i + 1]);
+  threadPool.parallelFor(0, N + 1, 1, [&](int, int k) {
+    if (k < N) {
+      ocpData.getDynamics(k, dynamics[k], scalingVectors[k]);
+    }
+    ocpData.getCost(k, cost[k]);
+  });
+}
+
+void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const int iteration, PackedOcpData<scalar_t>& ocpData,
+                              vector_array_t& DOut, vector_array_t& EOut, scalar_t& cOut) {
+  const auto& ocpSize = ocpData.ocpSize();
+  const int N = ocpData.numStages();
+  if (N < 1) {
+    throw std::runtime_error("[precondition::ocpDataInPlaceInParallel] The number of stages cannot be less than 1.");
   }
 
-  const auto numDecisionVariables = std::accumulate(ocpSize.numInputs.begin(), ocpSize.numInputs.end(), 0) +
-                                    std::accumulate(std::next(ocpSize.numStates.begin()), ocpSize.numStates.end(), 0);
+  // Init output
+  setScalingToIdentity(ocpSize, DOut, EOut, cOut);
+  for (int i = 0; i < N; i++) {
+    ocpData.C(i).setOnes();
+  }
 
-  vector_array_t D(2 * N), E(N);
-  std::atomic_int timeIndex{0};
-  const size_t numWorkers = threadPool.numThreads() + 1U;
+  RuizWorkspace workspace(ocpSize, threadPool.numThreads() + 1U);
   for (int i = 0; i < iteration; i++) {
-    invSqrtInfNormInParallel(threadPool, dynamics, cost, scalingVectors, D, E);
-    scaleDataOneStepInPlaceInParallel(threadPool, D, E, dynamics, cost, scalingVectors);
-
-    timeIndex = 0;
-    scalar_array_t infNormOfhArray(numWorkers, 0.0);
-    scalar_array_t sumOfInfNormOfHArray(numWorkers, 0.0);
-    auto infNormOfh_sumOfInfNormOfH = [&](int workerId) {
-      scalar_t workerInfNormOfh = 0.0;
-      scalar_t workerSumOfInfNormOfH = 0.0;
-
-      int k = timeIndex++;
-      if (k == 0) {  // Only one worker will execute this
-        workerInfNormOfh = (cost[0].dfdu + cost[0].dfdux * x0).lpNorm<Eigen::Infinity>();
-        workerSumOfInfNormOfH = matrixInfNormCols(cost[0].dfduu).derived().sum();
-        k = timeIndex++;
-      }
+    std::ignore = invSqrtInfNormInParallel(threadPool, ocpData, workspace.D, workspace.E);
+    scaleOnePassInPlaceInParallel(threadPool, x0, workspace, ocpData, DOut, EOut, cOut);
+  }
+}
 
-      while (k <= N) {
-        workerInfNormOfh = std::max(workerInfNormOfh, cost[k].dfdx.lpNorm<Eigen::Infinity>());
-        workerInfNormOfh = std::max(workerInfNormOfh, cost[k].dfdu.lpNorm<Eigen::Infinity>());
-        workerSumOfInfNormOfH += matrixInfNormCols(cost[k].dfdxx, cost[k].dfdux).derived().sum();
-        workerSumOfInfNormOfH += matrixInfNormCols(cost[k].dfdux.transpose().eval(), cost[k].dfduu).derived().sum();
-        k = timeIndex++;
-      }
+size_t ocpDataIncrementallyInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const size_t maxIteration,
+                                             const scalar_t tolerance, PackedOcpData<scalar_t>& ocpData, vector_array_t& DInOut,
+                                             vector_array_t& EInOut, scalar_t& cInOut) {
+  const auto& ocpSize = ocpData.ocpSize();
+  const int N = ocpData.numStages();
+  if (N < 1) {
+    throw std::runtime_error("[precondition::ocpDataIncrementallyInPlaceInParallel] The number of stages cannot be less than 1.");
+  }
 
-      infNormOfhArray[workerId] = std::max(infNormOfhArray[workerId], workerInfNormOfh);
-      sumOfInfNormOfHArray[workerId] += workerSumOfInfNormOfH;
-    };
-    threadPool.runParallel(std::move(infNormOfh_sumOfInfNormOfH), numWorkers);
-
-    const auto infNormOfh = *std::max_element(infNormOfhArray.cbegin(), infNormOfhArray.cend());
-    const auto sumOfInfNormOfH = std::accumulate(sumOfInfNormOfHArray.cbegin(), sumOfInfNormOfHArray.cend(), 0.0);
-    const auto averageOfInfNormOfH = sumOfInfNormOfH / static_cast<scalar_t>(numDecisionVariables);
-    const auto gamma = 1.0 / limitScaling(std::max(averageOfInfNormOfH, infNormOfh));
-
-    // compute EOut, DOut, and scale cost
-    timeIndex = 0;
-    auto computeDOutEOutScaleCost = [&](int workerId) {
-      int k = timeIndex++;
-      while (k < N) {
-        EOut[k].array() *= E[k].array();
-        DOut[2 * k].array() *= D[2 * k].array();
-        DOut[2 * k + 1].array() *= D[2 * k + 1].array();
-        // cost
-        cost[k].dfdxx *= gamma;
-        cost[k].dfduu *= gamma;
-        cost[k].dfdux *= gamma;
-        cost[k].dfdx *= gamma;
-        cost[k].dfdu *= gamma;
-
-        k = timeIndex++;
-      }
-      if (k == N) {  // Only one worker will execute this
-        cost[N].dfdxx *= gamma;
-        cost[N].dfduu *= gamma;
-        cost[N].dfdux *= gamma;
-        cost[N].dfdx *= gamma;
-        cost[N].dfdu *= gamma;
-      }
-    };
-    threadPool.runParallel(std::move(computeDOutEOutScaleCost), numWorkers);
+  for (int i = 0; i < N; i++) {
+    ocpData.C(i).setOnes();
+  }
 
-    // compute cOut
-    cOut *= gamma;
+  // Apply the initial scaling at once, as the scaling of the passes commute.
+  if (isScalingConsistent(ocpSize, DInOut, EInOut, cInOut)) {
+    scaleDataOneStepInPlaceInParallel(threadPool, DInOut, EInOut, ocpData);
+    scaleCostInPlaceInParallel(threadPool, cInOut, ocpData);
+  } else {
+    setScalingToIdentity(ocpSize, DInOut, EInOut, cInOut);
+  }
+
+  RuizWorkspace workspace(ocpSize, threadPool.numThreads() + 1U);
+  size_t numPasses = 0;
+  while (numPasses < maxIteration) {
+    const auto deviation = invSqrtInfNormInParallel(threadPool, ocpData, workspace.D, workspace.E);
+    if (deviation <= tolerance) {
+      break;
+    }
+    scaleOnePassInPlaceInParallel(threadPool, x0, workspace, ocpData, DInOut, EInOut, cInOut);
+    ++numPasses;
   }
+  return numPasses;
 }
 
 void kktMatrixInPlace(int iteration, Eigen::SparseMatrix<scalar_t>& H, vector_t& h, Eigen::SparseMatrix<scalar_t>& G, vector_t& g,
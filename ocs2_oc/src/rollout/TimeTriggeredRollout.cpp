@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/rollout/TimeTriggeredRollout.h"
 
+#include <ocs2_core/misc/Tracing.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -46,6 +48,7 @@ TimeTriggeredRollout::TimeTriggeredRollout(const ControlledSystemBase& systemDyn
 vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, ControllerBase* controller,
                                    ModeSchedule& modeSchedule, scalar_array_t& timeTrajectory, size_array_t& postEventIndices,
                                    vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+  OCS2_TRACE_SCOPE("TimeTriggeredRollout::run");
   if (initTime > finalTime) {
     throw std::runtime_error("[TimeTriggeredRollout::run] The initial time should be less-equal to the final time!");
   }
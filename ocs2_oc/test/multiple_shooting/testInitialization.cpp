@@ -0,0 +1,130 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+
+#include <ocs2_oc/multiple_shooting/Initialization.h>
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+class MultipleShootingInitializationTest : public testing::Test {
+ protected:
+  static constexpr int nx = 3;
+  static constexpr int nu = 2;
+
+  MultipleShootingInitializationTest() : dynamicsPtr(getOcs2Dynamics(getRandomDynamics(nx, nu))), initializer(nu) {
+    discretizer = selectDynamicsDiscretization(SensitivityIntegratorType::RK4);
+
+    // Previous solution on [0.0, 1.0]
+    for (int i = 0; i <= 10; i++) {
+      previousSolution.timeTrajectory_.push_back(0.1 * i);
+      previousSolution.stateTrajectory_.push_back(vector_t::Random(nx));
+      previousSolution.inputTrajectory_.push_back(vector_t::Random(nu));
+    }
+  }
+
+  std::unique_ptr<LinearSystemDynamics> dynamicsPtr;
+  DynamicsDiscretizer discretizer;
+  DefaultInitializer initializer;
+  PrimalSolution previousSolution;
+};
+
+constexpr int MultipleShootingInitializationTest::nx;
+constexpr int MultipleShootingInitializationTest::nu;
+
+TEST_F(MultipleShootingInitializationTest, extrapolateTail) {
+  const vector_t initState = vector_t::Random(nx);
+  const auto timeDiscretization = timeDiscretizationWithEvents(0.3, 1.3, 0.1, {});
+  const int N = static_cast<int>(timeDiscretization.size()) - 1;
+
+  vector_array_t xInit, uInit, xShift, uShift;
+  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, previousSolution, initializer, xInit, uInit);
+  multiple_shooting::shiftStateInputTrajectories(initState, timeDiscretization, previousSolution, initializer, discretizer, *dynamicsPtr,
+                                                 xShift, uShift);
+  ASSERT_EQ(xShift.size(), N + 1);
+  ASSERT_EQ(uShift.size(), N);
+
+  for (int i = 0; i < N; i++) {
+    const scalar_t time = getIntervalStart(timeDiscretization[i]);
+    const scalar_t nextTime = getIntervalEnd(timeDiscretization[i + 1]);
+    if (nextTime <= previousSolution.timeTrajectory_.back()) {
+      // Identical in the period of the previous solution
+      EXPECT_TRUE(uShift[i].isApprox(uInit[i]));
+      EXPECT_TRUE(xShift[i + 1].isApprox(xInit[i + 1]));
+    } else {
+      // Rollout with the last input in the tail
+      EXPECT_TRUE(uShift[i].isApprox(previousSolution.inputTrajectory_.back()));
+      EXPECT_TRUE(xShift[i + 1].isApprox(discretizer(*dynamicsPtr, time, xShift[i], uShift[i], nextTime - time)));
+    }
+  }
+}
+
+TEST_F(MultipleShootingInitializationTest, extrapolateTailUntilEvent) {
+  const vector_t initState = vector_t::Random(nx);
+  const scalar_t eventTime = 1.15;
+  const auto timeDiscretization = timeDiscretizationWithEvents(0.3, 1.3, 0.1, {eventTime});
+  const int N = static_cast<int>(timeDiscretization.size()) - 1;
+
+  vector_array_t x, u;
+  multiple_shooting::shiftStateInputTrajectories(initState, timeDiscretization, previousSolution, initializer, discretizer, *dynamicsPtr,
+                                                 x, u);
+
+  for (int i = 0; i < N; i++) {
+    const scalar_t time = getIntervalStart(timeDiscretization[i]);
+    if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
+      EXPECT_EQ(u[i].size(), 0);
+    } else if (time >= previousSolution.timeTrajectory_.back() && time < eventTime) {
+      EXPECT_TRUE(u[i].isApprox(previousSolution.inputTrajectory_.back()));
+    } else if (time > eventTime) {
+      // The initializer is used after the event
+      EXPECT_TRUE(u[i].isZero());
+      EXPECT_TRUE(x[i + 1].isApprox(x[i]));
+    }
+  }
+}
+
+TEST_F(MultipleShootingInitializationTest, noPreviousSolution) {
+  const vector_t initState = vector_t::Random(nx);
+  const auto timeDiscretization = timeDiscretizationWithEvents(0.3, 1.3, 0.1, {});
+
+  vector_array_t x, u;
+  multiple_shooting::shiftStateInputTrajectories(initState, timeDiscretization, PrimalSolution(), initializer, discretizer, *dynamicsPtr,
+                                                 x, u);
+
+  // Falls back to the initializer
+  EXPECT_TRUE(x.front().isApprox(initState));
+  for (int i = 0; i < u.size(); i++) {
+    EXPECT_TRUE(u[i].isZero());
+    EXPECT_TRUE(x[i + 1].isApprox(initState));
+  }
+}
@@ -65,6 +65,43 @@ TEST(test_transcription_metrics, intermediate) {
   ASSERT_TRUE(metrics.isApprox(multiple_shooting::computeMetrics(transcription), 1e-12));
 }
 
+TEST(test_transcription_metrics, intermediateInPlace) {
+  constexpr int nx = 2;
+  constexpr int nu = 2;
+
+  // optimal control problem with and without the state-input equality constraints
+  OptimalControlProblem unconstrainedProblem = createCircularKinematicsProblem("/tmp/sqp_test_generated");
+  unconstrainedProblem.inequalityConstraintPtr->add("inequalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 3)));
+  OptimalControlProblem constrainedProblem = unconstrainedProblem;
+  constrainedProblem.equalityConstraintPtr->add("equalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 1)));
+
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+
+  const scalar_t dt = 0.1;
+  multiple_shooting::TranscriptionWorkspace workspace;
+  for (auto* problemPtr : {&constrainedProblem, &unconstrainedProblem, &constrainedProblem}) {
+    const scalar_t t = 0.5;
+    const vector_t x = vector_t::Random(nx);
+    const vector_t x_next = vector_t::Random(nx);
+    const vector_t u = vector_t::Random(nu);
+
+    auto transcription = multiple_shooting::setupIntermediateNode(*problemPtr, sensitivityDiscretizer, t, dt, x, x_next, u);
+    multiple_shooting::setupIntermediateNode(*problemPtr, sensitivityDiscretizer, t, dt, x, x_next, u, workspace.intermediate);
+    ASSERT_TRUE(multiple_shooting::computeMetrics(transcription).isApprox(multiple_shooting::computeMetrics(workspace.intermediate), 1e-12));
+
+    multiple_shooting::projectTranscription(transcription, true);
+    multiple_shooting::projectTranscription(workspace.intermediate, true, workspace.projection);
+    const auto& result = workspace.intermediate;
+    EXPECT_TRUE(result.cost.dfduu.isApprox(transcription.cost.dfduu));
+    EXPECT_TRUE(result.dynamics.dfdu.isApprox(transcription.dynamics.dfdu));
+    EXPECT_TRUE(result.stateInputIneqConstraints.dfdu.isApprox(transcription.stateInputIneqConstraints.dfdu));
+    EXPECT_EQ(result.stateInputEqConstraints.f.size(), 0);
+    EXPECT_EQ(result.constraintsProjection.f.size(), transcription.constraintsProjection.f.size());
+    EXPECT_TRUE(result.constraintsProjection.dfdu.isApprox(transcription.constraintsProjection.dfdu));
+    EXPECT_TRUE(result.projectionMultiplierCoefficients.f.isApprox(transcription.projectionMultiplierCoefficients.f));
+  }
+}
+
 TEST(test_transcription_metrics, event) {
   constexpr int nx = 2;
 
@@ -127,4 +127,20 @@ TEST(test_time_discretization, withEvents) {
   ASSERT_EQ(time[12].event, AnnotatedTime::Event::PreEvent);
   ASSERT_EQ(time[13].event, AnnotatedTime::Event::PostEvent);
   ASSERT_EQ(time[14].event, AnnotatedTime::Event::None);
-}
\ No newline at end of file
+}
+TEST(test_time_discretization, inPlace) {
+  scalar_t dt = 0.1;
+  scalar_array_t eventTimes{3.25, 3.4, 3.8999999999999999999, 4.02, 4.5};
+  constexpr scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>();
+
+  // Reuse a discretization of a longer horizon
+  std::vector<AnnotatedTime> time = timeDiscretizationWithEvents(2.0, 4.0, dt, eventTimes);
+  timeDiscretizationWithEvents(3.0, 4.0, dt, eventTimes, dt_min, time);
+
+  const auto expected = timeDiscretizationWithEvents(3.0, 4.0, dt, eventTimes);
+  ASSERT_EQ(time.size(), expected.size());
+  for (size_t i = 0; i < time.size(); ++i) {
+    ASSERT_EQ(time[i].time, expected[i].time);
+    ASSERT_EQ(time[i].event, expected[i].event);
+  }
+}
@@ -0,0 +1,143 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "ocs2_oc/oc_problem/PackedOcpData.h"
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+class PackedOcpDataTest : public testing::Test {
+ protected:
+  static constexpr size_t N_ = 10;  // numStages
+  static constexpr size_t nx_ = 5;
+  static constexpr size_t nu_ = 3;
+
+  PackedOcpDataTest() {
+    srand(0);
+
+    for (int i = 0; i < N_; i++) {
+      dynamicsArray.push_back(ocs2::getRandomDynamics(nx_, nu_));
+      costArray.push_back(ocs2::getRandomCost(nx_, nu_));
+      scalingVectors.push_back(ocs2::vector_t::Random(nx_));
+    }
+    costArray.push_back(ocs2::getRandomCost(nx_, 0));
+
+    ocpSize_ = ocs2::extractSizesFromProblem(dynamicsArray, costArray, nullptr);
+  }
+
+  template <typename Scalar>
+  void pack(ocs2::PackedOcpData<Scalar>& ocpData) const {
+    ocpData.resize(ocpSize_);
+    for (int k = 0; k < N_; k++) {
+      ocpData.setDynamics(k, dynamicsArray[k], &scalingVectors[k]);
+      ocpData.setCost(k, costArray[k]);
+    }
+    ocpData.setCost(N_, costArray[N_]);
+  }
+
+  ocs2::OcpSize ocpSize_;
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamicsArray;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> costArray;
+  ocs2::vector_array_t scalingVectors;
+};
+
+constexpr size_t PackedOcpDataTest::N_;
+constexpr size_t PackedOcpDataTest::nx_;
+constexpr size_t PackedOcpDataTest::nu_;
+
+TEST_F(PackedOcpDataTest, roundTrip) {
+  ocs2::PackedOcpData<ocs2::scalar_t> ocpData;
+  pack(ocpData);
+  ASSERT_EQ(ocpData.numStages(), N_);
+
+  for (int k = 0; k < N_; k++) {
+    ocs2::VectorFunctionLinearApproximation dynamics;
+    ocs2::vector_t scalingVector;
+    ocpData.getDynamics(k, dynamics, scalingVector);
+    EXPECT_TRUE(dynamics.dfdx == dynamicsArray[k].dfdx);
+    EXPECT_TRUE(dynamics.dfdu == dynamicsArray[k].dfdu);
+    EXPECT_TRUE(dynamics.f == dynamicsArray[k].f);
+    EXPECT_TRUE(scalingVector == scalingVectors[k]);
+  }
+
+  for (int k = 0; k <= N_; k++) {
+    ocs2::ScalarFunctionQuadraticApproximation cost;
+    ocpData.getCost(k, cost);
+    EXPECT_TRUE(cost.dfdxx == costArray[k].dfdxx);
+    EXPECT_TRUE(cost.dfdx == costArray[k].dfdx);
+    if (k < N_) {
+      EXPECT_TRUE(cost.dfduu == costArray[k].dfduu);
+      EXPECT_TRUE(cost.dfdux == costArray[k].dfdux);
+      EXPECT_TRUE(cost.dfdu == costArray[k].dfdu);
+    }
+  }
+}
+
+TEST_F(PackedOcpDataTest, alignment) {
+  ocs2::PackedOcpData<float> ocpData;
+  pack(ocpData);
+
+  auto address = [](const float* ptr) { return reinterpret_cast<std::uintptr_t>(ptr); };
+  for (int k = 0; k < N_; k++) {
+    // Every stage starts at a cache line, and every block is 16-byte aligned.
+    EXPECT_EQ(address(ocpData.A(k).data()) % 64, 0);
+    for (const float* ptr : {ocpData.B(k).data(), ocpData.b(k).data(), ocpData.C(k).data(), ocpData.Q(k).data(), ocpData.R(k).data(),
+                             ocpData.P(k).data(), ocpData.q(k).data(), ocpData.r(k).data()}) {
+      EXPECT_EQ(address(ptr) % 16, 0);
+    }
+    // Stage major: the data of stage k lies in front of the data of stage k + 1.
+    EXPECT_LT(address(ocpData.r(k).data()), address(ocpData.A(k + 1).data()));
+  }
+}
+
+TEST_F(PackedOcpDataTest, setStage) {
+  ocs2::PackedOcpData<ocs2::scalar_t> doubleData;
+  pack(doubleData);
+
+  ocs2::PackedOcpData<float> floatData(ocpSize_);
+  for (int k = 0; k <= N_; k++) {
+    floatData.setStage(k, doubleData);
+  }
+
+  for (int k = 0; k < N_; k++) {
+    EXPECT_TRUE(floatData.A(k).isApprox(dynamicsArray[k].dfdx.cast<float>()));
+    EXPECT_TRUE(floatData.B(k).isApprox(dynamicsArray[k].dfdu.cast<float>()));
+    EXPECT_TRUE(floatData.b(k).isApprox(dynamicsArray[k].f.cast<float>()));
+    EXPECT_TRUE(floatData.C(k).isApprox(scalingVectors[k].cast<float>()));
+    EXPECT_TRUE(floatData.R(k).isApprox(costArray[k].dfduu.cast<float>()));
+    EXPECT_TRUE(floatData.P(k).isApprox(costArray[k].dfdux.cast<float>()));
+    EXPECT_TRUE(floatData.r(k).isApprox(costArray[k].dfdu.cast<float>()));
+  }
+  for (int k = 0; k <= N_; k++) {
+    EXPECT_TRUE(floatData.Q(k).isApprox(costArray[k].dfdxx.cast<float>()));
+    EXPECT_TRUE(floatData.q(k).isApprox(costArray[k].dfdx.cast<float>()));
+  }
+}
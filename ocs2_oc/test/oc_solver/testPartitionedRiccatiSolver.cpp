@@ -0,0 +1,177 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/oc_problem/OcpSize.h"
+#include "ocs2_oc/oc_problem/OcpToKkt.h"
+#include "ocs2_oc/oc_solver/PartitionedRiccatiSolver.h"
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+class PartitionedRiccatiSolverTest : public testing::Test {
+ protected:
+  static constexpr size_t N_ = 20;  // numStages
+  static constexpr size_t nx_ = 4;
+  static constexpr size_t nu_ = 3;
+  static constexpr ocs2::scalar_t tol_ = 1e-7;
+
+  PartitionedRiccatiSolverTest() : threadPool_(3) {
+    srand(0);
+
+    x0_ = ocs2::vector_t::Random(nx_);
+    for (int i = 0; i < N_; i++) {
+      auto dynamics = ocs2::getRandomDynamics(nx_, nu_);
+      dynamics.dfdx *= 0.5;  // keeps the random dynamics stable over the horizon
+      dynamicsArray_.push_back(std::move(dynamics));
+      costArray_.push_back(ocs2::getRandomCost(nx_, nu_));
+    }
+    costArray_.push_back(ocs2::getRandomCost(nx_, 0));
+  }
+
+  /** Solves the KKT system of the equality constrained QP in Z = [u_{0}; x_{1}; ...; u_{N-1}; x_{N}]. */
+  ocs2::vector_t solveKkt() const {
+    const auto ocpSize = ocs2::extractSizesFromProblem(dynamicsArray_, costArray_, nullptr);
+    ocs2::VectorFunctionLinearApproximation constraints;
+    ocs2::getConstraintMatrix(ocpSize, x0_, dynamicsArray_, nullptr, nullptr, constraints);
+    ocs2::ScalarFunctionQuadraticApproximation cost;
+    ocs2::getCostMatrix(ocpSize, x0_, costArray_, cost);
+
+    const auto nz = cost.dfdx.size();
+    const auto nc = constraints.f.size();
+    ocs2::matrix_t kkt = ocs2::matrix_t::Zero(nz + nc, nz + nc);
+    kkt.topLeftCorner(nz, nz) = cost.dfdxx;
+    kkt.topRightCorner(nz, nc) = constraints.dfdx.transpose();
+    kkt.bottomLeftCorner(nc, nz) = constraints.dfdx;
+    ocs2::vector_t rhs(nz + nc);
+    rhs << -cost.dfdx, constraints.f;
+    return kkt.lu().solve(rhs).head(nz);
+  }
+
+  ocs2::ThreadPool threadPool_;
+  ocs2::vector_t x0_;
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamicsArray_;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> costArray_;
+};
+
+constexpr size_t PartitionedRiccatiSolverTest::N_;
+constexpr size_t PartitionedRiccatiSolverTest::nx_;
+constexpr size_t PartitionedRiccatiSolverTest::nu_;
+constexpr ocs2::scalar_t PartitionedRiccatiSolverTest::tol_;
+
+TEST_F(PartitionedRiccatiSolverTest, compareToKkt) {
+  const ocs2::vector_t zKkt = solveKkt();
+
+  for (size_t numPartitions : {1, 2, 3, 7, 20, 50}) {
+    ocs2::PartitionedRiccatiSolver solver(numPartitions);
+    ocs2::vector_array_t xSol, uSol;
+    solver.solve(threadPool_, x0_, dynamicsArray_, costArray_, xSol, uSol);
+
+    ASSERT_EQ(xSol.size(), N_ + 1);
+    ASSERT_EQ(uSol.size(), N_);
+    EXPECT_TRUE(xSol[0].isApprox(x0_));
+    for (int k = 0; k < N_; k++) {
+      const auto offset = k * (nx_ + nu_);
+      EXPECT_TRUE(uSol[k].isApprox(zKkt.segment(offset, nu_), tol_)) << "numPartitions: " << numPartitions << ", k: " << k;
+      EXPECT_TRUE(xSol[k + 1].isApprox(zKkt.segment(offset + nu_, nx_), tol_)) << "numPartitions: " << numPartitions << ", k: " << k;
+    }
+  }
+}
+
+TEST_F(PartitionedRiccatiSolverTest, compareToSequentialRiccati) {
+  ocs2::PartitionedRiccatiSolver sequentialSolver(1);
+  ocs2::vector_array_t xSol, uSol;
+  sequentialSolver.solve(threadPool_, x0_, dynamicsArray_, costArray_, xSol, uSol);
+  const auto sequentialCostToGo = sequentialSolver.getRiccatiCostToGo();
+  ASSERT_EQ(sequentialCostToGo.size(), N_ + 1);
+
+  ocs2::PartitionedRiccatiSolver partitionedSolver(4);
+  partitionedSolver.solve(threadPool_, x0_, dynamicsArray_, costArray_, xSol, uSol);
+  const auto partitionedCostToGo = partitionedSolver.getRiccatiCostToGo();
+  ASSERT_EQ(partitionedCostToGo.size(), N_ + 1);
+
+  for (int k = 0; k < N_; k++) {
+    EXPECT_TRUE(partitionedSolver.getRiccatiFeedback()[k].isApprox(sequentialSolver.getRiccatiFeedback()[k], tol_));
+    EXPECT_TRUE(partitionedSolver.getRiccatiFeedforward()[k].isApprox(sequentialSolver.getRiccatiFeedforward()[k], tol_));
+  }
+  for (int k = 0; k <= N_; k++) {
+    EXPECT_TRUE(partitionedCostToGo[k].dfdxx.isApprox(sequentialCostToGo[k].dfdxx, tol_));
+    EXPECT_TRUE(partitionedCostToGo[k].dfdx.isApprox(sequentialCostToGo[k].dfdx, tol_));
+  }
+}
+
+TEST_F(PartitionedRiccatiSolverTest, stagesWithoutInputs) {
+  // Event nodes have no inputs
+  for (int k : {4, 11}) {
+    dynamicsArray_[k] = ocs2::getRandomDynamics(nx_, 0);
+    dynamicsArray_[k].dfdx *= 0.5;
+    costArray_[k] = ocs2::getRandomCost(nx_, 0);
+  }
+
+  ocs2::PartitionedRiccatiSolver sequentialSolver(1);
+  ocs2::vector_array_t xSequential, uSequential;
+  sequentialSolver.solve(threadPool_, x0_, dynamicsArray_, costArray_, xSequential, uSequential);
+
+  ocs2::PartitionedRiccatiSolver partitionedSolver(4);
+  ocs2::vector_array_t xSol, uSol;
+  partitionedSolver.solve(threadPool_, x0_, dynamicsArray_, costArray_, xSol, uSol);
+
+  ASSERT_EQ(uSol[4].size(), 0);
+  ASSERT_EQ(uSol[11].size(), 0);
+  for (int k = 0; k < N_; k++) {
+    EXPECT_TRUE(uSol[k].isApprox(uSequential[k], tol_)) << "k: " << k;
+    EXPECT_TRUE(xSol[k + 1].isApprox(xSequential[k + 1], tol_)) << "k: " << k;
+    EXPECT_TRUE(xSol[k + 1].isApprox(dynamicsArray_[k].dfdx * xSol[k] + dynamicsArray_[k].dfdu * uSol[k] + dynamicsArray_[k].f, tol_));
+  }
+}
+
+TEST_F(PartitionedRiccatiSolverTest, costToGoGradient) {
+  // The gradient of the optimal cost w.r.t. x_k equals the Riccati cost-to-go gradient along the optimal trajectory
+  ocs2::PartitionedRiccatiSolver solver(5);
+  ocs2::vector_array_t xSol, uSol;
+  solver.solve(threadPool_, x0_, dynamicsArray_, costArray_, xSol, uSol);
+  const auto costToGo = solver.getRiccatiCostToGo();
+
+  const auto& terminalCost = costArray_.back();
+  const ocs2::vector_t terminalGradient = terminalCost.dfdxx * xSol.back() + terminalCost.dfdx;
+  const ocs2::vector_t costToGoGradient = costToGo.back().dfdxx * xSol.back() + costToGo.back().dfdx;
+  EXPECT_TRUE(costToGoGradient.isApprox(terminalGradient, tol_));
+
+  // Adjoint recursion lambda_k = Q x + P' u + q + A' lambda_{k+1}
+  ocs2::vector_t lambda = terminalGradient;
+  for (int k = N_ - 1; k >= 0; k--) {
+    const auto& cost = costArray_[k];
+    const auto& dynamics = dynamicsArray_[k];
+    lambda = cost.dfdxx * xSol[k] + cost.dfdux.transpose() * uSol[k] + cost.dfdx + dynamics.dfdx.transpose() * lambda;
+    const ocs2::vector_t gradient = costToGo[k].dfdxx * xSol[k] + costToGo[k].dfdx;
+    EXPECT_TRUE(gradient.isApprox(lambda, tol_)) << "k: " << k;
+  }
+}
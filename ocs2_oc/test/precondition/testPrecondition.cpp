@@ -187,6 +187,79 @@ TEST_F(PreconditionTest, ocpDataInPlaceInParallel) {
   EXPECT_TRUE(g_ref.isApprox(g_scaledData));  // g
 }
 
+TEST_F(PreconditionTest, ocpDataIncrementallyInPlaceInParallel) {
+  ocs2::ThreadPool threadPool(5, 99);
+
+  auto packOcpData = [&](ocs2::PackedOcpData<ocs2::scalar_t>& ocpData) {
+    ocpData.resize(ocpSize_);
+    for (int k = 0; k < N_; k++) {
+      ocpData.setDynamics(k, dynamicsArray[k], nullptr);
+      ocpData.setCost(k, costArray[k]);
+    }
+    ocpData.setCost(N_, costArray[N_]);
+  };
+
+  // Test 1: Starting from identity with zero tolerance, it is identical to the fixed number of passes.
+  ocs2::PackedOcpData<ocs2::scalar_t> ocpData_ref, ocpData;
+  packOcpData(ocpData_ref);
+  packOcpData(ocpData);
+
+  ocs2::vector_array_t D_ref, E_ref;
+  ocs2::scalar_t c_ref;
+  ocs2::precondition::ocpDataInPlaceInParallel(threadPool, x0, 5, ocpData_ref, D_ref, E_ref, c_ref);
+
+  ocs2::vector_array_t D, E;
+  ocs2::scalar_t c = 1.0;
+  ASSERT_EQ(ocs2::precondition::ocpDataIncrementallyInPlaceInParallel(threadPool, x0, 5, 0.0, ocpData, D, E, c), 5);
+
+  EXPECT_DOUBLE_EQ(c, c_ref);
+  for (int k = 0; k < 2 * N_; k++) {
+    EXPECT_TRUE(D[k].isApprox(D_ref[k]));
+  }
+  for (int k = 0; k < N_; k++) {
+    EXPECT_TRUE(E[k].isApprox(E_ref[k]));
+    EXPECT_TRUE(ocpData.A(k).isApprox(ocpData_ref.A(k)));
+    EXPECT_TRUE(ocpData.B(k).isApprox(ocpData_ref.B(k)));
+    EXPECT_TRUE(ocpData.b(k).isApprox(ocpData_ref.b(k)));
+    EXPECT_TRUE(ocpData.R(k).isApprox(ocpData_ref.R(k)));
+  }
+  for (int k = 0; k <= N_; k++) {
+    EXPECT_TRUE(ocpData.Q(k).isApprox(ocpData_ref.Q(k)));
+    EXPECT_TRUE(ocpData.q(k).isApprox(ocpData_ref.q(k)));
+  }
+
+  // Test 2: Reusing the converged scaling on slightly perturbed data needs fewer passes than starting from scratch.
+  constexpr size_t maxIteration = 100;
+  constexpr ocs2::scalar_t tolerance = 1e-3;
+  packOcpData(ocpData);
+  D.clear();
+  E.clear();
+  c = 1.0;
+  const auto numColdPasses =
+      ocs2::precondition::ocpDataIncrementallyInPlaceInParallel(threadPool, x0, maxIteration, tolerance, ocpData, D, E, c);
+  EXPECT_GT(numColdPasses, 0);
+  EXPECT_LT(numColdPasses, maxIteration);
+
+  for (auto& dynamics : dynamicsArray) {
+    dynamics.dfdx += 0.01 * ocs2::matrix_t::Random(nx_, nx_);
+  }
+  packOcpData(ocpData);
+  const auto numWarmPasses =
+      ocs2::precondition::ocpDataIncrementallyInPlaceInParallel(threadPool, x0, maxIteration, tolerance, ocpData, D, E, c);
+  EXPECT_LT(numWarmPasses, numColdPasses);
+
+  // The data is scaled by the returned factors, including the ones given as the starting point.
+  for (int k = 0; k < N_; k++) {
+    const auto& Du = D[2 * k];
+    EXPECT_TRUE(ocpData.B(k).isApprox(E[k].asDiagonal() * dynamicsArray[k].dfdu * Du.asDiagonal()));
+    EXPECT_TRUE(ocpData.R(k).isApprox(c * Du.asDiagonal() * costArray[k].dfduu * Du.asDiagonal()));
+    if (k > 0) {
+      const auto& Dx = D[2 * k - 1];
+      EXPECT_TRUE(ocpData.A(k).isApprox(E[k].asDiagonal() * dynamicsArray[k].dfdx * Dx.asDiagonal()));
+    }
+  }
+}
+
 TEST_F(PreconditionTest, descaleSolution) {
   ocs2::vector_array_t D(2 * N_);
   ocs2::vector_t DStacked(numDecisionVariables_);
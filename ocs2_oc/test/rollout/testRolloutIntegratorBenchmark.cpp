@@ -0,0 +1,114 @@
+/******************************************************************************
+Copyright (c) 2023, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+using namespace ocs2;
+
+namespace {
+
+struct RolloutResult {
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+};
+
+}  // namespace
+
+/**
+ * Compares the per-step cost of a TimeTriggeredRollout through the boost odeint fixed-step integrators against the in-house
+ * fixed-step integrators of the same scheme. Both take the same steps, such that the difference is the integration overhead.
+ */
+TEST(RolloutIntegratorBenchmark, fixedStepIntegrators) {
+  constexpr size_t numRollouts = 20;
+  constexpr size_t nx = 12;
+  constexpr size_t nu = 4;
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const scalar_t timeStep = 1e-3;
+
+  srand(0);
+  const matrix_t A = -matrix_t::Identity(nx, nx) + 0.1 * matrix_t::Random(nx, nx);
+  const matrix_t B = matrix_t::Random(nx, nu);
+  LinearSystemDynamics systemDynamics(A, B);
+
+  const scalar_array_t controllerTimeStamp{initTime, finalTime};
+  const vector_array_t uff(2, vector_t::Ones(nu));
+  const matrix_array_t k(2, -0.1 * matrix_t::Ones(nu, nx));
+  LinearController controller(controllerTimeStamp, uff, k);
+
+  ModeSchedule modeSchedule({0.3, 0.6}, {0, 1, 2});
+  const vector_t initState = vector_t::Ones(nx);
+
+  auto runBenchmark = [&](IntegratorType integratorType, RolloutResult& result) {
+    rollout::Settings settings;
+    settings.integratorType = integratorType;
+    settings.timeStep = timeStep;
+    settings.maxNumStepsPerSecond = 100000;
+    TimeTriggeredRollout rollout(systemDynamics, settings);
+
+    benchmark::RepeatedTimer timer;
+    for (size_t i = 0; i < numRollouts; i++) {
+      timer.startTimer();
+      rollout.run(initTime, initState, finalTime, &controller, modeSchedule, result.timeTrajectory, result.postEventIndices,
+                  result.stateTrajectory, result.inputTrajectory);
+      timer.endTimer();
+    }
+    // time per integration step in microseconds
+    return 1e3 * timer.getAverageInMilliseconds() / static_cast<scalar_t>(result.timeTrajectory.size());
+  };
+
+  const std::vector<std::pair<IntegratorType, IntegratorType>> integratorPairs{{IntegratorType::EULER, IntegratorType::EULER_OCS2},
+                                                                               {IntegratorType::RK4, IntegratorType::RK4_OCS2}};
+  for (const auto& integratorPair : integratorPairs) {
+    RolloutResult boostResult, ocs2Result;
+    const scalar_t boostPerStep = runBenchmark(integratorPair.first, boostResult);
+    const scalar_t ocs2PerStep = runBenchmark(integratorPair.second, ocs2Result);
+
+    ASSERT_EQ(boostResult.timeTrajectory.size(), ocs2Result.timeTrajectory.size());
+    ASSERT_EQ(boostResult.postEventIndices, ocs2Result.postEventIndices);
+    for (size_t i = 0; i < boostResult.timeTrajectory.size(); i++) {
+      ASSERT_DOUBLE_EQ(boostResult.timeTrajectory[i], ocs2Result.timeTrajectory[i]) << "i: " << i;
+      ASSERT_TRUE(boostResult.stateTrajectory[i].isApprox(ocs2Result.stateTrajectory[i], 1e-10)) << "i: " << i;
+    }
+
+    std::cerr << "[RolloutIntegratorBenchmark] nx = " << nx << ", nu = " << nu << ", steps = " << boostResult.timeTrajectory.size() << "\n"
+              << "\t" << integrator_type::toString(integratorPair.first) << " per step [us]: " << boostPerStep << "\n"
+              << "\t" << integrator_type::toString(integratorPair.second) << " per step [us]: " << ocs2PerStep << "\n";
+  }
+}
@@ -255,4 +255,60 @@ TEST(linear_change_of_input_variables, bothPx_U0) {
   const vector_t unprojected = evaluate(linear, dx, Pu * du_tilde + Px * dx + u0);
   const vector_t projected = evaluate(linearProjected, dx, du_tilde);
   ASSERT_TRUE(unprojected.isApprox(projected));
-}
\ No newline at end of file
+}
+TEST(quadratic_change_of_input_variables, sparsePx) {
+  const int n = 6;
+  const int m = 3;
+  const int p = 2;
+
+  // Create change of variables, Px only has non-zero columns 1, 2 and 4
+  const column_blocks_t PxColumns{{1, 2}, {4, 1}};
+  const matrix_t Pu = matrix_t::Random(m, p);
+  matrix_t Px = matrix_t::Zero(m, n);
+  for (const auto& block : PxColumns) {
+    Px.middleCols(block.start, block.size).setRandom();
+  }
+  const vector_t u0 = vector_t::Random(m);
+  const auto quadratic = getRandomCost(n, m);
+
+  // Apply change of variables
+  auto quadraticProjected = quadratic;
+  changeOfInputVariables(quadraticProjected, Pu, Px, u0);
+  auto quadraticProjectedSparse = quadratic;
+  changeOfInputVariables(quadraticProjectedSparse, Pu, Px, u0, &PxColumns);
+
+  // Compare
+  ASSERT_TRUE(quadraticProjectedSparse.dfdxx.isApprox(quadraticProjected.dfdxx));
+  ASSERT_TRUE(quadraticProjectedSparse.dfdux.isApprox(quadraticProjected.dfdux));
+  ASSERT_TRUE(quadraticProjectedSparse.dfduu.isApprox(quadraticProjected.dfduu));
+  ASSERT_TRUE(quadraticProjectedSparse.dfdx.isApprox(quadraticProjected.dfdx));
+  ASSERT_TRUE(quadraticProjectedSparse.dfdu.isApprox(quadraticProjected.dfdu));
+  ASSERT_DOUBLE_EQ(quadraticProjectedSparse.f, quadraticProjected.f);
+}
+
+TEST(linear_change_of_input_variables, sparsePx) {
+  const int n = 6;
+  const int m = 3;
+  const int p = 2;
+
+  // Create change of variables, Px only has non-zero columns 0 and 3
+  const column_blocks_t PxColumns{{0, 1}, {3, 1}};
+  const matrix_t Pu = matrix_t::Random(m, p);
+  matrix_t Px = matrix_t::Zero(m, n);
+  for (const auto& block : PxColumns) {
+    Px.middleCols(block.start, block.size).setRandom();
+  }
+  const vector_t u0 = vector_t::Random(m);
+  const auto linear = getRandomDynamics(n, m);
+
+  // Apply change of variables
+  auto linearProjected = linear;
+  changeOfInputVariables(linearProjected, Pu, Px, u0);
+  auto linearProjectedSparse = linear;
+  changeOfInputVariables(linearProjectedSparse, Pu, Px, u0, &PxColumns);
+
+  // Compare
+  ASSERT_TRUE(linearProjectedSparse.dfdx.isApprox(linearProjected.dfdx));
+  ASSERT_TRUE(linearProjectedSparse.dfdu.isApprox(linearProjected.dfdu));
+  ASSERT_TRUE(linearProjectedSparse.f.isApprox(linearProjected.f));
+}
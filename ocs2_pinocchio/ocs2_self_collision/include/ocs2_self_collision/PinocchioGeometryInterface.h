@@ -46,6 +46,8 @@ namespace ocs2 {
 
 class PinocchioGeometryInterface final {
  public:
+  using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+
   /**
    * Constructor
    *
@@ -77,6 +79,25 @@ class PinocchioGeometryInterface final {
    */
   std::vector<hpp::fcl::DistanceResult> computeDistances(const PinocchioInterface& pinocchioInterface) const;
 
+  /**
+   * Compute collision pair distances with a bounding sphere broadphase and warm started GJK queries.
+   *
+   * Pairs whose bounding spheres are further apart than activationDistance skip the narrowphase. Their result holds the distance
+   * between the bounding spheres, which is a lower bound on the distance between the objects, and the nearest points on the spheres.
+   * The distance is therefore discontinuous where a pair crosses the activation distance.
+   *
+   * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in] activationDistance: Bounding sphere distance above which a pair is not passed to the narrowphase.
+   * @param [in, out] distanceRequests: The distance request of each collision pair. The GJK guess of every evaluated pair is updated
+   *                                    to warm start the next call.
+   * @param [out] distanceResults: The distance result of each collision pair.
+   */
+  void computeDistances(const PinocchioInterface& pinocchioInterface, scalar_t activationDistance,
+                        std::vector<hpp::fcl::DistanceRequest>& distanceRequests,
+                        std::vector<hpp::fcl::DistanceResult>& distanceResults) const;
+
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const;
 
@@ -91,8 +112,15 @@ class PinocchioGeometryInterface final {
                                const std::vector<std::pair<size_t, size_t>>& collisionObjectPairs);
   void addCollisionLinkPairs(const PinocchioInterface& pinocchioInterface,
                              const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs);
+  void computeBoundingSpheres();
+
+  struct BoundingSphere {
+    vector3_t center;  // in the frame of the geometry object
+    scalar_t radius;
+  };
 
   std::shared_ptr<pinocchio::GeometryModel> geometryModelPtr_;
+  std::vector<BoundingSphere> boundingSpheres_;  // one per geometry object
 };
 
 }  // namespace ocs2
@@ -29,11 +29,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 #include <ocs2_self_collision/PinocchioGeometryInterface.h>
 
 namespace ocs2 {
 
+/**
+ * Self-collision distances of the collision pairs of a PinocchioGeometryInterface.
+ *
+ * Pairs whose bounding spheres are further apart than the activation distance are not passed to GJK; their distance is
+ * approximated by the distance between the bounding spheres. The GJK queries of the remaining pairs are warm started from the
+ * previous call. The distance and its gradient jump when a pair crosses the activation distance. The activation distance should
+ * thus lie where the penalty of the constraint is negligible.
+ *
+ * @note The evaluation reuses internal storage and is not thread-safe. Each thread should use its own copy, as done by cloning
+ * the optimal control problem for every worker.
+ */
 class SelfCollision {
  public:
   using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
@@ -43,8 +56,11 @@ class SelfCollision {
    *
    * @param [in] pinocchioGeometryInterface: pinocchio geometry interface of the robot model
    * @parma [in] minimumDistance: minimum allowed distance between each collision pair
+   * @param [in] activationDistance: bounding sphere distance above which a collision pair is not evaluated by GJK. By default all
+   *                                 pairs are evaluated.
    */
-  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance);
+  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity());
 
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const { return pinocchioGeometryInterface_.getNumCollisionPairs(); }
@@ -76,6 +92,15 @@ class SelfCollision {
  private:
   PinocchioGeometryInterface pinocchioGeometryInterface_;
   scalar_t minimumDistance_;
+  scalar_t activationDistance_;
+
+  mutable std::vector<hpp::fcl::DistanceRequest> distanceRequests_;
+  mutable std::vector<hpp::fcl::DistanceResult> distanceResults_;
+
+  // Jacobians of the parent joints of the collision objects, shared between the pairs of the same joint
+  std::vector<size_t> jointIndices_;
+  std::vector<std::pair<size_t, size_t>> pairToJointJacobianIndices_;
+  mutable matrix_array_t jointJacobians_;
 };
 
 }  // namespace ocs2
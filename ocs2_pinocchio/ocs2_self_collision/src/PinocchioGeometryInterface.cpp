@@ -38,6 +38,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <pinocchio/multibody/model.hpp>
 #include <pinocchio/parsers/urdf.hpp>
 
+#include <hpp/fcl/distance.h>
+
 #include <urdf_parser/urdf_parser.h>
 
 namespace ocs2 {
@@ -51,6 +53,7 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
   buildGeomFromPinocchioInterface(pinocchioInterface, *geometryModelPtr_);
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
+  computeBoundingSpheres();
 }
 
 PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface& pinocchioInterface,
@@ -61,6 +64,7 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
   addCollisionLinkPairs(pinocchioInterface, collisionLinkPairs);
+  computeBoundingSpheres();
 }
 
 /******************************************************************************************************/
@@ -75,6 +79,56 @@ std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistanc
   return std::move(geometryData.distanceResults);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::computeDistances(const PinocchioInterface& pinocchioInterface, scalar_t activationDistance,
+                                                  std::vector<hpp::fcl::DistanceRequest>& distanceRequests,
+                                                  std::vector<hpp::fcl::DistanceResult>& distanceResults) const {
+  const auto& data = pinocchioInterface.getData();
+  const auto& geometryModel = *geometryModelPtr_;
+  const size_t numCollisionPairs = geometryModel.collisionPairs.size();
+
+  if (distanceRequests.size() != numCollisionPairs) {
+    hpp::fcl::DistanceRequest request(true);  // enable nearest points
+    request.enable_cached_gjk_guess = true;
+    distanceRequests.assign(numCollisionPairs, request);
+  }
+  distanceResults.resize(numCollisionPairs);
+
+  for (size_t i = 0; i < numCollisionPairs; ++i) {
+    const auto& collisionPair = geometryModel.collisionPairs[i];
+    const auto& object1 = geometryModel.geometryObjects[collisionPair.first];
+    const auto& object2 = geometryModel.geometryObjects[collisionPair.second];
+    const pinocchio::SE3 placement1 = data.oMi[object1.parentJoint] * object1.placement;
+    const pinocchio::SE3 placement2 = data.oMi[object2.parentJoint] * object2.placement;
+
+    // Broadphase: the distance between the bounding spheres is a lower bound on the distance between the objects
+    const auto& sphere1 = boundingSpheres_[collisionPair.first];
+    const auto& sphere2 = boundingSpheres_[collisionPair.second];
+    const vector3_t center1 = placement1.act(sphere1.center);
+    const vector3_t center2 = placement2.act(sphere2.center);
+    const scalar_t centerDistance = (center2 - center1).norm();
+    const scalar_t sphereDistance = centerDistance - sphere1.radius - sphere2.radius;
+
+    auto& result = distanceResults[i];
+    result.clear();
+    if (sphereDistance > activationDistance) {
+      // coinciding centers can only be culled with a negative activation distance, any direction is valid then
+      const vector3_t normal = (centerDistance > 0.0) ? vector3_t((center2 - center1) / centerDistance) : vector3_t::UnitX();
+      result.min_distance = sphereDistance;
+      result.nearest_points[0] = center1 + sphere1.radius * normal;
+      result.nearest_points[1] = center2 - sphere2.radius * normal;
+    } else {
+      auto& request = distanceRequests[i];
+      hpp::fcl::distance(object1.geometry.get(), hpp::fcl::Transform3f(placement1.rotation(), placement1.translation()),
+                         object2.geometry.get(), hpp::fcl::Transform3f(placement2.rotation(), placement2.translation()), request, result);
+      // start the next GJK query of this pair from the last support direction
+      request.updateGuess(result);
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -139,4 +193,16 @@ void PinocchioGeometryInterface::addCollisionLinkPairs(const PinocchioInterface&
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::computeBoundingSpheres() {
+  boundingSpheres_.clear();
+  boundingSpheres_.reserve(geometryModelPtr_->geometryObjects.size());
+  for (const auto& object : geometryModelPtr_->geometryObjects) {
+    object.geometry->computeLocalAABB();
+    boundingSpheres_.push_back({object.geometry->aabb_center, object.geometry->aabb_radius});
+  }
+}
+
 }  // namespace ocs2
@@ -29,12 +29,12 @@
 
 #include <pinocchio/fwd.hpp>
 
+#include <algorithm>
+#include <iterator>
+
 #include <pinocchio/algorithm/jacobian.hpp>
 #include <pinocchio/multibody/geometry.hpp>
 
-#include <ocs2_robotic_tools/common/RotationTransforms.h>
-#include <ocs2_robotic_tools/common/SkewSymmetricMatrix.h>
-
 #include <ocs2_self_collision/SelfCollision.h>
 
 namespace ocs2 {
@@ -42,18 +42,40 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
-    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance) {}
+SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                             scalar_t activationDistance)
+    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)),
+      minimumDistance_(minimumDistance),
+      activationDistance_(activationDistance) {
+  const auto& geometryModel = pinocchioGeometryInterface_.getGeometryModel();
+
+  auto getJointJacobianIndex = [&](size_t jointIndex) {
+    const auto it = std::find(jointIndices_.begin(), jointIndices_.end(), jointIndex);
+    if (it != jointIndices_.end()) {
+      return static_cast<size_t>(std::distance(jointIndices_.begin(), it));
+    }
+    jointIndices_.push_back(jointIndex);
+    return jointIndices_.size() - 1;
+  };
+
+  pairToJointJacobianIndices_.reserve(geometryModel.collisionPairs.size());
+  for (const auto& collisionPair : geometryModel.collisionPairs) {
+    const size_t index1 = getJointJacobianIndex(geometryModel.geometryObjects[collisionPair.first].parentJoint);
+    const size_t index2 = getJointJacobianIndex(geometryModel.geometryObjects[collisionPair.second].parentJoint);
+    pairToJointJacobianIndices_.emplace_back(index1, index2);
+  }
+  jointJacobians_.resize(jointIndices_.size());
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  pinocchioGeometryInterface_.computeDistances(pinocchioInterface, activationDistance_, distanceRequests_, distanceResults_);
 
-  vector_t violations = vector_t::Zero(distanceArray.size());
-  for (size_t i = 0; i < distanceArray.size(); ++i) {
-    violations[i] = distanceArray[i].min_distance - minimumDistance_;
+  vector_t violations(distanceResults_.size());
+  for (size_t i = 0; i < distanceResults_.size(); ++i) {
+    violations[i] = distanceResults_[i].min_distance - minimumDistance_;
   }
 
   return violations;
@@ -63,49 +85,50 @@ vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) c
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  pinocchioGeometryInterface_.computeDistances(pinocchioInterface, activationDistance_, distanceRequests_, distanceResults_);
 
   const auto& model = pinocchioInterface.getModel();
   const auto& data = pinocchioInterface.getData();
 
-  const auto& geometryModel = pinocchioGeometryInterface_.getGeometryModel();
+  // Jacobians from pinocchio are given as
+  // [ position jacobian ]
+  // [ rotation jacobian ]
+  for (size_t j = 0; j < jointIndices_.size(); ++j) {
+    jointJacobians_[j].setZero(6, model.nv);
+    pinocchio::getJointJacobian(model, data, jointIndices_[j], pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, jointJacobians_[j]);
+  }
+
+  vector_t f(distanceResults_.size());
+  matrix_t dfdq(distanceResults_.size(), model.nq);
+  for (size_t i = 0; i < distanceResults_.size(); ++i) {
+    const auto& distanceResult = distanceResults_[i];
 
-  vector_t f(distanceArray.size());
-  matrix_t dfdq(distanceArray.size(), model.nq);
-  for (size_t i = 0; i < distanceArray.size(); ++i) {
     // Distance violation
-    f[i] = distanceArray[i].min_distance - minimumDistance_;
+    f[i] = distanceResult.min_distance - minimumDistance_;
 
     // Jacobian calculation
-    const auto& collisionPair = geometryModel.collisionPairs[i];
-    const auto& joint1 = geometryModel.geometryObjects[collisionPair.first].parentJoint;
-    const auto& joint2 = geometryModel.geometryObjects[collisionPair.second].parentJoint;
-
-    // We need to get the jacobian of the point on the first object; use the joint jacobian translated to the point
-    const vector3_t joint1Position = data.oMi[joint1].translation();
-    const vector3_t pt1Offset = distanceArray[i].nearest_points[0] - joint1Position;
-    matrix_t joint1Jacobian = matrix_t::Zero(6, model.nv);
-    pinocchio::getJointJacobian(model, data, joint1, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, joint1Jacobian);
-    // Jacobians from pinocchio are given as
-    // [ position jacobian ]
-    // [ rotation jacobian ]
-    const matrix_t pt1Jacobian = joint1Jacobian.topRows(3) - skewSymmetricMatrix(pt1Offset) * joint1Jacobian.bottomRows(3);
-
-    // We need to get the jacobian of the point on the second object; use the joint jacobian translated to the point
-    const vector3_t joint2Position = data.oMi[joint2].translation();
-    const vector3_t pt2Offset = distanceArray[i].nearest_points[1] - joint2Position;
-    matrix_t joint2Jacobian = matrix_t::Zero(6, model.nv);
-    pinocchio::getJointJacobian(model, data, joint2, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, joint2Jacobian);
-    const matrix_t pt2Jacobian = joint2Jacobian.topRows(3) - skewSymmetricMatrix(pt2Offset) * joint2Jacobian.bottomRows(3);
-
-    // To get the (approximate) jacobian of the distance, get the difference between the two nearest point jacobians, then multiply by the
-    // vector from point to point
-    const matrix_t differenceJacobian = pt2Jacobian - pt1Jacobian;
+    const size_t joint1JacobianIndex = pairToJointJacobianIndices_[i].first;
+    const size_t joint2JacobianIndex = pairToJointJacobianIndices_[i].second;
+    const auto& joint1Jacobian = jointJacobians_[joint1JacobianIndex];
+    const auto& joint2Jacobian = jointJacobians_[joint2JacobianIndex];
+
+    // The nearest points relative to the joints
+    const vector3_t pt1Offset = distanceResult.nearest_points[0] - data.oMi[jointIndices_[joint1JacobianIndex]].translation();
+    const vector3_t pt2Offset = distanceResult.nearest_points[1] - data.oMi[jointIndices_[joint2JacobianIndex]].translation();
+
     // TODO(perry): is there a way to calculate a correct jacobian for the case of distanceVector = 0?
-    const vector3_t distanceVector = distanceArray[i].min_distance > 0
-                                         ? (distanceArray[i].nearest_points[1] - distanceArray[i].nearest_points[0]).normalized()
-                                         : (distanceArray[i].nearest_points[0] - distanceArray[i].nearest_points[1]).normalized();
-    dfdq.row(i).noalias() = distanceVector.transpose() * differenceJacobian;
+    const vector3_t distanceVector = distanceResult.min_distance > 0
+                                         ? (distanceResult.nearest_points[1] - distanceResult.nearest_points[0]).normalized()
+                                         : (distanceResult.nearest_points[0] - distanceResult.nearest_points[1]).normalized();
+
+    // To get the (approximate) jacobian of the distance, project the difference between the two nearest point jacobians on the vector
+    // from point to point. The jacobian of a point is the joint jacobian translated to the point, J_pt = J_pos - [offset]_x * J_rot,
+    // and n^T * [offset]_x = (n x offset)^T.
+    auto dfdqRow = dfdq.row(i);
+    dfdqRow.noalias() = distanceVector.transpose() * joint2Jacobian.topRows<3>();
+    dfdqRow.noalias() -= distanceVector.transpose() * joint1Jacobian.topRows<3>();
+    dfdqRow.noalias() -= distanceVector.cross(pt2Offset).transpose() * joint2Jacobian.bottomRows<3>();
+    dfdqRow.noalias() += distanceVector.cross(pt1Offset).transpose() * joint1Jacobian.bottomRows<3>();
   }  // end of i loop
 
   return {f, dfdq};
@@ -53,8 +53,6 @@ class LeggedRobotPreComputation : public PreComputation {
 
   LeggedRobotPreComputation* clone() const override;
 
-  void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
-
   const std::vector<EndEffectorLinearConstraint::Config>& getEeNormalVelocityConstraintConfigs() const { return eeNormalVelConConfigs_; }
 
   PinocchioInterface& getPinocchioInterface() { return pinocchioInterface_; }
@@ -63,6 +61,8 @@ class LeggedRobotPreComputation : public PreComputation {
  private:
   LeggedRobotPreComputation(const LeggedRobotPreComputation& other) = default;
 
+  void requestImpl(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
+
   PinocchioInterface pinocchioInterface_;
   CentroidalModelInfo info_;
   const SwingTrajectoryPlanner* swingTrajectoryPlannerPtr_;
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_centroidal_model/AccessHelperFunctions.h>
 #include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
 #include <ocs2_centroidal_model/ModelHelperFunctions.h>
+#include <ocs2_core/automatic_differentiation/CppAdBuildQueue.h>
 #include <ocs2_core/misc/Display.h>
 #include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 #include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
@@ -133,6 +134,9 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   // Optimal control problem
   problemPtr_.reset(new OptimalControlProblem);
 
+  // The CppAD libraries of all components are compiled in parallel when the queue is flushed
+  CppAdBuildQueue cppAdBuildQueue;
+
   // Dynamics
   bool useAnalyticalGradientsDynamics = false;
   loadData::loadCppDataType(taskFile, "legged_robot_interface.useAnalyticalGradientsDynamics", useAnalyticalGradientsDynamics);
@@ -200,6 +204,8 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   // Initialization
   constexpr bool extendNormalizedMomentum = true;
   initializerPtr_.reset(new LeggedRobotInitializer(centroidalModelInfo_, *referenceManagerPtr_, extendNormalizedMomentum));
+
+  cppAdBuildQueue.flush();
 }
 
 /******************************************************************************************************/
@@ -62,7 +62,7 @@ LeggedRobotPreComputation* LeggedRobotPreComputation::clone() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void LeggedRobotPreComputation::request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
+void LeggedRobotPreComputation::requestImpl(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
   if (!request.containsAny(Request::Cost + Request::Constraint + Request::SoftConstraint)) {
     return;
   }
@@ -0,0 +1,137 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>  // forward declarations must be included first.
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include <ocs2_centroidal_model/AccessHelperFunctions.h>
+#include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
+#include <ocs2_centroidal_model/ModelHelperFunctions.h>
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+/**
+ * Compares the by-value evaluation of the CppAdInterface against the evaluation into preallocated outputs on the generated centroidal
+ * flow map of the legged robot.
+ */
+class TestCppAdInterfaceBenchmark : public ::testing::Test {
+ public:
+  static constexpr size_t numEvaluations = 1000;
+
+  TestCppAdInterfaceBenchmark()
+      : pinocchioInterfacePtr(createAnymalPinocchioInterface()),
+        centroidalModelInfo(createAnymalCentroidalModelInfo(*pinocchioInterfacePtr, CentroidalModelType::SingleRigidBodyDynamics)) {
+    const auto& pinocchioInterface = *pinocchioInterfacePtr;
+    const auto& info = centroidalModelInfo;
+    auto systemFlowMapFunc = [&](const ad_vector_t& x, ad_vector_t& y) {
+      auto pinocchioInterfaceCppAd = pinocchioInterface.toCppAd();
+      const auto infoCppAd = info.toCppAd();
+      CentroidalModelPinocchioMappingCppAd mappingCppAd(infoCppAd);
+      mappingCppAd.setPinocchioInterface(pinocchioInterfaceCppAd);
+
+      const ad_vector_t state = x.head(info.stateDim);
+      const ad_vector_t input = x.tail(info.inputDim);
+      const ad_vector_t qPinocchio = mappingCppAd.getPinocchioJointPosition(state);
+      updateCentroidalDynamics(pinocchioInterfaceCppAd, infoCppAd, qPinocchio);
+
+      y.resize(info.stateDim);
+      centroidal_model::getNormalizedMomentum(y, infoCppAd) =
+          getNormalizedCentroidalMomentumRate(pinocchioInterfaceCppAd, infoCppAd, input);
+      centroidal_model::getGeneralizedCoordinates(y, infoCppAd) = mappingCppAd.getPinocchioJointVelocity(state, input);
+    };
+
+    cppAdInterfacePtr.reset(
+        new CppAdInterface(systemFlowMapFunc, info.stateDim + info.inputDim, "testCppAdInterfaceBenchmark_legged_robot_systemFlowMap"));
+    cppAdInterfacePtr->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, false);
+  }
+
+  std::unique_ptr<PinocchioInterface> pinocchioInterfacePtr;
+  CentroidalModelInfo centroidalModelInfo;
+  std::unique_ptr<CppAdInterface> cppAdInterfacePtr;
+};
+
+constexpr size_t TestCppAdInterfaceBenchmark::numEvaluations;
+
+TEST_F(TestCppAdInterfaceBenchmark, jacobian) {
+  const vector_t p(0);
+  benchmark::RepeatedTimer byValueTimer;
+  benchmark::RepeatedTimer preallocatedTimer;
+
+  matrix_t jacobian;
+  for (size_t i = 0; i < numEvaluations; i++) {
+    const vector_t x = vector_t::Random(centroidalModelInfo.stateDim + centroidalModelInfo.inputDim);
+
+    byValueTimer.startTimer();
+    const matrix_t jacobianByValue = cppAdInterfacePtr->getJacobian(x, p);
+    byValueTimer.endTimer();
+
+    preallocatedTimer.startTimer();
+    cppAdInterfacePtr->getJacobian(x, p, jacobian);
+    preallocatedTimer.endTimer();
+
+    ASSERT_TRUE(jacobian.isApprox(jacobianByValue));
+  }
+
+  std::cerr << "[CppAdInterface] legged robot flow map jacobian\n"
+            << "\tby value     [ms]: " << byValueTimer.getAverageInMilliseconds() << "\n"
+            << "\tpreallocated [ms]: " << preallocatedTimer.getAverageInMilliseconds() << "\n";
+}
+
+TEST_F(TestCppAdInterfaceBenchmark, gaussNewtonApproximation) {
+  const vector_t p(0);
+  benchmark::RepeatedTimer byValueTimer;
+  benchmark::RepeatedTimer preallocatedTimer;
+
+  ScalarFunctionQuadraticApproximation gnApproximation;
+  for (size_t i = 0; i < numEvaluations; i++) {
+    const vector_t x = vector_t::Random(centroidalModelInfo.stateDim + centroidalModelInfo.inputDim);
+
+    byValueTimer.startTimer();
+    const auto gnApproximationByValue = cppAdInterfacePtr->getGaussNewtonApproximation(x, p);
+    byValueTimer.endTimer();
+
+    preallocatedTimer.startTimer();
+    cppAdInterfacePtr->getGaussNewtonApproximation(x, p, gnApproximation);
+    preallocatedTimer.endTimer();
+
+    ASSERT_DOUBLE_EQ(gnApproximation.f, gnApproximationByValue.f);
+    ASSERT_TRUE(gnApproximation.dfdxx.isApprox(gnApproximationByValue.dfdxx));
+  }
+
+  std::cerr << "[CppAdInterface] legged robot flow map Gauss-Newton approximation\n"
+            << "\tby value     [ms]: " << byValueTimer.getAverageInMilliseconds() << "\n"
+            << "\tpreallocated [ms]: " << preallocatedTimer.getAverageInMilliseconds() << "\n";
+}
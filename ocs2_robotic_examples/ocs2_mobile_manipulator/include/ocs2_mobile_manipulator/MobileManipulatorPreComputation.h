@@ -51,13 +51,13 @@ class MobileManipulatorPreComputation : public PreComputation {
   MobileManipulatorPreComputation(const MobileManipulatorPreComputation& rhs) = delete;
   MobileManipulatorPreComputation* clone() const override;
 
-  void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
-  void requestFinal(RequestSet request, scalar_t t, const vector_t& x) override;
-
   PinocchioInterface& getPinocchioInterface() { return pinocchioInterface_; }
   const PinocchioInterface& getPinocchioInterface() const { return pinocchioInterface_; }
 
  private:
+  void requestImpl(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
+  void requestFinalImpl(RequestSet request, scalar_t t, const vector_t& x) override;
+
   PinocchioInterface pinocchioInterface_;
   MobileManipulatorPinocchioMapping pinocchioMapping_;
 };
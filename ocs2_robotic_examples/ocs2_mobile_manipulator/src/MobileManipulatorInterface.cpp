@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <limits>
 #include <string>
 
 #include <pinocchio/fwd.hpp>  // forward declarations must be included first.
@@ -36,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mobile_manipulator/MobileManipulatorInterface.h"
 
+#include <ocs2_core/automatic_differentiation/CppAdBuildQueue.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_core/misc/LoadData.h>
 #include <ocs2_core/misc/LoadStdVectorOfPair.h>
@@ -159,6 +161,9 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
   /*
    * Optimal control problem
    */
+  // The CppAD libraries of all components are compiled in parallel when the queue is flushed
+  CppAdBuildQueue cppAdBuildQueue;
+
   // Cost
   problem_.costPtr->add("inputCost", getQuadraticInputCost(taskFile));
 
@@ -218,6 +223,8 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
 
   // Initialization
   initializerPtr_.reset(new DefaultInitializer(manipulatorModelInfo_.inputDim));
+
+  cppAdBuildQueue.flush();
 }
 
 /******************************************************************************************************/
@@ -304,6 +311,7 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
   scalar_t mu = 1e-2;
   scalar_t delta = 1e-3;
   scalar_t minimumDistance = 0.0;
+  scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity();
 
   boost::property_tree::ptree pt;
   boost::property_tree::read_info(taskFile, pt);
@@ -312,6 +320,7 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
   loadData::loadPtreeValue(pt, mu, prefix + ".mu", true);
   loadData::loadPtreeValue(pt, delta, prefix + ".delta", true);
   loadData::loadPtreeValue(pt, minimumDistance, prefix + ".minimumDistance", true);
+  loadData::loadPtreeValue(pt, activationDistance, prefix + ".activationDistance", true);
   loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionObjectPairs", collisionObjectPairs, true);
   loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionLinkPairs", collisionLinkPairs, true);
   std::cerr << " #### =============================================================================\n";
@@ -324,8 +333,13 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
   std::unique_ptr<StateConstraint> constraint;
   if (usePreComputation) {
     constraint = std::make_unique<MobileManipulatorSelfCollisionConstraint>(MobileManipulatorPinocchioMapping(manipulatorModelInfo_),
-                                                                            std::move(geometryInterface), minimumDistance);
+                                                                            std::move(geometryInterface), minimumDistance,
+                                                                            activationDistance);
   } else {
+    if (activationDistance < std::numeric_limits<scalar_t>::infinity()) {
+      std::cerr << "[MobileManipulatorInterface] WARNING: " << prefix << ".activationDistance is ignored by the auto-differentiated "
+                << "self-collision constraint, all collision pairs are evaluated." << std::endl;
+    }
     constraint = std::make_unique<SelfCollisionConstraintCppAd>(
         pinocchioInterface, MobileManipulatorPinocchioMapping(manipulatorModelInfo_), std::move(geometryInterface), minimumDistance,
         "self_collision", libraryFolder, recompileLibraries, false);
@@ -0,0 +1,179 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LoadData.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include "ocs2_mobile_manipulator/FactoryFunctions.h"
+#include "ocs2_mobile_manipulator/MobileManipulatorPinocchioMapping.h"
+#include "ocs2_mobile_manipulator/package_path.h"
+
+using namespace ocs2;
+using namespace mobile_manipulator;
+
+/**
+ * Compares the by-value evaluation of the CppAdInterface against the evaluation into preallocated outputs on the generated end-effector
+ * kinematics of the mobile manipulator.
+ */
+class TestCppAdInterfaceBenchmark : public ::testing::Test {
+ public:
+  static constexpr size_t numEvaluations = 1000;
+
+  TestCppAdInterfaceBenchmark() : pinocchioInterface(createMobileManipulatorPinocchioInterface()), modelInfo(loadManipulatorModelInfo()) {
+    const auto eeFrameId = pinocchioInterface.getModel().getBodyId(modelInfo.eeFrame);
+    auto positionFunc = [&, this](const ad_vector_t& x, ad_vector_t& y) {
+      auto pinocchioInterfaceCppAd = pinocchioInterface.toCppAd();
+      const auto& model = pinocchioInterfaceCppAd.getModel();
+      auto& data = pinocchioInterfaceCppAd.getData();
+      const MobileManipulatorPinocchioMappingCppAd mappingCppAd(modelInfo);
+
+      pinocchio::forwardKinematics(model, data, mappingCppAd.getPinocchioJointPosition(x));
+      pinocchio::updateFramePlacements(model, data);
+      y = data.oMf[eeFrameId].translation();
+    };
+
+    cppAdInterfacePtr.reset(
+        new CppAdInterface(positionFunc, modelInfo.stateDim, "testCppAdInterfaceBenchmark_mobile_manipulator_position"));
+    cppAdInterfacePtr->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::Second, false);
+  }
+
+  PinocchioInterface pinocchioInterface;
+  ManipulatorModelInfo modelInfo;
+  std::unique_ptr<CppAdInterface> cppAdInterfacePtr;
+
+ protected:
+  ManipulatorModelInfo loadManipulatorModelInfo() {
+    const std::string taskFile = ocs2::mobile_manipulator::getPath() + "/config/mabi_mobile/task.info";
+    boost::property_tree::ptree pt;
+    boost::property_tree::read_info(taskFile, pt);
+    ManipulatorModelType modelType = mobile_manipulator::loadManipulatorType(taskFile, "model_information.manipulatorModelType");
+    std::string baseFrame, eeFrame;
+    loadData::loadPtreeValue<std::string>(pt, baseFrame, "model_information.baseFrame", false);
+    loadData::loadPtreeValue<std::string>(pt, eeFrame, "model_information.eeFrame", false);
+    return mobile_manipulator::createManipulatorModelInfo(pinocchioInterface, modelType, baseFrame, eeFrame);
+  }
+
+  PinocchioInterface createMobileManipulatorPinocchioInterface() {
+    const std::string urdfPath = ocs2::robotic_assets::getPath() + "/resources/mobile_manipulator/mabi_mobile/urdf/mabi_mobile.urdf";
+    const std::string taskFile = ocs2::mobile_manipulator::getPath() + "/config/mabi_mobile/task.info";
+    ManipulatorModelType modelType = mobile_manipulator::loadManipulatorType(taskFile, "model_information.manipulatorModelType");
+    std::vector<std::string> removeJointNames;
+    loadData::loadStdVector<std::string>(taskFile, "model_information.removeJoints", removeJointNames, false);
+    return createPinocchioInterface(urdfPath, modelType, removeJointNames);
+  }
+};
+
+constexpr size_t TestCppAdInterfaceBenchmark::numEvaluations;
+
+TEST_F(TestCppAdInterfaceBenchmark, jacobian) {
+  const vector_t p(0);
+  benchmark::RepeatedTimer byValueTimer;
+  benchmark::RepeatedTimer preallocatedTimer;
+
+  matrix_t jacobian;
+  for (size_t i = 0; i < numEvaluations; i++) {
+    const vector_t x = vector_t::Random(modelInfo.stateDim);
+
+    byValueTimer.startTimer();
+    const matrix_t jacobianByValue = cppAdInterfacePtr->getJacobian(x, p);
+    byValueTimer.endTimer();
+
+    preallocatedTimer.startTimer();
+    cppAdInterfacePtr->getJacobian(x, p, jacobian);
+    preallocatedTimer.endTimer();
+
+    ASSERT_TRUE(jacobian.isApprox(jacobianByValue));
+  }
+
+  std::cerr << "[CppAdInterface] mobile manipulator end-effector position jacobian\n"
+            << "\tby value     [ms]: " << byValueTimer.getAverageInMilliseconds() << "\n"
+            << "\tpreallocated [ms]: " << preallocatedTimer.getAverageInMilliseconds() << "\n";
+}
+
+TEST_F(TestCppAdInterfaceBenchmark, hessian) {
+  const vector_t p(0);
+  benchmark::RepeatedTimer byValueTimer;
+  benchmark::RepeatedTimer preallocatedTimer;
+
+  matrix_t hessian;
+  for (size_t i = 0; i < numEvaluations; i++) {
+    const vector_t x = vector_t::Random(modelInfo.stateDim);
+    const vector_t w = vector_t::Random(3);
+
+    byValueTimer.startTimer();
+    const matrix_t hessianByValue = cppAdInterfacePtr->getHessian(w, x, p);
+    byValueTimer.endTimer();
+
+    preallocatedTimer.startTimer();
+    cppAdInterfacePtr->getHessian(w, x, p, hessian);
+    preallocatedTimer.endTimer();
+
+    ASSERT_TRUE(hessian.isApprox(hessianByValue));
+  }
+
+  std::cerr << "[CppAdInterface] mobile manipulator end-effector position hessian\n"
+            << "\tby value     [ms]: " << byValueTimer.getAverageInMilliseconds() << "\n"
+            << "\tpreallocated [ms]: " << preallocatedTimer.getAverageInMilliseconds() << "\n";
+}
+
+TEST_F(TestCppAdInterfaceBenchmark, gaussNewtonApproximation) {
+  const vector_t p(0);
+  benchmark::RepeatedTimer byValueTimer;
+  benchmark::RepeatedTimer preallocatedTimer;
+
+  ScalarFunctionQuadraticApproximation gnApproximation;
+  for (size_t i = 0; i < numEvaluations; i++) {
+    const vector_t x = vector_t::Random(modelInfo.stateDim);
+
+    byValueTimer.startTimer();
+    const auto gnApproximationByValue = cppAdInterfacePtr->getGaussNewtonApproximation(x, p);
+    byValueTimer.endTimer();
+
+    preallocatedTimer.startTimer();
+    cppAdInterfacePtr->getGaussNewtonApproximation(x, p, gnApproximation);
+    preallocatedTimer.endTimer();
+
+    ASSERT_DOUBLE_EQ(gnApproximation.f, gnApproximationByValue.f);
+    ASSERT_TRUE(gnApproximation.dfdxx.isApprox(gnApproximationByValue.dfdxx));
+  }
+
+  std::cerr << "[CppAdInterface] mobile manipulator end-effector position Gauss-Newton approximation\n"
+            << "\tby value     [ms]: " << byValueTimer.getAverageInMilliseconds() << "\n"
+            << "\tpreallocated [ms]: " << preallocatedTimer.getAverageInMilliseconds() << "\n";
+}
@@ -156,3 +156,27 @@ TEST_F(TestSelfCollision, testRandomJointPositions) {
     ASSERT_TRUE(Jd1.isApprox(Jd2));
   }
 }
+
+TEST_F(TestSelfCollision, BroadphaseLowerBound) {
+  SelfCollision selfCollision(geometryInterface, minDistance);
+  // with a negative activation distance, pairs are evaluated by their bounding spheres unless these overlap by more than 1m
+  SelfCollision selfCollisionBroadphase(geometryInterface, minDistance, -1.0);
+
+  for (int i = 0; i < 10; i++) {
+    vector_t q = vector_t::Random(9);
+    computeLinearApproximation(pinocchioInterface, q);
+
+    vector_t d1, d2;
+    matrix_t Jd1, Jd2;
+    std::tie(d1, Jd1) = selfCollision.getLinearApproximation(pinocchioInterface);
+    std::tie(d2, Jd2) = selfCollisionBroadphase.getLinearApproximation(pinocchioInterface);
+
+    ASSERT_EQ(d1.size(), d2.size());
+    ASSERT_EQ(Jd1.rows(), Jd2.rows());
+    ASSERT_EQ(Jd1.cols(), Jd2.cols());
+    for (int j = 0; j < d1.size(); j++) {
+      ASSERT_LE(d2[j], d1[j] + 1e-9) << "pair: " << j;
+    }
+    ASSERT_TRUE(d2.isApprox(selfCollisionBroadphase.getValue(pinocchioInterface)));
+  }
+}
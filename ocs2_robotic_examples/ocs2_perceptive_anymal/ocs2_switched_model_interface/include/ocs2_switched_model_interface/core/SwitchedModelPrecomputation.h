@@ -37,12 +37,6 @@ class SwitchedModelPreComputation : public ocs2::PreComputation {
 
   SwitchedModelPreComputation* clone() const override { return new SwitchedModelPreComputation(*this); }
 
-  void request(ocs2::RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
-
-  void requestPreJump(ocs2::RequestSet request, scalar_t t, const vector_t& x) override;
-
-  void requestFinal(ocs2::RequestSet request, scalar_t t, const vector_t& x) override;
-
   // Precomputation access : always available
   const SignedDistanceField* getSignedDistanceField() const { return swingTrajectoryPlannerPtr_->getSignedDistanceField(); }
   const contact_flag_t& getContactFlags() const { return contactFlags_; }
@@ -72,6 +66,12 @@ class SwitchedModelPreComputation : public ocs2::PreComputation {
   SwitchedModelPreComputation() = default;
   SwitchedModelPreComputation(const SwitchedModelPreComputation& other);
 
+  void requestImpl(ocs2::RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
+
+  void requestPreJumpImpl(ocs2::RequestSet request, scalar_t t, const vector_t& x) override;
+
+  void requestFinalImpl(ocs2::RequestSet request, scalar_t t, const vector_t& x) override;
+
  private:
   const FootPhase& getFootPhase(size_t leg) const { return *feetPhases_[leg]; }
   void updateFeetPhases(scalar_t t);
@@ -67,7 +67,7 @@ SwitchedModelPreComputation::SwitchedModelPreComputation(const SwitchedModelPreC
       tapedStateInput_(other.tapedStateInput_),
       robotMass_(other.robotMass_) {}
 
-void SwitchedModelPreComputation::request(ocs2::RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
+void SwitchedModelPreComputation::requestImpl(ocs2::RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
   updateFeetPhases(t);
 
   if (request.containsAny(ocs2::Request::Cost + ocs2::Request::Constraint + ocs2::Request::SoftConstraint)) {
@@ -82,7 +82,7 @@ void SwitchedModelPreComputation::request(ocs2::RequestSet request, scalar_t t,
   }
 }
 
-void SwitchedModelPreComputation::requestPreJump(ocs2::RequestSet request, scalar_t t, const vector_t& x) {
+void SwitchedModelPreComputation::requestPreJumpImpl(ocs2::RequestSet request, scalar_t t, const vector_t& x) {
   updateFeetPhases(t);
 
   if (request.containsAny(ocs2::Request::Cost + ocs2::Request::Constraint + ocs2::Request::SoftConstraint)) {
@@ -95,7 +95,7 @@ void SwitchedModelPreComputation::requestPreJump(ocs2::RequestSet request, scala
   }
 }
 
-void SwitchedModelPreComputation::requestFinal(ocs2::RequestSet request, scalar_t t, const vector_t& x) {
+void SwitchedModelPreComputation::requestFinalImpl(ocs2::RequestSet request, scalar_t t, const vector_t& x) {
   updateFeetPhases(t);
 
   if (request.containsAny(ocs2::Request::Cost + ocs2::Request::Constraint + ocs2::Request::SoftConstraint)) {
@@ -174,7 +174,7 @@ class MPC_ROS_Interface {
   std::mutex publisherMutex_;
   std::condition_variable msgReady_;
 
-  benchmark::RepeatedTimer mpcTimer_;
+  benchmark::RepeatedTimer mpcTimer_{"MPC_ROS_Interface::mpcObservationCallback"};
 
   // MPC reset
   std::mutex resetMutex_;
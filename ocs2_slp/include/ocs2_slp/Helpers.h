@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
+#include <ocs2_oc/oc_problem/PackedOcpData.h>
 
 namespace ocs2 {
 namespace slp {
@@ -65,6 +66,14 @@ namespace slp {
  */
 scalar_t hessianEigenvaluesUpperBound(const OcpSize& ocpSize, const std::vector<ScalarFunctionQuadraticApproximation>& cost);
 
+/**
+ * Same as the above, but computed on the packed stage-major layout without assembling the row-wise absolute sum of H.
+ *
+ * @param [in] ocpData: The packed dynamics and cost data.
+ * @return: The upper bound of eigenvalues for H.
+ */
+scalar_t hessianEigenvaluesUpperBound(const PackedOcpData<scalar_t>& ocpData);
+
 /**
  * Computes the upper bound of eigenvalues for the matrix G G' ( in parallel). The bound is computed based on the Gershgorin Circle Theorem.
  *
@@ -103,6 +112,16 @@ scalar_t GGTEigenvaluesUpperBound(ThreadPool& threadPool, const OcpSize& ocpSize
                                   const std::vector<VectorFunctionLinearApproximation>* constraintsPtr,
                                   const vector_array_t* scalingVectorsPtr);
 
+/**
+ * Same as the above, but computed in parallel on the packed stage-major layout without general constraints. The diagonals C_k of
+ * ocpData are used as the scaling vectors.
+ *
+ * @param [in] threadPool: The thread pool.
+ * @param [in] ocpData: The packed dynamics and cost data.
+ * @return: The upper bound of eigenvalues for G G'.
+ */
+scalar_t GGTEigenvaluesUpperBound(ThreadPool& threadPool, const PackedOcpData<scalar_t>& ocpData);
+
 /**
  * Computes the row-wise absolute sum of the cost hessian matrix, H. Also refer to "ocs2_oc/oc_problem/OcpToKkt.h".
  *
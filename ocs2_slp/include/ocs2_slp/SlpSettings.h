@@ -39,14 +39,17 @@ namespace slp {
 
 /** Multiple-shooting SLP (Successive Linear Programming) settings */
 struct Settings {
-  size_t slpIteration = 10;     // Maximum number of SLP iterations
-  size_t scalingIteration = 3;  // Number of pre-conditioning iterations
-  scalar_t deltaTol = 1e-6;     // Termination condition : RMS update of x(t) and u(t) are both below this value
-  scalar_t costTol = 1e-4;      // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
+  size_t slpIteration = 10;          // Maximum number of SLP iterations
+  size_t scalingIteration = 3;       // Number of pre-conditioning iterations
+  bool incrementalScaling = false;   // Start the pre-conditioning from the previous scaling and stop once scalingTolerance is reached
+  scalar_t scalingTolerance = 1e-2;  // Termination condition of the incremental pre-conditioning: max deviation of inf-norms from 1
+  scalar_t deltaTol = 1e-6;          // Termination condition : RMS update of x(t) and u(t) are both below this value
+  scalar_t costTol = 1e-4;           // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
   // Linesearch - step size rules
-  scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
-  scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  scalar_t alpha_decay = 0.5;       // multiply the step size by this factor every time a linesearch step is rejected.
+  scalar_t alpha_min = 1e-4;        // terminate linesearch if the attempted step size is below this threshold
+  size_t linesearchCandidates = 1;  // number of consecutive step sizes {alpha, alpha * alpha_decay, ...} evaluated concurrently
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -57,6 +60,11 @@ struct Settings {
   // Discretization method
   scalar_t dt = 0.01;  // user-defined time discretization
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
+  bool extrapolateTail = false;  // Warm start the tail after the previous solution by holding its last input instead of the initializer
+
+  // Pre-computation
+  bool shareDynamicsPreComputation = false;  // Let the dynamics use the pre-computation of the problem, such that each node is
+                                             // requested once for all terms. Requires dynamics that accept the problem's pre-computation.
 
   // Inequality penalty relaxed barrier parameters
   scalar_t inequalityConstraintMu = 0.0;
@@ -76,6 +84,7 @@ struct Settings {
 
   // LP subproblem solver settings
   pipg::Settings pipgSettings = pipg::Settings();
+  bool warmStartPipg = false;  // Start PIPG from the primal-dual solution of the previous LP, shifted in time for a new MPC call
 };
 
 /**
@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
@@ -69,6 +70,9 @@ class SlpSolver : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Total number of PIPG iterations over all solved LP subproblems. */
+  size_t getNumPipgIterations() const { return totalNumPipgIterations_; }
+
   const OptimalControlProblem& getOptimalControlProblem() const override { return ocpDefinitions_.front(); }
 
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
@@ -124,9 +128,21 @@ class SlpSolver : public SolverBase {
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                             const vector_array_t& u, std::vector<Metrics>& metrics);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, std::vector<Metrics>& metrics);
+  /** A trial point of the linesearch {t, x(t) + a*dx(t), u(t) + a*du(t)} with a = stepSize, and its performance metrics */
+  struct LinesearchCandidate {
+    scalar_t stepSize = 0.0;
+    vector_array_t x;
+    vector_array_t u;
+    std::vector<Metrics> metrics;
+    PerformanceIndex performance;
+  };
+
+  /**
+   * Computes only the performance metrics of the first numCandidates linesearch candidates. The nodes of all candidates are evaluated in
+   * a single parallel loop, such that the threads are split between candidates and nodes.
+   */
+  void computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, size_t numCandidates,
+                          std::vector<LinesearchCandidate>& candidates);
 
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
@@ -136,6 +152,9 @@ class SlpSolver : public SolverBase {
   };
   OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
 
+  /** Maps the warm start of PIPG and the pre-conditioning scaling from the time discretization of the previous problem to the given one. */
+  void shiftWarmStart(const std::vector<AnnotatedTime>& time);
+
   /** Constructs the primal solution based on the optimized state and input trajectories */
   PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u);
 
@@ -167,14 +186,29 @@ class SlpSolver : public SolverBase {
   // LQ approximation
   std::vector<ScalarFunctionQuadraticApproximation> cost_;
   std::vector<VectorFunctionLinearApproximation> dynamics_;
+  PackedOcpData<scalar_t> ocpData_;
   std::vector<VectorFunctionLinearApproximation> stateInputEqConstraints_;
   std::vector<VectorFunctionLinearApproximation> stateIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
 
+  // Per-worker memory of the transcription, swapped with the LQ approximation of each node
+  std::vector<multiple_shooting::TranscriptionWorkspace> workerTranscription_;
+
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
+  // Time discretization of the previous LP, and its unscaled PIPG solution remaining after the step used to warm start the next LP
+  scalar_array_t warmStartTime_;
+  vector_array_t warmStartDeltaX_;
+  vector_array_t warmStartDeltaU_;
+  vector_array_t warmStartLambda_;
+
+  // Pre-conditioning scaling factors of the last LP, the starting point of the next one when incrementalScaling is set
+  vector_array_t scalingD_;
+  vector_array_t scalingE_;
+  scalar_t scalingC_{1.0};
+
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
@@ -184,17 +218,18 @@ class SlpSolver : public SolverBase {
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
-  benchmark::RepeatedTimer initializationTimer_;
-  benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
-  benchmark::RepeatedTimer solveQpTimer_;
-  benchmark::RepeatedTimer linesearchTimer_;
-  benchmark::RepeatedTimer computeControllerTimer_;
+  size_t totalNumPipgIterations_{0};
+  benchmark::RepeatedTimer initializationTimer_{"SlpSolver::initialization"};
+  benchmark::RepeatedTimer linearQuadraticApproximationTimer_{"SlpSolver::linearQuadraticApproximation"};
+  benchmark::RepeatedTimer solveQpTimer_{"SlpSolver::solveQp"};
+  benchmark::RepeatedTimer linesearchTimer_{"SlpSolver::linesearch"};
+  benchmark::RepeatedTimer computeControllerTimer_{"SlpSolver::computeController"};
 
   // PIPG Solver
-  benchmark::RepeatedTimer lambdaEstimation_;
-  benchmark::RepeatedTimer sigmaEstimation_;
-  benchmark::RepeatedTimer preConditioning_;
-  benchmark::RepeatedTimer pipgSolverTimer_;
+  benchmark::RepeatedTimer lambdaEstimation_{"SlpSolver::lambdaEstimation"};
+  benchmark::RepeatedTimer sigmaEstimation_{"SlpSolver::sigmaEstimation"};
+  benchmark::RepeatedTimer preConditioning_{"SlpSolver::preConditioning"};
+  benchmark::RepeatedTimer pipgSolverTimer_{"SlpSolver::pipgSolver"};
 };
 
 }  // namespace ocs2
@@ -42,6 +42,10 @@ struct Settings {
   scalar_t relativeTolerance = 1e-2;
   /** Number of iterations between consecutive calculation of termination conditions. **/
   size_t checkTerminationInterval = 1;
+  /** Number of times a thread polls the iteration barrier before it parks. Set to 0 to always park the waiting threads. **/
+  size_t numBarrierSpins = 10000;
+  /** Whether to run the iterations in single precision. It halves the memory traffic, but limits the attainable tolerances to ~1e-6. **/
+  bool useSinglePrecision = false;
   /** The static lower bound of the cost hessian H. **/
   scalar_t lowerBoundH = 5e-6;
   /** This value determines to display the a summary log. */
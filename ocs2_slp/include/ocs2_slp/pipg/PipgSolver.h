@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
+#include <ocs2_oc/oc_problem/PackedOcpData.h>
 
 #include "ocs2_slp/pipg/PipgBounds.h"
 #include "ocs2_slp/pipg/PipgSettings.h"
@@ -58,7 +59,8 @@ class PipgSolver {
   explicit PipgSolver(pipg::Settings settings);
 
   /**
-   * Solve the optimal control in parallel.
+   * Solve the optimal control in parallel. The iterations run in single precision if pipg::Settings::useSinglePrecision is set, while
+   * the inputs and the outputs stay in double precision.
    *
    * @param [in] threadPool : The external thread pool.
    * @param [in] x0 : Initial state
@@ -79,6 +81,38 @@ class PipgSolver {
                            const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds, vector_array_t& xTrajectory,
                            vector_array_t& uTrajectory);
 
+  /**
+   * Solve the optimal control in parallel for a problem given in the packed stage-major layout. The diagonals C_k of ocpData are used
+   * as the scaling vectors. In double precision, the iterations read ocpData directly without any copy.
+   *
+   * @param [in] threadPool : The external thread pool.
+   * @param [in] x0 : Initial state
+   * @param [in] ocpData : The packed dynamics and cost data. Its size must match size().
+   * @param [in] EInv : Inverse of the scaling factor E. Used to calculate un-sacled termination criteria.
+   * @param [in] pipgBounds : The PipgBounds used to define the primal and dual stepsizes.
+   * @param [out] xTrajectory : The optimized state trajectory.
+   * @param [out] uTrajectory : The optimized input trajectory.
+   * @return The solver status.
+   */
+  pipg::SolverStatus solve(ThreadPool& threadPool, const vector_t& x0, const PackedOcpData<scalar_t>& ocpData, const vector_array_t* EInv,
+                           const pipg::PipgBounds& pipgBounds, vector_array_t& xTrajectory, vector_array_t& uTrajectory);
+
+  /**
+   * Sets the primal and dual variables the next call of solve() starts from, expressed in the (scaled) variables of that problem. The
+   * initial guess is used by one solve() only. Stages with missing or mismatching sizes are started from zero.
+   *
+   * @param [in] xTrajectory : The state trajectory of the length (N + 1). The first entry is not used.
+   * @param [in] uTrajectory : The input trajectory of the length N.
+   * @param [in] wTrajectory : The dual variables of the dynamics constraints of the length N.
+   */
+  void setWarmStart(vector_array_t xTrajectory, vector_array_t uTrajectory, vector_array_t wTrajectory);
+
+  /** The dual variables of the dynamics constraints found by the last solve(), in the (scaled) variables of that problem. */
+  const vector_array_t& getDualSolution() const { return dualSolution_; }
+
+  /** The number of iterations of the last solve(). */
+  size_t getNumIterations() const { return numIterations_; }
+
   void resize(const OcpSize& size);
 
   int getNumDecisionVariables() const { return numDecisionVariables_; }
@@ -88,6 +122,43 @@ class PipgSolver {
   const pipg::Settings& settings() const { return settings_; }
 
  private:
+  /** The QP data and the PIPG iterates in the precision of the PIPG iterations. */
+  template <typename Scalar>
+  struct Data {
+    using vector_type = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+    void resize(const OcpSize& ocpSize) {
+      const int N = ocpSize.numStages;
+      ocpData.resize(ocpSize);
+
+      X.resize(N + 1);
+      W.resize(N);
+      V.resize(N);
+      U.resize(N);
+      XNew.resize(N + 1);
+      UNew.resize(N);
+      WNew.resize(N);
+      primalResidual.resize(N);
+    }
+
+    // The QP data, filled by the PIPG workers when the problem is not given in the packed layout and precision.
+    PackedOcpData<Scalar> ocpData;
+
+    // Data buffer for parallelized PIPG
+    std::vector<vector_type> X, W, V, U;
+    std::vector<vector_type> XNew, UNew, WNew;
+    std::vector<vector_type> primalResidual;
+  };
+
+  /**
+   * Runs the PIPG iterations in the precision given by Scalar on ocpData. Before the first iteration, each worker calls prepareStage(k)
+   * for the stages k of ocpData it is responsible for, which allows to fill ocpData in parallel.
+   */
+  template <typename Scalar, typename PrepareStage>
+  pipg::SolverStatus solveInPrecision(ThreadPool& threadPool, const vector_t& x0, const PackedOcpData<Scalar>& ocpData,
+                                      PrepareStage prepareStage, const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds,
+                                      Data<Scalar>& data, vector_array_t& xTrajectory, vector_array_t& uTrajectory);
+
   void verifySizes(const std::vector<VectorFunctionLinearApproximation>& dynamics,
                    const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                    const std::vector<VectorFunctionLinearApproximation>* constraints) const;
@@ -102,9 +173,16 @@ class PipgSolver {
   int numDecisionVariables_;
   int numDynamicsConstraints_;
 
-  // Data buffer for parallelized PIPG
-  vector_array_t X_, W_, V_, U_;
-  vector_array_t XNew_, UNew_, WNew_;
+  Data<scalar_t> doublePrecisionData_;
+  Data<float> singlePrecisionData_;
+
+  // Warm start
+  bool hasWarmStart_ = false;
+  vector_array_t warmStartX_, warmStartU_, warmStartW_;
+
+  // Result of the last solve
+  vector_array_t dualSolution_;
+  size_t numIterations_ = 0;
 };
 
 }  // namespace ocs2
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_slp/Helpers.h"
 
+#include <algorithm>
 #include <atomic>
 #include <numeric>
 
@@ -63,6 +64,57 @@ scalar_t GGTEigenvaluesUpperBound(ThreadPool& threadPool, const OcpSize& ocpSize
   return rowwiseAbsSumGGT.maxCoeff();
 }
 
+scalar_t hessianEigenvaluesUpperBound(const PackedOcpData<scalar_t>& ocpData) {
+  auto maxAbsRowSum = [](const vector_t& absRowSum) { return absRowSum.size() > 0 ? absRowSum.maxCoeff() : 0.0; };
+
+  const int N = ocpData.numStages();
+  scalar_t res = maxAbsRowSum(ocpData.R(0).cwiseAbs().rowwise().sum());
+  for (int k = 1; k < N; k++) {
+    const auto Q = ocpData.Q(k);
+    const auto R = ocpData.R(k);
+    const auto P = ocpData.P(k);
+    res = std::max(res, maxAbsRowSum(Q.cwiseAbs().rowwise().sum() + P.transpose().cwiseAbs().rowwise().sum()));
+    res = std::max(res, maxAbsRowSum(P.cwiseAbs().rowwise().sum() + R.cwiseAbs().rowwise().sum()));
+  }
+  res = std::max(res, maxAbsRowSum(ocpData.Q(N).cwiseAbs().rowwise().sum()));
+  return res;
+}
+
+scalar_t GGTEigenvaluesUpperBound(ThreadPool& threadPool, const PackedOcpData<scalar_t>& ocpData) {
+  const int N = ocpData.numStages();
+  if (N < 1) {
+    throw std::runtime_error("[GGTEigenvaluesUpperBound] The number of stages cannot be less than 1.");
+  }
+  Eigen::setNbThreads(1);  // No multithreading within Eigen.
+
+  scalar_array_t maxAbsRowSumArray(threadPool.numThreads() + 1U, 0.0);
+  threadPool.parallelFor(0, N, 1, [&](int workerId, int k) {
+    const auto B = ocpData.B(k);
+    const auto C = ocpData.C(k);
+    matrix_t GGT = C.cwiseAbs2().asDiagonal();
+    GGT.noalias() += B * B.transpose();
+    if (k != 0) {
+      const auto A = ocpData.A(k);
+      GGT.noalias() += A * A.transpose();
+    }
+
+    vector_t absRowSum = GGT.cwiseAbs().rowwise().sum();
+    if (k != 0) {
+      absRowSum += (ocpData.A(k) * ocpData.C(k - 1).asDiagonal()).cwiseAbs().rowwise().sum();
+    }
+    if (k != N - 1) {
+      absRowSum += (ocpData.A(k + 1) * C.asDiagonal()).transpose().cwiseAbs().rowwise().sum();
+    }
+    if (absRowSum.size() > 0) {
+      maxAbsRowSumArray[workerId] = std::max(maxAbsRowSumArray[workerId], absRowSum.maxCoeff());
+    }
+  });
+
+  Eigen::setNbThreads(0);  // Restore default setup.
+
+  return *std::max_element(maxAbsRowSumArray.cbegin(), maxAbsRowSumArray.cend());
+}
+
 vector_t hessianAbsRowSum(const OcpSize& ocpSize, const std::vector<ScalarFunctionQuadraticApproximation>& cost) {
   const int N = ocpSize.numStages;
   const int nu_0 = ocpSize.numInputs[0];
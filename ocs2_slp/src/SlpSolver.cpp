@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_slp/SlpSolver.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
@@ -60,6 +61,13 @@ SlpSolver::SlpSolver(slp::Settings settings, const OptimalControlProblem& optima
   for (int w = 0; w < settings_.nThreads; w++) {
     ocpDefinitions_.push_back(optimalControlProblem);
   }
+  // Optionally, the dynamics of each worker share its pre-computation, such that each node is requested once for all terms
+  if (settings_.shareDynamicsPreComputation) {
+    for (auto& ocpDefinition : ocpDefinitions_) {
+      ocpDefinition.dynamicsPtr->setSharedPreComputation(ocpDefinition.preComputationPtr.get());
+    }
+  }
+  workerTranscription_.resize(settings_.nThreads);
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
@@ -81,15 +89,26 @@ void SlpSolver::reset() {
   // Clear solution
   primalSolution_ = PrimalSolution();
   performanceIndeces_.clear();
+  warmStartTime_.clear();
+  warmStartDeltaX_.clear();
+  warmStartDeltaU_.clear();
+  warmStartLambda_.clear();
+  scalingD_.clear();
+  scalingE_.clear();
+  scalingC_ = 1.0;
 
   // reset timers
   numProblems_ = 0;
   totalNumIterations_ = 0;
+  totalNumPipgIterations_ = 0;
   initializationTimer_.reset();
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
   linesearchTimer_.reset();
   computeControllerTimer_.reset();
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    ocpDefinition.preComputationPtr->resetCacheStatistics();
+  }
   lambdaEstimation_.reset();
   sigmaEstimation_.reset();
   preConditioning_.reset();
@@ -144,6 +163,13 @@ std::string SlpSolver::getBenchmarkingInformation() const {
                << linesearchTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tCompute Controller :\t" << std::setw(10) << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t("
                << computeControllerTotal / benchmarkTotal * inPercent << "%)\n";
+    size_t numRequests = 0;
+    size_t numReused = 0;
+    for (const auto& ocpDefinition : ocpDefinitions_) {
+      numRequests += ocpDefinition.preComputationPtr->getCacheStatistics().numRequests;
+      numReused += ocpDefinition.preComputationPtr->getCacheStatistics().numReused;
+    }
+    infoStream << "\tPre-computation    :\t" << numReused << " of " << numRequests << " requests reused\n";
   }
   return infoStream.str();
 }
@@ -171,6 +197,8 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   for (auto& ocpDefinition : ocpDefinitions_) {
     const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
     ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+    // The references might have changed, which invalidates the pre-computation at any node
+    ocpDefinition.preComputationPtr->invalidateCache();
   }
 
   // Trajectory spread of primalSolution_
@@ -180,7 +208,15 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Initialize the state and input
   vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  if (settings_.extrapolateTail) {
+    multiple_shooting::shiftStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, discretizer_,
+                                                   *ocpDefinitions_.front().dynamicsPtr, x, u);
+  } else {
+    multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  }
+  if (settings_.warmStartPipg || settings_.incrementalScaling) {
+    shiftWarmStart(timeDiscretization);
+  }
 
   // Bookkeeping
   performanceIndeces_.clear();
@@ -209,6 +245,16 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     performanceIndeces_.push_back(stepInfo.performanceAfterStep);
     linesearchTimer_.endTimer();
 
+    // The part of the LP solution which has not been applied by the step
+    if (settings_.warmStartPipg) {
+      for (auto& v : warmStartDeltaX_) {
+        v *= 1.0 - stepInfo.stepSize;
+      }
+      for (auto& v : warmStartDeltaU_) {
+        v *= 1.0 - stepInfo.stepSize;
+      }
+    }
+
     // Check convergence
     convergence = checkConvergence(iter, baselinePerformance, stepInfo);
 
@@ -245,13 +291,27 @@ SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta
   // without constraints, or when using projection, we have an unconstrained QP.
   pipgSolver_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
 
+  // pack the LQ approximation once into the stage-major layout shared by the pre-conditioning and PIPG
+  const int N = pipgSolver_.size().numStages;
+  ocpData_.resize(pipgSolver_.size());
+  threadPool_.parallelFor(0, N + 1, 1, [&](int, int k) {
+    if (k < N) {
+      ocpData_.setDynamics(k, dynamics_[k], nullptr);
+    }
+    ocpData_.setCost(k, cost_[k]);
+  });
+
   // pre-condition the OCP
   preConditioning_.startTimer();
-  scalar_t c;
-  vector_array_t D, E;
-  vector_array_t scalingVectors;
-  precondition::ocpDataInPlaceInParallel(threadPool_, delta_x0, pipgSolver_.size(), settings_.scalingIteration, dynamics_, cost_, D, E,
-                                         scalingVectors, c);
+  if (settings_.incrementalScaling) {
+    precondition::ocpDataIncrementallyInPlaceInParallel(threadPool_, delta_x0, settings_.scalingIteration, settings_.scalingTolerance,
+                                                        ocpData_, scalingD_, scalingE_, scalingC_);
+  } else {
+    precondition::ocpDataInPlaceInParallel(threadPool_, delta_x0, settings_.scalingIteration, ocpData_, scalingD_, scalingE_, scalingC_);
+  }
+  const auto& D = scalingD_;
+  const auto& E = scalingE_;
+  const auto c = scalingC_;
   preConditioning_.endTimer();
 
   // estimate mu and lambda: mu I < H < lambda I
@@ -265,34 +325,109 @@ SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta
     return c * pipgSolver_.settings().lowerBoundH * maxScalingFactor * maxScalingFactor;
   }();
   lambdaEstimation_.startTimer();
-  const auto lambdaScaled = slp::hessianEigenvaluesUpperBound(pipgSolver_.size(), cost_);
+  const auto lambdaScaled = slp::hessianEigenvaluesUpperBound(ocpData_);
   lambdaEstimation_.endTimer();
 
   // estimate sigma: G' G < sigma I
   // However, since the G'G and GG' have exactly the same set of eigenvalues value: G G' < sigma I
   sigmaEstimation_.startTimer();
-  const auto sigmaScaled = slp::GGTEigenvaluesUpperBound(threadPool_, pipgSolver_.size(), dynamics_, nullptr, &scalingVectors);
+  const auto sigmaScaled = slp::GGTEigenvaluesUpperBound(threadPool_, ocpData_);
   sigmaEstimation_.endTimer();
 
   pipgSolverTimer_.startTimer();
   vector_array_t EInv(E.size());
   std::transform(E.begin(), E.end(), EInv.begin(), [](const vector_t& v) { return v.cwiseInverse(); });
+  if (settings_.warmStartPipg && warmStartLambda_.size() == N) {
+    // scale the warm start to the pre-conditioned problem: y = inv(D) z and w = c inv(E) lambda
+    vector_array_t xGuess(N + 1), uGuess(N), wGuess(N);
+    for (int k = 0; k < N; k++) {
+      if (warmStartDeltaX_[k + 1].size() == D[2 * k + 1].size()) {
+        xGuess[k + 1] = warmStartDeltaX_[k + 1].cwiseQuotient(D[2 * k + 1]);
+      }
+      if (warmStartDeltaU_[k].size() == D[2 * k].size()) {
+        uGuess[k] = warmStartDeltaU_[k].cwiseQuotient(D[2 * k]);
+      }
+      if (warmStartLambda_[k].size() == E[k].size()) {
+        wGuess[k] = c * warmStartLambda_[k].cwiseProduct(EInv[k]);
+      }
+    }
+    pipgSolver_.setWarmStart(std::move(xGuess), std::move(uGuess), std::move(wGuess));
+  }
   const pipg::PipgBounds pipgBounds{muEstimated, lambdaScaled, sigmaScaled};
-  const auto pipgStatus =
-      pipgSolver_.solve(threadPool_, delta_x0, dynamics_, cost_, nullptr, scalingVectors, &EInv, pipgBounds, deltaXSol, deltaUSol);
+  const auto pipgStatus = pipgSolver_.solve(threadPool_, delta_x0, ocpData_, &EInv, pipgBounds, deltaXSol, deltaUSol);
+  totalNumPipgIterations_ += pipgSolver_.getNumIterations();
   pipgSolverTimer_.endTimer();
 
-  // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
-  solution.armijoDescentMetric = armijoDescentMetric(cost_, deltaXSol, deltaUSol);
-
   precondition::descaleSolution(D, deltaXSol, deltaUSol);
 
+  if (settings_.warmStartPipg) {
+    // keep the unscaled solution: z = D y and lambda = E w / c
+    const auto& dualSolution = pipgSolver_.getDualSolution();
+    warmStartLambda_.resize(N);
+    for (int k = 0; k < N; k++) {
+      warmStartLambda_[k] = E[k].cwiseProduct(dualSolution[k]) / c;
+    }
+    warmStartDeltaX_ = deltaXSol;
+    warmStartDeltaU_ = deltaUSol;
+  }
+
+  // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
+  // The metric is evaluated on the unscaled cost, and is multiplied by c to match the one of the pre-conditioned problem.
+  solution.armijoDescentMetric = c * armijoDescentMetric(cost_, deltaXSol, deltaUSol);
+
   // remap the tilde delta u to real delta u
   multiple_shooting::remapProjectedInput(constraintsProjection_, deltaXSol, deltaUSol);
 
   return solution;
 }
 
+void SlpSolver::shiftWarmStart(const std::vector<AnnotatedTime>& time) {
+  const int N = static_cast<int>(time.size()) - 1;
+  scalar_array_t newTime(time.size());
+  std::transform(time.begin(), time.end(), newTime.begin(), [](const AnnotatedTime& t) { return t.time; });
+
+  const int prevN = static_cast<int>(warmStartTime_.size()) - 1;
+  if (prevN >= 1 && newTime != warmStartTime_) {
+    // Holds the value of the last previous node at or before the time of each new node. A trajectory stores the values of the nodes
+    // starting from firstNode.
+    auto shift = [&](const vector_array_t& trajectory, int firstNode, int numNodes) {
+      vector_array_t shiftedTrajectory(numNodes);
+      for (int i = 0; i < numNodes; i++) {
+        const auto it = std::upper_bound(warmStartTime_.cbegin(), warmStartTime_.cend(), newTime[firstNode + i]);
+        const int node = static_cast<int>(std::distance(warmStartTime_.cbegin(), it)) - 1;
+        const int index = std::min(std::max(node - firstNode, 0), static_cast<int>(trajectory.size()) - 1);
+        shiftedTrajectory[i] = trajectory[index];
+      }
+      return shiftedTrajectory;
+    };
+
+    if (warmStartDeltaX_.size() == prevN + 1 && warmStartDeltaU_.size() == prevN && warmStartLambda_.size() == prevN) {
+      warmStartDeltaX_ = shift(warmStartDeltaX_, 0, N + 1);
+      warmStartDeltaU_ = shift(warmStartDeltaU_, 0, N);
+      warmStartLambda_ = shift(warmStartLambda_, 1, N);
+    }
+
+    // D interleaves the input scaling of node k and the state scaling of node k + 1. E is the scaling of the dynamics into node k + 1.
+    if (scalingD_.size() == 2 * prevN && scalingE_.size() == prevN) {
+      vector_array_t Du(prevN), Dx(prevN);
+      for (int k = 0; k < prevN; k++) {
+        Du[k].swap(scalingD_[2 * k]);
+        Dx[k].swap(scalingD_[2 * k + 1]);
+      }
+      Du = shift(Du, 0, N);
+      Dx = shift(Dx, 1, N);
+      scalingD_.resize(2 * N);
+      for (int k = 0; k < N; k++) {
+        scalingD_[2 * k].swap(Du[k]);
+        scalingD_[2 * k + 1].swap(Dx[k]);
+      }
+      scalingE_ = shift(scalingE_, 1, N);
+    }
+  }
+
+  warmStartTime_ = std::move(newTime);
+}
+
 PrimalSolution SlpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
   ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
   return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u));
@@ -318,18 +453,22 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
     PerformanceIndex workerPerformance;  // Accumulate performance in local variable
+    auto& workspace = workerTranscription_[workerId];
 
+    // The transcription is written into the worker's workspace, and swapped with the storage of the node. The performance is derived
+    // from the metrics in the same way as in computePerformance().
     int i = timeIndex++;
     while (i < N) {
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
+        auto& result = workspace.event;
+        multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1], result);
         metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
+        workerPerformance += toPerformanceIndex(metrics[i]);
+        std::swap(cost_[i], result.cost);
+        std::swap(dynamics_[i], result.dynamics);
         stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+        std::swap(stateIneqConstraints_[i], result.ineqConstraints);
         stateInputIneqConstraints_[i].resize(0, x[i].size());
         constraintsProjection_[i].resize(0, x[i].size());
         projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
@@ -337,17 +476,18 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        auto& result = workspace.intermediate;
+        multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i], result);
         metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
-        multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
+        workerPerformance += toPerformanceIndex(metrics[i], dt);
+        multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier, workspace.projection);
+        std::swap(cost_[i], result.cost);
+        std::swap(dynamics_[i], result.dynamics);
+        std::swap(stateInputEqConstraints_[i], result.stateInputEqConstraints);
+        std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+        std::swap(stateInputIneqConstraints_[i], result.stateInputIneqConstraints);
+        std::swap(constraintsProjection_[i], result.constraintsProjection);
+        std::swap(projectionMultiplierCoefficients_[i], result.projectionMultiplierCoefficients);
       }
 
       i = timeIndex++;
@@ -355,11 +495,12 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
+      auto& result = workspace.terminal;
+      multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N], result);
       metrics[i] = multiple_shooting::computeMetrics(result);
-      workerPerformance += multiple_shooting::computePerformanceIndex(result);
-      cost_[i] = std::move(result.cost);
-      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      workerPerformance += toPerformanceIndex(metrics[i]);
+      std::swap(cost_[i], result.cost);
+      std::swap(stateIneqConstraints_[i], result.ineqConstraints);
     }
 
     // Accumulate! Same worker might run multiple tasks
@@ -377,52 +518,70 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   return totalPerformance;
 }
 
-PerformanceIndex SlpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, std::vector<Metrics>& metrics) {
+void SlpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, size_t numCandidates,
+                                   std::vector<LinesearchCandidate>& candidates) {
   // Problem size
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
+  const int numNodes = N + 1;
+  const int numTasks = static_cast<int>(numCandidates) * numNodes;
+  for (size_t j = 0; j < numCandidates; ++j) {
+    candidates[j].metrics.resize(numNodes);
+  }
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
+  // Performance of candidate j accumulated by a worker is stored at [j * nThreads + workerId]
+  std::vector<PerformanceIndex> performance(numCandidates * settings_.nThreads, PerformanceIndex());
+  std::atomic_int taskIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    int k = taskIndex++;
+    while (k < numTasks) {
+      // Get candidate and node of the task
+      const int j = k / numNodes;
+      const int i = k % numNodes;
+      const auto& x = candidates[j].x;
+      const auto& u = candidates[j].u;
+      auto& metrics = candidates[j].metrics;
+      PerformanceIndex& workerPerformance = performance[j * settings_.nThreads + workerId];
+
+      if (i == N) {
+        // Terminal node
+        const scalar_t tN = getIntervalStart(time[N]);
+        metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
+        workerPerformance += toPerformanceIndex(metrics[N]);
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
+        workerPerformance += toPerformanceIndex(metrics[i]);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
         metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
+        workerPerformance += toPerformanceIndex(metrics[i], dt);
       }
 
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += toPerformanceIndex(metrics[N]);
+      k = taskIndex++;
     }
   };
   runParallel(std::move(parallelTask));
 
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  for (size_t j = 0; j < numCandidates; ++j) {
+    auto& candidate = candidates[j];
+    const auto workerBegin = performance.begin() + j * settings_.nThreads;
+    const auto workerEnd = workerBegin + settings_.nThreads;
 
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
-  return totalPerformance;
+    // Account for initial state in performance
+    const vector_t initDynamicsViolation = initState - candidate.x.front();
+    candidate.metrics.front().dynamicsViolation += initDynamicsViolation;
+    workerBegin->dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+
+    // Sum performance of the threads
+    candidate.performance = std::accumulate(std::next(workerBegin), workerEnd, *workerBegin);
+    candidate.performance.merit =
+        candidate.performance.cost + candidate.performance.equalityLagrangian + candidate.performance.inequalityLagrangian;
+  }
 }
 
 slp::StepInfo SlpSolver::takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
@@ -434,6 +593,9 @@ slp::StepInfo SlpSolver::takeStep(const PerformanceIndex& baseline, const std::v
    * Filter linesearch based on:
    * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
    * https://link.springer.com/article/10.1007/s10107-004-0559-y
+   *
+   * The step sizes of the backtracking sequence are evaluated concurrently in batches of settings_.linesearchCandidates, and the largest
+   * accepted step size of a batch is taken. This results in the same step as trying the step sizes one after the other.
    */
   if (settings_.printLinesearch) {
     std::cerr << std::setprecision(9) << std::fixed;
@@ -450,57 +612,70 @@ slp::StepInfo SlpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
   const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
 
+  const size_t maxNumCandidates = std::max(settings_.linesearchCandidates, size_t(1));
+  std::vector<LinesearchCandidate> candidates(maxNumCandidates);
+
   scalar_t alpha = 1.0;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  std::vector<Metrics> metricsNew(metrics.size());
+  bool tooSmallStep = false;
   do {
-    // Compute step
-    multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
-    multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
+    // Compute the steps of the next candidates of the backtracking sequence
+    size_t numCandidates = 0;
+    do {
+      auto& candidate = candidates[numCandidates++];
+      candidate.stepSize = alpha;
+      candidate.x.resize(x.size());
+      candidate.u.resize(u.size());
+      multiple_shooting::incrementTrajectory(u, du, alpha, candidate.u);
+      multiple_shooting::incrementTrajectory(x, dx, alpha, candidate.x);
+
+      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
+      alpha *= settings_.alpha_decay;
+      tooSmallStep = alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol;
+    } while (numCandidates < maxNumCandidates && !tooSmallStep && alpha >= settings_.alpha_min);
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew, metricsNew);
-
-    // Step acceptance and record step type
-    bool stepAccepted;
-    StepType stepType;
-    std::tie(stepAccepted, stepType) =
-        filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
-    }
+    computePerformance(timeDiscretization, initState, numCandidates, candidates);
+
+    for (size_t j = 0; j < numCandidates; ++j) {
+      auto& candidate = candidates[j];
+
+      // Step acceptance and record step type
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) =
+          filterLinesearch_.acceptStep(baseline, candidate.performance, candidate.stepSize * subproblemSolution.armijoDescentMetric);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << candidate.stepSize << ", Step Type: " << toString(stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << candidate.stepSize * deltaXnorm << "\t|du| = " << candidate.stepSize * deltaUnorm << "\n";
+        std::cerr << candidate.performance << "\n";
+      }
 
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      metrics = std::move(metricsNew);
-
-      // Prepare step info
-      slp::StepInfo stepInfo;
-      stepInfo.stepSize = alpha;
-      stepInfo.stepType = stepType;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
-      return stepInfo;
-
-    } else {  // Try smaller step
-      alpha *= settings_.alpha_decay;
+      if (stepAccepted) {  // Return the largest accepted step
+        x = std::move(candidate.x);
+        u = std::move(candidate.u);
+        metrics = std::move(candidate.metrics);
+
+        // Prepare step info
+        slp::StepInfo stepInfo;
+        stepInfo.stepSize = candidate.stepSize;
+        stepInfo.stepType = stepType;
+        stepInfo.dx_norm = candidate.stepSize * deltaXnorm;
+        stepInfo.du_norm = candidate.stepSize * deltaUnorm;
+        stepInfo.performanceAfterStep = candidate.performance;
+        stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(candidate.performance);
+        return stepInfo;
+      }
+    }
 
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
-        if (settings_.printLinesearch) {
-          std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
-                    << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
-        }
-        break;
+    // All candidates are rejected -> Try smaller steps
+    if (tooSmallStep) {
+      if (settings_.printLinesearch) {
+        std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
+                  << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
       }
+      break;
     }
   } while (alpha >= settings_.alpha_min);
 
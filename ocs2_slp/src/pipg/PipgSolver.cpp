@@ -29,13 +29,35 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_slp/pipg/PipgSolver.h"
 
-#include <condition_variable>
+#include <algorithm>
+#include <atomic>
 #include <iostream>
-#include <mutex>
+#include <memory>
 #include <numeric>
 
+#include <ocs2_core/thread_support/SpinBarrier.h>
+
 namespace ocs2 {
 
+namespace {
+/**
+ * The data owned by one worker of the PIPG iteration. alignas(64) rounds the size up to whole cache lines. Since std::allocator
+ * ignores extended alignments before C++17, the padding adds one more line such that neighbouring workers never share a line.
+ */
+struct alignas(64) PipgWorker {
+  // The worker updates the stages [firstStage, lastStage).
+  int firstStage = 0;
+  int lastStage = 0;
+  // Multi-thread performance analysis
+  int workload = 0;
+  // Termination criteria of the owned stages
+  scalar_t constraintsViolationInfNorm = 0.0;
+  scalar_t solutionSSE = 0.0;
+  scalar_t solutionSquaredNorm = 0.0;
+  char padding[64];
+};
+}  // anonymous namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -56,204 +78,333 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
   if (N < 1) {
     throw std::runtime_error("[PipgSolver::solve] The number of stages cannot be less than 1.");
   }
-  if (scalingVectors.size() != N) {
+  if (scalingVectors.size() != static_cast<size_t>(N)) {
     throw std::runtime_error("[PipgSolver::solve] The size of scalingVectors doesn't match the number of stage.");
   }
 
   // Disable Eigen's internal multithreading
   Eigen::setNbThreads(1);
 
-  vector_array_t primalResidualArray(N);
-  scalar_array_t constraintsViolationInfNormArray(N);
-  scalar_t constraintsViolationInfNorm;
+  pipg::SolverStatus status;
+  if (settings().useSinglePrecision) {
+    auto& ocpData = singlePrecisionData_.ocpData;
+    auto prepareStage = [&](int k) {
+      if (k < N) {
+        ocpData.setDynamics(k, dynamics[k], &scalingVectors[k]);
+      }
+      ocpData.setCost(k, cost[k]);
+    };
+    status = solveInPrecision(threadPool, x0, ocpData, prepareStage, EInv, pipgBounds, singlePrecisionData_, xTrajectory, uTrajectory);
+  } else {
+    auto& ocpData = doublePrecisionData_.ocpData;
+    auto prepareStage = [&](int k) {
+      if (k < N) {
+        ocpData.setDynamics(k, dynamics[k], &scalingVectors[k]);
+      }
+      ocpData.setCost(k, cost[k]);
+    };
+    status = solveInPrecision(threadPool, x0, ocpData, prepareStage, EInv, pipgBounds, doublePrecisionData_, xTrajectory, uTrajectory);
+  }
+
+  Eigen::setNbThreads(0);  // Restore default setup.
 
-  scalar_t solutionSSE, solutionSquaredNorm;
-  scalar_array_t solutionSEArray(N);
-  scalar_array_t solutionSquaredNormArray(N);
+  return status;
+};
 
-  // initial state
-  X_[0] = x0;
-  XNew_[0] = x0;
-  // cold start
-  for (int t = 0; t < N; t++) {
-    X_[t + 1].setZero(dynamics[t].dfdx.rows());
-    U_[t].setZero(dynamics[t].dfdu.cols());
-    W_[t].setZero(dynamics[t].dfdx.rows());
-    // WNew_ will NOT be filled, but will be swapped to W_ in iteration 0. Thus, initialize WNew_ here.
-    WNew_[t].setZero(dynamics[t].dfdx.rows());
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0, const PackedOcpData<scalar_t>& ocpData,
+                                     const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds, vector_array_t& xTrajectory,
+                                     vector_array_t& uTrajectory) {
+  if (!(ocpData.ocpSize() == ocpSize_)) {
+    throw std::runtime_error("[PipgSolver::solve] The size of ocpData doesn't match the size of the solver.");
+  }
+  const int N = ocpSize_.numStages;
+  if (N < 1) {
+    throw std::runtime_error("[PipgSolver::solve] The number of stages cannot be less than 1.");
+  }
+
+  // Disable Eigen's internal multithreading
+  Eigen::setNbThreads(1);
+
+  pipg::SolverStatus status;
+  if (settings().useSinglePrecision) {
+    auto prepareStage = [&](int k) { singlePrecisionData_.ocpData.setStage(k, ocpData); };
+    status = solveInPrecision(threadPool, x0, singlePrecisionData_.ocpData, prepareStage, EInv, pipgBounds, singlePrecisionData_,
+                              xTrajectory, uTrajectory);
+  } else {
+    auto prepareStage = [](int) {};
+    status = solveInPrecision(threadPool, x0, ocpData, prepareStage, EInv, pipgBounds, doublePrecisionData_, xTrajectory, uTrajectory);
   }
 
+  Eigen::setNbThreads(0);  // Restore default setup.
+
+  return status;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Scalar, typename PrepareStage>
+pipg::SolverStatus PipgSolver::solveInPrecision(ThreadPool& threadPool, const vector_t& x0, const PackedOcpData<Scalar>& ocpData,
+                                                PrepareStage prepareStage, const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds,
+                                                Data<Scalar>& data, vector_array_t& xTrajectory, vector_array_t& uTrajectory) {
+  using vector_type = typename Data<Scalar>::vector_type;
+  const int N = ocpSize_.numStages;
+
+  auto& X = data.X;
+  auto& U = data.U;
+  auto& W = data.W;
+  auto& V = data.V;
+  auto& XNew = data.XNew;
+  auto& UNew = data.UNew;
+  auto& WNew = data.WNew;
+
+  scalar_t constraintsViolationInfNorm = 0.0;
+  scalar_t solutionSSE = 0.0;
+  scalar_t solutionSquaredNorm = 0.0;
+
+  // initial state
+  X[0] = x0.cast<Scalar>();
+  XNew[0] = X[0];
+
+  // Static partition of the stages 1, ..., N into contiguous blocks, one per worker.
+  std::vector<PipgWorker> workers;
+  std::unique_ptr<SpinBarrier> iterationBarrier;
+  auto partitionStages = [&](int numWorkers) {
+    workers.assign(numWorkers, PipgWorker());
+    for (int w = 0; w < numWorkers; w++) {
+      workers[w].firstStage = 1 + w * N / numWorkers;
+      workers[w].lastStage = 1 + (w + 1) * N / numWorkers;
+    }
+    iterationBarrier = std::make_unique<SpinBarrier>(numWorkers, settings().numBarrierSpins);
+  };
+
   scalar_t alpha = pipgBounds.primalStepSize(0);
   scalar_t beta = pipgBounds.primalStepSize(0);
   scalar_t betaLast = 0;
 
   size_t k = 0;
-  std::atomic_int timeIndex{1}, finishedTaskCounter{0};
-  std::atomic_bool keepRunning{true}, shouldWait{true};
+  bool keepRunning = true;
   bool isConverged = false;
 
-  std::mutex mux;
-  std::condition_variable iterationFinished;
-  std::vector<int> threadsWorkloadCounter(threadPool.numThreads() + 1U, 0);
-
-  auto updateVariablesTask = [&](int workerId) {
-    int t;
-    int workerOrder;
+  // primalResidual = C * X[t] - A * X[t - 1] - B * U[t - 1] - b
+  auto computePrimalResidual = [&](int t, vector_type& primalResidual) {
+    primalResidual = -ocpData.b(t - 1);
+    primalResidual.array() += ocpData.C(t - 1).array() * X[t].array();
+    primalResidual.noalias() -= ocpData.A(t - 1) * X[t - 1];
+    primalResidual.noalias() -= ocpData.B(t - 1) * U[t - 1];
+  };
 
-    while (keepRunning) {
-      // Reset workerOrder in case all tasks have been assigned and some workers cannot enter the following while loop, keeping the
-      // workerOrder from previous iterations.
-      workerOrder = 0;
-      while ((t = timeIndex++) <= N) {
-        if (t == N) {
-          std::lock_guard<std::mutex> lk(mux);
-          shouldWait = true;
-        }
-        // Multi-thread performance analysis
-        ++threadsWorkloadCounter[workerId];
+  // Runs on the last worker arriving at the barrier, while all other workers wait.
+  auto finishIteration = [&]() {
+    betaLast = beta;
+    // Adaptive step size
+    beta = pipgBounds.dualStepSize(k);
+    alpha = pipgBounds.primalStepSize(k);
+
+    if (k != 0 && k % settings().checkTerminationInterval == 0) {
+      constraintsViolationInfNorm = 0.0;
+      solutionSSE = 0.0;
+      solutionSquaredNorm = 0.0;
+      for (const auto& worker : workers) {
+        constraintsViolationInfNorm = std::max(constraintsViolationInfNorm, worker.constraintsViolationInfNorm);
+        solutionSSE += worker.solutionSSE;
+        solutionSquaredNorm += worker.solutionSquaredNorm;
+      }
 
-        // PIPG algorithm
-        const auto& A = dynamics[t - 1].dfdx;
-        const auto& B = dynamics[t - 1].dfdu;
-        const auto& C = scalingVectors[t - 1];
-        const auto& b = dynamics[t - 1].f;
+      isConverged = constraintsViolationInfNorm <= settings().absoluteTolerance &&
+                    (solutionSSE <= settings().relativeTolerance * settings().relativeTolerance * solutionSquaredNorm ||
+                     solutionSSE <= settings().absoluteTolerance);
 
-        const auto& R = cost[t - 1].dfduu;
-        const auto& Q = cost[t].dfdxx;
-        const auto& P = cost[t - 1].dfdux;
-        const auto& q = cost[t].dfdx;
-        const auto& r = cost[t - 1].dfdu;
+      keepRunning = k < settings().maxNumIterations && !isConverged;
+    }
 
-        if (k != 0) {
-          // Update W of the iteration k - 1. Move the update of W to the front of the calculation of V to prevent data race.
-          // vector_t primalResidual = C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b;
-          primalResidualArray[t - 1] = -b;
-          primalResidualArray[t - 1].array() += C.array() * X_[t].array();
-          primalResidualArray[t - 1].noalias() -= A * X_[t - 1];
-          primalResidualArray[t - 1].noalias() -= B * U_[t - 1];
-          if (EInv != nullptr) {
-            constraintsViolationInfNormArray[t - 1] = (*EInv)[t - 1].cwiseProduct(primalResidualArray[t - 1]).lpNorm<Eigen::Infinity>();
-          } else {
-            constraintsViolationInfNormArray[t - 1] = primalResidualArray[t - 1].lpNorm<Eigen::Infinity>();
-          }
+    XNew.swap(X);
+    UNew.swap(U);
+    WNew.swap(W);
 
-          WNew_[t - 1] = W_[t - 1] + betaLast * primalResidualArray[t - 1];
+    ++k;
+  };
 
-          // What stored in UNew and XNew is the solution of iteration k - 2 and what stored in U and X is the solution of iteration k
-          // - 1. By convention, iteration starts from 0 and the solution of iteration -1 is the initial value. Reuse UNew and XNew
-          // memory to store the difference between the last solution and the one before last solution.
-          UNew_[t - 1] -= U_[t - 1];
-          XNew_[t] -= X_[t];
+  std::atomic_int workerCounter{0};
 
-          solutionSEArray[t - 1] = UNew_[t - 1].squaredNorm() + XNew_[t].squaredNorm();
-          solutionSquaredNormArray[t - 1] = U_[t - 1].squaredNorm() + X_[t].squaredNorm();
-        }
+  auto updateVariablesTask = [&](int) {
+    // The workerIndex of the thread pool is not contiguous, so the workers are handed out by a counter.
+    auto& worker = workers[workerCounter++];
 
-        // V_[t - 1] = W_[t - 1] + (beta + betaLast) * (C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b);
-        V_[t - 1] = W_[t - 1] - (beta + betaLast) * b;
-        V_[t - 1].array() += (beta + betaLast) * C.array() * X_[t].array();
-        V_[t - 1].noalias() -= (beta + betaLast) * (A * X_[t - 1]);
-        V_[t - 1].noalias() -= (beta + betaLast) * (B * U_[t - 1]);
+    // V of stage lastStage, which is owned by the next worker. Allocated by the thread which writes it.
+    vector_type VNext;
+    if (worker.lastStage <= N) {
+      VNext.setZero(ocpSize_.numStates[worker.lastStage]);
+    }
 
-        // UNew_[t - 1] = U_[t - 1] - alpha * (R * U_[t - 1] + P * X_[t - 1] + r - B.transpose() * V_[t - 1]);
-        UNew_[t - 1] = U_[t - 1] - alpha * r;
-        UNew_[t - 1].noalias() -= alpha * (R * U_[t - 1]);
-        UNew_[t - 1].noalias() -= alpha * (P * X_[t - 1]);
-        UNew_[t - 1].noalias() += alpha * (B.transpose() * V_[t - 1]);
+    // Prepare the QP data of the stages [firstStage - 1, lastStage - 1), and the final stage on the last worker.
+    for (int t = worker.firstStage; t < worker.lastStage; t++) {
+      prepareStage(t - 1);
+    }
+    if (worker.lastStage > N) {
+      prepareStage(N);
+    }
 
-        // XNew_[t] = X_[t] - alpha * (Q * X_[t] + q + C * V_[t - 1]);
-        XNew_[t] = X_[t] - alpha * q;
-        XNew_[t].array() -= alpha * C.array() * V_[t - 1].array();
-        XNew_[t].noalias() -= alpha * (Q * X_[t]);
+    // Start from the warm start if available and consistent, otherwise from zero.
+    auto initialize = [&](const vector_array_t& guess, int index, int size, vector_type& value) {
+      if (hasWarmStart_ && index < static_cast<int>(guess.size()) && guess[index].size() == size) {
+        value = guess[index].template cast<Scalar>();
+      } else {
+        value.setZero(size);
+      }
+    };
+    for (int t = worker.firstStage; t < worker.lastStage; t++) {
+      initialize(warmStartX_, t, ocpSize_.numStates[t], X[t]);
+      initialize(warmStartU_, t - 1, ocpSize_.numInputs[t - 1], U[t - 1]);
+      initialize(warmStartW_, t - 1, ocpSize_.numStates[t], W[t - 1]);
+      // WNew will NOT be filled, but will be swapped to W in iteration 0. Thus, initialize WNew here.
+      WNew[t - 1] = W[t - 1];
+      data.primalResidual[t - 1].setZero(ocpSize_.numStates[t]);
+    }
+    iterationBarrier->arriveAndWait();
 
-        if (t != N) {
-          const auto& ANext = dynamics[t].dfdx;
-          const auto& BNext = dynamics[t].dfdu;
-          const auto& CNext = scalingVectors[t];
-          const auto& bNext = dynamics[t].f;
+    while (keepRunning) {
+      const bool checkTermination = k != 0 && k % settings().checkTerminationInterval == 0;
+      if (checkTermination) {
+        worker.constraintsViolationInfNorm = 0.0;
+        worker.solutionSSE = 0.0;
+        worker.solutionSquaredNorm = 0.0;
+      }
 
-          // dfdux
-          const auto& PNext = cost[t].dfdux;
+      const auto alphaScalar = static_cast<Scalar>(alpha);
+      const auto betaLastScalar = static_cast<Scalar>(betaLast);
+      const auto betaSumScalar = static_cast<Scalar>(beta + betaLast);
 
-          // vector_t VNext = W_[t] + (beta + betaLast) * (CNext * X_[t + 1] - ANext * X_[t] - BNext * U_[t] - bNext);
-          vector_t VNext = W_[t] - (beta + betaLast) * bNext;
-          VNext.array() += (beta + betaLast) * CNext.array() * X_[t + 1].array();
-          VNext.noalias() -= (beta + betaLast) * (ANext * X_[t]);
-          VNext.noalias() -= (beta + betaLast) * (BNext * U_[t]);
+      // Update W of the iteration k - 1 and compute V of all owned stages first, such that the X update can read V of the
+      // following stage. V of the first stage of the next worker is computed redundantly.
+      for (int t = worker.firstStage; t < worker.lastStage; t++) {
+        auto& primalResidual = data.primalResidual[t - 1];
+        computePrimalResidual(t, primalResidual);
 
-          XNew_[t].noalias() += alpha * (ANext.transpose() * VNext);
-          // Add dfdxu * du if it is not the final state.
-          XNew_[t].noalias() -= alpha * (PNext.transpose() * U_[t]);
+        if (k != 0) {
+          WNew[t - 1] = W[t - 1] + betaLastScalar * primalResidual;
+
+          if (checkTermination) {
+            const scalar_t constraintsViolation =
+                (EInv != nullptr) ? (*EInv)[t - 1].cwiseProduct(primalResidual.template cast<scalar_t>()).template lpNorm<Eigen::Infinity>()
+                                  : static_cast<scalar_t>(primalResidual.template lpNorm<Eigen::Infinity>());
+            worker.constraintsViolationInfNorm = std::max(worker.constraintsViolationInfNorm, constraintsViolation);
+
+            // What stored in UNew and XNew is the solution of iteration k - 2 and what stored in U and X is the solution of iteration
+            // k - 1. By convention, iteration starts from 0 and the solution of iteration -1 is the initial value. Reuse UNew and XNew
+            // memory to store the difference between the last solution and the one before last solution.
+            UNew[t - 1] -= U[t - 1];
+            XNew[t] -= X[t];
+
+            worker.solutionSSE += static_cast<scalar_t>(UNew[t - 1].squaredNorm() + XNew[t].squaredNorm());
+            worker.solutionSquaredNorm += static_cast<scalar_t>(U[t - 1].squaredNorm() + X[t].squaredNorm());
+          }
         }
 
-        workerOrder = ++finishedTaskCounter;
+        // V[t - 1] = W[t - 1] + (beta + betaLast) * (C * X[t] - A * X[t - 1] - B * U[t - 1] - b);
+        V[t - 1] = W[t - 1] + betaSumScalar * primalResidual;
+      }
+      if (worker.lastStage <= N) {
+        computePrimalResidual(worker.lastStage, VNext);
+        VNext *= betaSumScalar;
+        VNext += W[worker.lastStage - 1];
       }
 
-      if (workerOrder != N) {
-        std::unique_lock<std::mutex> lk(mux);
-        iterationFinished.wait(lk, [&shouldWait] { return !shouldWait; });
-        lk.unlock();
-      } else {
-        betaLast = beta;
-        // Adaptive step size
-        beta = pipgBounds.dualStepSize(k);
-        alpha = pipgBounds.primalStepSize(k);
-
-        if (k != 0 && k % settings().checkTerminationInterval == 0) {
-          constraintsViolationInfNorm =
-              *(std::max_element(constraintsViolationInfNormArray.begin(), constraintsViolationInfNormArray.end()));
-
-          solutionSSE = std::accumulate(solutionSEArray.begin(), solutionSEArray.end(), 0.0);
-          solutionSquaredNorm = std::accumulate(solutionSquaredNormArray.begin(), solutionSquaredNormArray.end(), 0.0);
-
-          isConverged = constraintsViolationInfNorm <= settings().absoluteTolerance &&
-                        (solutionSSE <= settings().relativeTolerance * settings().relativeTolerance * solutionSquaredNorm ||
-                         solutionSSE <= settings().absoluteTolerance);
+      for (int t = worker.firstStage; t < worker.lastStage; t++) {
+        // Multi-thread performance analysis
+        ++worker.workload;
 
-          keepRunning = k < settings().maxNumIterations && !isConverged;
-        }
+        // PIPG algorithm
+        const auto B = ocpData.B(t - 1);
+        const auto C = ocpData.C(t - 1);
+
+        const auto R = ocpData.R(t - 1);
+        const auto Q = ocpData.Q(t);
+        const auto P = ocpData.P(t - 1);
+        const auto q = ocpData.q(t);
+        const auto r = ocpData.r(t - 1);
+
+        // UNew[t - 1] = U[t - 1] - alpha * (R * U[t - 1] + P * X[t - 1] + r - B.transpose() * V[t - 1]);
+        UNew[t - 1] = U[t - 1] - alphaScalar * r;
+        UNew[t - 1].noalias() -= alphaScalar * (R * U[t - 1]);
+        UNew[t - 1].noalias() -= alphaScalar * (P * X[t - 1]);
+        UNew[t - 1].noalias() += alphaScalar * (B.transpose() * V[t - 1]);
+
+        // XNew[t] = X[t] - alpha * (Q * X[t] + q + C * V[t - 1]);
+        XNew[t] = X[t] - alphaScalar * q;
+        XNew[t].array() -= alphaScalar * C.array() * V[t - 1].array();
+        XNew[t].noalias() -= alphaScalar * (Q * X[t]);
 
-        XNew_.swap(X_);
-        UNew_.swap(U_);
-        WNew_.swap(W_);
+        if (t != N) {
+          const auto ANext = ocpData.A(t);
+          const auto PNext = ocpData.P(t);
+          const auto& VNextStage = (t + 1 < worker.lastStage) ? V[t] : VNext;
 
-        ++k;
-        finishedTaskCounter = 0;
-        timeIndex = 1;
-        {
-          std::lock_guard<std::mutex> lk(mux);
-          shouldWait = false;
+          XNew[t].noalias() += alphaScalar * (ANext.transpose() * VNextStage);
+          // Add dfdxu * du if it is not the final state.
+          XNew[t].noalias() -= alphaScalar * (PNext.transpose() * U[t]);
         }
-        iterationFinished.notify_all();
       }
+
+      iterationBarrier->arriveAndWait(finishIteration);
     }
   };
-  threadPool.runParallel(std::move(updateVariablesTask), threadPool.numThreads() + 1U);
 
-  xTrajectory = X_;
-  uTrajectory = U_;
+  // The workers wait for each other at every iteration, therefore they have to run at the same time. If the pool can not provide
+  // the helpers (e.g. it is busy or this is a nested call), all stages are updated by the calling thread.
+  partitionStages(std::min(static_cast<int>(threadPool.numThreads()) + 1, N));
+  if (!threadPool.tryRunConcurrently(updateVariablesTask, static_cast<int>(workers.size()))) {
+    partitionStages(1);
+    updateVariablesTask(static_cast<int>(threadPool.numThreads()));
+  }
+
+  xTrajectory.resize(N + 1);
+  uTrajectory.resize(N);
+  for (int t = 0; t < N; t++) {
+    xTrajectory[t] = X[t].template cast<scalar_t>();
+    uTrajectory[t] = U[t].template cast<scalar_t>();
+  }
+  xTrajectory[N] = X[N].template cast<scalar_t>();
+  dualSolution_.resize(N);
+  for (int t = 0; t < N; t++) {
+    dualSolution_[t] = W[t].template cast<scalar_t>();
+  }
+  hasWarmStart_ = false;
+  numIterations_ = k;
   const auto status = isConverged ? pipg::SolverStatus::SUCCESS : pipg::SolverStatus::MAX_ITER;
 
   if (settings().displayShortSummary) {
-    scalar_t totalTasks = std::accumulate(threadsWorkloadCounter.cbegin(), threadsWorkloadCounter.cend(), 0.0);
+    const scalar_t totalTasks = std::accumulate(workers.cbegin(), workers.cend(), 0.0,
+                                                [](scalar_t sum, const PipgWorker& worker) { return sum + worker.workload; });
     std::cerr << "\n+++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n++++++++++++++ PIPG +++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++++++++++++++++++++++++++++++++++\n";
     std::cerr << "Solver status: " << pipg::toString(status) << "\n";
+    std::cerr << "Precision: " << (settings().useSinglePrecision ? "single" : "double") << "\n";
     std::cerr << "Number of Iterations: " << k << " out of " << settings().maxNumIterations << "\n";
     std::cerr << "Norm of delta primal solution: " << std::sqrt(solutionSSE) << "\n";
     std::cerr << "Constraints violation : " << constraintsViolationInfNorm << "\n";
     std::cerr << "Thread workload(ID: # of finished tasks): ";
-    for (int i = 0; i < threadsWorkloadCounter.size(); i++) {
-      std::cerr << i << ": " << threadsWorkloadCounter[i] << "(" << static_cast<scalar_t>(threadsWorkloadCounter[i]) / totalTasks * 100.0
-                << "%) ";
+    for (size_t i = 0; i < workers.size(); i++) {
+      std::cerr << i << ": " << workers[i].workload << "(" << static_cast<scalar_t>(workers[i].workload) / totalTasks * 100.0 << "%) ";
     }
   }
 
-  Eigen::setNbThreads(0);  // Restore default setup.
-
   return status;
-};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PipgSolver::setWarmStart(vector_array_t xTrajectory, vector_array_t uTrajectory, vector_array_t wTrajectory) {
+  warmStartX_ = std::move(xTrajectory);
+  warmStartU_ = std::move(uTrajectory);
+  warmStartW_ = std::move(wTrajectory);
+  hasWarmStart_ = true;
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -265,19 +416,17 @@ void PipgSolver::resize(const OcpSize& ocpSize) {
   verifyOcpSize(ocpSize);
 
   ocpSize_ = ocpSize;
-  const int N = ocpSize_.numStages;
 
   numDecisionVariables_ = std::accumulate(std::next(ocpSize_.numStates.begin()), ocpSize_.numStates.end(), 0);
   numDecisionVariables_ += std::accumulate(ocpSize_.numInputs.begin(), ocpSize_.numInputs.end(), 0);
   numDynamicsConstraints_ = std::accumulate(std::next(ocpSize_.numStates.begin()), ocpSize_.numStates.end(), 0);
 
-  X_.resize(N + 1);
-  W_.resize(N);
-  V_.resize(N);
-  U_.resize(N);
-  XNew_.resize(N + 1);
-  UNew_.resize(N);
-  WNew_.resize(N);
+  // The precision is fixed by the settings, only its buffers are allocated.
+  if (settings().useSinglePrecision) {
+    singlePrecisionData_.resize(ocpSize_);
+  } else {
+    doublePrecisionData_.resize(ocpSize_);
+  }
 }
 
 /******************************************************************************************************/
@@ -286,16 +435,16 @@ void PipgSolver::resize(const OcpSize& ocpSize) {
 void PipgSolver::verifySizes(const std::vector<VectorFunctionLinearApproximation>& dynamics,
                              const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                              const std::vector<VectorFunctionLinearApproximation>* constraints) const {
-  if (dynamics.size() != ocpSize_.numStages) {
+  if (dynamics.size() != static_cast<size_t>(ocpSize_.numStages)) {
     throw std::runtime_error("[PipgSolver::verifySizes] Inconsistent size of dynamics: " + std::to_string(dynamics.size()) + " with " +
                              std::to_string(ocpSize_.numStages) + " number of stages.");
   }
-  if (cost.size() != ocpSize_.numStages + 1) {
+  if (cost.size() != static_cast<size_t>(ocpSize_.numStages + 1)) {
     throw std::runtime_error("[PipgSolver::verifySizes] Inconsistent size of cost: " + std::to_string(cost.size()) + " with " +
                              std::to_string(ocpSize_.numStages + 1) + " nodes.");
   }
   if (constraints != nullptr) {
-    if (constraints->size() != ocpSize_.numStages + 1) {
+    if (constraints->size() != static_cast<size_t>(ocpSize_.numStages + 1)) {
       throw std::runtime_error("[PipgSolver::verifySizes] Inconsistent size of constraints: " + std::to_string(constraints->size()) +
                                " with " + std::to_string(ocpSize_.numStages + 1) + " nodes.");
     }
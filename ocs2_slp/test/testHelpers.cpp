@@ -90,4 +90,24 @@ TEST_F(HelperFunctionTest, GGTAbsRowSumInParallel) {
   ocs2::vector_t rowwiseSum = ocs2::slp::GGTAbsRowSumInParallel(threadPool_, ocpSize_, dynamicsArray, nullptr, &scalingVectors);
   ocs2::matrix_t GGT = constraintsApproximation.dfdx * constraintsApproximation.dfdx.transpose();
   EXPECT_TRUE(rowwiseSum.isApprox(GGT.cwiseAbs().rowwise().sum()));
-}
\ No newline at end of file
+}
+
+TEST_F(HelperFunctionTest, packedEigenvaluesUpperBound) {
+  ocs2::vector_array_t scalingVectors(N_);
+  for (auto& v : scalingVectors) {
+    v = ocs2::vector_t::Random(nx_);
+  }
+
+  ocs2::PackedOcpData<ocs2::scalar_t> ocpData(ocpSize_);
+  for (int k = 0; k < N_; k++) {
+    ocpData.setDynamics(k, dynamicsArray[k], &scalingVectors[k]);
+    ocpData.setCost(k, costArray[k]);
+  }
+  ocpData.setCost(N_, costArray[N_]);
+
+  const auto hessianBound = ocs2::slp::hessianEigenvaluesUpperBound(ocpSize_, costArray);
+  EXPECT_NEAR(ocs2::slp::hessianEigenvaluesUpperBound(ocpData), hessianBound, 1e-9 * hessianBound);
+
+  const auto GGTBound = ocs2::slp::GGTEigenvaluesUpperBound(threadPool_, ocpSize_, dynamicsArray, nullptr, &scalingVectors);
+  EXPECT_NEAR(ocs2::slp::GGTEigenvaluesUpperBound(threadPool_, ocpData), GGTBound, 1e-9 * GGTBound);
+}
@@ -0,0 +1,162 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/oc_problem/OcpSize.h>
+#include <ocs2_oc/oc_problem/PackedOcpData.h>
+#include <ocs2_oc/precondition/Ruzi.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+#include "ocs2_slp/Helpers.h"
+#include "ocs2_slp/pipg/PipgSolver.h"
+
+using namespace ocs2;
+
+/**
+ * Compares the pre-conditioning, the step size estimation, and the PIPG iterations on the dynamics and cost arrays against the same
+ * pipeline on the packed stage-major layout. The number of PIPG iterations is fixed, such that both pipelines do the same work.
+ */
+class TestPipgBenchmark : public ::testing::Test {
+ public:
+  static constexpr size_t numSolves = 10;
+  static constexpr size_t nThreads = 4;
+  static constexpr int nx = 24;
+  static constexpr int nu = 12;
+  static constexpr int scalingIteration = 3;
+
+  TestPipgBenchmark() : threadPool(nThreads - 1) { srand(0); }
+
+  static pipg::Settings getSettings() {
+    pipg::Settings settings;
+    settings.maxNumIterations = 200;
+    settings.absoluteTolerance = 0.0;
+    settings.relativeTolerance = 0.0;
+    settings.checkTerminationInterval = 10;
+    settings.displayShortSummary = false;
+    return settings;
+  }
+
+  void setProblem(int N) {
+    x0 = vector_t::Random(nx);
+    dynamics.clear();
+    cost.clear();
+    for (int k = 0; k < N; k++) {
+      auto stageDynamics = getRandomDynamics(nx, nu);
+      stageDynamics.dfdx = 0.5 * matrix_t::Identity(nx, nx) + 0.2 * stageDynamics.dfdx;
+      dynamics.push_back(std::move(stageDynamics));
+      cost.push_back(getRandomCost(nx, nu));
+    }
+    cost.push_back(getRandomCost(nx, 0));
+  }
+
+  static pipg::PipgBounds getPipgBounds(const vector_array_t& D, scalar_t c, scalar_t lambda, scalar_t sigma) {
+    scalar_t maxScalingFactor = -1;
+    for (const auto& v : D) {
+      if (v.size() != 0) {
+        maxScalingFactor = std::max(maxScalingFactor, v.maxCoeff());
+      }
+    }
+    return {c * 1e-3 * maxScalingFactor * maxScalingFactor, lambda, sigma};
+  }
+
+  ThreadPool threadPool;
+  vector_t x0;
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+};
+
+constexpr size_t TestPipgBenchmark::numSolves;
+constexpr size_t TestPipgBenchmark::nThreads;
+constexpr int TestPipgBenchmark::nx;
+constexpr int TestPipgBenchmark::nu;
+constexpr int TestPipgBenchmark::scalingIteration;
+
+TEST_F(TestPipgBenchmark, packedLayout) {
+  for (int N : {50, 100, 200}) {
+    setProblem(N);
+    const OcpSize ocpSize = extractSizesFromProblem(dynamics, cost, nullptr);
+
+    PipgSolver arraySolver(getSettings());
+    PipgSolver packedSolver(getSettings());
+    arraySolver.resize(ocpSize);
+    packedSolver.resize(ocpSize);
+    PackedOcpData<scalar_t> ocpData(ocpSize);
+    benchmark::RepeatedTimer arrayTimer;
+    benchmark::RepeatedTimer packedTimer;
+
+    vector_array_t xArray, uArray, xPacked, uPacked;
+    for (size_t i = 0; i < numSolves; i++) {
+      // The pre-conditioning scales the data in place.
+      auto dynamicsCopy = dynamics;
+      auto costCopy = cost;
+
+      arrayTimer.startTimer();
+      {
+        scalar_t c;
+        vector_array_t D, E, scalingVectors;
+        precondition::ocpDataInPlaceInParallel(threadPool, x0, ocpSize, scalingIteration, dynamicsCopy, costCopy, D, E, scalingVectors, c);
+        const auto lambda = slp::hessianEigenvaluesUpperBound(ocpSize, costCopy);
+        const auto sigma = slp::GGTEigenvaluesUpperBound(threadPool, ocpSize, dynamicsCopy, nullptr, &scalingVectors);
+        arraySolver.solve(threadPool, x0, dynamicsCopy, costCopy, nullptr, scalingVectors, nullptr, getPipgBounds(D, c, lambda, sigma),
+                          xArray, uArray);
+      }
+      arrayTimer.endTimer();
+
+      packedTimer.startTimer();
+      {
+        threadPool.parallelFor(0, N + 1, 1, [&](int, int k) {
+          if (k < N) {
+            ocpData.setDynamics(k, dynamics[k], nullptr);
+          }
+          ocpData.setCost(k, cost[k]);
+        });
+        scalar_t c;
+        vector_array_t D, E;
+        precondition::ocpDataInPlaceInParallel(threadPool, x0, scalingIteration, ocpData, D, E, c);
+        const auto lambda = slp::hessianEigenvaluesUpperBound(ocpData);
+        const auto sigma = slp::GGTEigenvaluesUpperBound(threadPool, ocpData);
+        packedSolver.solve(threadPool, x0, ocpData, nullptr, getPipgBounds(D, c, lambda, sigma), xPacked, uPacked);
+      }
+      packedTimer.endTimer();
+    }
+
+    for (int k = 0; k < N; k++) {
+      ASSERT_TRUE(uPacked[k].isApprox(uArray[k], 1e-9)) << "N: " << N << ", k: " << k;
+      ASSERT_TRUE(xPacked[k + 1].isApprox(xArray[k + 1], 1e-9)) << "N: " << N << ", k: " << k;
+    }
+
+    std::cerr << "[PipgBenchmark] N = " << N << ", nx = " << nx << ", nu = " << nu << ", nThreads = " << nThreads << "\n"
+              << "\tarrays           [ms]: " << arrayTimer.getAverageInMilliseconds() << "\n"
+              << "\tpacked layout    [ms]: " << packedTimer.getAverageInMilliseconds() << "\n";
+  }
+}
@@ -30,6 +30,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <gtest/gtest.h>
 #include <Eigen/Sparse>
 
+#include <chrono>
+
 #include <ocs2_oc/oc_problem/OcpToKkt.h>
 #include <ocs2_oc/test/testProblemsGeneration.h>
 #include <ocs2_qp_solver/QpSolver.h>
@@ -87,6 +89,15 @@ class PIPGSolverTest : public testing::Test {
   std::vector<ocs2::ScalarFunctionQuadraticApproximation> costArray;
   std::vector<ocs2::VectorFunctionLinearApproximation> constraintsArray;
 
+  ocs2::pipg::PipgBounds getPipgBounds() const {
+    Eigen::JacobiSVD<ocs2::matrix_t> svd(costApproximation.dfdxx);
+    const ocs2::scalar_t lambda = svd.singularValues()(0);
+    const ocs2::scalar_t mu = svd.singularValues()(svd.rank() - 1);
+    Eigen::JacobiSVD<ocs2::matrix_t> svdGTG(constraintsApproximation.dfdx.transpose() * constraintsApproximation.dfdx);
+    const ocs2::scalar_t sigma = svdGTG.singularValues()(0);
+    return {mu, lambda, sigma};
+  }
+
   ocs2::PipgSolver solver;
   ocs2::ThreadPool threadPool{numThreads_ - 1u, 50};
 };
@@ -183,4 +194,109 @@ TEST_F(PIPGSolverTest, correctness) {
   ASSERT_TRUE(std::abs(PIPGConstraintViolation) < solver.settings().absoluteTolerance);
   EXPECT_TRUE(std::abs(QPConstraintViolation - PIPGConstraintViolation) < solver.settings().absoluteTolerance * 10.0);
   EXPECT_TRUE(std::abs(PIPGParallelCConstraintViolation - PIPGConstraintViolation) < solver.settings().absoluteTolerance * 10.0);
-}
\ No newline at end of file
+}
+TEST_F(PIPGSolverTest, singlePrecision) {
+  const auto pipgBounds = getPipgBounds();
+  const ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
+
+  // Tolerances within the reach of single precision
+  auto settings = configurePipg(30000, 1e-5, 1e-4, verbose_);
+  ocs2::PipgSolver doublePrecisionSolver(settings);
+  settings.useSinglePrecision = true;
+  ocs2::PipgSolver singlePrecisionSolver(settings);
+
+  auto solve = [&](ocs2::PipgSolver& pipgSolver, ocs2::vector_t& primalSolution) {
+    pipgSolver.resize(solver.size());
+    ocs2::vector_array_t X, U;
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto status = pipgSolver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+    const auto solveTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    ocs2::toKktSolution(X, U, primalSolution);
+    EXPECT_EQ(status, ocs2::pipg::SolverStatus::SUCCESS);
+    return solveTime;
+  };
+
+  ocs2::vector_t doublePrecisionSolution, singlePrecisionSolution;
+  const auto doublePrecisionTime = solve(doublePrecisionSolver, doublePrecisionSolution);
+  const auto singlePrecisionTime = solve(singlePrecisionSolver, singlePrecisionSolution);
+
+  const ocs2::scalar_t constraintViolation =
+      (constraintsApproximation.dfdx * singlePrecisionSolution - constraintsApproximation.f).cwiseAbs().maxCoeff();
+
+  if (verbose_) {
+    std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+    std::cerr << "\n+++++++++++ [TestPIPG] Single precision ++++++++++++++";
+    std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+    std::cerr << "double-single:  " << (doublePrecisionSolution - singlePrecisionSolution).cwiseAbs().maxCoeff() << "\n";
+    std::cerr << "single constraint-violation:  " << constraintViolation << "\n";
+    std::cerr << "solve time [ms] double: " << doublePrecisionTime << "  single: " << singlePrecisionTime << "\n\n" << std::endl;
+  }
+
+  EXPECT_TRUE(singlePrecisionSolution.isApprox(doublePrecisionSolution, 1e-3))
+      << "Inf-norm of (double - single): " << (doublePrecisionSolution - singlePrecisionSolution).cwiseAbs().maxCoeff();
+  EXPECT_LT(constraintViolation, 1e-4);
+}
+
+TEST_F(PIPGSolverTest, warmStart) {
+  const auto pipgBounds = getPipgBounds();
+  const ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
+
+  ocs2::PipgSolver pipgSolver(configurePipg(30000, 1e-8, 1e-4, false));
+  pipgSolver.resize(solver.size());
+
+  // cold start
+  ocs2::vector_array_t X, U;
+  auto status = pipgSolver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+  ASSERT_EQ(status, ocs2::pipg::SolverStatus::SUCCESS);
+  const auto coldStartIterations = pipgSolver.getNumIterations();
+
+  // warm start from a perturbed solution
+  ocs2::vector_array_t XGuess = X, UGuess = U, WGuess = pipgSolver.getDualSolution();
+  for (auto& v : XGuess) {
+    v += 1e-3 * ocs2::vector_t::Random(v.size());
+  }
+  pipgSolver.setWarmStart(std::move(XGuess), std::move(UGuess), std::move(WGuess));
+  ocs2::vector_array_t XWarm, UWarm;
+  status = pipgSolver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, XWarm, UWarm);
+  ASSERT_EQ(status, ocs2::pipg::SolverStatus::SUCCESS);
+  const auto warmStartIterations = pipgSolver.getNumIterations();
+
+  if (verbose_) {
+    std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+    std::cerr << "\n+++++++++++++++ [TestPIPG] Warm start ++++++++++++++++";
+    std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
+    std::cerr << "iterations cold: " << coldStartIterations << "  warm: " << warmStartIterations << "\n\n" << std::endl;
+  }
+
+  ocs2::vector_t coldSolution, warmSolution;
+  ocs2::toKktSolution(X, U, coldSolution);
+  ocs2::toKktSolution(XWarm, UWarm, warmSolution);
+  EXPECT_TRUE(warmSolution.isApprox(coldSolution, 1e-5))
+      << "Inf-norm of (cold - warm): " << (coldSolution - warmSolution).cwiseAbs().maxCoeff();
+  EXPECT_LT(warmStartIterations, coldStartIterations);
+}
+
+TEST_F(PIPGSolverTest, nestedInThreadPool) {
+  const auto pipgBounds = getPipgBounds();
+  const ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
+
+  ocs2::vector_array_t X, U;
+  auto status = solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+  ASSERT_EQ(status, ocs2::pipg::SolverStatus::SUCCESS);
+
+  // A call from a worker of the pool can not gather the other workers, thus all stages are updated by that worker.
+  ocs2::vector_array_t XNested, UNested;
+  status = threadPool
+               .run([&](int) {
+                 return solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, XNested,
+                                     UNested);
+               })
+               .get();
+  ASSERT_EQ(status, ocs2::pipg::SolverStatus::SUCCESS);
+
+  ocs2::vector_t solution, nestedSolution;
+  ocs2::toKktSolution(X, U, solution);
+  ocs2::toKktSolution(XNested, UNested, nestedSolution);
+  EXPECT_TRUE(nestedSolution.isApprox(solution, solver.settings().absoluteTolerance * 10.0))
+      << "Inf-norm of (pool - nested): " << (solution - nestedSolution).cwiseAbs().maxCoeff();
+}
@@ -40,7 +40,8 @@ namespace {
 
 std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunctionLinearApproximation& dynamicsMatrices,
                                                                const ScalarFunctionQuadraticApproximation& costMatrices,
-                                                               const ocs2::scalar_t tol) {
+                                                               const ocs2::scalar_t tol, bool useSinglePrecision = false,
+                                                               bool incrementalScaling = false) {
   int n = dynamicsMatrices.dfdu.rows();
   int m = dynamicsMatrices.dfdu.cols();
 
@@ -72,6 +73,7 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunct
     settings.lowerBoundH = 1e-3;
     settings.checkTerminationInterval = 1;
     settings.displayShortSummary = true;
+    settings.useSinglePrecision = useSinglePrecision;
     return settings;
   };
 
@@ -80,6 +82,7 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunct
     settings.dt = 0.05;
     settings.slpIteration = 10;
     settings.scalingIteration = 3;
+    settings.incrementalScaling = incrementalScaling;
     settings.printSolverStatistics = true;
     settings.printSolverStatus = true;
     settings.printLinesearch = true;
@@ -102,6 +105,54 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunct
   return {solver.primalSolution(finalTime), solver.getIterationsLog()};
 }
 
+/** Runs a few MPC calls along the predicted state trajectory and returns the total number of PIPG iterations. */
+size_t runMpc(const VectorFunctionLinearApproximation& dynamicsMatrices, const ScalarFunctionQuadraticApproximation& costMatrices,
+              bool warmStartPipg, bool incrementalScaling = false) {
+  constexpr size_t numMpcCalls = 5;
+  constexpr scalar_t timeHorizon = 1.0;
+  const int n = dynamicsMatrices.dfdu.rows();
+  const int m = dynamicsMatrices.dfdu.cols();
+
+  OptimalControlProblem problem;
+  problem.dynamicsPtr = getOcs2Dynamics(dynamicsMatrices);
+  problem.costPtr->add("intermediateCost", getOcs2Cost(costMatrices));
+  problem.finalCostPtr->add("finalCost", getOcs2StateCost(costMatrices));
+
+  TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(n)}, {vector_t::Zero(m)});
+  std::shared_ptr<ReferenceManager> referenceManagerPtr(new ReferenceManager(targetTrajectories));
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  DefaultInitializer zeroInitializer(m);
+
+  slp::Settings settings;
+  settings.dt = 0.05;
+  settings.slpIteration = 3;
+  settings.scalingIteration = 3;
+  settings.nThreads = 2;
+  settings.warmStartPipg = warmStartPipg;
+  settings.incrementalScaling = incrementalScaling;
+  settings.scalingTolerance = 1e-2;
+  settings.pipgSettings.maxNumIterations = 30000;
+  settings.pipgSettings.absoluteTolerance = 1e-6;
+  settings.pipgSettings.relativeTolerance = 1e-3;
+  settings.pipgSettings.lowerBoundH = 1e-3;
+  settings.pipgSettings.checkTerminationInterval = 10;
+  settings.pipgSettings.displayShortSummary = false;
+
+  SlpSolver solver(settings, problem, zeroInitializer);
+  solver.setReferenceManager(referenceManagerPtr);
+
+  scalar_t initTime = 0.0;
+  vector_t initState = vector_t::Ones(n);
+  for (size_t i = 0; i < numMpcCalls; i++) {
+    solver.run(initTime, initState, initTime + timeHorizon);
+    const auto primalSolution = solver.primalSolution(initTime + timeHorizon);
+    initTime = primalSolution.timeTrajectory_[1];
+    initState = primalSolution.stateTrajectory_[1];
+  }
+  return solver.getNumPipgIterations();
+}
+
 }  // namespace
 }  // namespace ocs2
 
@@ -121,3 +172,61 @@ TEST(testSlpSolver, test_unconstrained) {
   ASSERT_LE(result.second.size(), 2);
   ASSERT_LT(result.second.back().dynamicsViolationSSE, tol);
 }
+
+TEST(testSlpSolver, test_unconstrained_single_precision) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-5;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto result = ocs2::solve(dynamics, costs, tol, true);
+
+  ASSERT_LE(result.second.size(), 2);
+  ASSERT_LT(result.second.back().dynamicsViolationSSE, tol);
+}
+
+TEST(testSlpSolver, test_warm_start_double_integrator) {
+  ocs2::VectorFunctionLinearApproximation dynamics;
+  dynamics.dfdx = (ocs2::matrix_t(2, 2) << 0.0, 1.0, 0.0, 0.0).finished();
+  dynamics.dfdu = (ocs2::matrix_t(2, 1) << 0.0, 1.0).finished();
+  ocs2::ScalarFunctionQuadraticApproximation costs;
+  costs.dfdxx = ocs2::matrix_t::Identity(2, 2);
+  costs.dfduu = 0.1 * ocs2::matrix_t::Identity(1, 1);
+  costs.dfdux = ocs2::matrix_t::Zero(1, 2);
+
+  const auto coldStartIterations = ocs2::runMpc(dynamics, costs, false);
+  const auto warmStartIterations = ocs2::runMpc(dynamics, costs, true);
+  std::cerr << "[DoubleIntegrator] PIPG iterations cold start: " << coldStartIterations << ", warm start: " << warmStartIterations << "\n";
+  EXPECT_LT(warmStartIterations, coldStartIterations);
+}
+
+TEST(testSlpSolver, test_warm_start_random_system) {
+  int n = 3;
+  int m = 2;
+  srand(0);
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  auto costs = ocs2::getRandomCost(n, m);
+
+  const auto coldStartIterations = ocs2::runMpc(dynamics, costs, false);
+  const auto warmStartIterations = ocs2::runMpc(dynamics, costs, true);
+  std::cerr << "[RandomSystem] PIPG iterations cold start: " << coldStartIterations << ", warm start: " << warmStartIterations << "\n";
+  EXPECT_LT(warmStartIterations, coldStartIterations);
+}
+
+TEST(testSlpSolver, test_incremental_scaling) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto result = ocs2::solve(dynamics, costs, tol, false, true);
+
+  ASSERT_LE(result.second.size(), 2);
+  ASSERT_LT(result.second.back().dynamicsViolationSSE, tol);
+
+  // The scaling is shifted along with the horizon over the MPC calls.
+  srand(0);
+  const auto randomDynamics = ocs2::getRandomDynamics(n, m);
+  const auto randomCosts = ocs2::getRandomCost(n, m);
+  EXPECT_GT(ocs2::runMpc(randomDynamics, randomCosts, true, true), 0);
+}
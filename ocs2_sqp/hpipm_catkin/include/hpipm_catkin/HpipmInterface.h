@@ -59,8 +59,8 @@ class HpipmInterface {
   /** Destructor */
   ~HpipmInterface();
 
-  /** Resize the problem */
-  void resize(OcpSize ocpSize);
+  /** Resize the problem. Does not allocate memory if the size did not change. */
+  void resize(const OcpSize& ocpSize);
 
   /**
    * Solves a discrete linear quadratic optimal control problem. The interface needs to be resized to a consistent OcpSize before calling
@@ -86,6 +86,34 @@ class HpipmInterface {
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
 
+  /**
+   * Writes the data of a single stage directly into the HPIPM QP memory. Stages are independent, such that this function can be
+   * called in parallel for different k. The interface needs to be resized to a consistent OcpSize before calling this function.
+   * After all stages are set, the QP is solved with solve(x0, stateTrajectory, inputTrajectory, verbose).
+   *
+   * @param k : Stage index in [0, N].
+   * @param x0 : Initial state (deviation), absorbed into the data of stage 0.
+   * @param dynamics : Linearized approximation of the discrete dynamics of stage k, nullptr for k = N.
+   * @param cost : Quadratic approximation of the cost of stage k.
+   * @param constraints : Linearized approximation of the constraints of stage k, or nullptr if the problem is unconstrained.
+   */
+  void setStage(int k, const vector_t& x0, const VectorFunctionLinearApproximation* dynamics,
+                const ScalarFunctionQuadraticApproximation& cost, const VectorFunctionLinearApproximation* constraints);
+
+  /**
+   * Solves the QP whose data has been written with setStage() for all stages.
+   *
+   * @param x0 : Initial state (deviation). Must be the same as passed to setStage().
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param verbose : Prints the HPIPM iteration statistics if true.
+   * @return HPIPM returned with flag hpipm_status.
+   */
+  hpipm_status solve(const vector_t& x0, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
+
+  /** Number of interior point iterations of the last solve. */
+  int getNumIterations() const;
+
   /**
    * Return the Riccati cost-to-go for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -100,6 +128,10 @@ class HpipmInterface {
   std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
                                                                        const ScalarFunctionQuadraticApproximation& cost0);
 
+  /** Writes the cost-to-go's of getRiccatiCostToGo() into the given array, reusing its memory. */
+  void getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                          std::vector<ScalarFunctionQuadraticApproximation>& costToGo);
+
   /**
    * Return the sequence of N feedback matrices for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -110,6 +142,10 @@ class HpipmInterface {
    */
   matrix_array_t getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0);
 
+  /** Writes the feedback matrices of getRiccatiFeedback() into the given array, reusing its memory. */
+  void getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                          matrix_array_t& feedback);
+
   /**
    * Return the sequence of N feedforward input vectors for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -121,6 +157,10 @@ class HpipmInterface {
   vector_array_t getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
                                        const ScalarFunctionQuadraticApproximation& cost0);
 
+  /** Writes the feedforward vectors of getRiccatiFeedforward() into the given array, reusing its memory. */
+  void getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                             vector_array_t& feedforward);
+
  private:
   class Impl;
   std::unique_ptr<Impl> pImpl_;
@@ -54,6 +54,9 @@ struct Settings {
   int warm_start = 0;
   int pred_corr = 1;
   int ric_alg = 0;  // square root ricatti recursion
+
+  // Interface options
+  bool directStageSetup = false;  // Write the stage data directly into the HPIPM QP memory (see HpipmInterface::setStage)
 };
 
 std::ostream& operator<<(std::ostream& stream, const Settings& settings);
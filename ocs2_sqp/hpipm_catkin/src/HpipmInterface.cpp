@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 
 extern "C" {
@@ -87,19 +89,29 @@ namespace ocs2 {
 
 class HpipmInterface::Impl {
  public:
-  Impl(OcpSize ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(std::move(ocpSize), true); }
-
-  void initializeMemory(OcpSize ocpSize, bool forceInitialization = false) {
-    // We will remove the initial state from the decision variables before passing the data to HPIPM.
-    // This removes the need for adding constraints to enforce x[0] = x_init
-    ocpSize.numStates[0] = 0;
+  Impl(const OcpSize& ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(ocpSize, true); }
 
+  void initializeMemory(const OcpSize& ocpSize, bool forceInitialization = false) {
     // Skip memory initialization if problem size didn't change.
-    if (!forceInitialization && ocpSize_ == ocpSize) {
+    if (!forceInitialization && requestedOcpSize_ == ocpSize) {
       return;
     }
 
-    ocpSize_ = std::move(ocpSize);
+    // We will remove the initial state from the decision variables before passing the data to HPIPM.
+    // This removes the need for adding constraints to enforce x[0] = x_init
+    requestedOcpSize_ = ocpSize;
+    ocpSize_ = ocpSize;
+    ocpSize_.numStates[0] = 0;
+
+    // Pointer arrays and bounds passed to HPIPM
+    const int N = ocpSize_.numStages;
+    for (auto* pointers : {&AA_, &BB_, &bb_}) {
+      pointers->resize(N);
+    }
+    for (auto* pointers : {&QQ_, &RR_, &SS_, &qq_, &rr_, &CC_, &DD_, &llg_, &uug_}) {
+      pointers->resize(N + 1);
+    }
+    boundData_.resize(N + 1);
 
     const int dim_size = d_ocp_qp_dim_memsize(ocpSize_.numStages);
     dimMem_.reserve(dim_size);
@@ -170,9 +182,7 @@ class HpipmInterface::Impl {
     verifySizes(x0, dynamics, cost, constraints);
 
     // === Dynamics ===
-    std::vector<scalar_t*> AA(N, nullptr);
-    std::vector<scalar_t*> BB(N, nullptr);
-    std::vector<scalar_t*> bb(N, nullptr);
+    std::fill(AA_.begin(), AA_.end(), nullptr);
 
     // k = 0. Absorb initial state into dynamics
     // The initial state is removed from the decision variables
@@ -181,85 +191,80 @@ class HpipmInterface::Impl {
     //         = B[0]*u[0] + (b[0] + A[0]*x[0])
     //         = B[0]*u[0] + \tilde{b}[0]
     // numState[0] = 0 --> No need to specify A[0] here
-    vector_t b0 = dynamics[0].f;
-    b0.noalias() += dynamics[0].dfdx * x0;
-    BB[0] = dynamics[0].dfdu.data();
-    bb[0] = b0.data();
+    b0_ = dynamics[0].f;
+    b0_.noalias() += dynamics[0].dfdx * x0;
+    BB_[0] = dynamics[0].dfdu.data();
+    bb_[0] = b0_.data();
 
     // k = 1 -> N-1
     for (int k = 1; k < N; k++) {
-      AA[k] = dynamics[k].dfdx.data();
-      BB[k] = dynamics[k].dfdu.data();
-      bb[k] = dynamics[k].f.data();
+      AA_[k] = dynamics[k].dfdx.data();
+      BB_[k] = dynamics[k].dfdu.data();
+      bb_[k] = dynamics[k].f.data();
     }
 
     // === Costs ===
-    std::vector<scalar_t*> QQ(N + 1, nullptr);
-    std::vector<scalar_t*> RR(N + 1, nullptr);
-    std::vector<scalar_t*> SS(N + 1, nullptr);
-    std::vector<scalar_t*> qq(N + 1, nullptr);
-    std::vector<scalar_t*> rr(N + 1, nullptr);
+    for (auto* pointers : {&QQ_, &RR_, &SS_, &qq_, &rr_}) {
+      std::fill(pointers->begin(), pointers->end(), nullptr);
+    }
 
     // k = 0. Elimination of initial state requires cost adaptation
     // numState[0] = 0 --> No need to specify Q[0], S[0], q[0] here
-    vector_t r0 = cost[0].dfdu;
-    r0 += cost[0].dfdux * x0;
-    RR[0] = cost[0].dfduu.data();
-    rr[0] = r0.data();
+    r0_ = cost[0].dfdu;
+    r0_.noalias() += cost[0].dfdux * x0;
+    RR_[0] = cost[0].dfduu.data();
+    rr_[0] = r0_.data();
 
     // k = 1 -> (N-1)
     for (int k = 1; k < N; k++) {
-      QQ[k] = cost[k].dfdxx.data();
-      RR[k] = cost[k].dfduu.data();
-      SS[k] = cost[k].dfdux.data();
-      qq[k] = cost[k].dfdx.data();
-      rr[k] = cost[k].dfdu.data();
+      QQ_[k] = cost[k].dfdxx.data();
+      RR_[k] = cost[k].dfduu.data();
+      SS_[k] = cost[k].dfdux.data();
+      qq_[k] = cost[k].dfdx.data();
+      rr_[k] = cost[k].dfdu.data();
     }
 
     // k = N, no inputs
-    QQ[N] = cost[N].dfdxx.data();
-    qq[N] = cost[N].dfdx.data();
+    QQ_[N] = cost[N].dfdxx.data();
+    qq_[N] = cost[N].dfdx.data();
 
     // === Constraints ===
     // for ocs2 --> C*dx + D*du + e = 0
     // for hpipm --> ug >= C*dx + D*du >= lg
-    std::vector<scalar_t*> CC(N + 1, nullptr);
-    std::vector<scalar_t*> DD(N + 1, nullptr);
-    std::vector<scalar_t*> llg(N + 1, nullptr);
-    std::vector<scalar_t*> uug(N + 1, nullptr);
-    std::vector<ocs2::vector_t> boundData;  // Declare at this scope to keep the data alive while HPIPM has the pointers
+    for (auto* pointers : {&CC_, &DD_, &llg_, &uug_}) {
+      std::fill(pointers->begin(), pointers->end(), nullptr);
+    }
 
     if (constraints != nullptr) {
       auto& constr = *constraints;
-      boundData.resize(N + 1);
 
       // k = 0, eliminate initial state
       // numState[0] = 0 --> No need to specify C[0] here
       if (constr[0].f.size() > 0) {
-        boundData[0] = -constr[0].f;
-        boundData[0].noalias() -= constr[0].dfdx * x0;
-        llg[0] = boundData[0].data();
-        uug[0] = boundData[0].data();
-        DD[0] = constr[0].dfdu.data();
+        boundData_[0] = -constr[0].f;
+        boundData_[0].noalias() -= constr[0].dfdx * x0;
+        llg_[0] = boundData_[0].data();
+        uug_[0] = boundData_[0].data();
+        DD_[0] = constr[0].dfdu.data();
       }
 
       // k = 1 -> (N-1)
       for (int k = 1; k < N; k++) {
         if (constr[k].f.size() > 0) {
-          CC[k] = constr[k].dfdx.data();
-          DD[k] = constr[k].dfdu.data();
-          boundData[k] = -constr[k].f;
-          llg[k] = boundData[k].data();
-          uug[k] = boundData[k].data();
+          CC_[k] = constr[k].dfdx.data();
+          DD_[k] = constr[k].dfdu.data();
+          boundData_[k] = -constr[k].f;
+          llg_[k] = boundData_[k].data();
+          uug_[k] = boundData_[k].data();
         }
       }
 
       // k = N, no inputs
       if (constr[N].f.size() > 0) {
-        CC[N] = constr[N].dfdx.data();
-        boundData[N] = -constr[N].f;
-        llg[N] = boundData[N].data();
-        uug[N] = boundData[N].data();
+        CC_[N] = constr[N].dfdx.data();
+        boundData_[N] = -constr[N].f;
+        llg_[N] = boundData_[N].data();
+        uug_[N] = boundData_[N].data();
       }
     }
 
@@ -279,8 +284,69 @@ class HpipmInterface::Impl {
     scalar_t** hlus = nullptr;
 
     // === Set and solve ===
-    d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
-                     hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
+    d_ocp_qp_set_all(AA_.data(), BB_.data(), bb_.data(), QQ_.data(), SS_.data(), RR_.data(), qq_.data(), rr_.data(), hidxbx, hlbx, hubx,
+                     hidxbu, hlbu, hubu, CC_.data(), DD_.data(), llg_.data(), uug_.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
+    return solve(x0, stateTrajectory, inputTrajectory, verbose);
+  }
+
+  void setStage(int k, const vector_t& x0, const VectorFunctionLinearApproximation* dynamics,
+                const ScalarFunctionQuadraticApproximation& cost, const VectorFunctionLinearApproximation* constraints) {
+    const int N = ocpSize_.numStages;
+    if (k < 0 || k > N) {
+      throw std::runtime_error("[HpipmInterface] Stage index " + std::to_string(k) + " is outside [0, " + std::to_string(N) + "].");
+    }
+    if (k < N && dynamics == nullptr) {
+      throw std::runtime_error("[HpipmInterface] Dynamics are required for stage " + std::to_string(k) + ".");
+    }
+
+    // HPIPM takes non-const pointers, but only reads and packs the data.
+    auto data = [](const auto& eigenObject) { return const_cast<scalar_t*>(eigenObject.data()); };
+
+    // === Dynamics and costs ===
+    if (k == 0) {
+      // Absorb initial state into dynamics and cost, see solve()
+      b0_ = dynamics->f;
+      b0_.noalias() += dynamics->dfdx * x0;
+      r0_ = cost.dfdu;
+      r0_.noalias() += cost.dfdux * x0;
+      d_ocp_qp_set_B(0, data(dynamics->dfdu), &qp_);
+      d_ocp_qp_set_b(0, b0_.data(), &qp_);
+      d_ocp_qp_set_R(0, data(cost.dfduu), &qp_);
+      d_ocp_qp_set_r(0, r0_.data(), &qp_);
+    } else if (k < N) {
+      d_ocp_qp_set_A(k, data(dynamics->dfdx), &qp_);
+      d_ocp_qp_set_B(k, data(dynamics->dfdu), &qp_);
+      d_ocp_qp_set_b(k, data(dynamics->f), &qp_);
+      d_ocp_qp_set_Q(k, data(cost.dfdxx), &qp_);
+      d_ocp_qp_set_S(k, data(cost.dfdux), &qp_);
+      d_ocp_qp_set_R(k, data(cost.dfduu), &qp_);
+      d_ocp_qp_set_q(k, data(cost.dfdx), &qp_);
+      d_ocp_qp_set_r(k, data(cost.dfdu), &qp_);
+    } else {  // k = N, no inputs
+      d_ocp_qp_set_Q(N, data(cost.dfdxx), &qp_);
+      d_ocp_qp_set_q(N, data(cost.dfdx), &qp_);
+    }
+
+    // === Constraints ===
+    // for ocs2 --> C*dx + D*du + e = 0
+    // for hpipm --> ug >= C*dx + D*du >= lg
+    if (constraints != nullptr && constraints->f.size() > 0) {
+      auto& bound = boundData_[k];  // Each stage has its own bound, such that stages can be set in parallel
+      bound = -constraints->f;
+      if (k == 0) {
+        bound.noalias() -= constraints->dfdx * x0;
+      } else {
+        d_ocp_qp_set_C(k, data(constraints->dfdx), &qp_);
+      }
+      if (k < N) {
+        d_ocp_qp_set_D(k, data(constraints->dfdu), &qp_);
+      }
+      d_ocp_qp_set_lg(k, bound.data(), &qp_);
+      d_ocp_qp_set_ug(k, bound.data(), &qp_);
+    }
+  }
+
+  hpipm_status solve(const vector_t& x0, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
     d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
 
     if (verbose) {
@@ -300,6 +366,12 @@ class HpipmInterface::Impl {
     return hpipm_status(hpipmStatus);
   }
 
+  int getNumIterations() {
+    int iter = 0;
+    d_ocp_qp_ipm_get_iter(&workspace_, &iter);
+    return iter;
+  }
+
   bool getStateSolution(const vector_t& x0, vector_array_t& stateTrajectory) {
     stateTrajectory.resize(ocpSize_.numStages + 1);
     stateTrajectory.front() = x0;
@@ -327,86 +399,86 @@ class HpipmInterface::Impl {
     return true;
   }
 
-  matrix_array_t getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0) {
+  void getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                          matrix_array_t& RiccatiFeedback) {
     const int N = ocpSize_.numStages;
-    matrix_array_t RiccatiFeedback(N);
+    RiccatiFeedback.resize(N);
 
     // k = 0, state is not a decision variable. Reconstruct backward pass from k = 1
-    matrix_t P1(ocpSize_.numStates[1], ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1.data());
+    P1_.resize(ocpSize_.numStates[1], ocpSize_.numStates[1]);
+    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1_.data());
 
-    matrix_t Lr(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr.data());  // Lr matrix is lower triangular
-    LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
+    Lr_.resize(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
+    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr_.data());  // Lr matrix is lower triangular
+    LinearAlgebra::setTriangularMinimumEigenvalues(Lr_);
 
     // RiccatiFeedback[0] = - (inv(Lr)^T * inv(Lr)) * (S0 + B0^T * P1 * A0)
     RiccatiFeedback[0] = -cost0.dfdux;
-    const matrix_t P1_A0 = P1 * dynamics0.dfdx;
-    RiccatiFeedback[0].noalias() -= dynamics0.dfdu.transpose() * P1_A0;
-    Lr.triangularView<Eigen::Lower>().solveInPlace(RiccatiFeedback[0]);
-    Lr.triangularView<Eigen::Lower>().transpose().solveInPlace(RiccatiFeedback[0]);
+    P1A0_.noalias() = P1_ * dynamics0.dfdx;
+    RiccatiFeedback[0].noalias() -= dynamics0.dfdu.transpose() * P1A0_;
+    Lr_.triangularView<Eigen::Lower>().solveInPlace(RiccatiFeedback[0]);
+    Lr_.triangularView<Eigen::Lower>().transpose().solveInPlace(RiccatiFeedback[0]);
 
     // k > 0
-    matrix_t Ls;
     for (int k = 1; k < N; ++k) {
       const auto numInput = ocpSize_.numInputs[k];
       if (numInput > 0) {
         // RiccatiFeedback[k] = -(Ls * Lr.inverse()).transpose();
-        Lr.resize(numInput, numInput);
-        d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, k, Lr.data());  // Lr matrix is lower triangular
-        LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
-
-        Ls.resize(ocpSize_.numStates[k], numInput);
-        d_ocp_qp_ipm_get_ric_Ls(&qp_, &arg_, &workspace_, k, Ls.data());
-        RiccatiFeedback[k].noalias() = -Lr.triangularView<Eigen::Lower>().transpose().solve(Ls.transpose());
+        Lr_.resize(numInput, numInput);
+        d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, k, Lr_.data());  // Lr matrix is lower triangular
+        LinearAlgebra::setTriangularMinimumEigenvalues(Lr_);
+
+        Ls_.resize(ocpSize_.numStates[k], numInput);
+        d_ocp_qp_ipm_get_ric_Ls(&qp_, &arg_, &workspace_, k, Ls_.data());
+        RiccatiFeedback[k] = -Ls_.transpose();
+        Lr_.triangularView<Eigen::Lower>().transpose().solveInPlace(RiccatiFeedback[k]);
+      } else {
+        RiccatiFeedback[k].resize(0, 0);
       }
     }
-
-    return RiccatiFeedback;
   }
 
-  vector_array_t getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
-                                       const ScalarFunctionQuadraticApproximation& cost0) {
+  void getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                             vector_array_t& RiccatiFeedforward) {
     const int N = ocpSize_.numStages;
-    vector_array_t RiccatiFeedforward(N);
+    RiccatiFeedforward.resize(N);
 
     // k = 0, state is not a decision variable. Reconstruct backward pass from k = 1
-    matrix_t P1(ocpSize_.numStates[1], ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1.data());
+    P1_.resize(ocpSize_.numStates[1], ocpSize_.numStates[1]);
+    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1_.data());
 
-    matrix_t Lr(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr.data());
-    LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
+    Lr_.resize(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
+    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr_.data());
+    LinearAlgebra::setTriangularMinimumEigenvalues(Lr_);
 
-    vector_t p1(ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, 1, p1.data());
+    p1_.resize(ocpSize_.numStates[1]);
+    d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, 1, p1_.data());
 
     // RiccatiFeedforward[0] = -(inv(Lr)^T * inv(Lr)) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0);
     RiccatiFeedforward[0] = -cost0.dfdu;
-    p1.noalias() += P1 * dynamics0.f;  // p1 + P1 * b0
-    RiccatiFeedforward[0].noalias() -= dynamics0.dfdu.transpose() * p1;
-    Lr.triangularView<Eigen::Lower>().solveInPlace(RiccatiFeedforward[0]);
-    Lr.triangularView<Eigen::Lower>().transpose().solveInPlace(RiccatiFeedforward[0]);
+    p1_.noalias() += P1_ * dynamics0.f;  // p1 + P1 * b0
+    RiccatiFeedforward[0].noalias() -= dynamics0.dfdu.transpose() * p1_;
+    Lr_.triangularView<Eigen::Lower>().solveInPlace(RiccatiFeedforward[0]);
+    Lr_.triangularView<Eigen::Lower>().transpose().solveInPlace(RiccatiFeedforward[0]);
 
     // k > 0
     for (int k = 1; k < N; ++k) {
       RiccatiFeedforward[k].resize(ocpSize_.numInputs[k]);
       d_ocp_qp_ipm_get_ric_k(&qp_, &arg_, &workspace_, k, RiccatiFeedforward[k].data());
     }
-
-    return RiccatiFeedforward;
   }
 
-  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
-                                                                       const ScalarFunctionQuadraticApproximation& cost0) {
+  void getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                          std::vector<ScalarFunctionQuadraticApproximation>& RiccatiCostToGo) {
     /*
      * Note on notation: HPIPM uses P, p for the cost-to-go, where we use Sm, sv
      */
     const int N = ocpSize_.numStages;
-    std::vector<ScalarFunctionQuadraticApproximation> RiccatiCostToGo(N + 1);
+    RiccatiCostToGo.resize(N + 1);
 
     // k > 0, this first so we have P[1] ready for P[0].
     for (int k = 1; k <= N; k++) {
+      RiccatiCostToGo[k].f = 0.0;
       RiccatiCostToGo[k].dfdxx.resize(ocpSize_.numStates[k], ocpSize_.numStates[k]);
       RiccatiCostToGo[k].dfdx.resize(ocpSize_.numStates[k]);
       d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdxx.data());
@@ -414,31 +486,35 @@ class HpipmInterface::Impl {
     }
 
     // k = 0
-    matrix_t Lr0(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr0.data());
-    LinearAlgebra::setTriangularMinimumEigenvalues(Lr0);
+    Lr_.resize(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
+    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr_.data());
+    LinearAlgebra::setTriangularMinimumEigenvalues(Lr_);
 
     // Shorthand notation
     const matrix_t& A0 = dynamics0.dfdx;
     const matrix_t& B0 = dynamics0.dfdu;
     const vector_t& b0 = dynamics0.f;
     const matrix_t& Q0 = cost0.dfdxx;
-    matrix_t tmp1 = cost0.dfdux;
+    matrix_t& tmp1 = Ls_;
+    tmp1 = cost0.dfdux;
     const vector_t& q0 = cost0.dfdx;
-    vector_t tmp2 = cost0.dfdu;
+    vector_t& tmp2 = costToGoTmp_;
+    tmp2 = cost0.dfdu;
     const matrix_t& P1 = RiccatiCostToGo[1].dfdxx;
-    vector_t tmp3 = RiccatiCostToGo[1].dfdx;
+    vector_t& tmp3 = p1_;
+    tmp3 = RiccatiCostToGo[1].dfdx;
 
     // Matrix terms
     // RiccatiCostToGo[0].dfdxx = Q0 + A0.transpose() * P1 * A0 -
     //                              (S0 + B0.transpose() * P1 * A0).transpose() * (R0 + B0.transpose() * P1 * B0).inverse() *
     //                                  (S0 + B0.transpose() * P1 * A0)
     // Use that inv(Lr0)^T * inv(Lr0) = (R0 + B0.transpose() * P1 * B0).inverse();
-    const matrix_t P1_A0 = P1 * A0;
-    tmp1.noalias() += B0.transpose() * P1_A0;
-    Lr0.triangularView<Eigen::Lower>().solveInPlace(tmp1);  // tmp1 = inv(Lr0) * (S0.transpose() + A0.transpose() * P1 * B0)
+    P1A0_.noalias() = P1 * A0;
+    tmp1.noalias() += B0.transpose() * P1A0_;
+    Lr_.triangularView<Eigen::Lower>().solveInPlace(tmp1);  // tmp1 = inv(Lr0) * (S0.transpose() + A0.transpose() * P1 * B0)
+    RiccatiCostToGo[0].f = 0.0;
     RiccatiCostToGo[0].dfdxx = Q0;
-    RiccatiCostToGo[0].dfdxx.noalias() += A0.transpose() * P1_A0;
+    RiccatiCostToGo[0].dfdxx.noalias() += A0.transpose() * P1A0_;
     RiccatiCostToGo[0].dfdxx.noalias() -= tmp1.transpose() * tmp1;
 
     // Vector terms
@@ -447,11 +523,10 @@ class HpipmInterface::Impl {
     //                       (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0);
     tmp3.noalias() += P1 * b0;  // tmp3 = p1 + B0.transpose() * P1 * b0
     tmp2.noalias() += B0.transpose() * tmp3;
-    Lr0.triangularView<Eigen::Lower>().solveInPlace(tmp2);  // tmp2 = inv(Lr0) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0)
+    Lr_.triangularView<Eigen::Lower>().solveInPlace(tmp2);  // tmp2 = inv(Lr0) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0)
     RiccatiCostToGo[0].dfdx = q0;
     RiccatiCostToGo[0].dfdx.noalias() += A0.transpose() * tmp3;
     RiccatiCostToGo[0].dfdx.noalias() -= tmp1.transpose() * tmp2;
-    return RiccatiCostToGo;
   }
 
   void printStatus() {
@@ -506,6 +581,17 @@ class HpipmInterface::Impl {
   Settings settings_;
   OcpSize ocpSize_;
 
+  OcpSize requestedOcpSize_;  // The size as requested in resize(), before the initial state is removed
+
+  // Data pointers passed to HPIPM, and the data that is adapted for the initial state or the bounds. Kept to avoid allocations.
+  std::vector<scalar_t*> AA_, BB_, bb_, QQ_, RR_, SS_, qq_, rr_, CC_, DD_, llg_, uug_;
+  vector_t b0_, r0_;
+  vector_array_t boundData_;
+
+  // Temporaries of the Riccati getters
+  matrix_t P1_, P1A0_, Lr_, Ls_;
+  vector_t p1_, costToGoTmp_;
+
   MemoryBlock dimMem_;
   d_ocp_qp_dim dim_;
 
@@ -522,13 +608,12 @@ class HpipmInterface::Impl {
   d_ocp_qp_ipm_ws workspace_;
 };
 
-HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings)
-    : pImpl_(new HpipmInterface::Impl(std::move(ocpSize), settings)) {}
+HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings) : pImpl_(new HpipmInterface::Impl(ocpSize, settings)) {}
 
 HpipmInterface::~HpipmInterface() = default;
 
-void HpipmInterface::resize(OcpSize ocpSize) {
-  pImpl_->initializeMemory(std::move(ocpSize));
+void HpipmInterface::resize(const OcpSize& ocpSize) {
+  pImpl_->initializeMemory(ocpSize);
 }
 
 hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
@@ -538,17 +623,49 @@ hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctio
   return pImpl_->solve(x0, dynamics, cost, constraints, stateTrajectory, inputTrajectory, verbose);
 }
 
+void HpipmInterface::setStage(int k, const vector_t& x0, const VectorFunctionLinearApproximation* dynamics,
+                              const ScalarFunctionQuadraticApproximation& cost, const VectorFunctionLinearApproximation* constraints) {
+  pImpl_->setStage(k, x0, dynamics, cost, constraints);
+}
+
+hpipm_status HpipmInterface::solve(const vector_t& x0, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
+  return pImpl_->solve(x0, stateTrajectory, inputTrajectory, verbose);
+}
+
+int HpipmInterface::getNumIterations() const {
+  return pImpl_->getNumIterations();
+}
+
 std::vector<ScalarFunctionQuadraticApproximation> HpipmInterface::getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
                                                                                      const ScalarFunctionQuadraticApproximation& cost0) {
-  return pImpl_->getRiccatiCostToGo(dynamics0, cost0);
+  std::vector<ScalarFunctionQuadraticApproximation> costToGo;
+  pImpl_->getRiccatiCostToGo(dynamics0, cost0, costToGo);
+  return costToGo;
+}
+void HpipmInterface::getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
+                                        const ScalarFunctionQuadraticApproximation& cost0,
+                                        std::vector<ScalarFunctionQuadraticApproximation>& costToGo) {
+  pImpl_->getRiccatiCostToGo(dynamics0, cost0, costToGo);
 }
 matrix_array_t HpipmInterface::getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0,
                                                   const ScalarFunctionQuadraticApproximation& cost0) {
-  return pImpl_->getRiccatiFeedback(dynamics0, cost0);
+  matrix_array_t feedback;
+  pImpl_->getRiccatiFeedback(dynamics0, cost0, feedback);
+  return feedback;
+}
+void HpipmInterface::getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0,
+                                        const ScalarFunctionQuadraticApproximation& cost0, matrix_array_t& feedback) {
+  pImpl_->getRiccatiFeedback(dynamics0, cost0, feedback);
 }
 vector_array_t HpipmInterface::getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
                                                      const ScalarFunctionQuadraticApproximation& cost0) {
-  return pImpl_->getRiccatiFeedforward(dynamics0, cost0);
+  vector_array_t feedforward;
+  pImpl_->getRiccatiFeedforward(dynamics0, cost0, feedforward);
+  return feedforward;
+}
+void HpipmInterface::getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
+                                           const ScalarFunctionQuadraticApproximation& cost0, vector_array_t& feedforward) {
+  pImpl_->getRiccatiFeedforward(dynamics0, cost0, feedforward);
 }
 
 }  // namespace ocs2
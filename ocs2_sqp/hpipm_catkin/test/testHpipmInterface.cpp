@@ -338,3 +338,45 @@ TEST(test_hpiphm_interface, retrieveRiccati) {
     ASSERT_TRUE(uSol[k].isApprox(KSol[k] * xSol[k] + kSol[k]));
   }
 }
+
+TEST(test_hpiphm_interface, directStageSetup) {
+  int nx = 3;
+  int nu = 2;
+  int nc = 1;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nc));
+  constraints[1] = ocs2::VectorFunctionLinearApproximation();
+
+  const auto ocpSize = ocs2::extractSizesFromProblem(system, cost, &constraints);
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+
+  // Solve with the stacked data
+  std::vector<ocs2::vector_t> xSolGiven;
+  std::vector<ocs2::vector_t> uSolGiven;
+  auto status = hpipmInterface.solve(x0, system, cost, &constraints, xSolGiven, uSolGiven);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+  // Solve with stage-wise data in reverse order
+  for (int k = N; k >= 0; k--) {
+    hpipmInterface.setStage(k, x0, (k < N) ? &system[k] : nullptr, cost[k], &constraints[k]);
+  }
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  status = hpipmInterface.solve(x0, xSol, uSol);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+  ASSERT_TRUE(ocs2::isEqual(xSolGiven, xSol, 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(uSolGiven, uSol, 1e-9));
+}
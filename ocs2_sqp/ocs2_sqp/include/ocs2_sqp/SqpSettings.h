@@ -44,8 +44,9 @@ struct Settings {
   scalar_t costTol = 1e-4;   // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
   // Linesearch - step size rules
-  scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
-  scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  scalar_t alpha_decay = 0.5;       // multiply the step size by this factor every time a linesearch step is rejected.
+  scalar_t alpha_min = 1e-4;        // terminate linesearch if the attempted step size is below this threshold
+  size_t linesearchCandidates = 1;  // number of consecutive step sizes {alpha, alpha * alpha_decay, ...} evaluated concurrently
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -59,10 +60,17 @@ struct Settings {
 
   // QP subproblem solver settings
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
+  bool usePartitionedRiccati = false;  // Solve QPs without constraints (or with projected ones) with the parallel-in-time Riccati solver
+  size_t numRiccatiPartitions = 0;     // Number of horizon partitions of the parallel-in-time Riccati solver, 0 to use nThreads
 
   // Discretization method
   scalar_t dt = 0.01;  // user-defined time discretization
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
+  bool extrapolateTail = false;  // Warm start the tail after the previous solution by holding its last input instead of the initializer
+
+  // Pre-computation
+  bool shareDynamicsPreComputation = false;  // Let the dynamics use the pre-computation of the problem, such that each node is
+                                             // requested once for all terms. Requires dynamics that accept the problem's pre-computation.
 
   // Inequality penalty relaxed barrier parameters
   scalar_t inequalityConstraintMu = 0.0;
@@ -35,8 +35,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
+#include <ocs2_oc/oc_problem/OcpSize.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/oc_solver/PartitionedRiccatiSolver.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 #include <ocs2_oc/search_strategy/FilterLinesearch.h>
 
@@ -112,9 +115,6 @@ class SqpSolver : public SolverBase {
     runImpl(initTime, initState, finalTime);
   }
 
-  /** Run a task in parallel with settings.nThreads */
-  void runParallel(std::function<void(int)> taskFunction);
-
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
 
@@ -122,9 +122,21 @@ class SqpSolver : public SolverBase {
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                             const vector_array_t& u, std::vector<Metrics>& metrics);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, std::vector<Metrics>& metrics);
+  /** A trial point of the linesearch {t, x(t) + a*dx(t), u(t) + a*du(t)} with a = stepSize, and its performance metrics */
+  struct LinesearchCandidate {
+    scalar_t stepSize = 0.0;
+    vector_array_t x;
+    vector_array_t u;
+    std::vector<Metrics> metrics;
+    PerformanceIndex performance;
+  };
+
+  /**
+   * Computes only the performance metrics of the first numCandidates linesearch candidates. The nodes of all candidates are evaluated in
+   * a single parallel loop, such that the threads are split between candidates and nodes.
+   */
+  void computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, size_t numCandidates,
+                          std::vector<LinesearchCandidate>& candidates);
 
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
@@ -132,13 +144,16 @@ class SqpSolver : public SolverBase {
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  void getOCPSolution(const vector_t& delta_x0, OcpSubproblemSolution& solution);
+
+  /** Returns true if the QP subproblem is solved by the parallel-in-time Riccati solver instead of HPIPM */
+  bool usePartitionedRiccati() const;
 
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
 
-  /** Constructs the primal solution based on the optimized state and input trajectories */
-  PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u);
+  /** Writes the primal solution based on the optimized state and input trajectories into primalSolution_ */
+  void toPrimalSolution(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& u);
 
   /** Decides on the step to take and overrides given trajectories {x(t), u(t)} <- {x(t) + a*dx(t), u(t) + a*du(t)} */
   sqp::StepInfo takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization, const vector_t& initState,
@@ -158,6 +173,7 @@ class SqpSolver : public SolverBase {
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  PartitionedRiccatiSolver partitionedRiccatiSolver_;
 
   // Threading
   ThreadPool threadPool_;
@@ -182,18 +198,34 @@ class SqpSolver : public SolverBase {
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
+  // Iteration data. It is kept between iterations and calls to run(), such that it is not reallocated for an unchanged horizon.
+  std::vector<AnnotatedTime> timeDiscretization_;
+  vector_array_t x_;
+  vector_array_t u_;
+  std::vector<Metrics> metrics_;
+  std::vector<LinesearchCandidate> linesearchCandidates_;
+  std::vector<PerformanceIndex> workerPerformance_;
+  std::vector<multiple_shooting::TranscriptionWorkspace> workerTranscription_;  // swapped with the LQ approximation of each node
+  vector_t deltaX0_;
+  OcpSubproblemSolution deltaSolution_;
+  vector_array_t deltaUSolProjected_;
+  matrix_array_t feedbackProjected_;
+  matrix_array_t feedback_;
+  OcpSize ocpSize_;
+
   // The ProblemMetrics associated to primalSolution_
   ProblemMetrics problemMetrics_;
 
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
+  size_t totalNumQpIterations_{0};
   sqp::Logger<sqp::LogEntry> logger_;
-  benchmark::RepeatedTimer initializationTimer_;
-  benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
-  benchmark::RepeatedTimer solveQpTimer_;
-  benchmark::RepeatedTimer linesearchTimer_;
-  benchmark::RepeatedTimer computeControllerTimer_;
+  benchmark::RepeatedTimer initializationTimer_{"SqpSolver::initialization"};
+  benchmark::RepeatedTimer linearQuadraticApproximationTimer_{"SqpSolver::linearQuadraticApproximation"};
+  benchmark::RepeatedTimer solveQpTimer_{"SqpSolver::solveQp"};
+  benchmark::RepeatedTimer linesearchTimer_{"SqpSolver::linesearch"};
+  benchmark::RepeatedTimer computeControllerTimer_{"SqpSolver::computeController"};
 };
 
 }  // namespace ocs2
@@ -58,6 +58,7 @@ sqp::Settings rectifySettings(const OptimalControlProblem& ocp, sqp::Settings&&
 SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
+      partitionedRiccatiSolver_(settings_.numRiccatiPartitions > 0 ? settings_.numRiccatiPartitions : settings_.nThreads),
       threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority),
       logger_(settings_.logSize) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
@@ -71,6 +72,13 @@ SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optima
   for (int w = 0; w < settings_.nThreads; w++) {
     ocpDefinitions_.push_back(optimalControlProblem);
   }
+  // Optionally, the dynamics of each worker share its pre-computation, such that each node is requested once for all terms
+  if (settings_.shareDynamicsPreComputation) {
+    for (auto& ocpDefinition : ocpDefinitions_) {
+      ocpDefinition.dynamicsPtr->setSharedPreComputation(ocpDefinition.preComputationPtr.get());
+    }
+  }
+  workerTranscription_.resize(settings_.nThreads);
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
@@ -118,11 +126,15 @@ void SqpSolver::reset() {
   // reset timers
   numProblems_ = 0;
   totalNumIterations_ = 0;
+  totalNumQpIterations_ = 0;
   logger_ = sqp::Logger<sqp::LogEntry>(settings_.logSize);
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
   linesearchTimer_.reset();
   computeControllerTimer_.reset();
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    ocpDefinition.preComputationPtr->resetCacheStatistics();
+  }
 }
 
 std::string SqpSolver::getBenchmarkingInformation() const {
@@ -147,6 +159,15 @@ std::string SqpSolver::getBenchmarkingInformation() const {
                << linesearchTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tCompute Controller :\t" << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << computeControllerTotal / benchmarkTotal * inPercent << "%)\n";
+    infoStream << "\tQP iterations      :\t" << static_cast<scalar_t>(totalNumQpIterations_) / std::max<size_t>(totalNumIterations_, 1)
+               << " (average per SQP iteration)\n";
+    size_t numRequests = 0;
+    size_t numReused = 0;
+    for (const auto& ocpDefinition : ocpDefinitions_) {
+      numRequests += ocpDefinition.preComputationPtr->getCacheStatistics().numRequests;
+      numReused += ocpDefinition.preComputationPtr->getCacheStatistics().numReused;
+    }
+    infoStream << "\tPre-computation    :\t" << numReused << " of " << numRequests << " requests reused\n";
   }
   return infoStream.str();
 }
@@ -189,12 +210,16 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  constexpr scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>();
+  timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes, dt_min, timeDiscretization_);
+  const auto& timeDiscretization = timeDiscretization_;
 
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
     const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
     ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+    // The references might have changed, which invalidates the pre-computation at any node
+    ocpDefinition.preComputationPtr->invalidateCache();
   }
 
   // Trajectory spread of primalSolution_
@@ -203,12 +228,19 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 
   // Initialize the state and input
-  vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  auto& x = x_;
+  auto& u = u_;
+  if (settings_.extrapolateTail) {
+    multiple_shooting::shiftStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, discretizer_,
+                                                   *ocpDefinitions_.front().dynamicsPtr, x, u);
+  } else {
+    multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  }
 
   // Bookkeeping
   performanceIndeces_.clear();
-  std::vector<Metrics> metrics;
+  performanceIndeces_.reserve(settings_.sqpIteration);
+  auto& metrics = metrics_;
 
   int iter = 0;
   sqp::Convergence convergence = sqp::Convergence::FALSE;
@@ -223,8 +255,9 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
     // Solve QP
     solveQpTimer_.startTimer();
-    const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
+    deltaX0_ = initState - x[0];
+    getOCPSolution(deltaX0_, deltaSolution_);
+    const auto& deltaSolution = deltaSolution_;
     extractValueFunction(timeDiscretization, x);
     solveQpTimer_.endTimer();
 
@@ -261,8 +294,8 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   ++numProblems_;
 
   computeControllerTimer_.startTimer();
-  primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
-  problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
+  toPrimalSolution(timeDiscretization, x, u);
+  multiple_shooting::toProblemMetrics(timeDiscretization, metrics, problemMetrics_);
   computeControllerTimer_.endTimer();
 
   if (settings_.printSolverStatus || settings_.printLinesearch) {
@@ -273,28 +306,37 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
-void SqpSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
-}
-
-SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta_x0) {
-  // Solve the QP
-  OcpSubproblemSolution solution;
+void SqpSolver::getOCPSolution(const vector_t& delta_x0, OcpSubproblemSolution& solution) {
+  // Solve the QP. When projecting, the QP is in the projected input, which is remapped into the solution afterwards.
   auto& deltaXSol = solution.deltaXSol;
-  auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
-  const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
-    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, &stateInputEqConstraints_));
-    status =
-        hpipmInterface_.solve(delta_x0, dynamics_, cost_, &stateInputEqConstraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  }
+  auto& deltaUSol = settings_.projectStateInputEqualityConstraints ? deltaUSolProjected_ : solution.deltaUSol;
+  if (usePartitionedRiccati()) {
+    partitionedRiccatiSolver_.solve(threadPool_, delta_x0, dynamics_, cost_, deltaXSol, deltaUSol);
+  } else {
+    hpipm_status status;
+    const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
+    // without constraints, or when using projection, we have an unconstrained QP.
+    const bool isConstrainedQp = hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints;
+    auto* constraintsPtr = isConstrainedQp ? &stateInputEqConstraints_ : nullptr;
+    extractSizesFromProblem(dynamics_, cost_, constraintsPtr, ocpSize_);
+    hpipmInterface_.resize(ocpSize_);
+    if (settings_.hpipmSettings.directStageSetup) {
+      const int N = static_cast<int>(dynamics_.size());
+      auto setStageTask = [&](int, int k) {
+        const auto* dynamicsPtr = (k < N) ? &dynamics_[k] : nullptr;
+        const auto* stageConstraintsPtr = (constraintsPtr != nullptr) ? &(*constraintsPtr)[k] : nullptr;
+        hpipmInterface_.setStage(k, delta_x0, dynamicsPtr, cost_[k], stageConstraintsPtr);
+      };
+      threadPool_.parallelFor(0, N + 1, 1, setStageTask);
+      status = hpipmInterface_.solve(delta_x0, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    } else {
+      status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, constraintsPtr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    }
+    totalNumQpIterations_ += hpipmInterface_.getNumIterations();
 
-  if (status != hpipm_status::SUCCESS) {
-    throw std::runtime_error("[SqpSolver] Failed to solve QP");
+    if (status != hpipm_status::SUCCESS) {
+      throw std::runtime_error("[SqpSolver] Failed to solve QP");
+    }
   }
 
   // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
@@ -302,15 +344,23 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
 
   // remap the tilde delta u to real delta u
   if (settings_.projectStateInputEqualityConstraints) {
-    multiple_shooting::remapProjectedInput(constraintsProjection_, deltaXSol, deltaUSol);
+    multiple_shooting::remapProjectedInput(constraintsProjection_, deltaXSol, deltaUSolProjected_, solution.deltaUSol);
   }
+}
 
-  return solution;
+bool SqpSolver::usePartitionedRiccati() const {
+  // The parallel-in-time Riccati solver only handles QPs without constraints, which is also the case when projecting the constraints.
+  const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
+  return settings_.usePartitionedRiccati && (!hasStateInputConstraints || settings_.projectStateInputEqualityConstraints);
 }
 
 void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
+    if (usePartitionedRiccati()) {
+      partitionedRiccatiSolver_.getRiccatiCostToGo(valueFunction_);
+    } else {
+      hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0], valueFunction_);
+    }
     // Correct for linearization state
     for (int i = 0; i < time.size(); ++i) {
       valueFunction_[i].dfdx.noalias() -= valueFunction_[i].dfdxx * x[i];
@@ -318,18 +368,23 @@ void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
   }
 }
 
-PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
+void SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& u) {
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
   if (settings_.useFeedbackPolicy) {
-    ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    // With projection, the Riccati feedback is in the projected input and is remapped to the original input
+    auto& KMatrices = settings_.projectStateInputEqualityConstraints ? feedbackProjected_ : feedback_;
+    if (usePartitionedRiccati()) {
+      KMatrices = partitionedRiccatiSolver_.getRiccatiFeedback();
+    } else {
+      hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0], KMatrices);
+    }
     if (settings_.projectStateInputEqualityConstraints) {
-      multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
+      multiple_shooting::remapProjectedGain(constraintsProjection_, feedbackProjected_, feedback_);
     }
-    return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u), std::move(KMatrices));
+    multiple_shooting::toPrimalSolution(time, modeSchedule, x, u, feedback_, primalSolution_);
 
   } else {
-    ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u));
+    multiple_shooting::toPrimalSolution(time, modeSchedule, x, u, primalSolution_);
   }
 }
 
@@ -338,7 +393,8 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
+  auto& performance = workerPerformance_;
+  performance.assign(settings_.nThreads, PerformanceIndex());
   cost_.resize(N + 1);
   dynamics_.resize(N);
   stateInputEqConstraints_.resize(N + 1);  // +1 because of HpipmInterface size check
@@ -348,67 +404,67 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   projectionMultiplierCoefficients_.resize(N);
   metrics.resize(N + 1);
 
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  auto nodeTask = [&](int workerId, int i) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
-    PerformanceIndex workerPerformance;  // Accumulate performance in local variable
-
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-        stateInputIneqConstraints_[i].resize(0, x[i].size());
-        constraintsProjection_[i].resize(0, x[i].size());
-        projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
-        if (settings_.projectStateInputEqualityConstraints) {
-          multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
-        }
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
-      }
-
-      i = timeIndex++;
-    }
+    PerformanceIndex& workerPerformance = performance[workerId];  // Accumulate! Same worker might run multiple nodes
+    auto& workspace = workerTranscription_[workerId];
 
-    if (i == N) {  // Only one worker will execute this
+    // The transcription is written into the worker's workspace, and swapped with the storage of the node. The performance is derived
+    // from the metrics in the same way as in computePerformance().
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
-      workerPerformance += multiple_shooting::computePerformanceIndex(result);
-      cost_[i] = std::move(result.cost);
+      auto& result = workspace.terminal;
+      multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N], result);
+      multiple_shooting::computeMetrics(result, metrics[i]);
+      workerPerformance += toPerformanceIndex(metrics[i]);
+      std::swap(cost_[i], result.cost);
       stateInputEqConstraints_[i].resize(0, x[i].size());
-      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      std::swap(stateIneqConstraints_[i], result.ineqConstraints);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      auto& result = workspace.event;
+      multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1], result);
+      multiple_shooting::computeMetrics(result, metrics[i]);
+      workerPerformance += toPerformanceIndex(metrics[i]);
+      std::swap(cost_[i], result.cost);
+      std::swap(dynamics_[i], result.dynamics);
+      stateInputEqConstraints_[i].resize(0, x[i].size());
+      std::swap(stateIneqConstraints_[i], result.ineqConstraints);
+      stateInputIneqConstraints_[i].resize(0, x[i].size());
+      constraintsProjection_[i].resize(0, x[i].size());
+      projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      auto& result = workspace.intermediate;
+      multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i], result);
+      multiple_shooting::computeMetrics(result, metrics[i]);
+      workerPerformance += toPerformanceIndex(metrics[i], dt);
+      if (settings_.projectStateInputEqualityConstraints) {
+        // The projected terms change the input dimension, they are written into the node storage of the same size.
+        multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier, workspace.projection, cost_[i],
+                                                dynamics_[i], stateInputIneqConstraints_[i]);
+        std::swap(constraintsProjection_[i], result.constraintsProjection);
+        std::swap(projectionMultiplierCoefficients_[i], result.projectionMultiplierCoefficients);
+      } else {
+        constraintsProjection_[i] = VectorFunctionLinearApproximation();
+        projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+        std::swap(cost_[i], result.cost);
+        std::swap(dynamics_[i], result.dynamics);
+        std::swap(stateInputIneqConstraints_[i], result.stateInputIneqConstraints);
+      }
+      std::swap(stateInputEqConstraints_[i], result.stateInputEqConstraints);
+      std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
     }
-
-    // Accumulate! Same worker might run multiple tasks
-    performance[workerId] += workerPerformance;
   };
-  runParallel(std::move(parallelTask));
+  threadPool_.parallelFor(0, N + 1, 1, nodeTask);
 
   // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  metrics.front().dynamicsViolation += initState - x.front();
+  performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
 
   // Sum performance of the threads
   PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
@@ -417,52 +473,63 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   return totalPerformance;
 }
 
-PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, std::vector<Metrics>& metrics) {
+void SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, size_t numCandidates,
+                                   std::vector<LinesearchCandidate>& candidates) {
   // Problem size
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
+  const int numNodes = N + 1;
+  for (size_t j = 0; j < numCandidates; ++j) {
+    candidates[j].metrics.resize(numNodes);
+  }
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
-  auto parallelTask = [&](int workerId) {
+  // Performance of candidate j accumulated by a worker is stored at [j * nThreads + workerId]
+  auto& performance = workerPerformance_;
+  performance.assign(numCandidates * settings_.nThreads, PerformanceIndex());
+  auto nodeTask = [&](int workerId, int k) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
-      }
-
-      i = timeIndex++;
-    }
+    // Get candidate and node of the task
+    const int j = k / numNodes;
+    const int i = k % numNodes;
+    const auto& x = candidates[j].x;
+    const auto& u = candidates[j].u;
+    auto& metrics = candidates[j].metrics;
+    PerformanceIndex& workerPerformance = performance[j * settings_.nThreads + workerId];
 
-    if (i == N) {  // Only one worker will execute this
+    if (i == N) {
+      // Terminal node
       const scalar_t tN = getIntervalStart(time[N]);
       metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += toPerformanceIndex(metrics[N]);
+      workerPerformance += toPerformanceIndex(metrics[N]);
+    } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      workerPerformance += toPerformanceIndex(metrics[i]);
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+      workerPerformance += toPerformanceIndex(metrics[i], dt);
     }
   };
-  runParallel(std::move(parallelTask));
+  threadPool_.parallelFor(0, static_cast<int>(numCandidates) * numNodes, 1, nodeTask);
 
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  for (size_t j = 0; j < numCandidates; ++j) {
+    auto& candidate = candidates[j];
+    const auto workerBegin = performance.begin() + j * settings_.nThreads;
+    const auto workerEnd = workerBegin + settings_.nThreads;
 
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
-  return totalPerformance;
+    // Account for initial state in performance
+    candidate.metrics.front().dynamicsViolation += initState - candidate.x.front();
+    workerBegin->dynamicsViolationSSE += (initState - candidate.x.front()).squaredNorm();
+
+    // Sum performance of the threads
+    candidate.performance = std::accumulate(std::next(workerBegin), workerEnd, *workerBegin);
+    candidate.performance.merit =
+        candidate.performance.cost + candidate.performance.equalityLagrangian + candidate.performance.inequalityLagrangian;
+  }
 }
 
 sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
@@ -474,6 +541,9 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
    * Filter linesearch based on:
    * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
    * https://link.springer.com/article/10.1007/s10107-004-0559-y
+   *
+   * The step sizes of the backtracking sequence are evaluated concurrently in batches of settings_.linesearchCandidates, and the largest
+   * accepted step size of a batch is taken. This results in the same step as trying the step sizes one after the other.
    */
   if (settings_.printLinesearch) {
     std::cerr << std::setprecision(9) << std::fixed;
@@ -490,57 +560,74 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
   const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
 
+  auto& candidates = linesearchCandidates_;
+  const size_t maxNumCandidates = std::max(settings_.linesearchCandidates, size_t(1));
+  if (candidates.size() < maxNumCandidates) {
+    candidates.resize(maxNumCandidates);
+  }
+
   scalar_t alpha = 1.0;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  std::vector<Metrics> metricsNew(metrics.size());
+  bool tooSmallStep = false;
   do {
-    // Compute step
-    multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
-    multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
+    // Compute the steps of the next candidates of the backtracking sequence
+    size_t numCandidates = 0;
+    do {
+      auto& candidate = candidates[numCandidates++];
+      candidate.stepSize = alpha;
+      candidate.x.resize(x.size());
+      candidate.u.resize(u.size());
+      multiple_shooting::incrementTrajectory(u, du, alpha, candidate.u);
+      multiple_shooting::incrementTrajectory(x, dx, alpha, candidate.x);
+
+      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
+      alpha *= settings_.alpha_decay;
+      tooSmallStep = alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol;
+    } while (numCandidates < maxNumCandidates && !tooSmallStep && alpha >= settings_.alpha_min);
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew, metricsNew);
-
-    // Step acceptance and record step type
-    bool stepAccepted;
-    StepType stepType;
-    std::tie(stepAccepted, stepType) =
-        filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
-    }
+    computePerformance(timeDiscretization, initState, numCandidates, candidates);
+
+    for (size_t j = 0; j < numCandidates; ++j) {
+      auto& candidate = candidates[j];
+
+      // Step acceptance and record step type
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) =
+          filterLinesearch_.acceptStep(baseline, candidate.performance, candidate.stepSize * subproblemSolution.armijoDescentMetric);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << candidate.stepSize << ", Step Type: " << toString(stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << candidate.stepSize * deltaXnorm << "\t|du| = " << candidate.stepSize * deltaUnorm << "\n";
+        std::cerr << candidate.performance << "\n";
+      }
 
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      metrics = std::move(metricsNew);
-
-      // Prepare step info
-      sqp::StepInfo stepInfo;
-      stepInfo.stepSize = alpha;
-      stepInfo.stepType = stepType;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
-      return stepInfo;
-
-    } else {  // Try smaller step
-      alpha *= settings_.alpha_decay;
+      if (stepAccepted) {  // Return the largest accepted step
+        // Swap instead of move, such that the memory of the previous iterate is reused for the next trial
+        x.swap(candidate.x);
+        u.swap(candidate.u);
+        metrics.swap(candidate.metrics);
+
+        // Prepare step info
+        sqp::StepInfo stepInfo;
+        stepInfo.stepSize = candidate.stepSize;
+        stepInfo.stepType = stepType;
+        stepInfo.dx_norm = candidate.stepSize * deltaXnorm;
+        stepInfo.du_norm = candidate.stepSize * deltaUnorm;
+        stepInfo.performanceAfterStep = candidate.performance;
+        stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(candidate.performance);
+        return stepInfo;
+      }
+    }
 
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
-        if (settings_.printLinesearch) {
-          std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
-                    << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
-        }
-        break;
+    // All candidates are rejected -> Try smaller steps
+    if (tooSmallStep) {
+      if (settings_.printLinesearch) {
+        std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
+                  << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
       }
+      break;
     }
   } while (alpha >= settings_.alpha_min);
 
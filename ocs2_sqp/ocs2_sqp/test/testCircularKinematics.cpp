@@ -141,3 +141,52 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+TEST(test_circular_kinematics, parallel_linesearch) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.alpha_decay = 0.8;  // <- slow decay such that steps are rejected multiple times
+  settings.nThreads = 3;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with sequential linesearch
+  settings.linesearchCandidates = 1;
+  ocs2::SqpSolver sequentialSolver(settings, problem, zeroInitializer);
+  sequentialSolver.run(startTime, initState, finalTime);
+
+  // Solve with several step sizes evaluated concurrently
+  settings.linesearchCandidates = 3;
+  ocs2::SqpSolver parallelSolver(settings, problem, zeroInitializer);
+  parallelSolver.run(startTime, initState, finalTime);
+
+  // Same iterates, up to the summation order of the performance indices
+  const auto& sequentialLog = sequentialSolver.getIterationsLog();
+  const auto& parallelLog = parallelSolver.getIterationsLog();
+  ASSERT_EQ(sequentialLog.size(), parallelLog.size());
+  for (int i = 0; i < sequentialLog.size(); i++) {
+    EXPECT_NEAR(sequentialLog[i].merit, parallelLog[i].merit, 1e-9);
+    EXPECT_NEAR(sequentialLog[i].dynamicsViolationSSE, parallelLog[i].dynamicsViolationSSE, 1e-9);
+    EXPECT_NEAR(sequentialLog[i].equalityConstraintsSSE, parallelLog[i].equalityConstraintsSSE, 1e-9);
+  }
+
+  const auto sequentialSolution = sequentialSolver.primalSolution(finalTime);
+  const auto parallelSolution = parallelSolver.primalSolution(finalTime);
+  ASSERT_EQ(sequentialSolution.stateTrajectory_.size(), parallelSolution.stateTrajectory_.size());
+  for (int i = 0; i < sequentialSolution.stateTrajectory_.size(); i++) {
+    EXPECT_TRUE(sequentialSolution.stateTrajectory_[i].isApprox(parallelSolution.stateTrajectory_[i], 1e-6));
+    EXPECT_TRUE(sequentialSolution.inputTrajectory_[i].isApprox(parallelSolution.inputTrajectory_[i], 1e-6));
+  }
+}
@@ -0,0 +1,120 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/oc_problem/OcpSize.h>
+#include <ocs2_oc/oc_solver/PartitionedRiccatiSolver.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+#include <hpipm_catkin/HpipmInterface.h>
+
+using namespace ocs2;
+
+/**
+ * Compares the QP solve of HPIPM against the parallel-in-time Riccati solver on unconstrained LQ problems of increasing horizon length.
+ */
+class TestPartitionedRiccatiBenchmark : public ::testing::Test {
+ public:
+  static constexpr size_t numSolves = 20;
+  static constexpr size_t nThreads = 4;
+  static constexpr int nx = 24;
+  static constexpr int nu = 12;
+
+  TestPartitionedRiccatiBenchmark() : threadPool(nThreads - 1) { srand(0); }
+
+  void setProblem(int N) {
+    x0 = vector_t::Random(nx);
+    dynamics.clear();
+    cost.clear();
+    for (int k = 0; k < N; k++) {
+      // Stable discrete dynamics keep the long horizons well conditioned
+      auto stageDynamics = getRandomDynamics(nx, nu);
+      stageDynamics.dfdx = 0.5 * matrix_t::Identity(nx, nx) + 0.2 * stageDynamics.dfdx;
+      dynamics.push_back(std::move(stageDynamics));
+      cost.push_back(getRandomCost(nx, nu));
+    }
+    cost.push_back(getRandomCost(nx, 0));
+  }
+
+  ThreadPool threadPool;
+  vector_t x0;
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+};
+
+constexpr size_t TestPartitionedRiccatiBenchmark::numSolves;
+constexpr size_t TestPartitionedRiccatiBenchmark::nThreads;
+constexpr int TestPartitionedRiccatiBenchmark::nx;
+constexpr int TestPartitionedRiccatiBenchmark::nu;
+
+TEST_F(TestPartitionedRiccatiBenchmark, horizonLength) {
+  const scalar_t tol = 1e-6;
+
+  for (int N : {50, 100, 200, 500, 1000}) {
+    setProblem(N);
+
+    HpipmInterface hpipmInterface(OcpSize(N, nx, nu));
+    PartitionedRiccatiSolver sequentialSolver(1);
+    PartitionedRiccatiSolver partitionedSolver(nThreads);
+    benchmark::RepeatedTimer hpipmTimer;
+    benchmark::RepeatedTimer sequentialTimer;
+    benchmark::RepeatedTimer partitionedTimer;
+
+    vector_array_t xHpipm, uHpipm, xSequential, uSequential, xPartitioned, uPartitioned;
+    for (size_t i = 0; i < numSolves; i++) {
+      hpipmTimer.startTimer();
+      const auto status = hpipmInterface.solve(x0, dynamics, cost, nullptr, xHpipm, uHpipm);
+      hpipmTimer.endTimer();
+      ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+      sequentialTimer.startTimer();
+      sequentialSolver.solve(threadPool, x0, dynamics, cost, xSequential, uSequential);
+      sequentialTimer.endTimer();
+
+      partitionedTimer.startTimer();
+      partitionedSolver.solve(threadPool, x0, dynamics, cost, xPartitioned, uPartitioned);
+      partitionedTimer.endTimer();
+    }
+
+    for (int k = 0; k < N; k++) {
+      ASSERT_TRUE(uPartitioned[k].isApprox(uHpipm[k], tol)) << "N: " << N << ", k: " << k;
+      ASSERT_TRUE(uSequential[k].isApprox(uHpipm[k], tol)) << "N: " << N << ", k: " << k;
+      ASSERT_TRUE(xPartitioned[k + 1].isApprox(xHpipm[k + 1], tol)) << "N: " << N << ", k: " << k;
+    }
+
+    std::cerr << "[PartitionedRiccati] N = " << N << ", nx = " << nx << ", nu = " << nu << ", nThreads = " << nThreads << "\n"
+              << "\thpipm                 [ms]: " << hpipmTimer.getAverageInMilliseconds() << "\n"
+              << "\tsequential riccati    [ms]: " << sequentialTimer.getAverageInMilliseconds() << "\n"
+              << "\tpartitioned riccati   [ms]: " << partitionedTimer.getAverageInMilliseconds() << "\n";
+  }
+}
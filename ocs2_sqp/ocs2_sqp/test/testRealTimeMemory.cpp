@@ -0,0 +1,293 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+
+#include "ocs2_sqp/SqpSolver.h"
+
+#include <ocs2_core/constraint/StateInputConstraintCollection.h>
+#include <ocs2_core/cost/StateCostCollection.h>
+#include <ocs2_core/cost/StateInputCostCollection.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+/*
+ * Counts the heap allocations by interposing malloc. Eigen and the default operator new both allocate through malloc. Only available
+ * with glibc, which exposes the underlying allocator.
+ */
+#ifdef __GLIBC__
+namespace {
+std::atomic<bool> countAllocations{false};
+std::atomic<size_t> numAllocations{0};
+}  // namespace
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size) {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_realloc(ptr, size);
+}
+}
+
+namespace ocs2 {
+namespace {
+
+/** Returns the number of heap allocations of the given function call */
+template <typename Function>
+size_t countHeapAllocations(Function&& function) {
+  numAllocations = 0;
+  countAllocations = true;
+  function();
+  countAllocations = false;
+  return numAllocations;
+}
+
+/** Pauses the counting during its lifetime */
+class UncountedScope {
+ public:
+  UncountedScope() : wasCounting_(countAllocations.exchange(false)) {}
+  ~UncountedScope() { countAllocations = wasCounting_; }
+
+ private:
+  const bool wasCounting_;
+};
+
+/*
+ * The problem definition returns its evaluations by value. The following wrappers exclude the allocations of the problem definition from
+ * the count, such that only the allocations of the solver are counted.
+ */
+class UncountedDynamics final : public SystemDynamicsBase {
+ public:
+  explicit UncountedDynamics(std::unique_ptr<SystemDynamicsBase> dynamicsPtr) : dynamicsPtr_(std::move(dynamicsPtr)) {}
+  ~UncountedDynamics() override = default;
+  UncountedDynamics* clone() const override { return new UncountedDynamics(*this); }
+
+  vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp) override {
+    UncountedScope uncounted;
+    return dynamicsPtr_->computeFlowMap(t, x, u, preComp);
+  }
+
+  VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                        const PreComputation& preComp) override {
+    UncountedScope uncounted;
+    return dynamicsPtr_->linearApproximation(t, x, u, preComp);
+  }
+
+ private:
+  UncountedDynamics(const UncountedDynamics& other) : SystemDynamicsBase(other), dynamicsPtr_(other.dynamicsPtr_->clone()) {}
+
+  std::unique_ptr<SystemDynamicsBase> dynamicsPtr_;
+};
+
+class UncountedCostCollection final : public StateInputCostCollection {
+ public:
+  UncountedCostCollection() = default;
+  ~UncountedCostCollection() override = default;
+  UncountedCostCollection* clone() const override { return new UncountedCostCollection(*this); }
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override {
+    UncountedScope uncounted;
+    return StateInputCostCollection::getValue(time, state, input, targetTrajectories, preComp);
+  }
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override {
+    UncountedScope uncounted;
+    return StateInputCostCollection::getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  }
+
+ private:
+  UncountedCostCollection(const UncountedCostCollection& other) = default;
+};
+
+class UncountedStateCostCollection final : public StateCostCollection {
+ public:
+  UncountedStateCostCollection() = default;
+  ~UncountedStateCostCollection() override = default;
+  UncountedStateCostCollection* clone() const override { return new UncountedStateCostCollection(*this); }
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override {
+    UncountedScope uncounted;
+    return StateCostCollection::getValue(time, state, targetTrajectories, preComp);
+  }
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override {
+    UncountedScope uncounted;
+    return StateCostCollection::getQuadraticApproximation(time, state, targetTrajectories, preComp);
+  }
+
+ private:
+  UncountedStateCostCollection(const UncountedStateCostCollection& other) = default;
+};
+
+class UncountedConstraintCollection final : public StateInputConstraintCollection {
+ public:
+  UncountedConstraintCollection() = default;
+  ~UncountedConstraintCollection() override = default;
+  UncountedConstraintCollection* clone() const override { return new UncountedConstraintCollection(*this); }
+
+  vector_array_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) const override {
+    UncountedScope uncounted;
+    return StateInputConstraintCollection::getValue(time, state, input, preComp);
+  }
+
+  VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                           const PreComputation& preComp) const override {
+    UncountedScope uncounted;
+    return StateInputConstraintCollection::getLinearApproximation(time, state, input, preComp);
+  }
+
+  LinearApproximationSparsity getLinearApproximationSparsity(scalar_t time, size_t stateDim, size_t inputDim) const override {
+    UncountedScope uncounted;
+    return StateInputConstraintCollection::getLinearApproximationSparsity(time, stateDim, inputDim);
+  }
+
+ private:
+  UncountedConstraintCollection(const UncountedConstraintCollection& other) = default;
+};
+
+void checkSteadyStateAllocations(size_t nThreads, SensitivityIntegratorType integratorType, bool usePartitionedRiccati,
+                                 bool projectConstraints, bool extractProjectionMultiplier) {
+  const int n = 3;
+  const int m = 2;
+  const auto dynamics = getRandomDynamics(n, m);
+  const auto costs = getRandomCost(n, m);
+
+  OptimalControlProblem problem;
+  problem.dynamicsPtr.reset(new UncountedDynamics(getOcs2Dynamics(dynamics)));
+  problem.costPtr.reset(new UncountedCostCollection);
+  problem.costPtr->add("intermediateCost", getOcs2Cost(costs));
+  problem.finalCostPtr.reset(new UncountedStateCostCollection);
+  problem.finalCostPtr->add("finalCost", getOcs2StateCost(costs));
+  if (projectConstraints) {
+    problem.equalityConstraintPtr.reset(new UncountedConstraintCollection);
+    problem.equalityConstraintPtr->add("intermediateConstraint", getOcs2Constraints(getRandomConstraints(n, m, 1)));
+  }
+
+  TargetTrajectories targetTrajectories({0.0}, {vector_t::Ones(n)}, {vector_t::Ones(m)});
+  auto referenceManagerPtr = std::make_shared<ReferenceManager>(targetTrajectories);
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 3;
+  settings.integratorType = integratorType;
+  settings.nThreads = nThreads;
+  settings.projectStateInputEqualityConstraints = projectConstraints;
+  settings.extractProjectionMultiplier = extractProjectionMultiplier;
+  settings.useFeedbackPolicy = true;
+  settings.createValueFunction = true;
+  settings.printSolverStatistics = false;
+  settings.usePartitionedRiccati = usePartitionedRiccati;
+  settings.numRiccatiPartitions = 2;
+
+  SqpSolver solver(settings, problem, DefaultInitializer(m));
+  solver.setReferenceManager(referenceManagerPtr);
+
+  // Warm up, the first calls size all storage
+  const vector_t initState = vector_t::Ones(n);
+  const scalar_t horizon = 1.0;
+  scalar_t initTime = 0.0;
+  for (int i = 0; i < 2; ++i) {
+    solver.run(initTime, initState, initTime + horizon);
+    initTime += 0.01;
+  }
+
+  // Only the problem definition allocates in a steady-state run
+  const size_t runAllocations = countHeapAllocations([&]() { solver.run(initTime, initState, initTime + horizon); });
+  EXPECT_EQ(runAllocations, 0) << "nThreads: " << nThreads;
+}
+
+/** Checks the steady-state allocations on the calling thread only and with the help of the thread pool */
+void checkSteadyStateAllocations(SensitivityIntegratorType integratorType, bool usePartitionedRiccati, bool projectConstraints,
+                                 bool extractProjectionMultiplier = false) {
+  for (const size_t nThreads : {1, 3}) {
+    checkSteadyStateAllocations(nThreads, integratorType, usePartitionedRiccati, projectConstraints, extractProjectionMultiplier);
+  }
+}
+
+}  // namespace
+}  // namespace ocs2
+
+TEST(test_real_time_memory, hpipm) {
+  ocs2::checkSteadyStateAllocations(ocs2::SensitivityIntegratorType::RK2, false, false);
+}
+
+TEST(test_real_time_memory, hpipmProjection) {
+  ocs2::checkSteadyStateAllocations(ocs2::SensitivityIntegratorType::RK2, false, true);
+}
+
+TEST(test_real_time_memory, partitionedRiccati) {
+  ocs2::checkSteadyStateAllocations(ocs2::SensitivityIntegratorType::RK2, true, false);
+}
+
+TEST(test_real_time_memory, partitionedRiccatiProjection) {
+  ocs2::checkSteadyStateAllocations(ocs2::SensitivityIntegratorType::RK2, true, true);
+}
+
+TEST(test_real_time_memory, partitionedRiccatiProjectionMultiplier) {
+  ocs2::checkSteadyStateAllocations(ocs2::SensitivityIntegratorType::RK2, true, true, true);
+}
+
+TEST(test_real_time_memory, integratorTypes) {
+  for (const auto integratorType : {ocs2::SensitivityIntegratorType::EULER, ocs2::SensitivityIntegratorType::RK4}) {
+    ocs2::checkSteadyStateAllocations(integratorType, true, false);
+  }
+}
+
+#endif
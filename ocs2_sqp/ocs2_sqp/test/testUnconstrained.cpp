@@ -41,7 +41,7 @@ namespace {
 
 std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSetting(
     bool feedback, bool emptyConstraint, const VectorFunctionLinearApproximation& dynamicsMatrices,
-    const ScalarFunctionQuadraticApproximation& costMatrices) {
+    const ScalarFunctionQuadraticApproximation& costMatrices, bool partitionedRiccati = false) {
   int n = dynamicsMatrices.dfdu.rows();
   int m = dynamicsMatrices.dfdu.cols();
 
@@ -76,6 +76,8 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSettin
   settings.printSolverStatus = true;
   settings.printLinesearch = true;
   settings.nThreads = 100;
+  settings.usePartitionedRiccati = partitionedRiccati;
+  settings.numRiccatiPartitions = 4;
 
   // Additional problem definitions
   const ocs2::scalar_t startTime = 0.0;
@@ -160,3 +162,29 @@ TEST(test_unconstrained, noFeedback) {
         withEmptyConstraint.controllerPtr_->computeInput(t, x).isApprox(withNullConstraint.controllerPtr_->computeInput(t, x), tol));
   }
 }
+
+TEST(test_unconstrained, partitionedRiccati) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-8;  // different QP solvers
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto solHpipm = ocs2::solveWithFeedbackSetting(true, true, dynamics, costs, false);
+  const auto solPartitioned = ocs2::solveWithFeedbackSetting(true, true, dynamics, costs, true);
+
+  ASSERT_LE(solPartitioned.second.size(), 2);
+  ASSERT_LT(solPartitioned.second.back().dynamicsViolationSSE, tol);
+
+  // Compare
+  const auto& withHpipm = solHpipm.first;
+  const auto& withPartitioned = solPartitioned.first;
+  for (int i = 0; i < withHpipm.timeTrajectory_.size(); i++) {
+    ASSERT_DOUBLE_EQ(withHpipm.timeTrajectory_[i], withPartitioned.timeTrajectory_[i]);
+    ASSERT_TRUE(withHpipm.stateTrajectory_[i].isApprox(withPartitioned.stateTrajectory_[i], tol));
+    ASSERT_TRUE(withHpipm.inputTrajectory_[i].isApprox(withPartitioned.inputTrajectory_[i], tol));
+
+    const auto t = withHpipm.timeTrajectory_[i];
+    const auto& x = withHpipm.stateTrajectory_[i];
+    ASSERT_TRUE(withHpipm.controllerPtr_->computeInput(t, x).isApprox(withPartitioned.controllerPtr_->computeInput(t, x), tol));
+  }
+}